@@ -229,7 +229,9 @@ namespace quda {
   };
 
 
-  // driver for computing the clover field from the gauge field
+  // driver for computing the clover field from the gauge field; on
+  // the host the clover field must be in QUDA_PACKED_CLOVER_ORDER and
+  // the field strength in QUDA_MILC_GAUGE_ORDER
   void computeClover(CloverField &clover, const GaugeField &gauge, double coeff,  QudaFieldLocation location);
 
 
@@ -257,7 +259,7 @@ namespace quda {
 
      @param clover The clover field (contains both the field itself and its inverse)
      @param computeTraceLog Whether to compute the trace logarithm of the clover term
-     @param location The location of the field
+     @param location The location of the field (host fields must be in QUDA_PACKED_CLOVER_ORDER)
   */
   void cloverInvert(CloverField &clover, bool computeTraceLog, QudaFieldLocation location);
 
@@ -478,6 +478,20 @@ namespace quda {
 	  for (int i=0; i<length; i++) clover[parity][x*length+i] = 2.0*v[i];
 	}
 
+	/**
+	   @brief Load the chiral block of a site, in the same layout as FloatNOrder
+	 */
+	__device__ __host__ inline void load(RegType v[length/2], int x, int parity, int chirality) const {
+	  for (int i=0; i<length/2; i++) v[i] = 0.5*clover[parity][x*length + chirality*length/2 + i];
+	}
+
+	/**
+	   @brief Store the chiral block of a site, in the same layout as FloatNOrder
+	 */
+	__device__ __host__ inline void save(const RegType v[length/2], int x, int parity, int chirality) {
+	  for (int i=0; i<length/2; i++) clover[parity][x*length + chirality*length/2 + i] = 2.0*v[i];
+	}
+
 	size_t Bytes() const { return length*sizeof(Float); }
       };
 
@@ -607,6 +607,28 @@ namespace quda {
     return z;
   }
 
+  /**
+     @brief ColorSpinor subtraction operator
+     @param[in] x Input vector
+     @param[in] y Input vector
+     @return The vector x - y
+  */
+  template<typename Float, int Nc, int Ns> __device__ __host__ inline
+    ColorSpinor<Float,Nc,Ns> operator-(const ColorSpinor<Float,Nc,Ns> &x, const ColorSpinor<Float,Nc,Ns> &y) {
+
+    ColorSpinor<Float,Nc,Ns> z;
+
+#pragma unroll
+    for (int i=0; i<Nc; i++) {
+#pragma unroll
+      for (int s=0; s<Ns; s++) {
+	z.data[s*Nc + i] = x.data[s*Nc + i] - y.data[s*Nc + i];
+      }
+    }
+
+    return z;
+  }
+
   /**
      @brief Compute the scalar-vector product y = a * x
      @param[in] a Input scalar
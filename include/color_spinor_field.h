@@ -753,6 +753,50 @@ namespace quda {
   void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity, const GaugeField& U, double A, double B);
   void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity, const GaugeField& U, double alpha);
 
+  /**
+     @brief Apply a generic Wuppertal smearing step to a set of vectors,
+     e.g., the twelve spin-color columns of a propagator.  The links
+     of each site are loaded once and applied to every vector.  Host
+     fields must be SPACE_SPIN_COLOR ordered with a QDP or MILC gauge
+     field and are processed with threaded kernels.
+     @param[out] out The out result fields
+     @param[in] in The in spinor fields
+     @param[in] parity The parity to update for single parity fields
+     @param[in] U The gauge field
+     @param[in] A The scaling factor for in(x)
+     @param[in] B The scaling factor for the hopping term
+  */
+  void wuppertalStep(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
+		     const GaugeField& U, double A, double B);
+
+  /**
+     @brief Apply nSteps standard Wuppertal smearing steps, alternating
+     between out and tmp such that the final step lands in out.  No
+     fields are allocated or copied between steps.
+     @param[out] out The out result field
+     @param[in] in The in spinor field, left unchanged
+     @param[in,out] tmp Work field of the same shape as out
+     @param[in] parity The parity to update for single parity fields
+     @param[in] U The gauge field
+     @param[in] alpha The smearing parameter
+     @param[in] nSteps The number of smearing steps
+  */
+  void wuppertalSmear(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &tmp,
+		      int parity, const GaugeField& U, double alpha, int nSteps);
+
+  /**
+     @brief Multi-vector variant of wuppertalSmear
+     @param[out] out The out result fields
+     @param[in] in The in spinor fields, left unchanged
+     @param[in,out] tmp Work fields of the same shape as out
+     @param[in] parity The parity to update for single parity fields
+     @param[in] U The gauge field
+     @param[in] alpha The smearing parameter
+     @param[in] nSteps The number of smearing steps
+  */
+  void wuppertalSmear(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+		      std::vector<ColorSpinorField*> &tmp, int parity, const GaugeField& U, double alpha, int nSteps);
+
   void exchangeExtendedGhost(cudaColorSpinorField* spinor, int R[], int parity, cudaStream_t *stream_p);
 
   void copyExtendedColorSpinor(ColorSpinorField &dst, const ColorSpinorField &src,
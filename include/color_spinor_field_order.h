@@ -660,8 +660,8 @@ namespace quda {
 	{
 	  if (volumeCB != stride) errorQuda("Stride must equal volume for this field order");
 	  for (int i=0; i<4; i++) {
-	    ghost[2*i] = ghost_ ? ghost_[2*i] : 0;
-	    ghost[2*i+1] = ghost_ ? ghost_[2*i+1] : 0;
+	    ghost[2*i] = ghost_ ? ghost_[2*i] : (Float*)(a.Ghost()[2*i]);
+	    ghost[2*i+1] = ghost_ ? ghost_[2*i+1] : (Float*)(a.Ghost()[2*i+1]);
 	    faceVolumeCB[i] = a.SurfaceCB(i)*nFace;
 	  }
 	}
@@ -707,6 +707,69 @@ namespace quda {
 	  }
 	}
 
+	/**
+	   @brief This accessor routine returns a colorspinor_wrapper to this object,
+	   allowing us to overload various operators for manipulating at
+	   the site level interms of matrix operations.
+	   @param[in] x_cb Checkerboarded space-time index we are requesting
+	   @param[in] parity Parity we are requesting
+	   @return Instance of a colorspinor_wrapper that curries in access to
+	   this field at the above coordinates.
+	*/
+	__device__ __host__ inline colorspinor_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >
+	  operator()(int x_cb, int parity) {
+	  return colorspinor_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >(*this, x_cb, parity);
+	}
+
+	/**
+	   @brief This accessor routine returns a const colorspinor_wrapper to this object,
+	   allowing us to overload various operators for manipulating at
+	   the site level interms of matrix operations.
+	   @param[in] x_cb Checkerboarded space-time index we are requesting
+	   @param[in] parity Parity we are requesting
+	   @return Instance of a colorspinor_wrapper that curries in access to
+	   this field at the above coordinates.
+	*/
+	__device__ __host__ inline const colorspinor_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >
+	  operator()(int x_cb, int parity) const {
+	  return colorspinor_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >
+	    (const_cast<SpaceSpinorColorOrder<Float,Ns,Nc>&>(*this), x_cb, parity);
+	}
+
+	/**
+	   @brief This accessor routine returns a colorspinor_ghost_wrapper to this object,
+	   allowing us to overload various operators for manipulating at
+	   the site level interms of matrix operations.
+	   @param[in] dim Dimensions of the ghost we are requesting
+	   @param[in] dir Direction of the ghost we are requesting
+	   @param[in] ghost_idx Checkerboarded space-time ghost index we are requesting
+	   @param[in] parity Parity we are requesting
+	   @return Instance of a colorspinor_ghost_wrapper that curries in access to
+	   this field at the above coordinates.
+	*/
+	__device__ __host__ inline colorspinor_ghost_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >
+	  Ghost(int dim, int dir, int ghost_idx, int parity) {
+	  return colorspinor_ghost_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >(*this, dim, dir, ghost_idx, parity);
+	}
+
+	/**
+	   @brief This accessor routine returns a const
+	   colorspinor_ghost_wrapper to this object, allowing us to
+	   overload various operators for manipulating at the site
+	   level interms of matrix operations.
+	   @param[in] dim Dimensions of the ghost we are requesting
+	   @param[in] dir Direction of the ghost we are requesting
+	   @param[in] ghost_idx Checkerboarded space-time ghost index we are requesting
+	   @param[in] parity Parity we are requesting
+	   @return Instance of a colorspinor_ghost_wrapper that curries in access to
+	   this field at the above coordinates.
+	*/
+	__device__ __host__ inline const colorspinor_ghost_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >
+	  Ghost(int dim, int dir, int ghost_idx, int parity) const {
+	  return colorspinor_ghost_wrapper<RegType,SpaceSpinorColorOrder<Float,Ns,Nc> >
+	    (const_cast<SpaceSpinorColorOrder<Float,Ns,Nc>&>(*this), dim, dir, ghost_idx, parity);
+	}
+
 	size_t Bytes() const { return nParity * volumeCB * Nc * Ns * 2 * sizeof(Float); }
       };
 
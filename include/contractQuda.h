@@ -7,6 +7,46 @@
 namespace quda {
   void contractCuda(const cudaColorSpinorField &x, const cudaColorSpinorField &y, void *result, const QudaContractType contract_type, const QudaParity parity, TimeProfile &profile);
   void contractCuda(const cudaColorSpinorField &x, const cudaColorSpinorField &y, void *result, const QudaContractType contract_type, const int tSlice, const QudaParity parity, TimeProfile &profile);
+
+  /**
+     Batched meson contractions of two propagators, computing for every
+     pair of sink and source gamma matrices and every momentum
+
+       C(t) = sum_x exp(-i p.x) Tr[G_snk S1(x) G_src gamma_5 S2(x)^dagger gamma_5]
+
+     in a single pass over the lattice, with the momentum projection and
+     time-slice reduction fused into the site loop.  Gamma matrix g is
+     gamma_1^{g&1} gamma_2^{(g>>1)&1} gamma_3^{(g>>2)&1} gamma_4^{(g>>3)&1}
+     in the basis of the fields, with g = 16 denoting gamma_5.  The
+     host implementation is threaded and the result does not depend on
+     the number of threads.
+     @param[out] corr Correlators, indexed ((snk*n_src + src)*n_mom + p)*Lt + t
+     @param[in] prop1 The 12 spin-color columns of the first propagator, host fields
+     @param[in] prop2 The 12 spin-color columns of the second propagator, host fields
+     @param[in] gamma_snk Sink gamma matrices
+     @param[in] gamma_src Source gamma matrices
+     @param[in] mom Momenta in lattice units of 2 pi / L, as (px,py,pz) triplets
+  */
+  void contractMesons(std::vector<Complex> &corr, const std::vector<ColorSpinorField*> &prop1,
+		      const std::vector<ColorSpinorField*> &prop2, const std::vector<int> &gamma_snk,
+		      const std::vector<int> &gamma_src, const std::vector<int> &mom);
+
+  /**
+     Batched nucleon contractions, computing for every momentum
+
+       C(t) = sum_x exp(-i p.x) eps_abc eps_a'b'c' Gamma_gd Gamma_d'g' P_ba S_d^{bb'}_{dd'}
+              (S_u^{aa'}_{gg'} S_u^{cc'}_{ab} - S_u^{ac'}_{gb} S_u^{ca'}_{ag'})
+
+     with Gamma = C gamma_5, C = gamma_2 gamma_4 and the positive parity
+     projector P = (1 + gamma_4)/2, in the basis of the fields.
+     @param[out] corr Correlators, indexed p*Lt + t
+     @param[in] prop_u The 12 spin-color columns of the up propagator, host fields
+     @param[in] prop_d The 12 spin-color columns of the down propagator, host fields
+     @param[in] mom Momenta in lattice units of 2 pi / L, as (px,py,pz) triplets
+  */
+  void contractBaryons(std::vector<Complex> &corr, const std::vector<ColorSpinorField*> &prop_u,
+		       const std::vector<ColorSpinorField*> &prop_d, const std::vector<int> &mom);
+
   void covDev(cudaColorSpinorField *out, cudaGaugeField &gauge, const cudaColorSpinorField *in, const int parity, const int mu, TimeProfile &profile);
 
   class CovD {
@@ -109,6 +109,35 @@ namespace quda {
 
   };
 
+  /**
+     @brief Multi-threaded host reduction that is bit-wise
+     reproducible.  The index range is split into a fixed number of
+     contiguous chunks, independent of the number of threads, each
+     chunk is summed in order, and the chunk partial sums are then
+     combined in order.
+     @param[in] n Number of elements to reduce over
+     @param[in] f Functor returning the contribution of element i
+     @return The sum of f(i) over i in [0, n)
+   */
+  template <typename T, typename F>
+  T hostReduce(int n, const F &f) {
+    constexpr int n_chunk = 256;
+    T partial[n_chunk];
+
+#pragma omp parallel for
+    for (int c=0; c<n_chunk; c++) {
+      const int begin = static_cast<int>((static_cast<long>(n) * c) / n_chunk);
+      const int end = static_cast<int>((static_cast<long>(n) * (c+1)) / n_chunk);
+      T sum = T();
+      for (int i=begin; i<end; i++) sum = Summ<T>()(sum, f(i));
+      partial[c] = sum;
+    }
+
+    T sum = T();
+    for (int c=0; c<n_chunk; c++) sum = Summ<T>()(sum, partial[c]);
+    return sum;
+  }
+
 #ifdef QUAD_SUM
   __device__ __host__ inline void zero(doubledouble &x) { x.a.x = 0.0; x.a.y = 0.0; }
   __device__ __host__ inline void zero(doubledouble2 &x) { zero(x.x); zero(x.y); }
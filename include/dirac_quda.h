@@ -8,6 +8,7 @@
 #include <dslash_quda.h>
 #include <face_quda.h>
 #include <blas_quda.h>
+#include <stencil.h>
 
 #include <typeinfo>
 
@@ -30,8 +31,8 @@ namespace quda {
     QudaMatPCType matpcType;
     QudaDagType dagger;
     cudaGaugeField *gauge;
-    cudaGaugeField *fatGauge;  // used by staggered only
-    cudaGaugeField *longGauge; // used by staggered only
+    GaugeField *fatGauge;  // used by staggered only (device or host)
+    GaugeField *longGauge; // used by staggered only (device or host)
     cudaCloverField *clover;
   
     double mu; // used by twisted mass only
@@ -46,11 +47,12 @@ namespace quda {
     // for multigrid only
     Transfer *transfer; 
     Dirac *dirac;
+    QudaPrecision link_precision; // precision in which the coarse link field is stored for operator application
 
   DiracParam() 
     : type(QUDA_INVALID_DIRAC), kappa(0.0), m5(0.0), matpcType(QUDA_MATPC_INVALID),
       dagger(QUDA_DAG_INVALID), gauge(0), clover(0), mu(0.0), mu_factor(0.0), epsilon(0.0),
-      tmp1(0), tmp2(0)
+      tmp1(0), tmp2(0), link_precision(QUDA_INVALID_PRECISION)
     {
 
     }
@@ -175,6 +177,16 @@ namespace quda {
   protected:
     void initConstants();
 
+    /**
+       @brief Apply the multi-flavour operator to both parities of full fields
+       @param[out] out The output fields
+       @param[in] in The input fields
+       @param[in] flavor The coefficients of each flavour
+       @param[in] A The clover field (NULL if there is no clover term)
+    */
+    void MultiFlavorApply(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			  const std::vector<WilsonFlavorParam> &flavor, const CloverField *A) const;
+
   public:
     DiracWilson(const DiracParam &param);
     DiracWilson(const DiracWilson &dirac);
@@ -190,6 +202,19 @@ namespace quda {
     virtual void M(ColorSpinorField &out, const ColorSpinorField &in) const;
     virtual void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+    /**
+       @brief Apply the full operator to several flavours that differ
+       only in their mass parameters.  The hopping term is independent
+       of the mass, so the links of each site are loaded once and
+       applied to every flavour.
+       @param[out] out The output fields, one per flavour
+       @param[in] in The input fields, one per flavour
+       @param[in] kappa The kappa of each flavour
+       @param[in] mu The twisted mass of each flavour (must be zero for Wilson)
+    */
+    virtual void MultiFlavorM(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<double> &kappa, const std::vector<double> &mu) const;
+
     virtual void prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			 ColorSpinorField &x, ColorSpinorField &b,
 			 const QudaSolutionType) const;
@@ -250,6 +275,18 @@ namespace quda {
     virtual void M(ColorSpinorField &out, const ColorSpinorField &in) const;
     virtual void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+    /**
+       @brief Apply the full operator to several flavours with the same
+       c_sw.  The clover term of flavour f is 1 + (kappa_f/kappa) (A - 1),
+       so it is formed from the resident clover field A on the fly.
+       @param[out] out The output fields, one per flavour
+       @param[in] in The input fields, one per flavour
+       @param[in] kappa The kappa of each flavour
+       @param[in] mu The twisted mass of each flavour (must be zero)
+    */
+    virtual void MultiFlavorM(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<double> &kappa, const std::vector<double> &mu) const;
+
     virtual void prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			 ColorSpinorField &x, ColorSpinorField &b,
 			 const QudaSolutionType) const;
@@ -486,6 +523,18 @@ namespace quda {
     virtual void M(ColorSpinorField &out, const ColorSpinorField &in) const;
     virtual void MdagM(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+    /**
+       @brief Apply the full single-flavour twisted-mass operator to
+       several flavours, (1 + 2 i kappa_f mu_f gamma_5) - kappa_f D,
+       loading the links of each site once for all flavours
+       @param[out] out The output fields, one per flavour
+       @param[in] in The input fields, one per flavour
+       @param[in] kappa The kappa of each flavour
+       @param[in] mu The twisted mass of each flavour
+    */
+    virtual void MultiFlavorM(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<double> &kappa, const std::vector<double> &mu) const;
+
     virtual void prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			 ColorSpinorField &x, ColorSpinorField &b,
 			 const QudaSolutionType) const;
@@ -688,8 +737,8 @@ namespace quda {
   class DiracImprovedStaggered : public Dirac {
 
   protected:
-    cudaGaugeField &fatGauge;
-    cudaGaugeField &longGauge;
+    GaugeField &fatGauge;
+    GaugeField &longGauge;
 
   public:
     DiracImprovedStaggered(const DiracParam &param);
@@ -756,8 +805,33 @@ namespace quda {
     cudaGaugeField *Xinv_d; /** GPU copy of inverse coarse clover term */
     cudaGaugeField *Yhat_d; /** GPU copy of the preconditioned coarse link field */
 
+    QudaPrecision link_precision; /** Precision in which the link fields are stored for operator application */
+    cpuGaugeField *Y_half_h; /** CPU half-precision copy of the coarse link field (used for application only) */
+    cpuGaugeField *Yhat_half_h; /** CPU half-precision copy of the preconditioned coarse link field */
+    cudaGaugeField *Y_half_d; /** GPU half-precision copy of the coarse link field (used for application only) */
+    cudaGaugeField *Yhat_half_d; /** GPU half-precision copy of the preconditioned coarse link field */
+
     void initializeCoarse();  /** Initialize the coarse gauge field */
 
+    /**
+       @brief Create the half-precision copies of the link fields
+       Y and Yhat.  Each link matrix is stored in 16-bit fixed
+       point with its own scale factor, given by the maximum element
+       of that matrix.  The full-precision fields
+       are retained, since they are needed to construct the next
+       coarser operator.
+    */
+    void createHalfLinks();
+
+    /**
+       @brief Return the link field used to apply the operator at a
+       given location: the half-precision copy if it exists,
+       otherwise the full-precision field.
+       @param[in] location Location of the fields we are applying to
+       @param[in] preconditioned Whether to return Yhat or Y
+    */
+    const GaugeField& Link(QudaFieldLocation location, bool preconditioned=false) const;
+
     bool enable_gpu; /** Whether to enable this operator for the GPU */
     bool init; /** Whether this instance did the allocation or not */
 
@@ -176,6 +176,7 @@ extern "C" {
     QUDA_MG_CYCLE_FCYCLE,
     QUDA_MG_CYCLE_WCYCLE,
     QUDA_MG_CYCLE_RECURSIVE,
+    QUDA_MG_CYCLE_KCYCLE,
     QUDA_MG_CYCLE_INVALID = QUDA_INVALID_ENUM
   } QudaMultigridCycleType;
 
@@ -480,6 +481,26 @@ extern "C" {
     QUDA_CONTRACT_INVALID = QUDA_INVALID_ENUM
   } QudaContractType;
 
+  typedef enum QudaGaugeFlowType_s {
+    QUDA_FLOW_WILSON,
+    QUDA_FLOW_SYMANZIK,
+    QUDA_FLOW_ZEUTHEN,
+    QUDA_FLOW_INVALID = QUDA_INVALID_ENUM
+  } QudaGaugeFlowType;
+
+  typedef enum QudaIntegratorType_s {
+    QUDA_LEAPFROG_INTEGRATOR,
+    QUDA_OMELYAN_INTEGRATOR,
+    QUDA_FORCE_GRADIENT_INTEGRATOR,
+    QUDA_INVALID_INTEGRATOR = QUDA_INVALID_ENUM
+  } QudaIntegratorType;
+
+  typedef enum QudaForceTermType_s {
+    QUDA_GAUGE_FORCE_TERM,
+    QUDA_CALLBACK_FORCE_TERM,
+    QUDA_INVALID_FORCE_TERM = QUDA_INVALID_ENUM
+  } QudaForceTermType;
+
 #ifdef __cplusplus
 }
 #endif
@@ -160,6 +160,7 @@
 #define QUDA_MG_CYCLE_FCYCLE 1
 #define QUDA_MG_CYCLE_WCYCLE 2
 #define QUDA_MG_CYCLE_RECURSIVE 3
+#define QUDA_MG_CYCLE_KCYCLE 4
 #define QUDA_MG_CYCLE_INVALID QUDA_INVALID_ENUM
 
 #define QudaSchwarzType integer(4)
@@ -423,4 +424,21 @@
 #define QUDA_CONTRACT_TSLICE_MINUS 8
 #define QUDA_CONTRACT_INVALID QUDA_INVALID_ENUM
 
+#define QudaGaugeFlowType integer(4)
+#define QUDA_FLOW_WILSON 0
+#define QUDA_FLOW_SYMANZIK 1
+#define QUDA_FLOW_ZEUTHEN 2
+#define QUDA_FLOW_INVALID QUDA_INVALID_ENUM
+
+#define QudaIntegratorType integer(4)
+#define QUDA_LEAPFROG_INTEGRATOR 0
+#define QUDA_OMELYAN_INTEGRATOR 1
+#define QUDA_FORCE_GRADIENT_INTEGRATOR 2
+#define QUDA_INVALID_INTEGRATOR QUDA_INVALID_ENUM
+
+#define QudaForceTermType integer(4)
+#define QUDA_GAUGE_FORCE_TERM 0
+#define QUDA_CALLBACK_FORCE_TERM 1
+#define QUDA_INVALID_FORCE_TERM QUDA_INVALID_ENUM
+
 #endif 
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace quda {
+
+  /**
+     @brief Serial 64-bit xxHash (XXH64) of a byte buffer.
+     @param buf Buffer to hash
+     @param bytes Length of the buffer in bytes
+     @param seed Hash seed
+     @return The XXH64 digest of the buffer
+   */
+  uint64_t xxHash64(const void *buf, size_t bytes, uint64_t seed=0);
+
+  /**
+     @brief Threaded content hash of a host buffer.  The buffer is
+     split into fixed-size chunks that are hashed in parallel with
+     XXH64, and the chunk digests are then hashed in order, so the
+     result is independent of the number of threads used.
+     @param buf Host buffer to hash
+     @param bytes Length of the buffer in bytes
+     @param seed Hash seed
+     @return The content hash of the buffer
+   */
+  uint64_t hostHash(const void *buf, size_t bytes, uint64_t seed=0);
+
+  /**
+     @brief Fold a value into a running hash
+     @param hash Running hash
+     @param value Value to fold in
+     @return The updated hash
+   */
+  inline uint64_t hashCombine(uint64_t hash, uint64_t value) { return xxHash64(&value, sizeof(value), hash); }
+
+} // namespace quda
@@ -124,7 +124,7 @@ namespace quda {
     QudaFieldGeometry geometry; // whether the field is a scale, vector or tensor
 
     QudaReconstructType reconstruct;
-    int nInternal; // number of degrees of freedom per link matrix
+    int nInternal; // number of degrees of freedom per link matrix (including the scale of half-precision coarse links)
     QudaGaugeFieldOrder order;
     QudaGaugeFixed fixed;
     QudaLinkType link_type;
@@ -165,6 +165,7 @@ namespace quda {
 
     int Length() const { return length; }
     int Ncolor() const { return nColor; }
+    int Ninternal() const { return nInternal; }
     QudaReconstructType Reconstruct() const { return reconstruct; }
     QudaGaugeFieldOrder Order() const { return order; }
     double Anisotropy() const { return anisotropy; }
@@ -194,6 +195,7 @@ namespace quda {
     double iMu() const { return i_mu; }
 
     const double& LinkMax() const { return fat_link_max; }
+
     int Nface() const { return nFace; }
 
     void checkField(const LatticeField &) const;
@@ -348,6 +350,16 @@ namespace quda {
   private:
     void **gauge; // the actual gauge field
 
+    /**
+       @brief Fill the border of an extended QDP or MILC ordered
+       field, including its edges and corners, with a single round of
+       messages to all neighbours (see exchangeExtendedGhost)
+       @param R The thickness of the extended region in each dimension
+       @param no_comms_fill Do local exchange to fill out the extended
+       region in non-partitioned dimensions
+    */
+    void exchangeExtendedBorder(const int *R, bool no_comms_fill);
+
   public:
     /**
        @brief Constructor for cpuGaugeField from a GaugeFieldParam
@@ -377,6 +389,10 @@ namespace quda {
     /**
        @brief This does routine will populate the border / halo region of a
        gauge field that has been created using copyExtendedGauge.  
+       Only the border is touched, so the interior can be updated in
+       place and refreshed at a cost proportional to the surface.  QDP
+       and MILC ordered fields exchange every face, edge and corner
+       region at once; other orders exchange one dimension at a time.
 
        @param R The thickness of the extended region in each dimension
        @param no_comms_fill Do local exchange to fill out the extended
@@ -384,6 +400,19 @@ namespace quda {
     */
     void exchangeExtendedGhost(const int *R, bool no_comms_fill=false);
 
+    /**
+       @brief Populate the border of an extended field one dimension
+       at a time with blocking exchanges, each of which forwards the
+       border filled by the previous dimensions to fill the edges and
+       corners.  This is the path of exchangeExtendedGhost for orders
+       other than QDP and MILC.
+
+       @param R The thickness of the extended region in each dimension
+       @param no_comms_fill Do local exchange to fill out the extended
+       region in non-partitioned dimenions
+    */
+    void exchangeExtendedGhostByDim(const int *R, bool no_comms_fill=false);
+
     /**
      * Generic gauge field copy
      * @param[in] src Source from which we are copying
@@ -147,7 +147,118 @@ namespace quda {
 
     template<typename ReduceType, typename Float> struct square { __host__ __device__ ReduceType operator()(quda::complex<Float> x) { return static_cast<ReduceType>(norm(x)); } };
 
-    template<typename Float, int nColor, QudaGaugeFieldOrder order> struct Accessor {
+    /**
+       @brief fieldorder_wrapper is an internal class that is used to
+       wrap elements of gauge fields that are stored in fixed-point
+       (short) format.  Every link matrix of a fixed-point field
+       carries its own scale factor, stored as a float in one extra
+       complex element that follows the matrix elements.  Reads
+       decode the element into the computation precision Float using
+       the scale of the matrix it belongs to, and writes encode the
+       element back into fixed point.  This allows kernels written
+       against the complex<Float> interface of the FieldOrder
+       accessors to consume fixed-point fields unchanged.
+    */
+    template <typename Float, typename storeFloat>
+    struct fieldorder_wrapper {
+      complex<storeFloat> *v;
+      const float *scale_inv;
+
+      /**
+	 @brief fieldorder_wrapper constructor
+	 @param[in] v Pointer to the stored element
+	 @param[in] scale_inv Pointer to the decoding scale factor (matrix max / fixed-point max)
+      */
+      __device__ __host__ inline fieldorder_wrapper(complex<storeFloat> *v, const float *scale_inv)
+	: v(v), scale_inv(scale_inv) { }
+
+      __device__ __host__ inline Float real() const { return static_cast<Float>(*scale_inv) * static_cast<Float>(v->real()); }
+      __device__ __host__ inline Float imag() const { return static_cast<Float>(*scale_inv) * static_cast<Float>(v->imag()); }
+
+      /**
+	 @brief Decode the stored element into the computation precision
+      */
+      __device__ __host__ inline operator complex<Float>() const { return complex<Float>(real(), imag()); }
+
+      /**
+	 @brief Encode a complex number into the fixed-point storage.
+	 The scale of the matrix must have been set beforehand (see
+	 FieldOrder::setMax).
+	 @param[in] a The value we are storing
+      */
+      __device__ __host__ inline void operator=(const complex<Float> &a) {
+	const Float scale = *scale_inv > 0.0f ? static_cast<Float>(1.0) / static_cast<Float>(*scale_inv) : static_cast<Float>(0.0);
+	*v = complex<storeFloat>(static_cast<storeFloat>(round(scale * a.real())),
+				 static_cast<storeFloat>(round(scale * a.imag())));
+      }
+
+      /**
+	 @brief Assignment from another wrapped element, which may use a different scale
+	 @param[in] a The wrapped element we are copying
+      */
+      __device__ __host__ inline fieldorder_wrapper& operator=(const fieldorder_wrapper &a) {
+	*this = complex<Float>(a);
+	return *this;
+      }
+    };
+
+    template <typename Float, typename storeFloat>
+    __device__ __host__ inline complex<Float> conj(const fieldorder_wrapper<Float,storeFloat> &a) {
+      return complex<Float>(a.real(), -a.imag());
+    }
+
+    template <typename Float, typename storeFloat>
+    __device__ __host__ inline complex<Float> operator*(const fieldorder_wrapper<Float,storeFloat> &a, const complex<Float> &b) {
+      return complex<Float>(a) * b;
+    }
+
+    template <typename Float, typename storeFloat>
+    __device__ __host__ inline complex<Float> operator*(const complex<Float> &a, const fieldorder_wrapper<Float,storeFloat> &b) {
+      return a * complex<Float>(b);
+    }
+
+    template <typename Float, typename storeFloat>
+    __host__ __device__ inline Float norm(const fieldorder_wrapper<Float,storeFloat> &a) {
+      return a.real()*a.real() + a.imag()*a.imag();
+    }
+
+    /**
+       @brief Helper that resolves the type returned by the element
+       accessors: a reference to the stored element when the storage
+       and computation precisions agree, and a fieldorder_wrapper
+       when the field is stored in fixed point.
+    */
+    template <typename Float, typename storeFloat> struct accessor_ref {
+      typedef fieldorder_wrapper<Float,storeFloat> type;
+      typedef const fieldorder_wrapper<Float,storeFloat> const_type;
+      /**
+	 @param[in] m Pointer to the first element of the link matrix
+	 @param[in] offset Offset of the element from m
+	 @param[in] scale_offset Offset of the matrix scale from m
+      */
+      __device__ __host__ static inline type get(complex<storeFloat> *m, int offset, int scale_offset)
+      { return type(m + offset, reinterpret_cast<const float*>(m + scale_offset)); }
+    };
+
+    template <typename Float> struct accessor_ref<Float,Float> {
+      typedef complex<Float>& type;
+      typedef const complex<Float>& const_type;
+      __device__ __host__ static inline type get(complex<Float> *m, int offset, int) { return m[offset]; }
+    };
+
+    /**
+       @brief Set the scale of a fixed-point link matrix from the
+       maximum absolute real or imaginary part of its elements; this
+       is a no-op for fields that are not stored in fixed point.
+       @param[in] scale Pointer to the scale element of the matrix
+       @param[in] max Maximum absolute element of the matrix
+    */
+    template <typename storeFloat>
+    __device__ __host__ inline void setMatrixScale(complex<storeFloat> *scale, float max) {
+      if (isHalf<storeFloat>::value) *reinterpret_cast<float*>(scale) = max * static_cast<float>(MAX_SHORT_INV);
+    }
+
+    template<typename Float, int nColor, QudaGaugeFieldOrder order, typename storeFloat=Float> struct Accessor {
       mutable complex<Float> dummy;
       Accessor(const GaugeField &, void *gauge_=0, void **ghost_=0) {
 	errorQuda("Not implemented for order=%d", order);
@@ -155,9 +266,10 @@ namespace quda {
       __device__ __host__ complex<Float>& operator()(int d, int parity, int x, int row, int col) const {
 	return dummy;
       }
+      __device__ __host__ inline void setMax(int d, int parity, int x, Float max) const { }
     };
 
-    template<typename Float, int nColor, QudaGaugeFieldOrder order, bool native_ghost>
+    template<typename Float, int nColor, QudaGaugeFieldOrder order, bool native_ghost, typename storeFloat=Float>
     struct GhostAccessor {
       mutable complex<Float> dummy;
       GhostAccessor(const GaugeField &, void *gauge_=0, void **ghost_=0) {
@@ -166,32 +278,37 @@ namespace quda {
       __device__ __host__ complex<Float>& operator()(int d, int parity, int x, int row, int col) const {
 	return dummy;
       }
+      __device__ __host__ inline void setMax(int d, int parity, int x, Float max) const { }
     };
 
-    template<typename Float, int nColor>
-      struct Accessor<Float,nColor,QUDA_QDP_GAUGE_ORDER> {
-      complex <Float> *u[QUDA_MAX_GEOMETRY];
+    template<typename Float, int nColor, typename storeFloat>
+      struct Accessor<Float,nColor,QUDA_QDP_GAUGE_ORDER,storeFloat> {
+      static constexpr int nBlock = nColor*nColor + (isHalf<storeFloat>::value ? 1 : 0); // complex elements per matrix
+      complex <storeFloat> *u[QUDA_MAX_GEOMETRY];
       const int cb_offset;
     Accessor(const GaugeField &U, void *gauge_=0, void **ghost_=0)
-      : cb_offset((U.Bytes()>>1) / (sizeof(complex<Float>)*U.Geometry())) {
+      : cb_offset((U.Bytes()>>1) / (sizeof(complex<storeFloat>)*U.Geometry())) {
 	for (int d=0; d<U.Geometry(); d++)
-	  u[d] = gauge_ ? static_cast<complex<Float>**>(gauge_)[d] :
-	    static_cast<complex<Float>**>(const_cast<void*>(U.Gauge_p()))[d];
+	  u[d] = gauge_ ? static_cast<complex<storeFloat>**>(gauge_)[d] :
+	    static_cast<complex<storeFloat>**>(const_cast<void*>(U.Gauge_p()))[d];
       }
-    Accessor(const Accessor<Float,nColor,QUDA_QDP_GAUGE_ORDER> &a) : cb_offset(a.cb_offset) {
+    Accessor(const Accessor<Float,nColor,QUDA_QDP_GAUGE_ORDER,storeFloat> &a) : cb_offset(a.cb_offset) {
 	for (int d=0; d<QUDA_MAX_GEOMETRY; d++)
 	  u[d] = a.u[d];
       }
-      __device__ __host__ inline complex<Float>& operator()(int d, int parity, int x, int row, int col) const
-      { return u[d][ parity*cb_offset + (x*nColor + row)*nColor + col]; }
+      __device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int d, int parity, int x, int row, int col) const
+      { return accessor_ref<Float,storeFloat>::get(u[d] + parity*cb_offset + x*nBlock, row*nColor + col, nColor*nColor); }
+
+      __device__ __host__ inline void setMax(int d, int parity, int x, Float max) const
+      { setMatrixScale(u[d] + parity*cb_offset + x*nBlock + nColor*nColor, max); }
 
       __device__ __host__ inline void atomic_add(int dim, int parity, int x_cb, int row, int col, complex<Float> &val) const {
 #ifdef __CUDA_ARCH__
 	typedef typename vector<Float,2>::type vec2;
-	vec2 *u2 = reinterpret_cast<vec2*>(u[dim] + parity*cb_offset + (x_cb*nColor + row)*nColor + col);
+	vec2 *u2 = reinterpret_cast<vec2*>(u[dim] + parity*cb_offset + x_cb*nBlock + row*nColor + col);
 	atomicAdd(u2, (vec2&)val);
 #else
-	u[dim][ parity*cb_offset + (x_cb*nColor + row)*nColor + col] += val;
+	u[dim][ parity*cb_offset + x_cb*nBlock + row*nColor + col] += val;
 #endif
       }
 
@@ -201,53 +318,61 @@ namespace quda {
       }
     };
 
-    template<typename Float, int nColor, bool native_ghost>
-      struct GhostAccessor<Float,nColor,QUDA_QDP_GAUGE_ORDER,native_ghost> {
-      complex<Float> *ghost[8];
+    template<typename Float, int nColor, bool native_ghost, typename storeFloat>
+      struct GhostAccessor<Float,nColor,QUDA_QDP_GAUGE_ORDER,native_ghost,storeFloat> {
+      static constexpr int nBlock = nColor*nColor + (isHalf<storeFloat>::value ? 1 : 0); // complex elements per matrix
+      complex<storeFloat> *ghost[8];
       int ghostOffset[8];
       GhostAccessor(const GaugeField &U, void *gauge_=0, void **ghost_=0) {
 	for (int d=0; d<4; d++) {
-	  ghost[d] = ghost_ ? static_cast<complex<Float>*>(ghost_[d]) :
-	    static_cast<complex<Float>*>(const_cast<void*>(U.Ghost()[d]));
-	  ghostOffset[d] = U.Nface()*U.SurfaceCB(d)*U.Ncolor()*U.Ncolor();
+	  ghost[d] = ghost_ ? static_cast<complex<storeFloat>*>(ghost_[d]) :
+	    static_cast<complex<storeFloat>*>(const_cast<void*>(U.Ghost()[d]));
+	  ghostOffset[d] = U.Nface()*U.SurfaceCB(d)*nBlock;
 
 	  ghost[d+4] = (U.Geometry() != QUDA_COARSE_GEOMETRY) ? nullptr :
-	    ghost_ ? static_cast<complex<Float>*>(ghost_[d+4]) :
-	    static_cast<complex<Float>*>(const_cast<void*>(U.Ghost()[d+4]));
-	  ghostOffset[d+4] = U.Nface()*U.SurfaceCB(d)*U.Ncolor()*U.Ncolor();
+	    ghost_ ? static_cast<complex<storeFloat>*>(ghost_[d+4]) :
+	    static_cast<complex<storeFloat>*>(const_cast<void*>(U.Ghost()[d+4]));
+	  ghostOffset[d+4] = U.Nface()*U.SurfaceCB(d)*nBlock;
 	}
       }
-      GhostAccessor(const GhostAccessor<Float,nColor,QUDA_QDP_GAUGE_ORDER,native_ghost> &a) {
+      GhostAccessor(const GhostAccessor<Float,nColor,QUDA_QDP_GAUGE_ORDER,native_ghost,storeFloat> &a) {
 	for (int d=0; d<8; d++) {
 	  ghost[d] = a.ghost[d];
 	  ghostOffset[d] = a.ghostOffset[d];
 	}
       }
-      __device__ __host__ inline complex<Float>& operator()(int d, int parity, int x, int row, int col) const
-      { return ghost[d][ parity*ghostOffset[d] + (x*nColor + row)*nColor + col]; }
+      __device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int d, int parity, int x, int row, int col) const
+      { return accessor_ref<Float,storeFloat>::get(ghost[d] + parity*ghostOffset[d] + x*nBlock, row*nColor + col, nColor*nColor); }
+
+      __device__ __host__ inline void setMax(int d, int parity, int x, Float max) const
+      { setMatrixScale(ghost[d] + parity*ghostOffset[d] + x*nBlock + nColor*nColor, max); }
     };
 
-    template<typename Float, int nColor>
-      struct Accessor<Float,nColor,QUDA_MILC_GAUGE_ORDER> {
-      complex<Float> *u;
+    template<typename Float, int nColor, typename storeFloat>
+      struct Accessor<Float,nColor,QUDA_MILC_GAUGE_ORDER,storeFloat> {
+      static constexpr int nBlock = nColor*nColor + (isHalf<storeFloat>::value ? 1 : 0); // complex elements per matrix
+      complex<storeFloat> *u;
       const int volumeCB;
       const int geometry;
     Accessor(const GaugeField &U, void *gauge_=0, void **ghost_=0)
-      : u(gauge_ ? static_cast<complex<Float>*>(gauge_) :
-	  static_cast<complex<Float>*>(const_cast<void *>(U.Gauge_p()))),
+      : u(gauge_ ? static_cast<complex<storeFloat>*>(gauge_) :
+	  static_cast<complex<storeFloat>*>(const_cast<void *>(U.Gauge_p()))),
 	volumeCB(U.VolumeCB()), geometry(U.Geometry()) { }
-    Accessor(const Accessor<Float,nColor,QUDA_MILC_GAUGE_ORDER> &a)
+    Accessor(const Accessor<Float,nColor,QUDA_MILC_GAUGE_ORDER,storeFloat> &a)
       : u(a.u), volumeCB(a.volumeCB), geometry(a.geometry) { }
-      __device__ __host__ inline complex<Float>& operator()(int d, int parity, int x, int row, int col) const
-      { return 	u[(((parity*volumeCB+x)*geometry + d)*nColor + row)*nColor + col]; }
+      __device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int d, int parity, int x, int row, int col) const
+      { return accessor_ref<Float,storeFloat>::get(u + ((parity*volumeCB+x)*geometry + d)*nBlock, row*nColor + col, nColor*nColor); }
+
+      __device__ __host__ inline void setMax(int d, int parity, int x, Float max) const
+      { setMatrixScale(u + ((parity*volumeCB+x)*geometry + d)*nBlock + nColor*nColor, max); }
 
       __device__ __host__ inline void atomic_add(int dim, int parity, int x_cb, int row, int col, complex<Float> &val) const {
 #ifdef __CUDA_ARCH__
 	typedef typename vector<Float,2>::type vec2;
-	vec2 *u2 = reinterpret_cast<vec2*>(u + (((parity*volumeCB+x_cb)*geometry + dim)*nColor + row)*nColor + col);
+	vec2 *u2 = reinterpret_cast<vec2*>(u + ((parity*volumeCB+x_cb)*geometry + dim)*nBlock + row*nColor + col);
 	atomicAdd(u2, (vec2&)val);
 #else
-	u[(((parity*volumeCB+x_cb)*geometry + dim)*nColor + row)*nColor + col] += val;
+	u[((parity*volumeCB+x_cb)*geometry + dim)*nBlock + row*nColor + col] += val;
 #endif
       }
 
@@ -257,30 +382,34 @@ namespace quda {
       }
     };
 
-    template<typename Float, int nColor, bool native_ghost>
-      struct GhostAccessor<Float,nColor,QUDA_MILC_GAUGE_ORDER,native_ghost> {
-      complex<Float> *ghost[8];
+    template<typename Float, int nColor, bool native_ghost, typename storeFloat>
+      struct GhostAccessor<Float,nColor,QUDA_MILC_GAUGE_ORDER,native_ghost,storeFloat> {
+      static constexpr int nBlock = nColor*nColor + (isHalf<storeFloat>::value ? 1 : 0); // complex elements per matrix
+      complex<storeFloat> *ghost[8];
       int ghostOffset[8];
       GhostAccessor(const GaugeField &U, void *gauge_=0, void **ghost_=0) {
 	for (int d=0; d<4; d++) {
-	  ghost[d] = ghost_ ? static_cast<complex<Float>*>(ghost_[d]) :
-	    static_cast<complex<Float>*>(const_cast<void*>(U.Ghost()[d]));
-	  ghostOffset[d] = U.Nface()*U.SurfaceCB(d)*U.Ncolor()*U.Ncolor();
+	  ghost[d] = ghost_ ? static_cast<complex<storeFloat>*>(ghost_[d]) :
+	    static_cast<complex<storeFloat>*>(const_cast<void*>(U.Ghost()[d]));
+	  ghostOffset[d] = U.Nface()*U.SurfaceCB(d)*nBlock;
 
 	  ghost[d+4] = (U.Geometry() != QUDA_COARSE_GEOMETRY) ? nullptr :
-	    ghost_ ? static_cast<complex<Float>*>(ghost_[d+4]) :
-	    static_cast<complex<Float>*>(const_cast<void*>(U.Ghost()[d+4]));
-	  ghostOffset[d+4] = U.Nface()*U.SurfaceCB(d)*U.Ncolor()*U.Ncolor();
+	    ghost_ ? static_cast<complex<storeFloat>*>(ghost_[d+4]) :
+	    static_cast<complex<storeFloat>*>(const_cast<void*>(U.Ghost()[d+4]));
+	  ghostOffset[d+4] = U.Nface()*U.SurfaceCB(d)*nBlock;
 	}
       }
-      GhostAccessor(const GhostAccessor<Float,nColor,QUDA_MILC_GAUGE_ORDER,native_ghost> &a) {
+      GhostAccessor(const GhostAccessor<Float,nColor,QUDA_MILC_GAUGE_ORDER,native_ghost,storeFloat> &a) {
 	for (int d=0; d<8; d++) {
 	  ghost[d] = a.ghost[d];
 	  ghostOffset[d] = a.ghostOffset[d];
 	}
       }
-      __device__ __host__ inline complex<Float>& operator()(int d, int parity, int x, int row, int col) const
-      { return ghost[d][ parity*ghostOffset[d] + (x*nColor + row)*nColor + col]; }
+      __device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int d, int parity, int x, int row, int col) const
+      { return accessor_ref<Float,storeFloat>::get(ghost[d] + parity*ghostOffset[d] + x*nBlock, row*nColor + col, nColor*nColor); }
+
+      __device__ __host__ inline void setMax(int d, int parity, int x, Float max) const
+      { setMatrixScale(ghost[d] + parity*ghostOffset[d] + x*nBlock + nColor*nColor, max); }
     };
 
     template<int nColor, int N>
@@ -293,64 +422,70 @@ namespace quda {
       return index;
     };
 
-    template<typename Float, int nColor>
-      struct Accessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER> {
-      complex<Float> *u;
+    template<typename Float, int nColor, typename storeFloat>
+      struct Accessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,storeFloat> {
+      static constexpr int nBlock = nColor*nColor + (isHalf<storeFloat>::value ? 1 : 0); // complex elements per matrix
+      complex<storeFloat> *u;
       const int offset_cb;
       const int stride;
       const int geometry;
     Accessor(const GaugeField &U, void *gauge_=0, void **ghost_=0)
-      : u(gauge_ ? static_cast<complex<Float>*>(gauge_) :
-	  static_cast<complex<Float>*>(const_cast<void*>(U.Gauge_p()))),
-	offset_cb( (U.Bytes()>>1) / sizeof(complex<Float>)), stride(U.Stride()), geometry(U.Geometry())
+      : u(gauge_ ? static_cast<complex<storeFloat>*>(gauge_) :
+	  static_cast<complex<storeFloat>*>(const_cast<void*>(U.Gauge_p()))),
+	offset_cb( (U.Bytes()>>1) / sizeof(complex<storeFloat>)), stride(U.Stride()), geometry(U.Geometry())
 	{  }
-    Accessor(const Accessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER> &a)
+    Accessor(const Accessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,storeFloat> &a)
       : u(a.u), offset_cb(a.offset_cb), stride(a.stride), geometry(a.geometry) {  }
 
-      __device__ __host__ inline complex<Float>& operator()(int dim, int parity, int x_cb, int row, int col) const
-      { return u[parity*offset_cb + dim*stride*nColor*nColor + (row*nColor+col)*stride + x_cb]; }
+      __device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int dim, int parity, int x_cb, int row, int col) const
+      { return accessor_ref<Float,storeFloat>::get(u + parity*offset_cb + dim*stride*nBlock + x_cb, (row*nColor+col)*stride, nColor*nColor*stride); }
+
+      __device__ __host__ inline void setMax(int dim, int parity, int x_cb, Float max) const
+      { setMatrixScale(u + parity*offset_cb + dim*stride*nBlock + nColor*nColor*stride + x_cb, max); }
 
       __device__ __host__ void atomic_add(int dim, int parity, int x_cb, int row, int col, complex<Float> &val) const {
 #ifdef __CUDA_ARCH__
 	typedef typename vector<Float,2>::type vec2;
-	vec2 *u2 = reinterpret_cast<vec2*>(u + parity*offset_cb + dim*stride*nColor*nColor + (row*nColor+col)*stride + x_cb);
+	vec2 *u2 = reinterpret_cast<vec2*>(u + parity*offset_cb + dim*stride*nBlock + (row*nColor+col)*stride + x_cb);
 	atomicAdd(u2, (vec2&)val);
 #else
-	u[parity*offset_cb + dim*stride*nColor*nColor + (row*nColor+col)*stride + x_cb] += val;
+	u[parity*offset_cb + dim*stride*nBlock + (row*nColor+col)*stride + x_cb] += val;
 #endif
       }
 
       __host__ double device_norm2(int dim) const {
 	if (dim >= geometry) errorQuda("Request dimension %d exceeds dimensionality of the field %d", dim, geometry);
-	thrust::device_ptr<complex<Float> > ptr(u);
-	double even = thrust::transform_reduce(ptr+0*offset_cb+(dim+0)*stride*nColor*nColor,
-					       ptr+0*offset_cb+(dim+1)*stride*nColor*nColor,
-					       square<double,Float>(), 0.0, thrust::plus<double>());
-	double odd  = thrust::transform_reduce(ptr+1*offset_cb+(dim+0)*stride*nColor*nColor,
-					       ptr+1*offset_cb+(dim+1)*stride*nColor*nColor,
-					       square<double,Float>(), 0.0, thrust::plus<double>());
+	if (isHalf<storeFloat>::value) errorQuda("Not implemented for fixed-point fields");
+	thrust::device_ptr<complex<storeFloat> > ptr(u);
+	double even = thrust::transform_reduce(ptr+0*offset_cb+(dim+0)*stride*nBlock,
+					       ptr+0*offset_cb+(dim+1)*stride*nBlock,
+					       square<double,storeFloat>(), 0.0, thrust::plus<double>());
+	double odd  = thrust::transform_reduce(ptr+1*offset_cb+(dim+0)*stride*nBlock,
+					       ptr+1*offset_cb+(dim+1)*stride*nBlock,
+					       square<double,storeFloat>(), 0.0, thrust::plus<double>());
 	return even + odd;
       }
     };
 
-    template<typename Float, int nColor, bool native_ghost>
-      struct GhostAccessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,native_ghost> {
-      complex<Float> *ghost[8];
+    template<typename Float, int nColor, bool native_ghost, typename storeFloat>
+      struct GhostAccessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,native_ghost,storeFloat> {
+      static constexpr int nBlock = nColor*nColor + (isHalf<storeFloat>::value ? 1 : 0); // complex elements per matrix
+      complex<storeFloat> *ghost[8];
       const int volumeCB;
       int ghostVolumeCB[8];
-      Accessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER> accessor;
+      Accessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,storeFloat> accessor;
     GhostAccessor(const GaugeField &U, void *gauge_, void **ghost_=0)
       : volumeCB(U.VolumeCB()), accessor(U, gauge_, ghost_)
       {
 	if (!native_ghost) assert(ghost_ != nullptr);
 	for (int d=0; d<4; d++) {
-	  ghost[d] = !native_ghost ? static_cast<complex<Float>*>(ghost_[d]) : nullptr;
+	  ghost[d] = !native_ghost ? static_cast<complex<storeFloat>*>(ghost_[d]) : nullptr;
 	  ghostVolumeCB[d] = U.Nface()*U.SurfaceCB(d);
-	  ghost[d+4] = !native_ghost && U.Geometry() == QUDA_COARSE_GEOMETRY? static_cast<complex<Float>*>(ghost_[d+4]) : nullptr;
+	  ghost[d+4] = !native_ghost && U.Geometry() == QUDA_COARSE_GEOMETRY? static_cast<complex<storeFloat>*>(ghost_[d+4]) : nullptr;
 	  ghostVolumeCB[d+4] = U.Nface()*U.SurfaceCB(d);
 	}
       }
-    GhostAccessor(const GhostAccessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,native_ghost> &a)
+    GhostAccessor(const GhostAccessor<Float,nColor,QUDA_FLOAT2_GAUGE_ORDER,native_ghost,storeFloat> &a)
       : volumeCB(a.volumeCB), accessor(a.accessor)
       {
 	for (int d=0; d<8; d++) {
@@ -358,12 +493,21 @@ namespace quda {
 	  ghostVolumeCB[d] = a.ghostVolumeCB[d];
 	}
       }
-      __device__ __host__ inline complex<Float>& operator()(int d, int parity, int x_cb, int row, int col) const
+      __device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int d, int parity, int x_cb, int row, int col) const
       {
 	if (native_ghost)
 	  return accessor(d%4, parity, x_cb+(d/4)*ghostVolumeCB[d]+volumeCB, row, col);
 	else
-	  return ghost[d][ ((parity*nColor + row)*nColor+col)*ghostVolumeCB[d] + x_cb ];
+	  return accessor_ref<Float,storeFloat>::get(ghost[d] + parity*nBlock*ghostVolumeCB[d] + x_cb,
+						     (row*nColor+col)*ghostVolumeCB[d], nColor*nColor*ghostVolumeCB[d]);
+      }
+
+      __device__ __host__ inline void setMax(int d, int parity, int x_cb, Float max) const
+      {
+	if (native_ghost)
+	  accessor.setMax(d%4, parity, x_cb+(d/4)*ghostVolumeCB[d]+volumeCB, max);
+	else
+	  setMatrixScale(ghost[d] + parity*nBlock*ghostVolumeCB[d] + nColor*nColor*ghostVolumeCB[d] + x_cb, max);
       }
     };
 
@@ -371,9 +515,16 @@ namespace quda {
     /**
        This is a template driven generic gauge field accessor.  To
        deploy for a specifc field ordering, the two operator()
-       accessors have to be specialized for that ordering.
+       accessors have to be specialized for that ordering.  Float is
+       the precision in which elements are returned, and storeFloat
+       the precision in which they are stored; when storeFloat is
+       short the field is stored in fixed point with a scale factor
+       per link matrix, and the accessors return fieldorder_wrapper
+       instances that decode and encode on the fly.  Writers must set
+       the scale of each matrix with setMax (or setGhostMax) before
+       storing its elements.
      */
-  template <typename Float, int nColor, int nSpinCoarse, QudaGaugeFieldOrder order, bool native_ghost=true>
+  template <typename Float, int nColor, int nSpinCoarse, QudaGaugeFieldOrder order, bool native_ghost=true, typename storeFloat=Float>
       struct FieldOrder {
 
       protected:
@@ -384,10 +535,13 @@ namespace quda {
 	static constexpr int nColorCoarse = nColor / nSpinCoarse;
 	QudaFieldLocation location;
 
-	const Accessor<Float,nColor,order> accessor;
-	const GhostAccessor<Float,nColor,order,native_ghost> ghostAccessor;
+	const Accessor<Float,nColor,order,storeFloat> accessor;
+	const GhostAccessor<Float,nColor,order,native_ghost,storeFloat> ghostAccessor;
 
       public:
+	/** Whether the field is stored in fixed point with a scale per link matrix */
+	static constexpr bool fixedPoint = isHalf<storeFloat>::value;
+
 	/**
 	 * Constructor for the FieldOrder class
 	 * @param field The field that we are accessing
@@ -416,7 +570,7 @@ namespace quda {
 	 * @param row row index
 	 * @param c column index
 	 */
-	__device__ __host__ const complex<Float>& operator()(int d, int parity, int x, int row, int col) const
+	__device__ __host__ typename accessor_ref<Float,storeFloat>::const_type operator()(int d, int parity, int x, int row, int col) const
 	{ return accessor(d,parity,x,row,col); }
 
 	/**
@@ -427,7 +581,7 @@ namespace quda {
 	 * @param row row index
 	 * @param c column index
 	 */
-	__device__ __host__ complex<Float>& operator() (int d, int parity, int x, int row, int col)
+	__device__ __host__ typename accessor_ref<Float,storeFloat>::type operator() (int d, int parity, int x, int row, int col)
 	{ return accessor(d,parity,x,row,col); }
 
 	/**
@@ -438,7 +592,7 @@ namespace quda {
 	 * @param row row index
 	 * @param c column index
 	 */
-	__device__ __host__ const complex<Float>& Ghost(int d, int parity, int x, int row, int col) const
+	__device__ __host__ typename accessor_ref<Float,storeFloat>::const_type Ghost(int d, int parity, int x, int row, int col) const
 	{ return ghostAccessor(d,parity,x,row,col); }
 
 	/**
@@ -449,7 +603,7 @@ namespace quda {
 	 * @param row row index
 	 * @param c column index
 	 */
-	__device__ __host__ complex<Float>& Ghost(int d, int parity, int x, int row, int col)
+	__device__ __host__ typename accessor_ref<Float,storeFloat>::type Ghost(int d, int parity, int x, int row, int col)
 	{ return ghostAccessor(d,parity,x,row,col); }
 
     	/**
@@ -462,7 +616,7 @@ namespace quda {
 	 * @param s_col col spin index
 	 * @param c_col col color index
 	 */
-	__device__ __host__ inline const complex<Float>& operator()(int d, int parity, int x, int s_row,
+	__device__ __host__ inline typename accessor_ref<Float,storeFloat>::const_type operator()(int d, int parity, int x, int s_row,
 							     int s_col, int c_row, int c_col) const {
 	  return (*this)(d, parity, x, s_row*nColorCoarse + c_row, s_col*nColorCoarse + c_col);
 	}
@@ -477,7 +631,7 @@ namespace quda {
 	 * @param s_col col spin index
 	 * @param c_col col color index
 	 */
-	__device__ __host__ inline complex<Float>& operator()(int d, int parity, int x, int s_row,
+	__device__ __host__ inline typename accessor_ref<Float,storeFloat>::type operator()(int d, int parity, int x, int s_row,
 							     int s_col, int c_row, int c_col) {
 	  return (*this)(d, parity, x, s_row*nColorCoarse + c_row, s_col*nColorCoarse + c_col);
 	}
@@ -492,7 +646,7 @@ namespace quda {
 	 * @param s_col col spin index
 	 * @param c_col col color index
 	 */
-	__device__ __host__ inline const complex<Float>& Ghost(int d, int parity, int x, int s_row,
+	__device__ __host__ inline typename accessor_ref<Float,storeFloat>::const_type Ghost(int d, int parity, int x, int s_row,
 							     int s_col, int c_row, int c_col) const {
 	  return Ghost(d, parity, x, s_row*nColorCoarse + c_row, s_col*nColorCoarse + c_col);
 	}
@@ -507,11 +661,68 @@ namespace quda {
 	 * @param s_col col spin index
 	 * @param c_col col color index
 	 */
-	__device__ __host__ inline complex<Float>& Ghost(int d, int parity, int x, int s_row,
+	__device__ __host__ inline typename accessor_ref<Float,storeFloat>::type Ghost(int d, int parity, int x, int s_row,
 							     int s_col, int c_row, int c_col) {
 	  return Ghost(d, parity, x, s_row*nColorCoarse + c_row, s_col*nColorCoarse + c_col);
 	}
 
+	/**
+	 * Set the scale of a link matrix from its maximum absolute
+	 * element.  This must precede storing the elements of the
+	 * matrix when the field is stored in fixed point, and is a
+	 * no-op otherwise.
+	 * @param d dimension index
+	 * @param parity Parity index
+	 * @param x 1-d site index
+	 * @param max Maximum absolute real or imaginary part of the matrix elements
+	 */
+	__device__ __host__ inline void setMax(int d, int parity, int x, Float max) const
+	{ accessor.setMax(d, parity, x, max); }
+
+	/**
+	 * Set the scale of a ghost-zone link matrix (see setMax)
+	 * @param d dimension index
+	 * @param parity Parity index
+	 * @param x 1-d ghost-zone site index
+	 * @param max Maximum absolute real or imaginary part of the matrix elements
+	 */
+	__device__ __host__ inline void setGhostMax(int d, int parity, int x, Float max) const
+	{ ghostAccessor.setMax(d, parity, x, max); }
+
+	/**
+	 * Return the maximum absolute real or imaginary part of the
+	 * elements of a link matrix
+	 * @param d dimension index
+	 * @param parity Parity index
+	 * @param x 1-d site index
+	 */
+	__device__ __host__ inline Float abs_max(int d, int parity, int x) const {
+	  Float max = static_cast<Float>(0.0);
+	  for (int row=0; row<nColor; row++)
+	    for (int col=0; col<nColor; col++) {
+	      const complex<Float> v = (*this)(d, parity, x, row, col);
+	      max = fmax(max, fmax(fabs(v.real()), fabs(v.imag())));
+	    }
+	  return max;
+	}
+
+	/**
+	 * Return the maximum absolute real or imaginary part of the
+	 * elements of a ghost-zone link matrix
+	 * @param d dimension index
+	 * @param parity Parity index
+	 * @param x 1-d ghost-zone site index
+	 */
+	__device__ __host__ inline Float ghost_abs_max(int d, int parity, int x) const {
+	  Float max = static_cast<Float>(0.0);
+	  for (int row=0; row<nColor; row++)
+	    for (int col=0; col<nColor; col++) {
+	      const complex<Float> v = Ghost(d, parity, x, row, col);
+	      max = fmax(max, fmax(fabs(v.real()), fabs(v.imag())));
+	    }
+	  return max;
+	}
+
 	__device__ __host__ inline void atomicAdd(int d, int parity, int x, int s_row, int s_col,
 						  int c_row, int c_col, complex<Float> &val) {
 	  accessor.atomic_add(d, parity, x, s_row*nColorCoarse + c_row, s_col*nColorCoarse + c_col, val);
@@ -554,7 +765,7 @@ namespace quda {
 	      for (int x_cb=0; x_cb<volumeCB; x_cb++) {
 		for (int row=0; row<nColor; row++)
 		  for (int col=0; col<nColor; col++)
-		    nrm2 += norm((*this)(dim,parity,x_cb,row,col));
+		    nrm2 += norm(complex<Float>((*this)(dim,parity,x_cb,row,col)));
 	      }
 	  }
 	  comm_allreduce(&nrm2);
@@ -562,7 +773,7 @@ namespace quda {
 	}
 
 	/** Return the size of the allocation (geometry and parity left out and added as needed in Tunable::bytes) */
-	size_t Bytes() const { return static_cast<size_t>(volumeCB) * nColor * nColor * 2ll * sizeof(Float); }
+	size_t Bytes() const { return static_cast<size_t>(volumeCB) * (nColor * nColor + (fixedPoint ? 1 : 0)) * 2ll * sizeof(storeFloat); }
       };
 
 
@@ -1291,6 +1502,37 @@ namespace quda {
 #endif
       }
 
+      /**
+	 @brief This accessor routine returns a gauge_ghost_wrapper to this object,
+	 allowing us to overload various operators for manipulating at
+	 the site level interms of matrix operations.
+	 @param[in] dir Which dimension are we requesting
+	 @param[in] ghost_idx Ghost index we are requesting
+	 @param[in] parity Parity we are requesting
+	 @return Instance of a gauge_ghost_wrapper that curries in access to
+	 this field at the above coordinates.
+       */
+      __device__ __host__ inline gauge_ghost_wrapper<RegType,LegacyOrder<Float,length> >
+	   Ghost(int dim, int ghost_idx, int parity) {
+	return gauge_ghost_wrapper<RegType,LegacyOrder<Float,length> >(*this, dim, ghost_idx, parity);
+      }
+
+      /**
+	 @brief This accessor routine returns a const gauge_ghost_wrapper to this object,
+	 allowing us to overload various operators for manipulating at
+	 the site level interms of matrix operations.
+	 @param[in] dir Which dimension are we requesting
+	 @param[in] ghost_idx Ghost index we are requesting
+	 @param[in] parity Parity we are requesting
+	 @return Instance of a gauge_ghost_wrapper that curries in access to
+	 this field at the above coordinates.
+       */
+      __device__ __host__ inline const gauge_ghost_wrapper<RegType,LegacyOrder<Float,length> >
+	   Ghost(int dim, int ghost_idx, int parity) const {
+	return gauge_ghost_wrapper<RegType,LegacyOrder<Float,length> >
+	(const_cast<LegacyOrder<Float,length>&>(*this), dim, ghost_idx, parity);
+      }
+
       __device__ __host__ inline void loadGhostEx(RegType v[length], int x, int dummy, int dir,
 						  int dim, int g, int parity, const int R[]) const {
 #if defined( __CUDA_ARCH__) && !defined(DISABLE_TROVE)
@@ -1366,6 +1608,37 @@ namespace quda {
 #endif
       }
 
+      /**
+	 @brief This accessor routine returns a gauge_wrapper to this object,
+	 allowing us to overload various operators for manipulating at
+	 the site level interms of matrix operations.
+	 @param[in] dir Which dimension are we requesting
+	 @param[in] x_cb Checkerboarded space-time index we are requesting
+	 @param[in] parity Parity we are requesting
+	 @return Instance of a gauge_wrapper that curries in access to
+	 this field at the above coordinates.
+       */
+      __device__ __host__ inline gauge_wrapper<RegType,QDPOrder<Float,length> >
+	   operator()(int dim, int x_cb, int parity) {
+	return gauge_wrapper<RegType,QDPOrder<Float,length> >(*this, dim, x_cb, parity);
+      }
+
+      /**
+	 @brief This accessor routine returns a const gauge_wrapper to this object,
+	 allowing us to overload various operators for manipulating at
+	 the site level interms of matrix operations.
+	 @param[in] dir Which dimension are we requesting
+	 @param[in] x_cb Checkerboarded space-time index we are requesting
+	 @param[in] parity Parity we are requesting
+	 @return Instance of a gauge_wrapper that curries in access to
+	 this field at the above coordinates.
+       */
+      __device__ __host__ inline const gauge_wrapper<RegType,QDPOrder<Float,length> >
+	   operator()(int dim, int x_cb, int parity) const {
+	return gauge_wrapper<RegType,QDPOrder<Float,length> >
+	(const_cast<QDPOrder<Float,length>&>(*this), dim, x_cb, parity);
+      }
+
       size_t Bytes() const { return length * sizeof(Float); }
     };
 
@@ -1448,9 +1721,84 @@ namespace quda {
 #endif
     }
 
+    /**
+	 @brief This accessor routine returns a gauge_wrapper to this object,
+	 allowing us to overload various operators for manipulating at
+	 the site level interms of matrix operations.
+	 @param[in] dir Which dimension are we requesting
+	 @param[in] x_cb Checkerboarded space-time index we are requesting
+	 @param[in] parity Parity we are requesting
+	 @return Instance of a gauge_wrapper that curries in access to
+	 this field at the above coordinates.
+     */
+    __device__ __host__ inline gauge_wrapper<RegType,MILCOrder<Float,length> >
+	   operator()(int dim, int x_cb, int parity) {
+	return gauge_wrapper<RegType,MILCOrder<Float,length> >(*this, dim, x_cb, parity);
+    }
+
+    /**
+	 @brief This accessor routine returns a const gauge_wrapper to this object,
+	 allowing us to overload various operators for manipulating at
+	 the site level interms of matrix operations.
+	 @param[in] dir Which dimension are we requesting
+	 @param[in] x_cb Checkerboarded space-time index we are requesting
+	 @param[in] parity Parity we are requesting
+	 @return Instance of a gauge_wrapper that curries in access to
+	 this field at the above coordinates.
+     */
+    __device__ __host__ inline const gauge_wrapper<RegType,MILCOrder<Float,length> >
+	   operator()(int dim, int x_cb, int parity) const {
+	return gauge_wrapper<RegType,MILCOrder<Float,length> >
+	(const_cast<MILCOrder<Float,length>&>(*this), dim, x_cb, parity);
+    }
+
     size_t Bytes() const { return length * sizeof(Float); }
   };
 
+  /**
+     @brief Accessor for MILC-ordered anti-Hermitian momentum fields.
+     These are stored compressed as 10 reals per link (the three
+     upper off-diagonal elements, the imaginary diagonal and a pad),
+     while load and save expose the full 18-real matrix so that host
+     kernels can use the same code path as the FloatN-ordered device
+     momentum (FloatNOrder<Float,18,2,11>).
+  */
+  template <typename Float> struct MILCMomOrder : public MILCOrder<Float,10> {
+    typedef typename mapper<Float>::type RegType;
+    Reconstruct<11,Float> reconstruct;
+  MILCMomOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) :
+    MILCOrder<Float,10>(u, gauge_, ghost_), reconstruct(u) { ; }
+  MILCMomOrder(const MILCMomOrder &order) : MILCOrder<Float,10>(order), reconstruct(order.reconstruct) { ; }
+    virtual ~MILCMomOrder() { ; }
+
+    __device__ __host__ inline void load(RegType v[18], int x, int dir, int parity) const {
+      RegType tmp[10];
+      MILCOrder<Float,10>::load(tmp, x, dir, parity);
+      reconstruct.Unpack(v, tmp, x, dir, 0.0, (const int*)0, (const int*)0);
+    }
+
+    __device__ __host__ inline void save(const RegType v[18], int x, int dir, int parity) {
+      RegType tmp[10];
+      reconstruct.Pack(tmp, v, x);
+      MILCOrder<Float,10>::save(tmp, x, dir, parity);
+    }
+
+    __device__ __host__ inline gauge_wrapper<RegType,MILCMomOrder<Float> >
+	   operator()(int dim, int x_cb, int parity) {
+	return gauge_wrapper<RegType,MILCMomOrder<Float> >(*this, dim, x_cb, parity);
+    }
+
+    __device__ __host__ inline const gauge_wrapper<RegType,MILCMomOrder<Float> >
+	   operator()(int dim, int x_cb, int parity) const {
+	return gauge_wrapper<RegType,MILCMomOrder<Float> >
+	(const_cast<MILCMomOrder<Float>&>(*this), dim, x_cb, parity);
+    }
+
+    /** host fields are never autotuned so no backup is required */
+    void save() { }
+    void load() { }
+  };
+
 
   /**
      struct to define CPS ordered gauge fields:
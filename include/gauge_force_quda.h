@@ -4,7 +4,11 @@
 namespace quda {
 
   /**
-     @brief Compute the gauge-force contribution to the momentum
+     @brief Compute the gauge-force contribution to the momentum.
+     The force is accumulated directly into mom (mom -= coeff * force)
+     without being stored separately.  Host fields (MILC-ordered
+     momentum, MILC- or QDP-ordered gauge field) are evaluated with
+     OpenMP threads.
      @param[out] mom Momentum field
      @param[in] u Gauge field (extended when running no multiple GPUs)
      @param[in] coeff Step-size coefficient
@@ -13,9 +17,45 @@ namespace quda {
      @param[in] path_coeff Coefficient of each path
      @param[in] num_paths Numer of paths
      @param[in] max_length Maximum length of each path
+     @param[in] tree Whether to evaluate the paths from the tree of
+     shared sub-paths (when no path is too long for it) or each path
+     independently
    */
   void gaugeForce(GaugeField& mom, const GaugeField& u, double coeff, int ***input_path,
-		  int *length, double *path_coeff, int num_paths, int max_length);
+		  int *length, double *path_coeff, int num_paths, int max_length, bool tree=true);
+
+  /**
+     @brief Compute the gauge action of the loops of a gauge force,
+     S = -coeff sum_{x,mu,i} path_coeff_i / (length_i + 1) Re Tr[U_mu(x) P_i(x)],
+     up to a constant.  The paths of direction mu close the loops
+     through U_mu(x) as for gaugeForce, and must contain every loop
+     through every link of the action, so that a loop of n links
+     appears n times and is counted once.  With these conventions
+     gaugeForce with the same coeff is the force of this action.
+     @param[in] u Gauge field (extended)
+     @param[in] coeff Prefactor of the loops (e.g., beta/3)
+     @param[in] input_path Host-array holding all path contributions for the gauge action
+     @param[in] length Host array holding the length of all paths
+     @param[in] path_coeff Coefficient of each path
+     @param[in] num_paths Numer of paths
+     @param[in] max_length Maximum length of each path
+     @return The gauge action
+   */
+  double gaugeLoopAction(const GaugeField& u, double coeff, int ***input_path, int *length, double *path_coeff,
+			 int num_paths, int max_length);
+
+  /**
+     @brief Flops per lattice site of the gauge-force computation,
+     counting the SU(3) matrix multiplications of all four directions
+     @param[in] input_path Host-array holding all path contributions for the gauge action
+     @param[in] length Host array holding the length of all paths
+     @param[in] path_coeff Coefficient of each path
+     @param[in] num_paths Numer of paths
+     @param[in] tree Whether to count for the path tree, which
+     evaluates products of sub-paths shared between paths only once,
+     or for evaluating each path independently
+   */
+  long long gaugeForceFlops(int ***input_path, const int *length, const double *path_coeff, int num_paths, bool tree=true);
 } // namespace quda
 
 
@@ -4,7 +4,9 @@ namespace quda {
      Compute the plaquette of the gauge field
 
      @param U The gauge field upon which to compute the plaquette
-     @param location The locaiton where to do the computation 
+     @param location The locaiton where to do the computation.  Host
+     computation requires a QDP or MILC ordered field, extended in any
+     partitioned dimension, and uses a reproducible threaded reduction.
      @return double3 variable returning (plaquette, spatial plaquette,
      temporal plaquette) site averages normalized such that each
      plaquette is in the range [0,1]
@@ -14,9 +16,10 @@ namespace quda {
 
 
 
-  /** Generate Gaussian distributed GaugeField
+  /** Generate Gaussian distributed GaugeField.  Host fields must be
+   * QDP or MILC ordered and receive the same links as device fields.
    * @param dataDs The GaugeField
-   * @param rngstate random states
+   * @param rngstate counter-based random number generator, advanced by one call
    */
 
   void gaugeGauss(GaugeField &dataDs, RNG &rngstate);
@@ -55,6 +58,38 @@ namespace quda {
 			const GaugeField& dataOr,
 			double rho, double epsilon);
 
+  /**
+     Parameters and results of a gradient flow integration
+   */
+  struct GaugeFlowParam {
+    QudaGaugeFlowType type; // Wilson, Symanzik or Zeuthen flow kernel
+    double epsilon; // initial step size, kept fixed when tol is zero
+    double tol; // tolerance on the per-link integration error, zero disables step size adaptation
+    int n_meas; // number of measurement flow times
+    const double *t_meas; // ascending flow times at which to measure, the flow stops at the last
+    double *E; // clover action density E(t) at each measurement time
+    double *t2E; // t^2 E(t) at each measurement time
+    double *Q; // clover topological charge Q(t) at each measurement time
+    int steps; // number of accepted steps taken
+    int rejected; // number of steps rejected by the step size control
+  };
+
+  /**
+     Integrate the gradient flow of the gauge field in place with the
+     Luscher third-order Runge-Kutta scheme.  When param.tol is
+     non-zero the step size is adapted by comparing with an embedded
+     second-order solution.  Steps are shortened to land on each
+     requested flow time, where E(t), t^2 E(t) and Q(t) are computed
+     from the clover field strength in a single fused pass.
+     @param U The gauge field to flow, with no reconstruction.  It must
+     be extended by at least one site (two for the Symanzik and Zeuthen
+     kernels) in every partitioned dimension.  Host fields may be QDP
+     or MILC ordered and use threaded kernels with reproducible
+     reductions.
+     @param param Flow parameters, updated with the measured observables
+   */
+  void gradientFlow(GaugeField &U, GaugeFlowParam &param);
+
 
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
@@ -99,11 +134,41 @@ namespace quda {
 		       const int autotune,
                        const double tolerance,
 		       const int stopWtheta);
+
+  /**
+   * @brief Host gauge fixing with overrelaxation, with threaded
+   * checkerboard sweeps.  Requires a single-node, unextended QDP or
+   * MILC ordered field.  Parameters as for the device version.
+   */
+  void gaugefixingOVR( cpuGaugeField& data, const int gauge_dir, const int Nsteps, const int verbose_interval,
+		       const double relax_boost, const double tolerance, const int reunit_interval, const int stopWtheta);
+
+  /**
+   * @brief Host gauge fixing with Fourier accelerated steepest
+   * descent, using batched 2D+2D host transforms.  Requires a
+   * single-node, unextended QDP or MILC ordered field.  Parameters as
+   * for the device version.
+   */
+  void gaugefixingFFT( cpuGaugeField& data, const int gauge_dir, const int Nsteps, const int verbose_interval,
+		       const double alpha, const int autotune, const double tolerance, const int stopWtheta);
+
+  /**
+   * @brief Gauge fixing quality of a host gauge field, as measured
+   * by the host and device gauge fixing.  Requires a single-node,
+   * unextended QDP or MILC ordered field.
+   * @param[in] data, host gauge field
+   * @param[in] gauge_dir, 3 for Coulomb gauge fixing, other for Landau gauge fixing
+   * @return (functional, theta), the functional is maximized and theta vanishes in the fixed gauge
+   */
+  double2 gaugeFixQuality( const cpuGaugeField& data, const int gauge_dir);
+
   /**
      Compute the Fmunu tensor
      @param Fmunu The Fmunu tensor
      @param gauge The gauge field upon which to compute the Fmnu tensor
-     @param location The location of where to do the computation
+     @param location The location of where to do the computation.  Host
+     computation requires a QDP or MILC ordered gauge field, extended
+     in any partitioned dimension, and a MILC-ordered Fmunu field.
    */
   void computeFmunu(GaugeField &Fmunu, 
 		    const GaugeField& gauge, 
@@ -112,7 +177,8 @@ namespace quda {
   /**
      Compute the topological charge
      @param Fmunu The Fmunu tensor, usually calculated from a smeared configuration
-     @param location The location of where to do the computation, currently supports only the GPU
+     @param location The location of where to do the computation.
+     Host computation requires a MILC-ordered Fmunu field.
    */
 
   double computeQCharge(GaugeField& Fmunu, QudaFieldLocation location);
@@ -141,6 +141,9 @@ namespace quda {
     /** Solver tolerance for each shift when refinement is applied using the heavy-quark residual */
     double tol_hq_offset[QUDA_MAX_MULTI_SHIFT];
 
+    /** Precision of the search direction of each shift in the multi-shift solver */
+    QudaPrecision precision_offset[QUDA_MAX_MULTI_SHIFT];
+
     /** Actual L2 residual norm achieved in solver for each offset */
     double true_res_offset[QUDA_MAX_MULTI_SHIFT];
 
@@ -242,6 +245,7 @@ namespace quda {
 	offset[i] = param.offset[i];
 	tol_offset[i] = param.tol_offset[i];
 	tol_hq_offset[i] = param.tol_hq_offset[i];
+	precision_offset[i] = param.cuda_prec_offset[i];
       }
 
       if(param.rhs_idx != 0 && (param.inv_type==QUDA_INC_EIGCG_INVERTER || param.inv_type==QUDA_GMRESDR_PROJ_INVERTER)){
@@ -276,6 +280,7 @@ namespace quda {
 	offset[i] = param.offset[i];
 	tol_offset[i] = param.tol_offset[i];
 	tol_hq_offset[i] = param.tol_hq_offset[i];
+	precision_offset[i] = param.precision_offset[i];
       }
 
       if((param.inv_type == QUDA_INC_EIGCG_INVERTER || param.inv_type == QUDA_EIGCG_INVERTER) && m % 16){//current hack for the magma library
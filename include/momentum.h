@@ -4,7 +4,9 @@
 namespace quda {
 
   /**
-     @brief Compute and return global the momentum action 1/2 mom^2
+     @brief Compute and return global the momentum action 1/2 mom^2.
+     Host fields must be MILC ordered and are reduced with threads
+     in a bit-wise reproducible order.
      @param mom Momentum field
      @return Momentum action contribution
    */
@@ -15,7 +17,8 @@ namespace quda {
 
      mom = mom - coeff * [force]_TA
 
-     where [A]_TA means the traceless anti-hermitian projection of A
+     where [A]_TA means the traceless anti-hermitian projection of A.
+     On the host both fields must be MILC ordered.
 
      @param mom Momentum field
      @param force Force field
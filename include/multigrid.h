@@ -235,6 +235,9 @@ namespace quda {
     /** Coarse temporary vector */
     ColorSpinorField *tmp_coarse;
 
+    /** Coarse correction vector for the second coarse-grid visit of a W-cycle */
+    ColorSpinorField *y_coarse;
+
     /** The coarse operator used for computing inter-grid residuals */
     Dirac *diracCoarseResidual;
 
@@ -277,6 +280,39 @@ namespace quda {
     */
     void destroySmoother();
 
+    /**
+       @brief Create the coarse-grid Dirac operators (residual,
+       smoother and sloppy smoother) from the fine-grid operators
+       and the transfer operator on this level.
+    */
+    void createCoarseDirac();
+
+    /**
+       @brief Free the coarse-grid Dirac operators
+    */
+    void destroyCoarseDirac();
+
+    /**
+       @brief Create the coarse-grid solver according to the cycle type
+    */
+    void createCoarseSolver();
+
+    /**
+       @brief Free the coarse-grid solver
+    */
+    void destroyCoarseSolver();
+
+    /**
+       @brief Rebuild the coarse-grid operators on this and all
+       coarser levels following a change in the fine-grid operator
+       (e.g., a new gauge field).  The fine-grid operators in param
+       must already point at the new operator.
+       @param refresh Whether to refine the existing null-space
+       vectors against the new operator (using
+       setup_maxiter_refresh iterations) before recoarsening
+    */
+    void updateCoarseOperator(bool refresh=false);
+
     /**
        This method is a placeholder for reseting the solver, e.g.,
        when a parameter has changed such as the mass.  For now, all it
@@ -316,8 +352,10 @@ namespace quda {
     /**
        @brief Generate the null-space vectors
        @param B Generated null-space vectors
+       @param refresh Whether we refine the existing vectors (used as
+       the initial guess) rather than starting from random vectors
      */
-    void generateNullVectors(std::vector<ColorSpinorField*> B);
+    void generateNullVectors(std::vector<ColorSpinorField*> B, bool refresh=false);
 
     /**
        @brief Return the total flops done on this and all coarser levels.
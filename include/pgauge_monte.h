@@ -14,35 +14,63 @@ namespace quda {
   /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate counter-based random number generator
    * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
    * @param[in] nhb number of heatbath steps
    * @param[in] nover number of overrelaxation steps
    */
   void Monte( cudaGaugeField& data, RNG &rngstate, double Beta, int nhb, int nover);
 
+  /** @brief Perform heatbath and overrelaxation on a host gauge field with threaded sweeps. Performs nhb heatbath steps followed by nover overrelaxation steps.
+   *
+   * Each site draws from the same counter-based random stream as in the device update, keyed by the seed, its global site index and
+   * the call counter, so the generated ensemble does not depend on the number of threads or on the lattice decomposition, and
+   * checkpointing only requires storing the seed and the counter.
+   *
+   * @param[in,out] data Gauge field, QDP or MILC ordered, extended by two sites in every partitioned dimension
+   * @param[in,out] rngstate counter-based random number generator, advanced by 8 nhb calls
+   * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
+   * @param[in] nhb number of heatbath steps
+   * @param[in] nover number of overrelaxation steps
+   */
+  void Monte( cpuGaugeField& data, RNG &rngstate, double Beta, int nhb, int nover);
+
   /** @brief Perform a cold start to the gauge field, identity SU(3) matrix, also fills the ghost links in multi-GPU case (no need to exchange data)
    *
    * @param[in,out] data Gauge field
    */
   void InitGaugeField( cudaGaugeField& data);
 
+  /** @brief Perform a cold start to the host gauge field, identity SU(3) matrix, including the border of an extended field
+   *
+   * @param[in,out] data Gauge field, QDP or MILC ordered
+   */
+  void InitGaugeField( cpuGaugeField& data);
+
   /** @brief Perform a hot start to the gauge field, random SU(3) matrix, followed by reunitarization, also exchange borders links in multi-GPU case.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate counter-based random number generator
    */
   void InitGaugeField( cudaGaugeField& data, RNG &rngstate);
 
   /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
    *
    * @param[in,out] data Gauge field
-   * @param[in,out] rngstate state of the CURAND random number generator
+   * @param[in,out] rngstate counter-based random number generator
    * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
    * @param[in] nhb number of heatbath steps
    * @param[in] nover number of overrelaxation steps
    */
   void PGaugeExchange( cudaGaugeField& data, const int dir, const int parity);
+
+  /** @brief Host version of PGaugeExchange, exchanging the links in direction dir of the given parity on the interior border
+   *
+   * @param[in,out] data Gauge field, QDP or MILC ordered
+   * @param[in] dir link direction
+   * @param[in] parity parity of the updated sites
+   */
+  void PGaugeExchange( cpuGaugeField& data, const int dir, const int parity);
   /*Exchange "borders" between nodes
   int R[4] = {0,0,0,0};
   for(int dir=0; dir<4; ++dir) if(comm_dim_partitioned(dir)) R[dir] = 2;
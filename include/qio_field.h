@@ -8,6 +8,45 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
 		       int nColor, int nSpin, int Nvec, int argc, char *argv[]);
 void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 			int nColor, int nSpin, int Nvec, int argc, char *argv[]);
+
+/**
+   @brief Queue spinor fields for writing by a background thread.
+   The fields are copied, converted to file_prec, before returning,
+   so V may be overwritten straight away, e.g., by the next
+   invertQuda call.  At most two writes are kept pending; further
+   calls block until one has completed.  With more than one node the
+   write is done synchronously since QMP is not assumed thread safe.
+   @param filename Output file name
+   @param V Host fields to write, one per vector
+   @param precision Precision of the host fields
+   @param file_prec Precision of the file (double or single), or
+   QUDA_INVALID_PRECISION to use the precision of the host fields
+   @param X Local lattice dimensions
+   @param nColor Number of colors
+   @param nSpin Number of spins
+   @param Nvec Number of vectors
+   @return Handle of this write, to be passed to write_spinor_field_wait(int)
+*/
+int write_spinor_field_async(const char *filename, void *V[], QudaPrecision precision, QudaPrecision file_prec,
+			     const int *X, int nColor, int nSpin, int Nvec);
+
+/**
+   @brief Wait for a single queued asynchronous write to complete,
+   leaving later writes running in the background.  Writes complete
+   in the order they were queued, so this also waits for all earlier
+   writes.  A write done synchronously (more than one node) has
+   already completed.
+   @param handle Handle returned by write_spinor_field_async
+*/
+void write_spinor_field_wait(int handle);
+
+/**
+   @brief Wait for all queued asynchronous writes to complete and
+   stop the writer thread.  Must be called before the host fields
+   are used for anything requiring the files to be on disk, and
+   before exit.
+*/
+void write_spinor_field_wait();
 #else
 inline void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec,
 		      const int *X, int argc, char *argv[]) {
@@ -24,6 +63,13 @@ inline void write_spinor_field(const char *filename, void *V[], QudaPrecision pr
   printf("QIO support has not been enabled\n");
   exit(-1);
 }
+inline int write_spinor_field_async(const char *filename, void *V[], QudaPrecision precision, QudaPrecision file_prec,
+				    const int *X, int nColor, int nSpin, int Nvec) {
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
+inline void write_spinor_field_wait(int handle) { }
+inline void write_spinor_field_wait() { }
 
 #endif
 
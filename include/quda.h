@@ -154,6 +154,13 @@ extern "C" {
     /** Solver tolerance for each shift when refinement is applied using the heavy-quark residual */
     double tol_hq_offset[QUDA_MAX_MULTI_SHIFT];
 
+    /** Precision of the search direction of each shift in the
+        multi-shift solver.  Large shifts converge quickly and can
+        be kept below the sloppy precision to reduce memory traffic
+        (defaults to cuda_prec_sloppy; shift 0 always uses
+        cuda_prec_sloppy) */
+    QudaPrecision cuda_prec_offset[QUDA_MAX_MULTI_SHIFT];
+
     /** Actual L2 residual norm achieved in solver for each offset */
     double true_res_offset[QUDA_MAX_MULTI_SHIFT];
 
@@ -411,6 +418,15 @@ extern "C" {
     /** Tolerance to use in the setup phase */
     double setup_tol[QUDA_MAX_MG_LEVEL];
 
+    /** Maximum number of iterations for each setup solver (0 =
+	solver default: 2000 for CG, 500 otherwise) */
+    int setup_maxiter[QUDA_MAX_MG_LEVEL];
+
+    /** Maximum number of iterations for refreshing the null-space
+	vectors, either on updateMultigridQuda or after loading them
+	from file (0 = no refresh) */
+    int setup_maxiter_refresh[QUDA_MAX_MG_LEVEL];
+
     /** Smoother to use on each level */
     QudaInverterType smoother[QUDA_MAX_MG_LEVEL];
 
@@ -424,6 +440,16 @@ extern "C" {
     /** The type of multigrid cycle to perform at each level */
     QudaMultigridCycleType cycle_type[QUDA_MAX_MG_LEVEL];
 
+    /** Tolerance of the flexible Krylov solver wrapping each coarse level in a K-cycle (indexed by the coarse level) */
+    double coarse_solver_tol[QUDA_MAX_MG_LEVEL];
+
+    /** Number of iterations of the flexible Krylov solver wrapping each coarse level in a K-cycle (indexed by the coarse level) */
+    int coarse_solver_maxiter[QUDA_MAX_MG_LEVEL];
+
+    /** Precision in which the coarse link field is stored when applying the coarse operator (indexed by the coarse level);
+        QUDA_HALF_PRECISION stores the links in 16-bit fixed point with a scale factor per link matrix */
+    QudaPrecision coarse_link_precision[QUDA_MAX_MG_LEVEL];
+
     /** Number of pre-smoother applications on each level */
     int nu_pre[QUDA_MAX_MG_LEVEL];
 
@@ -468,6 +494,94 @@ extern "C" {
 
   } QudaMultigridParam;
 
+  /**
+   * A force term of one time scale of a molecular-dynamics
+   * integrator.  Gauge-action terms are evaluated by QUDA from the
+   * loop description; callback terms let the application add any
+   * other force to the resident momentum field.
+   */
+  typedef struct QudaForceTerm_s {
+
+    /** Whether this is a gauge-action or an application callback term */
+    QudaForceTermType type;
+
+    /** Gauge-action loops in the format of computeGaugeForceQuda */
+    int ***input_path_buf;
+
+    /** Length of each loop */
+    int *path_length;
+
+    /** Coefficient of each loop */
+    double *loop_coeff;
+
+    /** Number of loops */
+    int num_paths;
+
+    /** Maximum loop length */
+    int max_length;
+
+    /** Prefactor of the gauge force (e.g., beta/3 for the MILC
+	normalization), so that a step dt applies
+	mom -= dt * coeff * [U * loops]_TA */
+    double coeff;
+
+    /** Callback that must add dt times its force to the resident
+	momentum field, e.g., through computeCloverForceQuda or
+	computeHISQForceQuda with use_resident_mom and
+	make_resident_mom set.  The resident gauge field and its
+	sloppy copies are current when it is called. */
+    void (*callback)(double dt, void *context);
+
+    /** Application context handed to the callback */
+    void *context;
+
+  } QudaForceTerm;
+
+  /**
+   * Description of a nested multi-time-scale molecular-dynamics
+   * integrator.  Level 0 is the outermost (coarsest) time scale; each
+   * step of level i integrates level i+1 over the sub-intervals of
+   * its gauge-field updates, and the innermost level updates the
+   * gauge field itself.
+   */
+  typedef struct QudaIntegratorParam_s {
+
+    /** Number of time scales */
+    int n_level;
+
+    /** Integration scheme of each level */
+    QudaIntegratorType integrator[QUDA_MAX_INTEGRATOR_LEVEL];
+
+    /** Number of steps of each level per step of the enclosing level */
+    int n_step[QUDA_MAX_INTEGRATOR_LEVEL];
+
+    /** Number of force terms of each level */
+    int n_term[QUDA_MAX_INTEGRATOR_LEVEL];
+
+    /** Force terms of each level */
+    QudaForceTerm *term[QUDA_MAX_INTEGRATOR_LEVEL];
+
+    /** Trajectory length */
+    double tau;
+
+    /** Parameter of the Omelyan (2MN) scheme */
+    double lambda;
+
+    /** Momentum action at the start and at the end of the trajectory (output) */
+    double mom_action[2];
+
+    /** Gauge action of the gauge-force terms at the start and at the
+	end of the trajectory, zero if there are callback terms (output) */
+    double gauge_action[2];
+
+    /** Number of force evaluations per term type (output) */
+    int n_force[2];
+
+    /** Time taken by the trajectory (output) */
+    double secs;
+
+  } QudaIntegratorParam;
+
 
 
   /*
@@ -614,6 +728,15 @@ extern "C" {
    */
   QudaEigParam newQudaEigParam(void);
 
+  /**
+   * A new QudaIntegratorParam should always be initialized
+   * immediately after it's defined (and prior to explicitly setting
+   * its members) using this function.  Typical usage is as follows:
+   *
+   *   QudaIntegratorParam md_param = newQudaIntegratorParam();
+   */
+  QudaIntegratorParam newQudaIntegratorParam(void);
+
   /**
    * Print the members of QudaGaugeParam.
    * @param param The QudaGaugeParam whose elements we are to print.
@@ -632,6 +755,12 @@ extern "C" {
    */
   void printQudaMultigridParam(QudaMultigridParam *param);
 
+  /**
+   * Print the members of QudaIntegratorParam.
+   * @param param The QudaIntegratorParam whose elements we are to print.
+   */
+  void printQudaIntegratorParam(QudaIntegratorParam *param);
+
   /**
    * Print the members of QudaEigParam.
    * @param param The QudaEigParam whose elements we are to print.
@@ -639,7 +768,10 @@ extern "C" {
   void printQudaEigParam(QudaEigParam *param);
 
   /**
-   * Load the gauge field from the host.
+   * Load the gauge field from the host.  Only the precise device
+   * field is created here; the sloppy, preconditioner and extended
+   * copies are created when a solver first needs them and refreshed
+   * only after the resident field changes.
    * @param h_gauge Base pointer to host gauge field (regardless of dimensionality)
    * @param param   Contains all metadata regarding host and device storage
    */
@@ -659,7 +791,9 @@ extern "C" {
 
   /**
    * Load the clover term and/or the clover inverse from the host.
-   * Either h_clover or h_clovinv may be set to NULL.
+   * Either h_clover or h_clovinv may be set to NULL.  As for the gauge
+   * field, the sloppy and preconditioner copies are created on first
+   * use by a solver.
    * @param h_clover    Base pointer to host clover field
    * @param h_cloverinv Base pointer to host clover inverse field
    * @param inv_param   Contains all metadata regarding host and device storage
@@ -672,6 +806,25 @@ extern "C" {
    */
   void freeCloverQuda(void);
 
+  /**
+   * Return the content hash of the resident gauge field of the given
+   * link type.  The hash covers the host field last loaded with
+   * loadGaugeQuda together with its load parameters, so it may be
+   * used as a cache key for quantities derived from the resident
+   * field; loadGaugeQuda skips reloading a field whose hash matches.
+   * @param type The link type (Wilson, fat or long links)
+   * @return The hash on this process, or zero if the resident field
+   *         is absent or has been modified since it was loaded
+   */
+  unsigned long long gaugeHashQuda(QudaLinkType type);
+
+  /**
+   * Return the content hash of the resident clover field, as for
+   * gaugeHashQuda.
+   * @return The hash on this process, or zero if unknown
+   */
+  unsigned long long cloverHashQuda(void);
+
   /**
    * Perform the solve, according to the parameters set in param.  It
    * is assumed that the gauge field has already been loaded via
@@ -732,15 +885,18 @@ extern "C" {
   void destroyMultigridQuda(void *mg_instance);
 
   /**
-<<<<<<< HEAD
-   * @brief Updates the multigrid preconditioner for the new gauge / clover field
+   * @brief Updates the multigrid preconditioner for the new gauge /
+   * clover field.  The coarse-grid operators are always rebuilt, and
+   * if param->setup_maxiter_refresh is non-zero on a given level the
+   * existing null-space vectors on that level are first refined
+   * against the new operator (rather than regenerated from random).
    * @param mg_instance Pointer to instance of multigrid_solver
+   * @param param Contains all metadata regarding host and device
+   *              storage and solver parameters
    */
   void updateMultigridQuda(void *mg_instance, QudaMultigridParam *param);
 
   /**
-=======
->>>>>>> 5c038cb32c1ab09c9fcd09c41a001f1a1bd857a3
    * Apply the Dslash operator (D_{eo} or D_{oe}).
    * @param h_out  Result spinor field
    * @param h_in   Input spinor field
@@ -882,6 +1038,32 @@ extern "C" {
    */
   double momActionQuda(void* momentum, QudaGaugeParam* param);
 
+  /**
+   * Integrate a molecular-dynamics trajectory with the gauge field
+   * and the momentum kept resident on the device throughout.  The
+   * gauge field is left resident (with its sloppy and extended
+   * copies current) and is only copied back to the host if
+   * param->return_result_gauge is set; likewise for the momentum.
+   * Adjacent momentum updates of consecutive steps are merged, so a
+   * leapfrog step costs one evaluation of each force term.  Fields
+   * derived from the gauge field other than its sloppy and extended
+   * copies (e.g., clover or fat links) are not updated; callback
+   * terms that need them must recompute them.
+   *
+   * @param gauge Host gauge field, loaded if param->use_resident_gauge is not set
+   * @param momentum Host momentum field, loaded if param->use_resident_mom is not set
+   * @param md_param The integrator description
+   * @param param The parameters of the external fields and the computation settings
+   * @return The change in the Hamiltonian dH over the trajectory when
+   * all terms are gauge-force terms, whose action is computed from
+   * their loops.  With callback terms, whose actions QUDA does not
+   * know, only the change in the momentum action is returned and the
+   * application adds the change in its own action (e.g., from
+   * plaqQuda and its fermion actions on the resident field) to form dH
+   */
+  double integrateTrajectoryQuda(void *gauge, void *momentum, QudaIntegratorParam *md_param,
+				 QudaGaugeParam *param);
+
   /**
    * Allocate a gauge (matrix) field on the device and optionally download a host gauge field.
    *
@@ -1032,6 +1214,59 @@ extern "C" {
   void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *param, 
                              unsigned int nSteps, double alpha);
 
+  /**
+   * Performs Wuppertal smearing on a set of host spinors, e.g., the
+   * twelve spin-color columns of a propagator, using a host gauge
+   * field.  All vectors are smeared in a single threaded pass over
+   * the links per step.
+   * @param h_out   Result spinor fields
+   * @param h_in    Input spinor fields
+   * @param n_vec   Number of spinor fields
+   * @param h_gauge Host gauge field, QDP or MILC ordered
+   * @param gauge_param Contains all metadata regarding the host gauge field
+   * @param param   Contains all metadata regarding host storage of the spinors
+   * @param nSteps  Number of steps to apply.
+   * @param alpha   Alpha coefficient for Wuppertal smearing.
+   */
+  void performWuppertalnStepHost(void **h_out, void **h_in, int n_vec, void *h_gauge,
+                                 QudaGaugeParam *gauge_param, QudaInvertParam *param,
+                                 unsigned int nSteps, double alpha);
+
+  /**
+   * Computes time-sliced, momentum-projected meson correlators of two
+   * host propagators for all pairs of sink and source gamma matrices
+   * in a single threaded pass, see contractMesons in contractQuda.h
+   * for the definition.  The lattice dimensions are those of the
+   * loaded gauge field.
+   * @param corr      Output (re,im) correlators, indexed
+   *                  ((snk*n_src + src)*n_mom + p)*Lt + t
+   * @param h_prop1   The 12 spin-color columns of the first propagator
+   * @param h_prop2   The 12 spin-color columns of the second propagator
+   * @param n_snk     Number of sink gamma matrices
+   * @param gamma_snk Sink gamma matrix indices
+   * @param n_src     Number of source gamma matrices
+   * @param gamma_src Source gamma matrix indices
+   * @param n_mom     Number of momenta
+   * @param mom       Momenta, as n_mom (px,py,pz) triplets
+   * @param param     Contains all metadata regarding host storage of the propagators
+   */
+  void contractMesonsQuda(double *corr, void **h_prop1, void **h_prop2, int n_snk, const int *gamma_snk,
+                          int n_src, const int *gamma_src, int n_mom, const int *mom, QudaInvertParam *param);
+
+  /**
+   * Computes time-sliced, momentum-projected nucleon correlators of
+   * host up and down propagators, see contractBaryons in
+   * contractQuda.h for the definition.
+   * @param corr      Output (re,im) correlators, indexed p*Lt + t
+   * @param h_prop_u  The 12 spin-color columns of the up propagator
+   * @param h_prop_d  The 12 spin-color columns of the down propagator
+   * @param n_mom     Number of momenta
+   * @param mom       Momenta, as n_mom (px,py,pz) triplets
+   * @param param     Contains all metadata regarding host storage of the propagators
+   */
+  void contractBaryonsQuda(double *corr, void **h_prop_u, void **h_prop_d, int n_mom, const int *mom,
+                           QudaInvertParam *param);
+
   /**
    * Performs APE smearing on gaugePrecise and stores it in gaugeSmeared
    * @param nSteps Number of steps to apply.
@@ -1054,11 +1289,70 @@ extern "C" {
    */
   void performOvrImpSTOUTnStep(unsigned int nSteps, double rho, double epsilon);
 
+  /**
+   * Integrates the gradient flow of gaugePrecise with the third-order
+   * Runge-Kutta scheme, storing the flowed field in gaugeSmeared, and
+   * measures the clover action density and topological charge at the
+   * requested flow times.
+   * @param type    Flow kernel (Wilson, Symanzik or Zeuthen)
+   * @param epsilon Initial step size, kept fixed when tol is zero
+   * @param tol     Tolerance on the per-link integration error for the adaptive step size control (zero disables adaptation)
+   * @param n_meas  Number of measurement flow times
+   * @param t_meas  Ascending flow times at which to measure; the flow stops at the last one
+   * @param E       Array for storing E(t) at each measurement time
+   * @param t2E     Array for storing t^2 E(t) at each measurement time
+   * @param Q       Array for storing Q(t) at each measurement time
+   * @return The number of integration steps taken
+   */
+  int performGradientFlowQuda(QudaGaugeFlowType type, double epsilon, double tol, int n_meas,
+			      const double *t_meas, double *E, double *t2E, double *Q);
+
+  /**
+   * Integrates the gradient flow of a host gauge field in place using
+   * multi-threaded host kernels, without touching the resident device
+   * fields.  Parameters and measurements are as for performGradientFlowQuda.
+   * @param h_gauge Host gauge field (QDP or MILC order)
+   * @param param   Contains all metadata regarding the host gauge field
+   * @return The number of integration steps taken
+   */
+  int performGradientFlowHostQuda(void *h_gauge, QudaGaugeParam *param, QudaGaugeFlowType type,
+				  double epsilon, double tol, int n_meas, const double *t_meas,
+				  double *E, double *t2E, double *Q);
+
   /**
    * Calculates the topological charge from gaugeSmeared, if it exist, or from gaugePrecise if no smeared fields are present.
    */
   double qChargeCuda();
 
+  /**
+   * Computes the total, spatial and temporal plaquette averages and
+   * the topological charge of a host gauge field using multi-threaded
+   * host kernels, without touching the resident device fields.  The
+   * reductions are bit-wise reproducible for any number of threads.
+   * @param plaq Array for storing the averages (total, spatial, temporal)
+   * @param h_gauge Host gauge field (QDP or MILC order)
+   * @param param Contains all metadata regarding the host gauge field
+   * @return The topological charge
+   */
+  double gaugeObservablesHostQuda(double plaq[3], void *h_gauge, QudaGaugeParam *param);
+
+  /**
+   * Computes the clover term, and optionally its inverse and trace
+   * log, of a host gauge field using multi-threaded host kernels,
+   * without touching the resident device fields.  The clover
+   * coefficient, twisted mass and precision are taken from inv_param;
+   * the clover field must be in QUDA_PACKED_CLOVER_ORDER with the same
+   * precision as the gauge field.  If compute_clover_trlog is set, the
+   * trace log of each parity is returned in inv_param->trlogA.
+   * @param h_clover Host buffer for the clover term
+   * @param h_clovinv Host buffer for the clover inverse (may be NULL)
+   * @param h_gauge Host gauge field (QDP or MILC order)
+   * @param gauge_param Contains all metadata regarding the host gauge field
+   * @param inv_param Contains all metadata regarding the clover field
+   */
+  void computeCloverHostQuda(void *h_clover, void *h_clovinv, void *h_gauge, QudaGaugeParam *gauge_param,
+			     QudaInvertParam *inv_param);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] gauge, gauge field to be fixed
@@ -1106,6 +1400,28 @@ extern "C" {
                       QudaGaugeParam* param,
                       double* timeinfo);
 
+  /**
+   * @brief Gauge fixing with overrelaxation on the host, with
+   * threaded checkerboard sweeps.  The field is fixed in place and
+   * must be QDP or MILC ordered; single node only.  Parameters as for
+   * computeGaugeFixingOVRQuda, timeinfo[1] holds the compute time.
+   */
+  int computeGaugeFixingOVRHostQuda(void* gauge, const unsigned int gauge_dir, const unsigned int Nsteps,
+                                    const unsigned int verbose_interval, const double relax_boost,
+                                    const double tolerance, const unsigned int reunit_interval,
+                                    const unsigned int stopWtheta, QudaGaugeParam* param, double* timeinfo);
+
+  /**
+   * @brief Gauge fixing with Fourier accelerated steepest descent on
+   * the host.  The field is fixed in place and must be QDP or MILC
+   * ordered; single node only.  Parameters as for
+   * computeGaugeFixingFFTQuda, timeinfo[1] holds the compute time.
+   */
+  int computeGaugeFixingFFTHostQuda(void* gauge, const unsigned int gauge_dir, const unsigned int Nsteps,
+                                    const unsigned int verbose_interval, const double alpha,
+                                    const unsigned int autotune, const double tolerance,
+                                    const unsigned int stopWtheta, QudaGaugeParam* param, double* timeinfo);
+
   /**
    * @brief Flush the chronological history for the given index
    * @param[in] index Index for which we are flushing
@@ -55,6 +55,13 @@
  */
 #define QUDA_MAX_MG_LEVEL 4
 
+/**
+ * @def QUDA_MAX_INTEGRATOR_LEVEL
+ * @brief Maximum number of nested time scales of a molecular-dynamics
+ * integrator.  This number may be increased if needed.
+ */
+#define QUDA_MAX_INTEGRATOR_LEVEL 4
+
 /**
  * @def QUDA_MAX_MULTI_REDUCE
  * @brief Maximum number of simultaneous reductions that can take
@@ -2,144 +2,216 @@
 #ifndef RANDOM_GPU_H
 #define RANDOM_GPU_H
 
-//#include <stdio.h>
-//#include <string.h>
-//#include <iostream>
-#include <curand_kernel.h>
+#include <cmath>
+#include <cuda_runtime.h>
 
 namespace quda {
 
-#if defined(XORWOW)
-typedef struct curandStateXORWOW cuRNGState;
-#elif defined(MRG32k3a)
-typedef struct curandStateMRG32k3a cuRNGState;
-#else
-typedef struct curandStateMRG32k3a cuRNGState;
-#endif
-
 /**
-    @brief Class declaration to initialize and hold CURAND RNG states
+   @brief State of a Philox-4x32-10 counter-based generator (Salmon
+   et al., SC'11).  The random stream is a pure function of the key
+   (seed), the subsequence (e.g., a global site index) and the
+   offset, so no per-site state needs to be stored or backed up and
+   the same numbers are produced on host and device, independent of
+   the number of threads or the lattice decomposition.
 */
-class RNG {
-public:
-    RNG(int rng_sizes, int seedin, const int XX[4]);
-    RNG(int rng_sizes, int seedin);
-    /*! free array */
-    void Release(); 
-    /*! initialize curand rng states with seed */
-    void Init();
-    /*! @brief return curand rng array size */
-    int Size(){ return rng_size;};
-    int Node_Offset(){ return node_offset;};
-    int Seed(){ return seed;};
-    __host__ __device__ __inline__ cuRNGState* State(){ return state;};
-    /*! @brief Restore CURAND array states initialization */
-    void restore();
-    /*! @brief Backup CURAND array states initialization */
-    void backup();
-private:
-    /*! array with current curand rng state */
-    cuRNGState *state;
-    /*! array for backup of current curand rng state */
-    cuRNGState *backup_state;
-    /*! initial rng seed */
-    int seed;
-    /*! @brief number of curand states */
-    int rng_size;  
-    /*! @brief offset in the index, in case of multigpus */
-    int node_offset;
-    int X[4];
-    /*! @brief allocate curand rng states array in device memory */
-    void AllocateRNG();
-    /*! @brief CURAND array states initialization */
-    void INITRNG(int rng_sizes, int seedin, int offsetin);
+struct PhiloxState {
+    unsigned int key[2];
+    unsigned int ctr[4];
+    unsigned int out[4];
+    int pos;
 };
 
-
-
-
-
 /**
-   @brief Return a random number between a and b
-   @param state curand rng state
-   @param a lower range
-   @param b upper range
-   @return  random number in range a,b
+   @brief Apply the ten Philox-4x32 rounds to a counter
+   @param out the 128 random bits for this counter
+   @param ctr the counter
+   @param key the key
 */
-template<class Real>
-inline  __device__ Real Random(cuRNGState &state, Real a, Real b){
-    Real res;
-    return res;
+__host__ __device__ inline void philox4x32_10(unsigned int out[4], const unsigned int ctr[4], const unsigned int key[2]){
+    unsigned int c[4] = { ctr[0], ctr[1], ctr[2], ctr[3] };
+    unsigned int k[2] = { key[0], key[1] };
+    for ( int r = 0; r < 10; r++ ) {
+        unsigned long long p0 = (unsigned long long)0xD2511F53u * c[0];
+        unsigned long long p1 = (unsigned long long)0xCD9E8D57u * c[2];
+        unsigned int c0 = (unsigned int)(p1 >> 32) ^ c[1] ^ k[0];
+        unsigned int c2 = (unsigned int)(p0 >> 32) ^ c[3] ^ k[1];
+        c[1] = (unsigned int)p1;
+        c[3] = (unsigned int)p0;
+        c[0] = c0;
+        c[2] = c2;
+        k[0] += 0x9E3779B9u;
+        k[1] += 0xBB67AE85u;
+    }
+    for ( int i = 0; i < 4; i++ ) out[i] = c[i];
 }
- 
-template<>
-inline  __device__ float Random<float>(cuRNGState &state, float a, float b){
-    return a + (b - a) * curand_uniform(&state);
+
+/**
+   @brief Initialize a Philox generator
+   @param state generator state
+   @param seed the key
+   @param subsequence independent stream, e.g., the global site index
+   @param offset position within the stream, in units of four 32-bit draws
+*/
+__host__ __device__ inline void philoxInit(PhiloxState &state, unsigned long long seed,
+                                           unsigned long long subsequence, unsigned long long offset){
+    state.key[0] = (unsigned int)seed;
+    state.key[1] = (unsigned int)(seed >> 32);
+    state.ctr[0] = (unsigned int)offset;
+    state.ctr[1] = (unsigned int)(offset >> 32);
+    state.ctr[2] = (unsigned int)subsequence;
+    state.ctr[3] = (unsigned int)(subsequence >> 32);
+    state.pos = 4;
 }
 
-template<>
-inline  __device__ double Random<double>(cuRNGState &state, double a, double b){
-    return a + (b - a) * curand_uniform_double(&state);
+/**
+   @brief Return the next 32 random bits of a Philox generator
+   @param state generator state
+*/
+__host__ __device__ inline unsigned int philoxNext(PhiloxState &state){
+    if ( state.pos == 4 ) {
+        philox4x32_10(state.out, state.ctr, state.key);
+        if ( ++state.ctr[0] == 0 ) state.ctr[1]++;
+        state.pos = 0;
+    }
+    return state.out[state.pos++];
 }
 
 /**
-   @brief Return a random number between 0 and 1
-   @param state curand rng state
-   @return  random number in range 0,1
+   @brief Return a random number in (0,1) from a Philox generator
+   @param state generator state
 */
 template<class Real>
-inline  __device__ Real Random(cuRNGState &state){
-    Real res;
-    return res;
-}
- 
+__host__ __device__ inline Real Random(PhiloxState &state);
+
 template<>
-inline  __device__ float Random<float>(cuRNGState &state){
-    return curand_uniform(&state);
+__host__ __device__ inline float Random<float>(PhiloxState &state){
+    return ((philoxNext(state) >> 8) + 0.5f) * 5.9604644775390625e-8f; // 2^-24
 }
 
 template<>
-inline  __device__ double Random<double>(cuRNGState &state){
-    return curand_uniform_double(&state);
+__host__ __device__ inline double Random<double>(PhiloxState &state){
+    unsigned long long a = philoxNext(state) >> 5;
+    unsigned long long b = philoxNext(state) >> 6;
+    return ((a << 26) + b + 0.5) * 1.1102230246251565e-16; // 2^-53
 }
 
+/**
+   @brief Return a random number between a and b from a Philox generator
+   @param state generator state
+   @param a lower range
+   @param b upper range
+   @return  random number in range a,b
+*/
+template<class Real>
+__host__ __device__ inline Real Random(PhiloxState &state, Real a, Real b){
+    return a + (b - a) * Random<Real>(state);
+}
 
 template<class Real>
-struct uniform { };
-template<>
-struct uniform<float> {
-    __device__
-        static inline float rand(cuRNGState &state) {
-        return curand_uniform(&state);
+struct uniform {
+    __host__ __device__
+        static inline Real rand(PhiloxState &state) {
+        return Random<Real>(state);
     }
 };
-template<>
-struct uniform<double> {
-    __device__
-        static inline double rand(cuRNGState &state) {
-        return curand_uniform_double(&state);
-    }
-};
-
-
 
+/**
+   @brief Standard normal deviates from a Philox generator using the
+   Box-Muller transform
+*/
 template<class Real>
-struct normal { };
-template<>
-struct normal<float> {
-    __device__
-        static inline float rand(cuRNGState &state) {
-        return curand_normal(&state);
+struct normal {
+    __host__ __device__
+        static inline Real rand(PhiloxState &state) {
+        Real radius = sqrt( (Real)-2.0 * log(Random<Real>(state)) );
+        Real phi = (Real)(2.0 * M_PI) * Random<Real>(state);
+        return radius * cos(phi);
     }
 };
-template<>
-struct normal<double> {
-    __device__
-        static inline double rand(cuRNGState &state) {
-        return curand_normal_double(&state);
+
+
+/**
+    @brief Counter-based random number generator.  No generator state
+    is stored per site: each site derives its Philox stream on the fly
+    from the seed, its global lattice coordinates and a call counter
+    that is advanced after every kernel that draws random numbers.
+    The memory footprint is thus O(1), a checkpoint consists only of
+    the seed and the counter, and a given site draws the same numbers
+    on host and device for any lattice decomposition.
+*/
+class RNG {
+public:
+    /**
+       @param rng_sizes number of sites served, for reference only
+       @param seedin initial seed
+       @param XX local (unextended) lattice dimensions used to compute
+       global site indices
+    */
+    RNG(int rng_sizes, int seedin, const int XX[4]);
+    RNG(int rng_sizes, int seedin);
+    /*! nothing to free, kept for compatibility */
+    void Release(); 
+    /*! reset the call counter */
+    void Init();
+    /*! @brief return number of sites served */
+    int Size(){ return rng_size;};
+    int Node_Offset(){ return node_offset;};
+    int Seed(){ return seed;};
+    /*! @brief return the call counter, which together with the seed fully describes the generator */
+    unsigned long long Counter() const { return counter; }
+    /*! @brief set the call counter, e.g., when restarting from a checkpoint */
+    void setCounter(unsigned long long counter_){ counter = counter_; }
+    /*! @brief advance the call counter, to be called after each kernel launch drawing random numbers */
+    void advance(){ counter++; }
+
+    /**
+       @brief Return the generator of a given site for the current call
+       @param x_cb checkerboard index of the site in the local lattice
+       @param parity parity of the site
+    */
+    __host__ __device__ inline PhiloxState State(int x_cb, int parity = 0) const {
+        unsigned long long site;
+        if ( X[0] == 0 ) {
+            site = node_offset + (unsigned long long)parity * rng_size + x_cb;
+        } else {
+            int x[4];
+            int za = x_cb / (X[0] >> 1);
+            int zb = za / X[1];
+            x[1] = za - zb * X[1];
+            x[3] = zb / X[2];
+            x[2] = zb - x[3] * X[2];
+            x[0] = 2 * (x_cb - za * (X[0] >> 1)) + ((x[1] + x[2] + x[3] + parity) & 1);
+            site = 0;
+            for ( int d = 3; d >= 0; d-- ) site = site * globalX[d] + commCoord[d] * X[d] + x[d];
+        }
+        PhiloxState state;
+        philoxInit(state, (unsigned long long)seed, site, counter << 32);
+        return state;
     }
-};
 
+    /*! @brief Restore the call counter saved by backup() */
+    void restore();
+    /*! @brief Save the call counter, e.g., before autotuning */
+    void backup();
+private:
+    /*! initial rng seed */
+    int seed;
+    /*! @brief number of kernel calls that have drawn random numbers */
+    unsigned long long counter;
+    /*! @brief counter saved by backup() */
+    unsigned long long backup_counter;
+    /*! @brief number of sites served */
+    int rng_size;  
+    /*! @brief offset in the index, in case of multigpus and no dimensions given */
+    int node_offset;
+    /*! @brief local lattice dimensions, zero if not given */
+    int X[4];
+    /*! @brief global lattice dimensions */
+    int globalX[4];
+    /*! @brief coordinates of this node in the process grid */
+    int commCoord[4];
+};
 
 }
 
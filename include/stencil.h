@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 namespace quda {
 
   /**
@@ -22,4 +24,136 @@ namespace quda {
   void ApplyLaplace(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
 		    double kappa, const ColorSpinorField *x, int parity);
 
+  /**
+     @brief Driver for applying the improved staggered operator on
+     the host
+
+     out = D in
+
+     where D is the staggered hopping term built from the one-hop fat
+     links U and the three-hop long links L.  If x is defined, the
+     operation is given by out = a * x - D in.  The input ghost zone
+     is exchanged three deep, and in partitioned dimensions the fat
+     and long links must carry padded ghost zones one and three deep
+     respectively.  A fifth dimension is treated as a set of
+     independent sources that share the links.
+
+     @param[out] out The output result field
+     @param[in] in The input field
+     @param[in] U The fat links
+     @param[in] L The long links
+     @param[in] a Scale factor applied to x
+     @param[in] x Vector field we accumulate onto to
+     @param[in] parity The parity of the output for single parity fields
+     @param[in] dagger Whether to apply the Hermitian conjugate
+  */
+  void ApplyImprovedStaggered(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			      const GaugeField &L, double a, const ColorSpinorField *x, int parity, bool dagger);
+
+  /**
+     @brief Coefficients of one flavour of the multi-flavour
+     Wilson-type operator applied by ApplyWilsonMultiFlavor
+   */
+  struct WilsonFlavorParam {
+    double a; // coefficient of the hopping term
+    double b; // coefficient of the identity
+    double c; // coefficient of the clover term
+    double d; // coefficient of i*gamma_5
+    WilsonFlavorParam(double a=0.0, double b=1.0, double c=0.0, double d=0.0) : a(a), b(b), c(c), d(d) { }
+  };
+
+  /**
+     @brief Driver for applying a Wilson-type operator to several
+     flavours that share the gauge field
+
+     out_f = a_f * D in_f + b_f * x_f + c_f * A x_f + i d_f gamma_5 x_f
+
+     where D is the Wilson hopping term and A the clover term.  The
+     hopping term does not depend on the quark mass, so the links of
+     each site (and the clover term) are loaded once and applied to
+     every flavour.  The fields can be single parity or full fields,
+     on the device or on the host (SPACE_SPIN_COLOR order with a QDP
+     or MILC gauge field).
+
+     @param[out] out The output result fields
+     @param[in] in The input fields of the hopping term
+     @param[in] x The input fields of the site term
+     @param[in] U The gauge field
+     @param[in] A The clover field (NULL if there is no clover term)
+     @param[in] flavor The coefficients of each flavour
+     @param[in] parity The parity of the output for single parity fields
+     @param[in] dagger Whether to apply the Hermitian conjugate
+  */
+  void ApplyWilsonMultiFlavor(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger);
+
+  /**
+     @brief Coefficients of the fifth-dimension operator of
+     domain-wall type fermions applied by ApplyDomainWall5D and
+     ApplyDomainWall4D
+
+     M5 = diag(a_s) + diag(b_s) D5
+
+     where D5 hops one chirality from slice s-1 and the other from
+     slice s+1 with the projectors 2 P_{+-} (the Hermitian conjugate
+     exchanges the two), and the hops across the walls are
+     multiplied by -mf.  The result in slice s is scaled by alpha_s,
+     and beta_s x_s is added when an accumulation field is given.
+   */
+  struct DomainWall5DParam {
+    std::vector<double> a;     // site coefficient of each slice
+    std::vector<double> b;     // hopping coefficient of each slice
+    std::vector<double> alpha; // scale of the result in each slice
+    std::vector<double> beta;  // scale of the accumulated field in each slice
+    double mf;                 // quark mass coupling the walls
+    bool inverse;              // whether to apply M5^{-1} rather than M5
+    DomainWall5DParam(int Ls, double mf=0.0, bool inverse=false)
+      : a(Ls, 1.0), b(Ls, 0.0), alpha(Ls, 1.0), beta(Ls, 1.0), mf(mf), inverse(inverse) { }
+  };
+
+  /**
+     @brief Driver for applying the fifth-dimension operator of
+     domain-wall type fermions on the host
+
+     out_s = alpha_s (M5 in)_s + beta_s x_s
+
+     or with M5^{-1} in place of M5, which is applied in O(Ls)
+     operations per site for arbitrary slice coefficients.  The
+     operator is vectorized across 4-d sites and supports the UKQCD
+     and DeGrand-Rossi gamma bases.
+
+     @param[out] out The output result field
+     @param[in] in The input field
+     @param[in] x Vector field we accumulate onto (may be NULL)
+     @param[in] m5 The fifth-dimension operator
+     @param[in] dagger Whether to apply the Hermitian conjugate
+  */
+  void ApplyDomainWall5D(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField *x,
+			 const DomainWall5DParam &m5, bool dagger);
+
+  /**
+     @brief Driver for applying the 4-d hopping term of domain-wall
+     type fermions fused with the fifth-dimension operator on the host
+
+     out_s = alpha_s (M5 D4 in)_s + beta_s x_s
+
+     or with M5^{-1} in place of M5, where D4 is the Wilson hopping
+     term of 4-d preconditioned fields.  The links of each site are
+     loaded once for every slice, and the hopping term is kept in
+     cache while M5 is applied to it; M5 = 1 (the default
+     DomainWall5DParam) gives the bare hopping term.  The fields must
+     be in the UKQCD basis.
+
+     @param[out] out The output result field
+     @param[in] in The input field
+     @param[in] U The gauge field
+     @param[in] x Vector field we accumulate onto (may be NULL)
+     @param[in] m5 The fifth-dimension operator
+     @param[in] parity The parity of the output
+     @param[in] dagger Whether to apply the Hermitian conjugate
+  */
+  void ApplyDomainWall4D(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			 const ColorSpinorField *x, const DomainWall5DParam &m5, int parity, bool dagger);
+
 } // namespace quda
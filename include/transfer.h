@@ -173,6 +173,14 @@ namespace quda {
     /** The destructor for Transfer */
     virtual ~Transfer();
 
+    /**
+     * @brief Recompute the block-orthogonal prolongator from the
+     * null-space vectors.  This should be called whenever the
+     * contents of B have changed (e.g., following a null-space
+     * refresh).  The geometry maps are unchanged.
+     */
+    void reset();
+
     /** 
      * Apply the prolongator
      * @param out The resulting field on the fine lattice
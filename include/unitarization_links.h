@@ -33,7 +33,17 @@ namespace quda {
 				  bool allow_svd, bool svd_only,
 				  double svd_rel_error, double svd_abs_error);
 
-  void unitarizeLinksCPU(cpuGaugeField& outfield, const cpuGaugeField &infield);
+  /**
+   * @brief Threaded host unitarization of the input gauge field,
+   * using the same Cayley-Hamilton and SVD algorithm as the device
+   * unitarizeLinks, vectorized over batches of links.  The input and
+   * output fields may be the same field.
+   *
+   * @param outfield Unitarized gauge field
+   * @param infield Gauge field to unitarize (MILC or QDP order)
+   * @return Number of links that failed the unitarity check
+   */
+  int unitarizeLinksCPU(cpuGaugeField& outfield, const cpuGaugeField &infield);
 
   void unitarizeLinks(cudaGaugeField& outfield, const cudaGaugeField &infield, int *fails);
   void unitarizeLinks(cudaGaugeField& outfield, int *fails);
@@ -50,6 +60,17 @@ namespace quda {
    * @param fails Number of link failures (device pointer)
    */
   void projectSU3(cudaGaugeField &U, double tol, int *fails);
+
+  /**
+   * @brief Project the input host gauge field onto the SU(3) group.
+   * This is a destructive operation, carried out with the batched
+   * host unitarization followed by removal of the determinant phase.
+   *
+   * @param U Gauge field that we are projecting onto SU(3)
+   * @param tol Tolerance of the unitarity check
+   * @param fails Number of link failures (host pointer, accumulated)
+   */
+  void projectSU3(cpuGaugeField &U, double tol, int *fails);
   
 } // namespace quda
 
@@ -0,0 +1,183 @@
+
+#ifndef FFT_HOST_H
+#define FFT_HOST_H
+
+#include <vector>
+#include <cmath>
+#include <quda_internal.h>
+#include <complex_quda.h>
+
+/*-------------------------------------------------------------------------------*/
+// Host counterparts of CUFFT_Plans.h.  The transforms use a bundled
+// mixed-radix decimation-in-time FFT, so any lattice extent is
+// supported, and follow the cuFFT conventions: the forward transform
+// uses exp(-2 pi i j k / n), the inverse exp(+2 pi i j k / n) and
+// neither is normalized.
+#define FFT_HOST_FORWARD -1
+#define FFT_HOST_INVERSE 1
+/*-------------------------------------------------------------------------------*/
+
+namespace quda {
+
+  /**
+   * @brief Plan for a one-dimensional complex-to-complex transform of length n
+   */
+  template <typename Float>
+  struct FFTHostPlan1D {
+    int n;
+    std::vector<int> factors; // radix and remaining length for each stage
+    std::vector<complex<Float> > twiddle[2]; // twiddles for the forward and inverse transforms
+
+    FFTHostPlan1D() : n(0) { }
+
+    void init(int n_) {
+      n = n_;
+      factors.clear();
+      int m = n, p = 4;
+      // radix 4 first, then 2, then odd primes
+      while ( m > 1 ) {
+        while ( m % p ) {
+          if ( p == 4 ) p = 2;
+          else if ( p == 2 ) p = 3;
+          else p += 2;
+          if ( p * p > m ) p = m;
+        }
+        m /= p;
+        factors.push_back(p);
+        factors.push_back(m);
+      }
+      for ( int d = 0; d < 2; d++ ) {
+        twiddle[d].resize(n);
+        double sign = d == 0 ? -1.0 : 1.0;
+        for ( int k = 0; k < n; k++ ) {
+          double phase = sign * 2.0 * M_PI * k / n;
+          twiddle[d][k] = complex<Float>(cos(phase), sin(phase));
+        }
+      }
+    }
+
+    /**
+     * @brief Radix-p butterfly applied to p interleaved transforms of length m
+     */
+    void butterfly(complex<Float> *out, const complex<Float> *tw, int fstride, int m, int p, complex<Float> *scratch) const {
+      if ( p == 2 ) {
+        for ( int k = 0; k < m; k++ ) {
+          complex<Float> t = out[k + m] * tw[k * fstride];
+          out[k + m] = out[k] - t;
+          out[k] += t;
+        }
+        return;
+      }
+      for ( int u = 0; u < m; u++ ) {
+        for ( int q = 0, k = u; q < p; q++, k += m ) scratch[q] = out[k];
+        for ( int q = 0, k = u; q < p; q++, k += m ) {
+          int t = 0;
+          out[k] = scratch[0];
+          for ( int r = 1; r < p; r++ ) {
+            t += fstride * k;
+            if ( t >= n ) t -= n;
+            out[k] += scratch[r] * tw[t];
+          }
+        }
+      }
+    }
+
+    void work(complex<Float> *out, const complex<Float> *in, int fstride, int in_stride, const int *f,
+              const complex<Float> *tw, complex<Float> *scratch) const {
+      const int p = f[0], m = f[1];
+      complex<Float> *out_end = out + p * m;
+      complex<Float> *out_begin = out;
+      if ( m == 1 ) {
+        for ( ; out != out_end; out++, in += fstride * in_stride ) *out = *in;
+      } else {
+        for ( ; out != out_end; out += m, in += fstride * in_stride )
+          work(out, in, fstride * p, in_stride, f + 2, tw, scratch);
+      }
+      butterfly(out_begin, tw, fstride, m, p, scratch);
+    }
+
+    /**
+     * @brief Transform n elements read with the given stride into contiguous output
+     * @param[out] out Contiguous output of length n
+     * @param[in] in Input, element j read from in[j * in_stride]
+     * @param[in] in_stride Input stride
+     * @param[in] direction FFT_HOST_FORWARD or FFT_HOST_INVERSE
+     * @param[in] scratch Work space of length n
+     */
+    void apply(complex<Float> *out, const complex<Float> *in, int in_stride, int direction, complex<Float> *scratch) const {
+      if ( n == 1 ) { out[0] = in[0]; return; }
+      work(out, in, 1, in_stride, factors.data(), twiddle[direction == FFT_HOST_FORWARD ? 0 : 1].data(), scratch);
+    }
+  };
+
+
+  /**
+   * @brief Plan for a batch of two-dimensional transforms over
+   * contiguous planes of size n_fast * n_slow, the mirror of a cuFFT
+   * plan created with cufftPlanMany
+   */
+  template <typename Float>
+  struct FFTHostPlan2DMany {
+    int n_fast;
+    int n_slow;
+    int batch;
+    FFTHostPlan1D<Float> plan_fast;
+    FFTHostPlan1D<Float> plan_slow;
+  };
+
+
+  /**
+   * @brief Creates a host plan supporting 4D (2D+2D) data layouts, see SetPlanFFT2DMany in CUFFT_Plans.h
+   * @param[out] plan, host FFT plan
+   * @param[in] size, int4 with lattice size dimensions, (.x,.y,.z,.w) -> (Nx, Ny, Nz, Nt)
+   * @param[in] dim, 0 for 2D plan in Z-T planes with batch size Nx*Ny, 1 for 2D plan in X-Y planes with batch size Nz*Nt
+   */
+  template <typename Float>
+  inline void SetPlanFFT2DMany( FFTHostPlan2DMany<Float> &plan, int4 size, int dim){
+    switch ( dim ) {
+    case 0:
+      plan.n_fast = size.z; plan.n_slow = size.w; plan.batch = size.x * size.y;
+      break;
+    case 1:
+      plan.n_fast = size.x; plan.n_slow = size.y; plan.batch = size.z * size.w;
+      break;
+    default:
+      errorQuda("Invalid plan dimension %d", dim);
+    }
+    plan.plan_fast.init(plan.n_fast);
+    plan.plan_slow.init(plan.n_slow);
+  }
+
+
+  /**
+   * @brief Perform the batched 2D transforms of a host plan, threaded over the planes
+   * @param[in] plan, host FFT plan
+   * @param[in] data_in, pointer to the complex input data
+   * @param[out] data_out, pointer to the complex output data, must not alias data_in
+   * @param[in] direction, the transform direction: FFT_HOST_FORWARD or FFT_HOST_INVERSE
+   */
+  template <typename Float>
+  inline void ApplyFFT(const FFTHostPlan2DMany<Float> &plan, complex<Float> *data_in, complex<Float> *data_out, int direction){
+    const int nf = plan.n_fast, ns = plan.n_slow;
+    const int nmax = nf > ns ? nf : ns;
+#pragma omp parallel
+    {
+      std::vector<complex<Float> > line(nmax), scratch(nmax);
+#pragma omp for
+      for ( int b = 0; b < plan.batch; b++ ) {
+        const complex<Float> *in = data_in + (size_t)b * nf * ns;
+        complex<Float> *out = data_out + (size_t)b * nf * ns;
+        // rows along the fast index
+        for ( int j = 0; j < ns; j++ ) plan.plan_fast.apply(out + j * nf, in + j * nf, 1, direction, scratch.data());
+        // columns along the slow index
+        for ( int i = 0; i < nf; i++ ) {
+          plan.plan_slow.apply(line.data(), out + i, nf, direction, scratch.data());
+          for ( int j = 0; j < ns; j++ ) out[i + j * nf] = line[j];
+        }
+      }
+    }
+  }
+
+} // namespace quda
+
+#endif
@@ -311,6 +311,14 @@ void printQudaInvertParam(QudaInvertParam *param) {
     param->cuda_prec_precondition = param->cuda_prec_sloppy;
 #endif
 
+#if defined INIT_PARAM
+  for (int i=0; i<QUDA_MAX_MULTI_SHIFT; i++) P(cuda_prec_offset[i], QUDA_INVALID_PRECISION);
+#else
+  for (int i=0; i<param->num_offset; i++)
+    if (param->cuda_prec_offset[i] == QUDA_INVALID_PRECISION)
+      param->cuda_prec_offset[i] = param->cuda_prec_sloppy;
+#endif
+
   P(gamma_basis, QUDA_INVALID_GAMMA_BASIS);
   P(dirac_order, QUDA_INVALID_DIRAC_ORDER);
   P(sp_pad, INVALID_INT);
@@ -525,6 +533,16 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(setup_tol[i], 5e-6);
 #else
     P(setup_tol[i], INVALID_DOUBLE);
+#endif
+#ifdef INIT_PARAM
+    P(setup_maxiter[i], 0);
+#else
+    P(setup_maxiter[i], INVALID_INT);
+#endif
+#ifdef INIT_PARAM
+    P(setup_maxiter_refresh[i], 0);
+#else
+    P(setup_maxiter_refresh[i], INVALID_INT);
 #endif
     P(smoother[i], QUDA_INVALID_INVERTER);
     P(smoother_solve_type[i], QUDA_INVALID_SOLVE);
@@ -546,6 +564,15 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(mu_factor[i], INVALID_DOUBLE);
 #endif
     P(smoother_tol[i], INVALID_DOUBLE);
+#ifdef INIT_PARAM
+    P(coarse_solver_tol[i], 0.25);
+    P(coarse_solver_maxiter[i], 2);
+    P(coarse_link_precision[i], QUDA_SINGLE_PRECISION);
+#else
+    P(coarse_solver_tol[i], INVALID_DOUBLE);
+    P(coarse_solver_maxiter[i], INVALID_INT);
+    P(coarse_link_precision[i], QUDA_INVALID_PRECISION);
+#endif
 #ifdef INIT_PARAM
     P(global_reduction[i], QUDA_BOOLEAN_YES);
 #else
@@ -587,6 +614,88 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 }
 
 
+// define the appropriate function for IntegratorParam
+
+#if defined INIT_PARAM
+QudaIntegratorParam newQudaIntegratorParam(void) {
+  QudaIntegratorParam ret;
+#elif defined CHECK_PARAM
+static void checkIntegratorParam(QudaIntegratorParam *param) {
+#else
+void printQudaIntegratorParam(QudaIntegratorParam *param) {
+  printfQuda("QUDA Integrator Parameters:\n");
+#endif
+
+  P(n_level, INVALID_INT);
+
+#ifdef INIT_PARAM
+  int n_level = QUDA_MAX_INTEGRATOR_LEVEL;
+#else
+  int n_level = param->n_level;
+#endif
+
+#ifdef CHECK_PARAM
+  if (n_level < 1 || n_level > QUDA_MAX_INTEGRATOR_LEVEL)
+    errorQuda("n_level = %d out of range [1, %d]", n_level, QUDA_MAX_INTEGRATOR_LEVEL);
+#endif
+
+  for (int i=0; i<n_level; i++) {
+    P(integrator[i], QUDA_INVALID_INTEGRATOR);
+    P(n_step[i], INVALID_INT);
+#ifdef INIT_PARAM
+    P(n_term[i], 0);
+    ret.term[i] = NULL;
+#else
+    P(n_term[i], INVALID_INT);
+#endif
+#ifdef CHECK_PARAM
+    if (param->n_step[i] < 1) errorQuda("n_step[%d] = %d must be positive", i, param->n_step[i]);
+    if (param->n_term[i] > 0 && !param->term[i]) errorQuda("term[%d] not set", i);
+    for (int j=0; j<param->n_term[i]; j++) {
+      const QudaForceTerm &t = param->term[i][j];
+      if (t.type == QUDA_GAUGE_FORCE_TERM) {
+	if (!t.input_path_buf || !t.path_length || !t.loop_coeff)
+	  errorQuda("Gauge force term %d of level %d has no loops", j, i);
+      } else if (t.type == QUDA_CALLBACK_FORCE_TERM) {
+	if (!t.callback) errorQuda("Callback force term %d of level %d has no callback", j, i);
+      } else {
+	errorQuda("Force term %d of level %d has invalid type %d", j, i, t.type);
+      }
+    }
+#endif
+  }
+
+  P(tau, INVALID_DOUBLE);
+
+#ifdef INIT_PARAM
+  P(lambda, 0.1931833275037836);
+  P(mom_action[0], 0.0);
+  P(mom_action[1], 0.0);
+  P(gauge_action[0], 0.0);
+  P(gauge_action[1], 0.0);
+  P(n_force[0], 0);
+  P(n_force[1], 0);
+  P(secs, 0.0);
+#else
+  P(lambda, INVALID_DOUBLE);
+#endif
+
+#if defined(PRINT_PARAM)
+  P(mom_action[0], INVALID_DOUBLE);
+  P(mom_action[1], INVALID_DOUBLE);
+  P(gauge_action[0], INVALID_DOUBLE);
+  P(gauge_action[1], INVALID_DOUBLE);
+  P(n_force[0], INVALID_INT);
+  P(n_force[1], INVALID_INT);
+  P(secs, INVALID_DOUBLE);
+#endif
+
+#ifdef INIT_PARAM
+  return ret;
+#endif
+}
+
+
 // clean up
 
 #undef INVALID_INT
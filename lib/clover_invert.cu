@@ -5,6 +5,7 @@
 #include <face_quda.h>
 #include <atomic.cuh>
 #include <cub_helper.cuh>
+#include <quda_matrix_soa.h>
 
 namespace quda {
 
@@ -29,15 +30,15 @@ namespace quda {
      Use a Cholesky decomposition to invert the clover matrix
      Here we use an inplace inversion which hopefully reduces register pressure
    */
-  template <int blockSize, typename Float, typename Clover, bool computeTrLog, bool twist>
-  __device__ __host__ inline double cloverInvertCompute(CloverInvertArg<Clover> arg, int x, int parity) {
+  template <typename Float, typename Clover, bool computeTrLog, bool twist>
+  __device__ __host__ inline double cloverInvertSite(Clover &inverse, const Clover &clover, double mu2, int x, int parity) {
 
     double trlogA = 0.0;
 
     for (int ch=0; ch<2; ch++) {
       Float A[36];
       // load the clover term into memory
-      arg.clover.load(A, x, parity, ch);
+      clover.load(A, x, parity, ch);
 
       Float diag[6];
       Float tmp[6]; // temporary storage
@@ -77,12 +78,12 @@ namespace quda {
          aux[14] = tri[14]*diag[4]+diag[5]*tri[14]+tri[10]*conj(tri[6])+tri[11]*conj(tri[7])+tri[12]*conj(tri[8])+tri[13]*conj(tri[9]);
 
          //update diagonal elements:
-         diag[0] = (Float)arg.mu2+diag[0]*diag[0]+norm(tri[ 0])+norm(tri[ 1])+norm(tri[ 3])+norm(tri[ 6])+norm(tri[10]);
-         diag[1] = (Float)arg.mu2+diag[1]*diag[1]+norm(tri[ 0])+norm(tri[ 2])+norm(tri[ 4])+norm(tri[ 7])+norm(tri[11]); 
-         diag[2] = (Float)arg.mu2+diag[2]*diag[2]+norm(tri[ 1])+norm(tri[ 2])+norm(tri[ 5])+norm(tri[ 8])+norm(tri[12]); 
-         diag[3] = (Float)arg.mu2+diag[3]*diag[3]+norm(tri[ 3])+norm(tri[ 4])+norm(tri[ 5])+norm(tri[ 9])+norm(tri[13]); 
-         diag[4] = (Float)arg.mu2+diag[4]*diag[4]+norm(tri[ 6])+norm(tri[ 7])+norm(tri[ 8])+norm(tri[ 9])+norm(tri[14]);
-         diag[5] = (Float)arg.mu2+diag[5]*diag[5]+norm(tri[10])+norm(tri[11])+norm(tri[12])+norm(tri[13])+norm(tri[14]);
+         diag[0] = (Float)mu2+diag[0]*diag[0]+norm(tri[ 0])+norm(tri[ 1])+norm(tri[ 3])+norm(tri[ 6])+norm(tri[10]);
+         diag[1] = (Float)mu2+diag[1]*diag[1]+norm(tri[ 0])+norm(tri[ 2])+norm(tri[ 4])+norm(tri[ 7])+norm(tri[11]); 
+         diag[2] = (Float)mu2+diag[2]*diag[2]+norm(tri[ 1])+norm(tri[ 2])+norm(tri[ 5])+norm(tri[ 8])+norm(tri[12]); 
+         diag[3] = (Float)mu2+diag[3]*diag[3]+norm(tri[ 3])+norm(tri[ 4])+norm(tri[ 5])+norm(tri[ 9])+norm(tri[13]); 
+         diag[4] = (Float)mu2+diag[4]*diag[4]+norm(tri[ 6])+norm(tri[ 7])+norm(tri[ 8])+norm(tri[ 9])+norm(tri[14]);
+         diag[5] = (Float)mu2+diag[5]*diag[5]+norm(tri[10])+norm(tri[11])+norm(tri[12])+norm(tri[13])+norm(tri[14]);
 
 	 //update off-diagonal elements:
          for(int i = 0; i < 15; i++) tri[i] = aux[i];
@@ -152,12 +153,17 @@ namespace quda {
       for (int i=0; i<15; i++) { A[6+2*i] = half*tri[idtab[i]].real(); A[6+2*i+1] = half*tri[idtab[i]].imag(); }
 
       // save the inverted matrix
-      arg.inverse.save(A, x, parity, ch);
+      inverse.save(A, x, parity, ch);
     }
 
     return trlogA;
   }
 
+  template <int blockSize, typename Float, typename Clover, bool computeTrLog, bool twist>
+  __device__ __host__ inline double cloverInvertCompute(CloverInvertArg<Clover> &arg, int x, int parity) {
+    return cloverInvertSite<Float,Clover,computeTrLog,twist>(arg.inverse, arg.clover, arg.mu2, x, parity);
+  }
+
   template <int blockSize, typename Float, typename Clover, bool computeTrLog, bool twist>
   void cloverInvert(CloverInvertArg<Clover> arg) {  
     for (int parity=0; parity<2; parity++) {
@@ -172,6 +178,173 @@ namespace quda {
     }
   }
 
+  /**
+     Host inversion of host_simd_width consecutive sites of one
+     parity.  This is the same Cholesky factorization and forward and
+     backward substitution as cloverInvertSite, but with the batch held
+     as structure of arrays (real and imaginary parts split) so that
+     every step vectorizes across the sites.  Lanes beyond the end of
+     the checkerboard are padded with the identity and discarded.
+   */
+  template <typename Float, typename Clover, bool computeTrLog>
+  double cloverInvertBatchHost(Clover &inverse, const Clover &clover, int x0, int parity) {
+    constexpr int W = host_simd_width;
+    const int n = clover.volumeCB - x0 < W ? clover.volumeCB - x0 : W;
+    const int idtab[15]={0,1,3,6,10,2,4,7,11,5,8,12,9,13,14};
+    double trlogA = 0.0;
+
+    for (int ch=0; ch<2; ch++) {
+      Float diag[6][W], tmp[6][W];
+      Float tr[15][W], ti[15][W];
+
+      for (int w=0; w<W; w++) {
+	Float A[36];
+	if (w < n) {
+	  clover.load(A, x0+w, parity, ch);
+	} else {
+	  for (int i=0; i<36; i++) A[i] = i<6 ? 0.5 : 0.0;
+	}
+	for (int i=0; i<6; i++) diag[i][w] = 2.0*A[i];
+	for (int i=0; i<15; i++) { tr[idtab[i]][w] = 2.0*A[6+2*i]; ti[idtab[i]][w] = 2.0*A[6+2*i+1]; }
+      }
+
+      for (int j=0; j<6; j++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) {
+	  diag[j][w] = sqrt(diag[j][w]);
+	  tmp[j][w] = 1.0 / diag[j][w];
+	}
+
+	for (int k=j+1; k<6; k++) {
+	  int kj = k*(k-1)/2+j;
+#pragma omp simd
+	  for (int w=0; w<W; w++) { tr[kj][w] *= tmp[j][w]; ti[kj][w] *= tmp[j][w]; }
+	}
+
+	for (int k=j+1; k<6; k++) {
+	  int kj = k*(k-1)/2+j;
+#pragma omp simd
+	  for (int w=0; w<W; w++) diag[k][w] -= tr[kj][w]*tr[kj][w] + ti[kj][w]*ti[kj][w];
+	  for (int l=k+1; l<6; l++) {
+	    int lj = l*(l-1)/2+j;
+	    int lk = l*(l-1)/2+k;
+	    // tri[lk] -= tri[lj] * conj(tri[kj])
+#pragma omp simd
+	    for (int w=0; w<W; w++) {
+	      tr[lk][w] -= tr[lj][w]*tr[kj][w] + ti[lj][w]*ti[kj][w];
+	      ti[lk][w] -= ti[lj][w]*tr[kj][w] - tr[lj][w]*ti[kj][w];
+	    }
+	  }
+	}
+      }
+
+      if (computeTrLog)
+	for (int w=0; w<n; w++)
+	  for (int j=0; j<6; j++) trlogA += 2.0*log((double)diag[j][w]);
+
+      Float vr[6][W], vi[6][W];
+      for (int k=0; k<6; k++) {
+	for (int l=0; l<k; l++) {
+#pragma omp simd
+	  for (int w=0; w<W; w++) { vr[l][w] = 0.0; vi[l][w] = 0.0; }
+	}
+
+	// forward substitute
+#pragma omp simd
+	for (int w=0; w<W; w++) { vr[k][w] = tmp[k][w]; vi[k][w] = 0.0; }
+	for (int l=k+1; l<6; l++) {
+	  Float sr[W], si[W];
+#pragma omp simd
+	  for (int w=0; w<W; w++) { sr[w] = 0.0; si[w] = 0.0; }
+	  for (int j=k; j<l; j++) {
+	    int lj = l*(l-1)/2+j;
+#pragma omp simd
+	    for (int w=0; w<W; w++) {
+	      sr[w] -= tr[lj][w]*vr[j][w] - ti[lj][w]*vi[j][w];
+	      si[w] -= tr[lj][w]*vi[j][w] + ti[lj][w]*vr[j][w];
+	    }
+	  }
+#pragma omp simd
+	  for (int w=0; w<W; w++) { vr[l][w] = sr[w]*tmp[l][w]; vi[l][w] = si[w]*tmp[l][w]; }
+	}
+
+	// backward substitute
+#pragma omp simd
+	for (int w=0; w<W; w++) { vr[5][w] *= tmp[5][w]; vi[5][w] *= tmp[5][w]; }
+	for (int l=4; l>=k; l--) {
+	  Float sr[W], si[W];
+#pragma omp simd
+	  for (int w=0; w<W; w++) { sr[w] = vr[l][w]; si[w] = vi[l][w]; }
+	  for (int j=l+1; j<6; j++) {
+	    int jl = j*(j-1)/2+l;
+	    // sum -= conj(tri[jl]) * v1[j]
+#pragma omp simd
+	    for (int w=0; w<W; w++) {
+	      sr[w] -= tr[jl][w]*vr[j][w] + ti[jl][w]*vi[j][w];
+	      si[w] -= tr[jl][w]*vi[j][w] - ti[jl][w]*vr[j][w];
+	    }
+	  }
+#pragma omp simd
+	  for (int w=0; w<W; w++) { vr[l][w] = sr[w]*tmp[l][w]; vi[l][w] = si[w]*tmp[l][w]; }
+	}
+
+	// overwrite column k
+#pragma omp simd
+	for (int w=0; w<W; w++) diag[k][w] = vr[k][w];
+	for (int l=k+1; l<6; l++) {
+	  int lk = l*(l-1)/2+k;
+#pragma omp simd
+	  for (int w=0; w<W; w++) { tr[lk][w] = vr[l][w]; ti[lk][w] = vi[l][w]; }
+	}
+      }
+
+      for (int w=0; w<n; w++) {
+	Float A[36];
+	for (int i=0; i<6; i++) A[i] = 0.5*diag[i][w];
+	for (int i=0; i<15; i++) { A[6+2*i] = 0.5*tr[idtab[i]][w]; A[6+2*i+1] = 0.5*ti[idtab[i]][w]; }
+	inverse.save(A, x0+w, parity, ch);
+      }
+    }
+
+    return trlogA;
+  }
+
+  /**
+     Threaded host clover inversion.  Untwisted fields are inverted in
+     batches of host_simd_width sites, twisted fields (which first
+     form T^2 + mu^2) site by site.  The trace log is accumulated
+     through hostReduce so that it is independent of the thread count.
+   */
+  template <typename Float, typename Clover>
+  void cloverInvertHost(Clover inverse, const Clover clover, bool computeTraceLog, double* const trlog) {
+    const int volumeCB = clover.volumeCB;
+    const bool twist = clover.Twisted();
+    const double mu2 = clover.Mu2();
+    const int nBlock = twist ? volumeCB : (volumeCB + host_simd_width - 1) / host_simd_width;
+
+    double2 result = hostReduce<double2>(2*nBlock, [&](int i) {
+	const int parity = i / nBlock;
+	const int b = i % nBlock;
+	double trlogA;
+	if (twist) {
+	  trlogA = computeTraceLog ?
+	    cloverInvertSite<Float,Clover,true,true>(inverse, clover, mu2, b, parity) :
+	    cloverInvertSite<Float,Clover,false,true>(inverse, clover, mu2, b, parity);
+	} else {
+	  trlogA = computeTraceLog ?
+	    cloverInvertBatchHost<Float,Clover,true>(inverse, clover, b*host_simd_width, parity) :
+	    cloverInvertBatchHost<Float,Clover,false>(inverse, clover, b*host_simd_width, parity);
+	}
+	return parity ? make_double2(0.0, trlogA) : make_double2(trlogA, 0.0);
+      });
+
+    if (computeTraceLog) {
+      comm_allreduce_array((double*)&result, 2);
+      trlog[0] = result.x;
+      trlog[1] = result.y;
+    }
+  }
+
   template <int blockSize, typename Float, typename Clover, bool computeTrLog, bool twist>
   __launch_bounds__(2*blockSize)
   __global__ void cloverInvertKernel(CloverInvertArg<Clover> arg) {  
@@ -267,7 +440,12 @@ namespace quda {
   template <typename Float>
   void cloverInvert(const CloverField &clover, bool computeTraceLog, QudaFieldLocation location) {
 
-    if (clover.isNative()) {
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      if (clover.Order() != QUDA_PACKED_CLOVER_ORDER)
+	errorQuda("Clover field order %d not supported on the host", clover.Order());
+      typedef clover::QDPOrder<Float,72> C;
+      cloverInvertHost<Float>(C(clover, 1), C(clover, 0), computeTraceLog, clover.TrLog());
+    } else if (clover.isNative()) {
       typedef typename clover_mapper<Float>::type C;
       cloverInvert<Float>(C(clover, 1), C(clover, 0), computeTraceLog,
 			  clover.TrLog(), clover, location);
@@ -153,6 +153,7 @@ namespace quda {
 
   template<typename Float, typename Clover, typename Fmunu>
   void cloverComputeCPU(CloverArg<Float,Clover,Fmunu> arg){
+#pragma omp parallel for
       for(int idx=0; idx<arg.threads; ++idx){
         cloverComputeCore(arg, idx);
       }
@@ -205,13 +206,24 @@ namespace quda {
     CloverArg<Float,Clover,Fmunu> arg(clover, f, meta, cloverCoeff);
     CloverCompute<Float,Clover,Fmunu> cloverCompute(arg, meta, location);
     cloverCompute.apply(0);
-    checkCudaError();
-    cudaDeviceSynchronize();
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      checkCudaError();
+      cudaDeviceSynchronize();
+    }
   }
 
   template<typename Float>
   void computeClover(CloverField &clover, const GaugeField &f, Float cloverCoeff, QudaFieldLocation location){
-    if (f.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      if (clover.Order() != QUDA_PACKED_CLOVER_ORDER)
+	errorQuda("Clover field order %d not supported on the host", clover.Order());
+      typedef clover::QDPOrder<Float,72> C;
+      if (f.Order() == QUDA_MILC_GAUGE_ORDER) {
+	computeClover(C(clover,0), gauge::MILCOrder<Float,18>(f), f, cloverCoeff, location);
+      } else {
+	errorQuda("Fmunu field order %d not supported on the host", f.Order());
+      }
+    } else if (f.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
       if (clover.isNative()) {
 	typedef typename clover_mapper<Float>::type C;
 	computeClover(C(clover,0), gauge::FloatNOrder<Float,18,2,18>(f), f, cloverCoeff, location);  
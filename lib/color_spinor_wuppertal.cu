@@ -8,17 +8,34 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#include <blas_quda.h>
+#include <algorithm>
 
 namespace quda {
 
-  template <typename Float, int Ns, int Nc, QudaReconstructType gRecon>
+  // maximum number of vectors smeared per pass, e.g., the spin-color columns of a propagator
+  static constexpr int max_wuppertal_vec = 12;
+
+  /**
+     @brief Parameter structure for driving the Wuppertal smearing
+     kernel.  Up to max_vec vectors are smeared in a single pass, such
+     that the links of each site are only loaded once.  The out and in
+     accessors are repointed at each vector in turn from the stored
+     per-vector field and ghost pointers.
+   */
+  template <typename Float, int Ns, int Nc, typename F_, typename G_>
   struct WuppertalSmearingArg {
-    typedef typename colorspinor_mapper<Float,Ns,Nc>::type F;
-    typedef typename gauge_mapper<Float,gRecon>::type G;
+    typedef F_ F;
+    typedef G_ G;
+    static constexpr int max_vec = max_wuppertal_vec;
 
-    F out;                // output vector field
-    const F in;           // input vector field
+    F out;                // output vector field accessor
+    F in;                 // input vector field accessor
     const G U;            // the gauge field
+    Float *out_v[max_vec];       // output field of each vector
+    Float *in_v[max_vec];        // input field of each vector
+    Float *in_ghost[max_vec][8]; // input ghost zones of each vector
+    const int nVec;       // number of vectors we are smearing
     const Float A;        // A parameter
     const Float B;        // B parameter
     const int parity;     // only use this for single parity fields
@@ -28,36 +45,38 @@ namespace quda {
     const int commDim[4]; // whether a given dimension is partitioned or not
     const int volumeCB;   // checkerboarded volume
 
-    WuppertalSmearingArg(ColorSpinorField &out, const ColorSpinorField &in, int parity, const GaugeField &U,
-                       Float A, Float B)
-      : out(out), in(in), U(U), A(A), B(B), parity(parity), nParity(in.SiteSubset()), nFace(1),
-        dim{ (3-nParity) * in.X(0), in.X(1), in.X(2), in.X(3), 1 },
+    WuppertalSmearingArg(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			 int parity, const GaugeField &U, Float A, Float B)
+      : out(*out[0]), in(*in[0]), U(U), nVec(in.size()), A(A), B(B), parity(parity), nParity(in[0]->SiteSubset()), nFace(1),
+        dim{ (3-nParity) * in[0]->X(0), in[0]->X(1), in[0]->X(2), in[0]->X(3), 1 },
       commDim{comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3)},
-      volumeCB(in.VolumeCB())
+      volumeCB(in[0]->VolumeCB())
     {
-      if (in.FieldOrder() != QUDA_FLOAT2_FIELD_ORDER || !U.isNative())
-        errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in.FieldOrder(), U.FieldOrder());
+      if (nVec > max_vec) errorQuda("Number of vectors %d exceeds maximum %d", nVec, max_vec);
+      for (int v=0; v<nVec; v++) {
+	out_v[v] = static_cast<Float*>(out[v]->V());
+	in_v[v] = static_cast<Float*>(in[v]->V());
+	for (int i=0; i<8; i++) in_ghost[v][i] = static_cast<Float*>(in[v]->Ghost()[i]);
+      }
     }
   };
 
   /**
      Computes out = sum_mu U_mu(x)in(x+d) + U^\dagger_mu(x-d)in(x-d)
      @param[out] out The out result field
-     @param[in] U The gauge field
-     @param[in] in The input field
-     @param[in] x_cb The checkerboarded site index
+     @param[in] arg Kernel argument holding the geometry
+     @param[in] in Accessor of the input field
+     @param[in] Ufwd The forward links U_mu(x)
+     @param[in] Uback The backward links U_mu(x-d)
+     @param[in] coord The site coordinates
      @param[in] parity The site parity
   */
-  template <typename Float, int Nc, typename Vector, typename Arg>
-  __device__ __host__ inline void computeNeighborSum(Vector &out, Arg &arg, int x_cb, int parity) {
+  template <typename Float, int Nc, typename Vector, typename Link, typename F, typename Arg>
+  __device__ __host__ inline void computeNeighborSum(Vector &out, const Arg &arg, const F &in,
+						     const Link Ufwd[3], const Link Uback[3], const int coord[5], int parity) {
 
-    typedef Matrix<complex<Float>,Nc> Link;
     const int their_spinor_parity = (arg.nParity == 2) ? 1-parity : 0;
 
-    int coord[5];
-    getCoords(coord, x_cb, arg.dim, parity);
-    coord[4] = 0;
-
 #pragma unroll
     for (int dir=0; dir<3; dir++) { // loop over spatial directions
 
@@ -66,52 +85,67 @@ namespace quda {
 
       if ( arg.commDim[dir] && (coord[dir] + arg.nFace >= arg.dim[dir]) ) {
         const int ghost_idx = ghostFaceIndex<1>(coord, arg.dim, dir, arg.nFace);
-
-        const Link U = arg.U(dir, x_cb, parity);
-	const Vector in = arg.in.Ghost(dir, 1, ghost_idx, their_spinor_parity);
-
-        out += U * in;
+	const Vector x = in.Ghost(dir, 1, ghost_idx, their_spinor_parity);
+        out += Ufwd[dir] * x;
       } else {
-        const Link U = arg.U(dir, x_cb, parity);
-	const Vector in = arg.in(fwd_idx, their_spinor_parity);
-
-        out += U * in;
+	const Vector x = in(fwd_idx, their_spinor_parity);
+        out += Ufwd[dir] * x;
       }
 
-      //Backward gather - compute back offset for spinor and gauge fetch
+      //Backward gather - compute back offset for spinor fetch
       const int back_idx = linkIndexM1(coord, arg.dim, dir);
-      const int gauge_idx = back_idx;
 
       if ( arg.commDim[dir] && (coord[dir] - arg.nFace < 0) ) {
         const int ghost_idx = ghostFaceIndex<0>(coord, arg.dim, dir, arg.nFace);
-
-        const Link U = arg.U.Ghost(dir, ghost_idx, 1-parity);
-	const Vector in = arg.in.Ghost(dir, 0, ghost_idx, their_spinor_parity);
-
-        out += conj(U) * in;
+	const Vector x = in.Ghost(dir, 0, ghost_idx, their_spinor_parity);
+        out += conj(Uback[dir]) * x;
       } else {
-        const Link U = arg.U(dir, gauge_idx, 1-parity);
-	const Vector in = arg.in(back_idx, their_spinor_parity);
-
-        out += conj(U) * in;
+	const Vector x = in(back_idx, their_spinor_parity);
+        out += conj(Uback[dir]) * x;
       }
     }
   }
 
   //out(x) = A in(x) + B computeNeighborSum(out, x)
+  //The six spatial links of the site are loaded once and applied to every vector
   template <typename Float, int Ns, int Nc, typename Arg>
   __device__ __host__ inline void computeWupperalStep(Arg &arg, int x_cb, int parity)
   {
     typedef ColorSpinor<Float,Nc,Ns> Vector;
-    Vector out;
+    typedef Matrix<complex<Float>,Nc> Link;
+    const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+
+    int coord[5];
+    getCoords(coord, x_cb, arg.dim, parity);
+    coord[4] = 0;
+
+    Link Ufwd[3], Uback[3];
+#pragma unroll
+    for (int dir=0; dir<3; dir++) {
+      Ufwd[dir] = arg.U(dir, x_cb, parity);
+      if ( arg.commDim[dir] && (coord[dir] - arg.nFace < 0) ) {
+	const int ghost_idx = ghostFaceIndex<0>(coord, arg.dim, dir, arg.nFace);
+	Uback[dir] = arg.U.Ghost(dir, ghost_idx, 1-parity);
+      } else {
+	Uback[dir] = arg.U(dir, linkIndexM1(coord, arg.dim, dir), 1-parity);
+      }
+    }
+
+    for (int v=0; v<arg.nVec; v++) {
+      // point the accessors at this vector
+      typename Arg::F in = arg.in;
+      in.field = arg.in_v[v];
+#pragma unroll
+      for (int i=0; i<8; i++) in.ghost[i] = arg.in_ghost[v][i];
+      typename Arg::F out = arg.out;
+      out.field = arg.out_v[v];
 
-    computeNeighborSum<Float,Nc>(out, arg, x_cb, parity);
+      Vector sum;
+      computeNeighborSum<Float,Nc>(sum, arg, in, Ufwd, Uback, coord, parity);
 
-    Vector in;
-    arg.in.load((Float*)in.data, x_cb, parity);
-    out = arg.A*in + arg.B*out;
-    
-    arg.out(x_cb, parity) = out;
+      Vector x = in(x_cb, my_spinor_parity);
+      out(x_cb, my_spinor_parity) = arg.A*x + arg.B*sum;
+    }
   }
 
   // CPU kernel for applying a wuppertal smearing step to a vector
@@ -123,6 +157,7 @@ namespace quda {
       // for full fields then set parity from loop else use arg setting
       parity = (arg.nParity == 2) ? parity : arg.parity;
 
+#pragma omp parallel for
       for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
         computeWupperalStep<Float,Ns,Nc>(arg, x_cb, parity);
       } // 4-d volumeCB
@@ -155,11 +190,11 @@ namespace quda {
 
     long long flops() const
     {
-      return (2*3*Ns*Nc*(8*Nc-2) + 2*3*Nc*Ns )*arg.nParity*(long long)meta.VolumeCB();
+      return (2*3*Ns*Nc*(8*Nc-2) + 2*3*Nc*Ns )*arg.nVec*arg.nParity*(long long)meta.VolumeCB();
     }
     long long bytes() const
     {
-      return arg.out.Bytes() + (2*3+1)*arg.in.Bytes() + arg.nParity*2*3*arg.U.Bytes()*meta.VolumeCB();
+      return (arg.out.Bytes() + (2*3+1)*arg.in.Bytes())*arg.nVec + arg.nParity*2*3*arg.U.Bytes()*meta.VolumeCB();
     }
     bool tuneGridDim() const { return false; }
     unsigned int minThreads() const { return arg.volumeCB; }
@@ -170,6 +205,9 @@ namespace quda {
     {
       strcpy(aux, meta.AuxString());
       strcat(aux, comm_dim_partitioned_string());
+      char nvec[8];
+      sprintf(nvec, ",nvec=%d", arg.nVec);
+      strcat(aux, nvec);
     }
     virtual ~WuppertalSmearing() { }
 
@@ -185,18 +223,41 @@ namespace quda {
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
   };
 
-  template<typename Float, int Ns, int Nc, QudaReconstructType gRecon>
-  void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity,
+  template<typename Float, int Ns, int Nc, typename F, typename G>
+  void wuppertalStep(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
 		     const GaugeField& U, double A, double B)
   {
-    WuppertalSmearingArg<Float,Ns,Nc,gRecon> arg(out, in, parity, U, A, B);
-    WuppertalSmearing<Float,Ns,Nc,WuppertalSmearingArg<Float,Ns,Nc,gRecon> > wuppertal(arg, in);
+    WuppertalSmearingArg<Float,Ns,Nc,F,G> arg(out, in, parity, U, A, B);
+    WuppertalSmearing<Float,Ns,Nc,WuppertalSmearingArg<Float,Ns,Nc,F,G> > wuppertal(arg, *in[0]);
     wuppertal.apply(0);
   }
 
+  // template on the field orders
+  template<typename Float, int Ns, int Nc, QudaReconstructType gRecon>
+  void wuppertalStep(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
+		     const GaugeField& U, double A, double B)
+  {
+    if (in[0]->isNative() && U.isNative()) {
+      typedef typename colorspinor_mapper<Float,Ns,Nc>::type F;
+      typedef typename gauge_mapper<Float,gRecon>::type G;
+      wuppertalStep<Float,Ns,Nc,F,G>(out, in, parity, U, A, B);
+    } else if (in[0]->FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && gRecon == QUDA_RECONSTRUCT_NO) {
+      typedef typename colorspinor::SpaceSpinorColorOrder<Float,Ns,Nc> F;
+      if (U.Order() == QUDA_QDP_GAUGE_ORDER) {
+	wuppertalStep<Float,Ns,Nc,F,gauge::QDPOrder<Float,2*Nc*Nc> >(out, in, parity, U, A, B);
+      } else if (U.Order() == QUDA_MILC_GAUGE_ORDER) {
+	wuppertalStep<Float,Ns,Nc,F,gauge::MILCOrder<Float,2*Nc*Nc> >(out, in, parity, U, A, B);
+      } else {
+	errorQuda("Unsupported gauge field order %d", U.Order());
+      }
+    } else {
+      errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in[0]->FieldOrder(), U.FieldOrder());
+    }
+  }
+
   // template on the gauge reconstruction
   template<typename Float, int Ns, int Nc>
-  void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity,
+  void wuppertalStep(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
 		     const GaugeField& U, double A, double B)
   {
     if (U.Reconstruct() == QUDA_RECONSTRUCT_NO) {
@@ -213,14 +274,10 @@ namespace quda {
 
   // template on the number of colors
   template<typename Float, int Ns>
-  void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity,
+  void wuppertalStep(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
 		     const GaugeField& U, double A, double B)
   {
-    if (out.Ncolor() != in.Ncolor()) {
-      errorQuda("Orign and destination fields must have the same number of colors\n");
-    }
-
-    if (out.Ncolor() == 3 ) {
+    if (in[0]->Ncolor() == 3 ) {
       wuppertalStep<Float,Ns,3>(out, in, parity, U, A, B);
     } else {
       errorQuda(" is not implemented for Ncolor!=3");
@@ -229,19 +286,76 @@ namespace quda {
 
   // template on the number of spins
   template<typename Float>
-  void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity,
+  void wuppertalStep(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
 		     const GaugeField& U, double A, double B)
   {
-    if(out.Nspin() != in.Nspin()) {
-      errorQuda("Orign and destination fields must have the same number of spins\n");
-    }
-
-    if (out.Nspin() == 4 ){
+    if (in[0]->Nspin() == 4 ){
       wuppertalStep<Float,4>(out, in, parity, U, A, B);
-    }else if (in.Nspin() == 1 ){
+    }else if (in[0]->Nspin() == 1 ){
       wuppertalStep<Float,1>(out, in, parity, U, A, B);
     }else{
-      errorQuda("Nspin %d not supported", out.Nspin());
+      errorQuda("Nspin %d not supported", in[0]->Nspin());
+    }
+  }
+
+  // template on the precision
+  static void wuppertalStepBatch(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+				 int parity, const GaugeField& U, double A, double B)
+  {
+    const int nFace = 1;
+    for (unsigned int v=0; v<in.size(); v++) in[v]->exchangeGhost((QudaParity)(1-parity), nFace, 0); // last parameter is dummy
+
+    if (in[0]->Precision() == QUDA_SINGLE_PRECISION){
+      wuppertalStep<float>(out, in, parity, U, A, B);
+    } else if(in[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      wuppertalStep<double>(out, in, parity, U, A, B);
+    } else {
+      errorQuda("Precision %d not supported", in[0]->Precision());
+    }
+  }
+
+  /**
+     Apply a generic Wuppertal smearing step to a set of vectors
+     Computes out(x) = A*in(x)  + B*\sum_mu (U_{-\mu}(x)in(x+mu) + U^\dagger_mu(x-mu)in(x-mu))
+     @param[out] out The out result fields
+     @param[in] in The in spinor fields
+     @param[in] U The gauge field
+     @param[in] A The scaling factor for in(x)
+     @param[in] B The scaling factor for \sum_mu (U_{-\mu}(x)in(x+mu) + U^\dagger_mu(x-mu)in(x-mu))
+  */
+  void wuppertalStep(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, int parity,
+		     const GaugeField& U, double A, double B)
+  {
+    if (in.size() != out.size()) errorQuda("Number of input %lu and output %lu vectors differ", in.size(), out.size());
+    if (in.size() == 0) return;
+
+    for (unsigned int v=0; v<in.size(); v++) {
+      if (in[v]->V() == out[v]->V()) errorQuda("Orign and destination fields must be different pointers");
+      if (out[v]->Ncolor() != in[v]->Ncolor()) errorQuda("Orign and destination fields must have the same number of colors\n");
+      if (out[v]->Nspin() != in[v]->Nspin()) errorQuda("Orign and destination fields must have the same number of spins\n");
+      if (in[v]->FieldOrder() != in[0]->FieldOrder() || out[v]->FieldOrder() != in[0]->FieldOrder())
+	errorQuda("Field order mismatch in = %d, out = %d", in[v]->FieldOrder(), out[v]->FieldOrder());
+
+      // check precisions match
+      checkPrecision(*out[v], *in[v], U);
+      checkPrecision(*in[v], *in[0]);
+
+      // check all locations match
+      checkLocation(*out[v], *in[v], U);
+    }
+
+    // device ghost zones share a single receive buffer, so with
+    // communication each vector has to be exchanged and smeared in turn
+    bool comms = false;
+    for (int d=0; d<4; d++) comms = comms || comm_dim_partitioned(d);
+    const int batch = (comms && in[0]->Location() == QUDA_CUDA_FIELD_LOCATION) ?
+      1 : max_wuppertal_vec;
+
+    for (unsigned int v=0; v<in.size(); v+=batch) {
+      const unsigned int end = std::min<unsigned int>(v+batch, in.size());
+      std::vector<ColorSpinorField*> out_batch(out.begin()+v, out.begin()+end);
+      std::vector<ColorSpinorField*> in_batch(in.begin()+v, in.begin()+end);
+      wuppertalStepBatch(out_batch, in_batch, parity, U, A, B);
     }
   }
 
@@ -254,31 +368,12 @@ namespace quda {
      @param[in] A The scaling factor for in(x)
      @param[in] B The scaling factor for \sum_mu (U_{-\mu}(x)in(x+mu) + U^\dagger_mu(x-mu)in(x-mu))
   */
-  // template on the precision
   void wuppertalStep(ColorSpinorField &out, const ColorSpinorField &in, int parity,
 		     const GaugeField& U, double A, double B)
   {
-    if (in.V() == out.V()) {
-      errorQuda("Orign and destination fields must be different pointers");
-    }
-
-    // check precisions match
-    checkPrecision(out, in, U);
-
-    // check all locations match
-    checkLocation(out, in, U);
-
-    const int nFace = 1;
-    in.exchangeGhost((QudaParity)(1-parity), nFace, 0); // last parameter is dummy
-
-    if (out.Precision() == QUDA_SINGLE_PRECISION){
-      wuppertalStep<float>(out, in, parity, U, A, B);
-    } else if(out.Precision() == QUDA_DOUBLE_PRECISION) {
-      wuppertalStep<double>(out, in, parity, U, A, B);
-    } else {
-      errorQuda("Precision %d not supported", out.Precision());
-    }
-    return;
+    std::vector<ColorSpinorField*> out_(1, &out);
+    std::vector<ColorSpinorField*> in_(1, const_cast<ColorSpinorField*>(&in));
+    wuppertalStep(out_, in_, parity, U, A, B);
   }
 
   /**
@@ -293,4 +388,45 @@ namespace quda {
   {
     wuppertalStep(out, in, parity, U, 1./(1.+6.*alpha), alpha/(1.+6.*alpha));
   }
+
+  /**
+     Apply nSteps standard Wuppertal smearing steps to a set of vectors,
+     alternating between out and tmp such that the final step lands in
+     out.  No fields are allocated or copied between steps.
+     @param[out] out The out result fields
+     @param[in] in The in spinor fields, left unchanged
+     @param[in,out] tmp Work fields of the same shape as out
+     @param[in] U The gauge field
+     @param[in] alpha The smearing parameter
+     @param[in] nSteps The number of smearing steps
+  */
+  void wuppertalSmear(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+		      std::vector<ColorSpinorField*> &tmp, int parity, const GaugeField& U, double alpha, int nSteps)
+  {
+    if (nSteps > 1 && tmp.size() != out.size()) errorQuda("Number of work %lu and output %lu vectors differ", tmp.size(), out.size());
+
+    if (nSteps <= 0) {
+      for (unsigned int v=0; v<in.size(); v++) blas::copy(*out[v], *in[v]);
+      return;
+    }
+
+    const double A = 1./(1.+6.*alpha);
+    const double B = alpha/(1.+6.*alpha);
+
+    const std::vector<ColorSpinorField*> *src = &in;
+    for (int i=0; i<nSteps; i++) {
+      std::vector<ColorSpinorField*> &dst = ((nSteps - i) % 2 == 1) ? out : tmp;
+      wuppertalStep(dst, *src, parity, U, A, B);
+      src = &dst;
+    }
+  }
+
+  void wuppertalSmear(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &tmp,
+		      int parity, const GaugeField& U, double alpha, int nSteps)
+  {
+    std::vector<ColorSpinorField*> out_(1, &out);
+    std::vector<ColorSpinorField*> in_(1, const_cast<ColorSpinorField*>(&in));
+    std::vector<ColorSpinorField*> tmp_(1, &tmp);
+    wuppertalSmear(out_, in_, tmp_, parity, U, alpha, nSteps);
+  }
 } // namespace quda
@@ -0,0 +1,353 @@
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <color_spinor_field_order.h>
+#include <gamma.cuh>
+#include <comm_quda.h>
+#include <contractQuda.h>
+#include <algorithm>
+
+namespace quda {
+
+#ifdef GPU_CONTRACT
+
+  // number of fixed partitions of each time slice, the partial sums of
+  // which are added in order so the result does not depend on the
+  // number of threads
+  static constexpr int contract_chunks = 64;
+
+  /**
+     @brief A product of gamma matrices has a single non-zero element
+     per row, so it is stored as the column and value of that element
+   */
+  struct SpinMonomial {
+    int col[4];
+    complex<double> elem[4];
+
+    SpinMonomial() { for (int i=0; i<4; i++) { col[i] = i; elem[i] = 1.0; } }
+
+    template <typename G> SpinMonomial(const G &g) {
+      for (int i=0; i<4; i++) elem[i] = g.getrowelem(i, col[i]);
+    }
+
+    SpinMonomial operator*(const SpinMonomial &b) const {
+      SpinMonomial c;
+      for (int i=0; i<4; i++) {
+	c.col[i] = b.col[col[i]];
+	c.elem[i] = elem[i] * b.elem[col[i]];
+      }
+      return c;
+    }
+  };
+
+  template <QudaGammaBasis basis> static void gammaMatrices(SpinMonomial gamma[5])
+  {
+    gamma[0] = SpinMonomial(Gamma<double,basis,0>());
+    gamma[1] = SpinMonomial(Gamma<double,basis,1>());
+    gamma[2] = SpinMonomial(Gamma<double,basis,2>());
+    gamma[3] = SpinMonomial(Gamma<double,basis,3>());
+    gamma[4] = SpinMonomial(Gamma<double,basis,4>());
+  }
+
+  /**
+     @brief Returns the gamma matrix with index g in the given basis,
+     gamma_1^{g&1} gamma_2^{(g>>1)&1} gamma_3^{(g>>2)&1} gamma_4^{(g>>3)&1},
+     such that g = 0 is the unit matrix and g = 15 is gamma_5 up to sign
+   */
+  static SpinMonomial gammaMonomial(QudaGammaBasis basis, int g)
+  {
+    SpinMonomial gamma[5];
+    if (basis == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) gammaMatrices<QUDA_DEGRAND_ROSSI_GAMMA_BASIS>(gamma);
+    else if (basis == QUDA_UKQCD_GAMMA_BASIS) gammaMatrices<QUDA_UKQCD_GAMMA_BASIS>(gamma);
+    else errorQuda("Gamma basis %d not supported", basis);
+
+    if (g == 16) return gamma[4]; // gamma_5 as defined in gamma.cuh
+    if (g < 0 || g > 16) errorQuda("Invalid gamma matrix index %d", g);
+    SpinMonomial m;
+    for (int mu=0; mu<4; mu++) if ((g >> mu) & 1) m = m * gamma[mu];
+    return m;
+  }
+
+  /**
+     @brief Geometry shared by the batched contractions: local and
+     global extents, the node offset and the momentum phase tables
+   */
+  struct ContractGeometry {
+    int X[4];
+    int L[4];
+    int offset[4];
+    int volumeS;
+    int nMom;
+    int xmax;
+    std::vector<complex<double> > phase; // [mom][dim][x] for the three spatial dimensions
+
+    ContractGeometry(const ColorSpinorField &meta, const std::vector<int> &mom)
+      : nMom(mom.size()/3)
+    {
+      if (meta.Ndim() != 4) errorQuda("Contractions require four-dimensional fields");
+      if (meta.SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Contractions require full fields");
+      for (int d=0; d<4; d++) {
+	X[d] = meta.X(d);
+	L[d] = X[d] * comm_dim(d);
+	offset[d] = X[d] * comm_coord(d);
+      }
+      volumeS = X[0] * X[1] * X[2];
+
+      xmax = std::max(X[0], std::max(X[1], X[2]));
+      phase.resize(nMom * 3 * xmax);
+      for (int p=0; p<nMom; p++) {
+	for (int d=0; d<3; d++) {
+	  for (int x=0; x<X[d]; x++) {
+	    double arg = -2.0 * M_PI * mom[3*p+d] * (x + offset[d]) / L[d];
+	    phase[(p*3 + d)*xmax + x] = complex<double>(cos(arg), sin(arg));
+	  }
+	}
+      }
+    }
+
+    inline complex<double> Phase(int p, const int x[4]) const {
+      return phase[(p*3+0)*xmax + x[0]] * phase[(p*3+1)*xmax + x[1]] * phase[(p*3+2)*xmax + x[2]];
+    }
+  };
+
+  /**
+     @brief Loads the 12x12 propagator matrix of a site, S[(alpha a)][(beta b)]
+     is spin-color component (alpha a) of the column (beta b)
+   */
+  template <typename Float, typename F>
+  inline void loadPropagator(complex<double> S[12][12], const std::vector<F> &prop, int parity, int x_cb)
+  {
+    for (int j=0; j<12; j++)
+      for (int s=0; s<4; s++)
+	for (int c=0; c<3; c++) {
+	  const complex<Float> &v = prop[j](parity, x_cb, s, c);
+	  S[s*3+c][j] = complex<double>(v.real(), v.imag());
+	}
+  }
+
+  /**
+     @brief Walks the sites of one local time slice, split into
+     contract_chunks fixed partitions, accumulating the per-site
+     results of f into one partial sum per chunk, which are then added
+     in order into corr.  Each chunk is given nScratch work elements.
+   */
+  template <typename Site>
+  void contractTimeSlices(std::vector<Complex> &corr, const ContractGeometry &geom, int nCorr, int nScratch, const Site &f)
+  {
+    const int Lt = geom.L[3];
+    const int nChunk = std::min(contract_chunks, geom.volumeS);
+    std::vector<complex<double> > partial((size_t)nChunk * nCorr);
+
+    for (int t=0; t<geom.X[3]; t++) {
+      std::fill(partial.begin(), partial.end(), complex<double>(0.0, 0.0));
+
+#pragma omp parallel for schedule(dynamic)
+      for (int chunk=0; chunk<nChunk; chunk++) {
+	std::vector<complex<double> > scratch(nScratch);
+	const int begin = (int)(((long long)geom.volumeS * chunk) / nChunk);
+	const int end = (int)(((long long)geom.volumeS * (chunk+1)) / nChunk);
+	for (int s=begin; s<end; s++) {
+	  int x[4] = { s % geom.X[0], (s / geom.X[0]) % geom.X[1], s / (geom.X[0] * geom.X[1]), t };
+	  const int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+	  const int x_cb = (s + t * geom.volumeS) >> 1;
+	  f(&partial[(size_t)chunk * nCorr], scratch.data(), x, parity, x_cb);
+	}
+      }
+
+      const int t_global = t + geom.offset[3];
+      for (int chunk=0; chunk<nChunk; chunk++)
+	for (int i=0; i<nCorr; i++) corr[(size_t)i * Lt + t_global] += Complex(partial[(size_t)chunk*nCorr+i].real(), partial[(size_t)chunk*nCorr+i].imag());
+    }
+
+    comm_allreduce_array(reinterpret_cast<double*>(corr.data()), 2 * corr.size());
+  }
+
+  template <typename Float, typename F>
+  void contractMesons(std::vector<Complex> &corr, const std::vector<ColorSpinorField*> &prop1, const std::vector<ColorSpinorField*> &prop2,
+		      const std::vector<int> &gamma_snk, const std::vector<int> &gamma_src, const std::vector<int> &mom)
+  {
+    const ContractGeometry geom(*prop1[0], mom);
+    const QudaGammaBasis basis = prop1[0]->GammaBasis();
+    const int nSnk = gamma_snk.size(), nSrc = gamma_src.size(), nMom = geom.nMom;
+    const int nCorr = nSnk * nSrc * nMom;
+
+    std::vector<SpinMonomial> snk, src;
+    for (int i=0; i<nSnk; i++) snk.push_back(gammaMonomial(basis, gamma_snk[i]));
+    for (int i=0; i<nSrc; i++) src.push_back(gammaMonomial(basis, gamma_src[i]));
+    const SpinMonomial g5 = gammaMonomial(basis, 16);
+
+    std::vector<F> S1, S2;
+    for (int j=0; j<12; j++) { S1.push_back(F(*prop1[j])); S2.push_back(F(*prop2[j])); }
+
+    corr.assign((size_t)nCorr * geom.L[3], Complex(0.0, 0.0));
+
+    contractTimeSlices(corr, geom, nCorr, nSnk * nSrc, [&](complex<double> *sum, complex<double> *tr, const int x[4], int parity, int x_cb) {
+	complex<double> s1[12][12], s2[12][12];
+	loadPropagator<Float>(s1, S1, parity, x_cb);
+	loadPropagator<Float>(s2, S2, parity, x_cb);
+
+	// A = gamma_5 S2^dagger gamma_5
+	complex<double> A[12][12];
+	for (int d=0; d<4; d++)
+	  for (int a=0; a<4; a++) {
+	    const int a5 = g5.col[a]; // gamma_5 is hermitian and squares to one
+	    const complex<double> e = g5.elem[d] * g5.elem[a5];
+	    for (int c=0; c<3; c++)
+	      for (int ca=0; ca<3; ca++) A[d*3+c][a*3+ca] = e * conj(s2[a5*3+ca][g5.col[d]*3+c]);
+	  }
+
+	// colour-traced spin tensor W[b][g][d][a] = sum_{a,c} S1[(b a)][(g c)] A[(d c)][(a a)],
+	// shared by all gamma insertions
+	complex<double> W[4][4][4][4];
+	for (int b=0; b<4; b++)
+	  for (int g=0; g<4; g++)
+	    for (int d=0; d<4; d++)
+	      for (int a=0; a<4; a++) {
+		complex<double> w(0.0, 0.0);
+		for (int ca=0; ca<3; ca++)
+		  for (int cc=0; cc<3; cc++) w += s1[b*3+ca][g*3+cc] * A[d*3+cc][a*3+ca];
+		W[b][g][d][a] = w;
+	      }
+
+	// Tr[G_snk S1 G_src gamma_5 S2^dagger gamma_5] for each pair
+	for (int i=0; i<nSnk; i++) {
+	  for (int j=0; j<nSrc; j++) {
+	    complex<double> t(0.0, 0.0);
+	    for (int a=0; a<4; a++)
+	      for (int g=0; g<4; g++)
+		t += snk[i].elem[a] * src[j].elem[g] * W[snk[i].col[a]][g][src[j].col[g]][a];
+	    tr[i*nSrc + j] = t;
+	  }
+	}
+
+	// fused momentum projection
+	for (int p=0; p<nMom; p++) {
+	  const complex<double> ph = geom.Phase(p, x);
+	  for (int ij=0; ij<nSnk*nSrc; ij++) sum[ij*nMom + p] += ph * tr[ij];
+	}
+      });
+  }
+
+  template <typename Float, typename F>
+  void contractBaryons(std::vector<Complex> &corr, const std::vector<ColorSpinorField*> &prop_u, const std::vector<ColorSpinorField*> &prop_d,
+		       const std::vector<int> &mom)
+  {
+    const ContractGeometry geom(*prop_u[0], mom);
+    const QudaGammaBasis basis = prop_u[0]->GammaBasis();
+    const int nMom = geom.nMom;
+
+    // diquark Gamma = C gamma_5 with C = gamma_2 gamma_4, and positive parity projector (1 + gamma_4)/2
+    const SpinMonomial Cg5 = gammaMonomial(basis, 2) * gammaMonomial(basis, 8) * gammaMonomial(basis, 16);
+    const SpinMonomial g4 = gammaMonomial(basis, 8);
+    complex<double> P[4][4];
+    for (int i=0; i<4; i++) for (int j=0; j<4; j++) P[i][j] = 0.0;
+    for (int i=0; i<4; i++) { P[i][i] += complex<double>(0.5, 0.0); P[i][g4.col[i]] += 0.5 * g4.elem[i]; }
+
+    static const int eps[6][3] = { {0,1,2}, {1,2,0}, {2,0,1}, {0,2,1}, {2,1,0}, {1,0,2} };
+    static const double eps_sign[6] = { 1.0, 1.0, 1.0, -1.0, -1.0, -1.0 };
+
+    std::vector<F> U, D;
+    for (int j=0; j<12; j++) { U.push_back(F(*prop_u[j])); D.push_back(F(*prop_d[j])); }
+
+    corr.assign((size_t)nMom * geom.L[3], Complex(0.0, 0.0));
+
+    contractTimeSlices(corr, geom, nMom, 0, [&](complex<double> *sum, complex<double> *, const int x[4], int parity, int x_cb) {
+	complex<double> u[12][12], d[12][12];
+	loadPropagator<Float>(u, U, parity, x_cb);
+	loadPropagator<Float>(d, D, parity, x_cb);
+
+	complex<double> c(0.0, 0.0);
+	for (int e=0; e<6; e++) {
+	  const int a = eps[e][0], b = eps[e][1], cc = eps[e][2];
+	  for (int f=0; f<6; f++) {
+	    const int a_ = eps[f][0], b_ = eps[f][1], c_ = eps[f][2];
+
+	    // direct term: Tr[P S_u^{cc'}] times the diquark sum over S_d^{bb'} S_u^{aa'}
+	    complex<double> trP(0.0, 0.0);
+	    for (int al=0; al<4; al++)
+	      for (int be=0; be<4; be++) trP += P[be][al] * u[al*3+cc][be*3+c_];
+
+	    // exchange term: (S_u^{ac'} P S_u^{ca'}), the first product formed once
+	    complex<double> UP[4][4];
+	    for (int ga=0; ga<4; ga++)
+	      for (int al=0; al<4; al++) {
+		UP[ga][al] = 0.0;
+		for (int be=0; be<4; be++) UP[ga][al] += u[ga*3+a][be*3+c_] * P[be][al];
+	      }
+
+	    complex<double> direct(0.0, 0.0), exchange(0.0, 0.0);
+	    for (int ga=0; ga<4; ga++) {
+	      const int de = Cg5.col[ga];
+	      for (int de_=0; de_<4; de_++) {
+		const int ga_ = Cg5.col[de_];
+		const complex<double> w = Cg5.elem[ga] * Cg5.elem[de_] * d[de*3+b][de_*3+b_];
+		direct += w * u[ga*3+a][ga_*3+a_];
+
+		complex<double> ex(0.0, 0.0);
+		for (int al=0; al<4; al++) ex += UP[ga][al] * u[al*3+cc][ga_*3+a_];
+		exchange += w * ex;
+	      }
+	    }
+	    c += eps_sign[e] * eps_sign[f] * (direct * trP - exchange);
+	  }
+	}
+
+	for (int p=0; p<nMom; p++) sum[p] += geom.Phase(p, x) * c;
+      });
+  }
+
+  static void checkPropagator(const std::vector<ColorSpinorField*> &prop, const ColorSpinorField &meta)
+  {
+    if (prop.size() != 12) errorQuda("Propagator must have 12 spin-color columns, not %lu", prop.size());
+    for (unsigned int j=0; j<prop.size(); j++) {
+      if (prop[j]->Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Batched contractions require host fields");
+      if (prop[j]->Nspin() != 4 || prop[j]->Ncolor() != 3) errorQuda("Contractions require Wilson-type fields");
+      if (prop[j]->FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) errorQuda("Field order %d not supported", prop[j]->FieldOrder());
+      if (prop[j]->Precision() != meta.Precision()) errorQuda("Precision mismatch %d %d", prop[j]->Precision(), meta.Precision());
+      if (prop[j]->GammaBasis() != meta.GammaBasis()) errorQuda("Gamma basis mismatch %d %d", prop[j]->GammaBasis(), meta.GammaBasis());
+      for (int d=0; d<4; d++) if (prop[j]->X(d) != meta.X(d)) errorQuda("Lattice dimensions do not match");
+    }
+  }
+
+#endif // GPU_CONTRACT
+
+  void contractMesons(std::vector<Complex> &corr, const std::vector<ColorSpinorField*> &prop1, const std::vector<ColorSpinorField*> &prop2,
+		      const std::vector<int> &gamma_snk, const std::vector<int> &gamma_src, const std::vector<int> &mom)
+  {
+#ifdef GPU_CONTRACT
+    if (mom.size() % 3) errorQuda("Momenta must be given as triplets");
+    checkPropagator(prop1, *prop1[0]);
+    checkPropagator(prop2, *prop1[0]);
+
+    if (prop1[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      contractMesons<double, colorspinor::FieldOrderCB<double,4,3,1,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER> >(corr, prop1, prop2, gamma_snk, gamma_src, mom);
+    } else if (prop1[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      contractMesons<float, colorspinor::FieldOrderCB<float,4,3,1,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER> >(corr, prop1, prop2, gamma_snk, gamma_src, mom);
+    } else {
+      errorQuda("Precision %d not supported", prop1[0]->Precision());
+    }
+#else
+    errorQuda("Contraction code has not been built");
+#endif
+  }
+
+  void contractBaryons(std::vector<Complex> &corr, const std::vector<ColorSpinorField*> &prop_u, const std::vector<ColorSpinorField*> &prop_d,
+		       const std::vector<int> &mom)
+  {
+#ifdef GPU_CONTRACT
+    if (mom.size() % 3) errorQuda("Momenta must be given as triplets");
+    checkPropagator(prop_u, *prop_u[0]);
+    checkPropagator(prop_d, *prop_u[0]);
+
+    if (prop_u[0]->Precision() == QUDA_DOUBLE_PRECISION) {
+      contractBaryons<double, colorspinor::FieldOrderCB<double,4,3,1,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER> >(corr, prop_u, prop_d, mom);
+    } else if (prop_u[0]->Precision() == QUDA_SINGLE_PRECISION) {
+      contractBaryons<float, colorspinor::FieldOrderCB<float,4,3,1,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER> >(corr, prop_u, prop_d, mom);
+    } else {
+      errorQuda("Precision %d not supported", prop_u[0]->Precision());
+    }
+#else
+    errorQuda("Contraction code has not been built");
+#endif
+  }
+
+} // namespace quda
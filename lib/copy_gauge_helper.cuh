@@ -36,6 +36,7 @@ namespace quda {
       for (int d=0; d<arg.geometry; d++) {
 	for (int x=0; x<arg.volume/2; x++) {
 #ifdef FINE_GRAINED_ACCESS
+	  if (OutOrder::fixedPoint) arg.out.setMax(d, parity, x, arg.in.abs_max(d, parity, x));
 	  for (int i=0; i<Ncolor(length); i++)
 	    for (int j=0; j<Ncolor(length); j++) {
 	      arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
@@ -67,7 +68,7 @@ namespace quda {
 #ifdef FINE_GRAINED_ACCESS
 	  for (int i=0; i<Ncolor(length); i++)
 	    for (int j=0; j<Ncolor(length); j++) {
-              complex<Float> u = arg.in(d, parity, x, i, j);
+              complex<RegType> u = arg.in(d, parity, x, i, j);
 	      if (isnan(u.real()))
 	        errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j));
 	      if (isnan(u.imag()))
@@ -102,6 +103,7 @@ namespace quda {
 	if (x >= arg.volume/2) return;
 
 #ifdef FINE_GRAINED_ACCESS
+	if (OutOrder::fixedPoint) arg.out.setMax(d, parity, x, arg.in.abs_max(d, parity, x));
 	for (int i=0; i<Ncolor(length); i++)
 	  for (int j=0; j<Ncolor(length); j++)
 	    arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
@@ -129,6 +131,7 @@ namespace quda {
       for (int d=0; d<arg.nDim; d++) {
 	for (int x=0; x<arg.faceVolumeCB[d]; x++) {
 #ifdef FINE_GRAINED_ACCESS
+	  if (OutOrder::fixedPoint) arg.out.setGhostMax(d+arg.offset, parity, x, arg.in.ghost_abs_max(d+arg.offset, parity, x));
 	  for (int i=0; i<Ncolor(length); i++)
 	    for (int j=0; j<Ncolor(length); j++)
 	      arg.out.Ghost(d+arg.offset, parity, x, i, j) = arg.in.Ghost(d+arg.offset, parity, x, i, j);
@@ -160,6 +163,7 @@ namespace quda {
       for (int d=0; d<arg.nDim; d++) {
 	if (x < arg.faceVolumeCB[d]) {
 #ifdef FINE_GRAINED_ACCESS
+	  if (OutOrder::fixedPoint) arg.out.setGhostMax(d+arg.offset, parity, x, arg.in.ghost_abs_max(d+arg.offset, parity, x));
 	  for (int i=0; i<Ncolor(length); i++)
 	    for (int j=0; j<Ncolor(length); j++)
 	      arg.out.Ghost(d+arg.offset, parity, x, i, j) = arg.in.Ghost(d+arg.offset, parity, x, i, j);
@@ -18,11 +18,11 @@ namespace quda {
 
 #ifdef FINE_GRAINED_ACCESS
       if (outGhost) {
-	typedef typename gauge::FieldOrder<FloatOut,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,false> G;
+	typedef typename gauge::FieldOrder<typename mapper<FloatOut>::type,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,false,FloatOut> G;
 	copyGauge<FloatOut,FloatIn,length>(G(out,(void*)Out,(void**)outGhost), inOrder, out.Volume(), faceVolumeCB,
 					   out.Ndim(), out.Geometry(), out, location, type);
       } else {
-	typedef typename gauge::FieldOrder<FloatOut,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,true> G;
+	typedef typename gauge::FieldOrder<typename mapper<FloatOut>::type,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,true,FloatOut> G;
 	copyGauge<FloatOut,FloatIn,length>(G(out,(void*)Out,(void**)outGhost), inOrder, out.Volume(), faceVolumeCB,
 					   out.Ndim(), out.Geometry(), out, location, type);
       }
@@ -36,7 +36,7 @@ namespace quda {
     } else if (out.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef FINE_GRAINED_ACCESS
-      typedef typename gauge::FieldOrder<FloatOut,Ncolor(length),1,QUDA_QDP_GAUGE_ORDER> G;
+      typedef typename gauge::FieldOrder<typename mapper<FloatOut>::type,Ncolor(length),1,QUDA_QDP_GAUGE_ORDER,true,FloatOut> G;
       copyGauge<FloatOut,FloatIn,length>(G(out,(void*)Out,(void**)outGhost), inOrder, out.Volume(),
 					 faceVolumeCB, out.Ndim(), out.Geometry(), out, location, type);
 #else
@@ -48,7 +48,7 @@ namespace quda {
     } else if (out.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef FINE_GRAINED_ACCESS
-      typedef typename gauge::FieldOrder<FloatOut,Ncolor(length),1,QUDA_MILC_GAUGE_ORDER> G;
+      typedef typename gauge::FieldOrder<typename mapper<FloatOut>::type,Ncolor(length),1,QUDA_MILC_GAUGE_ORDER,true,FloatOut> G;
       copyGauge<FloatOut,FloatIn,length>(G(out,(void*)Out,(void**)outGhost), inOrder, out.Volume(),
 					 faceVolumeCB, out.Ndim(), out.Geometry(), out, location, type);
 #else
@@ -74,10 +74,10 @@ namespace quda {
     if (in.isNative()) {      
 #ifdef FINE_GRAINED_ACCESS
       if (inGhost) {
-	typedef typename gauge::FieldOrder<FloatIn,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,false> G;
+	typedef typename gauge::FieldOrder<typename mapper<FloatIn>::type,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,false,FloatIn> G;
 	copyGaugeMG<FloatOut,FloatIn,length> (G(const_cast<GaugeField&>(in),(void*)In,(void**)inGhost), out, location, Out, outGhost, type);
       } else {
-	typedef typename gauge::FieldOrder<FloatIn,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,true> G;
+	typedef typename gauge::FieldOrder<typename mapper<FloatIn>::type,Ncolor(length),1,QUDA_FLOAT2_GAUGE_ORDER,true,FloatIn> G;
 	copyGaugeMG<FloatOut,FloatIn,length> (G(const_cast<GaugeField&>(in),(void*)In,(void**)inGhost), out, location, Out, outGhost, type);
       }
 #else
@@ -87,7 +87,7 @@ namespace quda {
     } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef FINE_GRAINED_ACCESS
-      typedef typename gauge::FieldOrder<FloatIn,Ncolor(length),1,QUDA_QDP_GAUGE_ORDER> G;
+      typedef typename gauge::FieldOrder<typename mapper<FloatIn>::type,Ncolor(length),1,QUDA_QDP_GAUGE_ORDER,true,FloatIn> G;
       copyGaugeMG<FloatOut,FloatIn,length>(G(const_cast<GaugeField&>(in),(void*)In,(void**)inGhost), out, location, Out, outGhost, type);
 #else
       typedef typename QDPOrder<FloatIn,length> G;
@@ -97,7 +97,7 @@ namespace quda {
     } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef FINE_GRAINED_ACCESS
-      typedef typename gauge::FieldOrder<FloatIn,Ncolor(length),1,QUDA_MILC_GAUGE_ORDER> G;
+      typedef typename gauge::FieldOrder<typename mapper<FloatIn>::type,Ncolor(length),1,QUDA_MILC_GAUGE_ORDER,true,FloatIn> G;
       copyGaugeMG<FloatOut,FloatIn,length>(G(const_cast<GaugeField&>(in),(void*)In,(void**)inGhost), out, location, Out, outGhost, type);
 #else
       typedef typename MILCOrder<FloatIn,length> G;
@@ -174,6 +174,17 @@ namespace quda {
 #endif
       } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
 	copyGaugeMG(out, in, location, (float*)Out, (float*)In, (float**)ghostOut, (float**)ghostIn, type);
+      } else if (in.Precision() == QUDA_HALF_PRECISION) {
+	copyGaugeMG(out, in, location, (float*)Out, (short*)In, (float**)ghostOut, (short**)ghostIn, type);
+      } else {
+	errorQuda("Precision %d not supported", in.Precision());
+      }
+    } else if (out.Precision() == QUDA_HALF_PRECISION) {
+      // half-precision coarse links are only converted to and from single precision
+      if (in.Precision() == QUDA_SINGLE_PRECISION) {
+	copyGaugeMG(out, in, location, (short*)Out, (float*)In, (short**)ghostOut, (float**)ghostIn, type);
+      } else if (in.Precision() == QUDA_HALF_PRECISION) {
+	copyGaugeMG(out, in, location, (short*)Out, (short*)In, (short**)ghostOut, (short**)ghostIn, type);
       } else {
 	errorQuda("Precision %d not supported", in.Precision());
       }
@@ -4,13 +4,15 @@
 #include <assert.h>
 #include <string.h>
 #include <typeinfo>
+#include <vector>
 
 namespace quda {
 
   cpuGaugeField::cpuGaugeField(const GaugeFieldParam &param) :
     GaugeField(param), backed_up(false)
   {
-    if (precision == QUDA_HALF_PRECISION) {
+    // half precision is only supported for coarse links, which are read through the fixed-point FieldOrder accessors
+    if (precision == QUDA_HALF_PRECISION && link_type != QUDA_COARSE_LINKS) {
       errorQuda("CPU fields do not support half precision");
     }
     if (pad != 0) {
@@ -178,8 +180,159 @@ namespace quda {
     for (int d=0; d<nDim; d++) host_free(recv[d]);
   }
 
+  /**
+     Copy a box of sites of an extended QDP or MILC ordered host field
+     to (pack) or from (unpack) a contiguous buffer.  Sites are ordered
+     lexicographically within the box with the links of each site
+     contiguous, so the sender and the receiver of a border region
+     agree on the order independently of their checkerboarding.
+     @param gauge The field data
+     @param order The field order (QDP or MILC)
+     @param E The extended dimensions
+     @param geometry The number of links per site
+     @param link_bytes The size of each link
+     @param lo The lower corner of the box in extended coordinates
+     @param hi The upper corner of the box (exclusive)
+     @param buffer The contiguous buffer
+     @param pack Whether to copy from the field into the buffer
+   */
+  static void copyExtendedBox(void **gauge, QudaGaugeFieldOrder order, const int *E, int geometry,
+			      size_t link_bytes, const int *lo, const int *hi, char *buffer, bool pack)
+  {
+    const size_t volumeCB = (size_t)E[0]*E[1]*E[2]*E[3] / 2;
+    const size_t site_bytes = geometry * link_bytes;
+    int n[4];
+    for (int d=0; d<4; d++) n[d] = hi[d] - lo[d];
+
+#pragma omp parallel for collapse(2)
+    for (int t=lo[3]; t<hi[3]; t++) {
+      for (int z=lo[2]; z<hi[2]; z++) {
+	for (int y=lo[1]; y<hi[1]; y++) {
+	  size_t row = (((size_t)(t-lo[3])*n[2] + (z-lo[2]))*n[1] + (y-lo[1]))*n[0];
+	  for (int x=lo[0]; x<hi[0]; x++) {
+	    size_t idx = (((size_t)t*E[2] + z)*E[1] + y)*E[0] + x;
+	    size_t cb = ((x+y+z+t) & 1)*volumeCB + idx/2;
+	    char *buf = buffer + (row + x - lo[0])*site_bytes;
+	    for (int g=0; g<geometry; g++) {
+	      char *link = order == QUDA_QDP_GAUGE_ORDER ?
+		static_cast<char*>(gauge[g]) + cb*link_bytes :
+		reinterpret_cast<char*>(gauge) + (cb*geometry + g)*link_bytes;
+	      if (pack) memcpy(buf + g*link_bytes, link, link_bytes);
+	      else memcpy(link, buf + g*link_bytes, link_bytes);
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+  void cpuGaugeField::exchangeExtendedBorder(const int *R, bool no_comms_fill) {
+
+    // the border filled from (and the sites sent to) one neighbour,
+    // which can be displaced in several dimensions at once
+    struct Border {
+      int disp[4];
+      int send_lo[4], send_hi[4]; // interior sites sent to the rank at disp
+      int recv_lo[4], recv_hi[4]; // border sites received from the rank at disp
+      bool local;                 // whether the rank at disp is this one
+      size_t bytes;
+      char *send, *recv;
+      MsgHandle *mh_send, *mh_recv;
+    };
+
+    bool active[4];
+    for (int d=0; d<4; d++) {
+      active[d] = R[d] && (commDimPartitioned(d) || no_comms_fill);
+      if (active[d] && x[d] < 3*R[d]) errorQuda("Local dimension %d = %d is smaller than R = %d", d, x[d]-2*R[d], R[d]);
+    }
+
+    const size_t link_bytes = nInternal * precision;
+    std::vector<Border> border;
+    size_t total_bytes = 0;
+    for (int i=0; i<81; i++) {
+      Border b;
+      bool trivial = true, valid = true;
+      b.local = true;
+      for (int d=0, j=i; d<4; d++, j/=3) {
+	b.disp[d] = j%3 - 1;
+	if (b.disp[d] == 0) {
+	  b.send_lo[d] = b.recv_lo[d] = R[d];
+	  b.send_hi[d] = b.recv_hi[d] = x[d] - R[d];
+	  continue;
+	}
+	if (!active[d]) valid = false;
+	if (commDimPartitioned(d)) b.local = false;
+	trivial = false;
+	b.send_lo[d] = b.disp[d] > 0 ? x[d] - 2*R[d] : R[d];
+	b.recv_lo[d] = b.disp[d] > 0 ? x[d] - R[d] : 0;
+	b.send_hi[d] = b.send_lo[d] + R[d];
+	b.recv_hi[d] = b.recv_lo[d] + R[d];
+      }
+      if (trivial || !valid) continue;
+      b.bytes = geometry * link_bytes;
+      for (int d=0; d<4; d++) b.bytes *= b.recv_hi[d] - b.recv_lo[d];
+      total_bytes += 2*b.bytes;
+      border.push_back(b);
+    }
+    if (border.size() == 0) return;
+
+    char *buffer = static_cast<char*>(safe_malloc(total_bytes));
+    size_t offset = 0;
+    for (unsigned int i=0; i<border.size(); i++) {
+      border[i].send = buffer + offset;
+      border[i].recv = buffer + offset + border[i].bytes;
+      offset += 2*border[i].bytes;
+    }
+
+    // prepost the receives, then pack and send every region at once
+    for (unsigned int i=0; i<border.size(); i++) {
+      Border &b = border[i];
+      if (b.local) continue;
+      b.mh_recv = comm_declare_receive_displaced(b.recv, b.disp, b.bytes);
+      comm_start(b.mh_recv);
+    }
+
+    for (unsigned int i=0; i<border.size(); i++) {
+      Border &b = border[i];
+      if (b.local) {
+	// periodic wrap: this rank sends its opposite region to itself
+	int lo[4], hi[4];
+	for (int d=0; d<4; d++) {
+	  lo[d] = b.disp[d] ? (b.disp[d] > 0 ? R[d] : x[d] - 2*R[d]) : b.send_lo[d];
+	  hi[d] = lo[d] + (b.send_hi[d] - b.send_lo[d]);
+	}
+	copyExtendedBox(gauge, order, x, geometry, link_bytes, lo, hi, b.recv, true);
+      } else {
+	copyExtendedBox(gauge, order, x, geometry, link_bytes, b.send_lo, b.send_hi, b.send, true);
+	b.mh_send = comm_declare_send_displaced(b.send, b.disp, b.bytes);
+	comm_start(b.mh_send);
+      }
+    }
+
+    for (unsigned int i=0; i<border.size(); i++) {
+      Border &b = border[i];
+      if (!b.local) comm_wait(b.mh_recv);
+      copyExtendedBox(gauge, order, x, geometry, link_bytes, b.recv_lo, b.recv_hi, b.recv, false);
+    }
+
+    for (unsigned int i=0; i<border.size(); i++) {
+      Border &b = border[i];
+      if (b.local) continue;
+      comm_wait(b.mh_send);
+      comm_free(b.mh_send);
+      comm_free(b.mh_recv);
+    }
+
+    host_free(buffer);
+  }
+
   void cpuGaugeField::exchangeExtendedGhost(const int *R, bool no_comms_fill) {
-    
+    if (order == QUDA_QDP_GAUGE_ORDER || order == QUDA_MILC_GAUGE_ORDER) exchangeExtendedBorder(R, no_comms_fill);
+    else exchangeExtendedGhostByDim(R, no_comms_fill);
+  }
+
+  void cpuGaugeField::exchangeExtendedGhostByDim(const int *R, bool no_comms_fill) {
+
     void *send[QUDA_MAX_DIM];
     void *recv[QUDA_MAX_DIM];
     size_t bytes[QUDA_MAX_DIM];
@@ -275,7 +428,7 @@ namespace quda {
 
 	void *buffer = create_gauge_buffer(bytes, order, geometry);
 	size_t ghost_bytes[8];
-	int dstNinternal = reconstruct != QUDA_RECONSTRUCT_NO ? reconstruct : 2*nColor*nColor;
+	int dstNinternal = nInternal;
 	for (int d=0; d<geometry; d++) ghost_bytes[d] = nFace * surface[d%4] * dstNinternal * precision;
 	void **ghost_buffer = (nFace > 0) ? create_ghost_buffer(ghost_bytes, order, geometry) : nullptr;
 
@@ -471,7 +471,7 @@ namespace quda {
       } else { // else on the GPU
 	void *buffer = create_gauge_buffer(src.Bytes(), src.Order(), src.Geometry());
 	size_t ghost_bytes[8];
-	int srcNinternal = src.Reconstruct() != QUDA_RECONSTRUCT_NO ? src.Reconstruct() : 2*nColor*nColor;
+	int srcNinternal = src.Ninternal();
 	for (int d=0; d<geometry; d++) ghost_bytes[d] = nFace * surface[d%4] * srcNinternal * src.Precision();
 	void **ghost_buffer = (nFace > 0) ? create_ghost_buffer(ghost_bytes, src.Order(), geometry) : nullptr;
 
@@ -523,7 +523,7 @@ namespace quda {
 
       // Allocate space for ghost zone if required
       size_t ghost_bytes[8];
-      int cpuNinternal = cpu.Reconstruct() != QUDA_RECONSTRUCT_NO ? cpu.Reconstruct() : 2*nColor*nColor;
+      int cpuNinternal = cpu.Ninternal();
       for (int d=0; d<geometry; d++) ghost_bytes[d] = nFace * surface[d%4] * cpuNinternal * cpu.Precision();
       void **ghost_buffer = (nFace > 0) ? create_ghost_buffer(ghost_bytes, cpu.Order(), geometry) : nullptr;
 
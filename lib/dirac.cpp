@@ -109,8 +109,10 @@ namespace quda {
 		in.SiteSubset(), out.SiteSubset());
     }
 
-    if (!static_cast<const cudaColorSpinorField&>(in).isNative()) errorQuda("Input field is not in native order");
-    if (!static_cast<const cudaColorSpinorField&>(out).isNative()) errorQuda("Output field is not in native order");
+    if (in.Location() == QUDA_CUDA_FIELD_LOCATION && !static_cast<const cudaColorSpinorField&>(in).isNative())
+      errorQuda("Input field is not in native order");
+    if (out.Location() == QUDA_CUDA_FIELD_LOCATION && !static_cast<const cudaColorSpinorField&>(out).isNative())
+      errorQuda("Output field is not in native order");
 
     if (out.Ndim() != 5) {
       if ((out.Volume() != gauge->Volume() && out.SiteSubset() == QUDA_FULL_SITE_SUBSET) ||
@@ -137,6 +137,22 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracClover::MultiFlavorM(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+				 const std::vector<double> &kappa, const std::vector<double> &mu) const
+  {
+    if (kappa.size() != in.size() || mu.size() != in.size())
+      errorQuda("Number of kappa %lu and mu %lu values must match the number of fields %lu", kappa.size(), mu.size(), in.size());
+
+    // the clover term scales with kappa at fixed c_sw: A_f = (1 - r) + r A with r = kappa_f / kappa
+    std::vector<WilsonFlavorParam> flavor;
+    for (unsigned int f=0; f<in.size(); f++) {
+      if (mu[f] != 0.0) errorQuda("Twisted mass %e not supported by the clover operator", mu[f]);
+      const double r = kappa[f] / this->kappa;
+      flavor.push_back(WilsonFlavorParam(-kappa[f], 1.0 - r, r));
+    }
+    MultiFlavorApply(out, in, flavor, &clover);
+  }
+
   void DiracClover::prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			    ColorSpinorField &x, ColorSpinorField &b, 
 			    const QudaSolutionType solType) const
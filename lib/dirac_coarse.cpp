@@ -7,7 +7,8 @@ namespace quda {
   DiracCoarse::DiracCoarse(const DiracParam &param, bool enable_gpu)
     : Dirac(param), mu(param.mu), mu_factor(param.mu_factor), transfer(param.transfer), dirac(param.dirac),
       Y_h(nullptr), X_h(nullptr), Xinv_h(nullptr), Yhat_h(nullptr),
-      Y_d(nullptr), X_d(nullptr), Xinv_d(nullptr), Yhat_d(nullptr),
+      Y_d(nullptr), X_d(nullptr), Xinv_d(nullptr), Yhat_d(nullptr), link_precision(param.link_precision),
+      Y_half_h(nullptr), Yhat_half_h(nullptr), Y_half_d(nullptr), Yhat_half_d(nullptr),
       enable_gpu(enable_gpu), init(true)
   {
     initializeCoarse();
@@ -18,7 +19,8 @@ namespace quda {
 			   cudaGaugeField *Y_d, cudaGaugeField *X_d, cudaGaugeField *Xinv_d, cudaGaugeField *Yhat_d) // gpu link field
     : Dirac(param), mu(param.mu), mu_factor(param.mu_factor), transfer(nullptr), dirac(nullptr),
       Y_h(Y_h), X_h(X_h), Xinv_h(Xinv_h), Yhat_h(Yhat_h),
-      Y_d(Y_d), X_d(X_d), Xinv_d(Xinv_d), Yhat_d(Yhat_d),
+      Y_d(Y_d), X_d(X_d), Xinv_d(Xinv_d), Yhat_d(Yhat_d), link_precision(Y_h->Precision()),
+      Y_half_h(nullptr), Yhat_half_h(nullptr), Y_half_d(nullptr), Yhat_half_d(nullptr),
       enable_gpu(Y_d && X_d && Xinv_d), init(false)
   {
 
@@ -27,7 +29,8 @@ namespace quda {
   DiracCoarse::DiracCoarse(const DiracCoarse &dirac, const DiracParam &param)
     : Dirac(param), mu(param.mu), mu_factor(param.mu_factor), transfer(param.transfer), dirac(param.dirac),
       Y_h(dirac.Y_h), X_h(dirac.X_h), Xinv_h(dirac.Xinv_h), Yhat_h(dirac.Yhat_h),
-      Y_d(dirac.Y_d), X_d(dirac.X_d), Xinv_d(dirac.Xinv_d), Yhat_d(dirac.Yhat_d),
+      Y_d(dirac.Y_d), X_d(dirac.X_d), Xinv_d(dirac.Xinv_d), Yhat_d(dirac.Yhat_d), link_precision(dirac.link_precision),
+      Y_half_h(dirac.Y_half_h), Yhat_half_h(dirac.Yhat_half_h), Y_half_d(dirac.Y_half_d), Yhat_half_d(dirac.Yhat_half_d),
       enable_gpu(dirac.enable_gpu), init(false)
   {
 
@@ -44,6 +47,10 @@ namespace quda {
       if (X_d) delete X_d;
       if (Xinv_d) delete Xinv_d;
       if (Yhat_d) delete Yhat_d;
+      if (Y_half_h) delete Y_half_h;
+      if (Yhat_half_h) delete Yhat_half_h;
+      if (Y_half_d) delete Y_half_d;
+      if (Yhat_half_d) delete Yhat_half_d;
     }
   }
 
@@ -127,6 +134,50 @@ namespace quda {
       }
     }
 
+    if (link_precision == QUDA_HALF_PRECISION) createHalfLinks();
+  }
+
+  void DiracCoarse::createHalfLinks()
+  {
+    if (Y_h->Precision() != QUDA_SINGLE_PRECISION)
+      errorQuda("Half-precision coarse links require a single-precision coarse operator, not %d", Y_h->Precision());
+
+    GaugeFieldParam gParam(*Y_h);
+    gParam.precision = QUDA_HALF_PRECISION;
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+
+    // each link matrix is encoded with its own scale during the copy
+    Y_half_h = new cpuGaugeField(gParam);
+    Yhat_half_h = new cpuGaugeField(gParam);
+    Y_half_h->copy(*Y_h);
+    Yhat_half_h->copy(*Yhat_h);
+    Y_half_h->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+    Yhat_half_h->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+
+    if (enable_gpu) {
+      gParam = GaugeFieldParam(*Y_d);
+      gParam.precision = QUDA_HALF_PRECISION;
+      gParam.create = QUDA_NULL_FIELD_CREATE;
+
+      Y_half_d = new cudaGaugeField(gParam);
+      Yhat_half_d = new cudaGaugeField(gParam);
+      // the conversion (including the ghost zone) is done on the device
+      Y_half_d->copy(*Y_d);
+      Yhat_half_d->copy(*Yhat_d);
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Coarse link fields stored in half precision with per-matrix scale\n");
+  }
+
+  const GaugeField& DiracCoarse::Link(QudaFieldLocation location, bool preconditioned) const
+  {
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      if (preconditioned) return Yhat_half_d ? *Yhat_half_d : *Yhat_d;
+      else return Y_half_d ? *Y_half_d : *Y_d;
+    } else {
+      if (preconditioned) return Yhat_half_h ? *Yhat_half_h : *Yhat_h;
+      else return Y_half_h ? *Y_half_h : *Y_h;
+    }
   }
 
   void DiracCoarse::Clover(ColorSpinorField &out, const ColorSpinorField &in, const QudaParity parity) const
@@ -160,9 +211,9 @@ namespace quda {
   {
     if (checkLocation(out,in) == QUDA_CUDA_FIELD_LOCATION) {
       if (!enable_gpu) errorQuda("Cannot apply %s on GPU since enable_gpu has not been set", __func__);
-      ApplyCoarse(out, in, in, *Y_d, *X_d, kappa, parity, true, false, dagger);
+      ApplyCoarse(out, in, in, Link(QUDA_CUDA_FIELD_LOCATION), *X_d, kappa, parity, true, false, dagger);
     } else if ( checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION ) {
-      ApplyCoarse(out, in, in, *Y_h, *X_h, kappa, parity, true, false, dagger);
+      ApplyCoarse(out, in, in, Link(QUDA_CPU_FIELD_LOCATION), *X_h, kappa, parity, true, false, dagger);
     }
     int n = in.Nspin()*in.Ncolor();
     flops += (8*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
@@ -176,9 +227,9 @@ namespace quda {
 
     if (checkLocation(out,in) == QUDA_CUDA_FIELD_LOCATION) {
       if (!enable_gpu) errorQuda("Cannot apply %s on GPU since enable_gpu has not been set", __func__);
-      ApplyCoarse(out, in, x, *Y_d, *X_d, kappa, parity, true, true, dagger);
+      ApplyCoarse(out, in, x, Link(QUDA_CUDA_FIELD_LOCATION), *X_d, kappa, parity, true, true, dagger);
     } else if ( checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION ) {
-      ApplyCoarse(out, in, x, *Y_h, *X_h, kappa, parity, true, true, dagger);
+      ApplyCoarse(out, in, x, Link(QUDA_CPU_FIELD_LOCATION), *X_h, kappa, parity, true, true, dagger);
     }
     int n = in.Nspin()*in.Ncolor();
     flops += (9*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
@@ -188,9 +239,9 @@ namespace quda {
   {
     if ( checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION ) {
       if (!enable_gpu) errorQuda("Cannot apply %s on GPU since enable_gpu has not been set", __func__);
-      ApplyCoarse(out, in, in, *Y_d, *X_d, kappa, QUDA_INVALID_PARITY, true, true, dagger);
+      ApplyCoarse(out, in, in, Link(QUDA_CUDA_FIELD_LOCATION), *X_d, kappa, QUDA_INVALID_PARITY, true, true, dagger);
     } else if ( checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION ) {
-      ApplyCoarse(out, in, in, *Y_h, *X_h, kappa, QUDA_INVALID_PARITY, true, true, dagger);
+      ApplyCoarse(out, in, in, Link(QUDA_CPU_FIELD_LOCATION), *X_h, kappa, QUDA_INVALID_PARITY, true, true, dagger);
     }
     int n = in.Nspin()*in.Ncolor();
     flops += (9*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
@@ -252,9 +303,9 @@ namespace quda {
   {
     if (checkLocation(out,in) == QUDA_CUDA_FIELD_LOCATION) {
       if (!enable_gpu) errorQuda("Cannot apply %s on GPU since enable_gpu has not been set", __func__);
-      ApplyCoarse(out, in, in, *Yhat_d, *X_d, kappa, parity, true, false, dagger);
+      ApplyCoarse(out, in, in, Link(QUDA_CUDA_FIELD_LOCATION, true), *X_d, kappa, parity, true, false, dagger);
     } else if ( checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION ) {
-      ApplyCoarse(out, in, in, *Yhat_h, *X_h, kappa, parity, true, false, dagger);
+      ApplyCoarse(out, in, in, Link(QUDA_CPU_FIELD_LOCATION, true), *X_h, kappa, parity, true, false, dagger);
     }
 
     int n = in.Nspin()*in.Ncolor();
@@ -8,6 +8,20 @@ namespace quda {
 #include <dslash_init.cuh>
   }
 
+  /**
+     @brief Fifth-dimension operator of the host branches: Dslash5 is
+     the bare hopping term D5 and Dslash5inv is (1 - kappa D5)^{-1}
+   */
+  static DomainWall5DParam domainWallM5(int Ls, double mass, bool inverse, double kappa)
+  {
+    DomainWall5DParam param(Ls, mass, inverse);
+    for (int s=0; s<Ls; s++) {
+      param.a[s] = inverse ? 1.0 : 0.0;
+      param.b[s] = inverse ? -kappa : 1.0;
+    }
+    return param;
+  }
+
 // Modification for the 4D preconditioned domain wall operator
   DiracDomainWall4DPC::DiracDomainWall4DPC(const DiracParam &param)
     : DiracDomainWallPC(param)
@@ -57,9 +71,13 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, 0, mass, 0, 0, commDim, 1, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, 0, mass, 0, 0, commDim, 1, profile);
+    } else {
+      ApplyDomainWall5D(out, in, nullptr, domainWallM5(in.X(4), mass, false, 0.0), dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -76,9 +94,13 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, 0, mass, k, 0, commDim, 2, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, 0, mass, k, 0, commDim, 2, profile);
+    } else {
+      ApplyDomainWall5D(out, in, nullptr, domainWallM5(in.X(4), mass, true, k), dagger == QUDA_DAG_YES);
+    }
 
   
     long long Ls = in.X(4);
@@ -111,10 +133,16 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-			 mass, k, 0, commDim, 1, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+			   mass, k, 0, commDim, 1, profile);
+    } else {
+      DomainWall5DParam param = domainWallM5(in.X(4), mass, false, 0.0);
+      param.alpha.assign(in.X(4), k);
+      ApplyDomainWall5D(out, in, &x, param, dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -131,10 +159,16 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-			 &static_cast<const cudaColorSpinorField&>(in),
-			 parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-			 mass, a, b, commDim, 2, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      domainWallDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+			   &static_cast<const cudaColorSpinorField&>(in),
+			   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+			   mass, a, b, commDim, 2, profile);
+    } else {
+      DomainWall5DParam param = domainWallM5(in.X(4), mass, true, a);
+      param.alpha.assign(in.X(4), b);
+      ApplyDomainWall5D(out, in, &x, param, dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     flops +=  (144LL*Ls + 48LL)*(long long)in.Volume() + 3LL*Ls*(Ls-1LL);
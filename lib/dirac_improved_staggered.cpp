@@ -11,15 +11,22 @@ namespace quda {
     Dirac(param), fatGauge(*(param.fatGauge)), longGauge(*(param.longGauge))
     //FIXME: this may break mixed precision multishift solver since may not have fatGauge initializeed yet
   {
-    improvedstaggered::initConstants(*param.gauge, profile);    
-    improvedstaggered::initStaggeredConstants(fatGauge, longGauge, profile);
+    // host operators read the links directly, so there is nothing to initialize
+    if (fatGauge.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      improvedstaggered::initConstants(*param.gauge, profile);
+      improvedstaggered::initStaggeredConstants(static_cast<cudaGaugeField&>(fatGauge),
+						static_cast<cudaGaugeField&>(longGauge), profile);
+    }
   }
 
   DiracImprovedStaggered::DiracImprovedStaggered(const DiracImprovedStaggered &dirac) 
   : Dirac(dirac), fatGauge(dirac.fatGauge), longGauge(dirac.longGauge)
   {
-    improvedstaggered::initConstants(*dirac.gauge, profile);
-    improvedstaggered::initStaggeredConstants(fatGauge, longGauge, profile);
+    if (fatGauge.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      improvedstaggered::initConstants(*dirac.gauge, profile);
+      improvedstaggered::initStaggeredConstants(static_cast<cudaGaugeField&>(fatGauge),
+						static_cast<cudaGaugeField&>(longGauge), profile);
+    }
   }
 
   DiracImprovedStaggered::~DiracImprovedStaggered() { }
@@ -65,12 +72,13 @@ namespace quda {
   {
     checkParitySpinor(in, out);
 
-    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
-      improvedStaggeredDslashCuda(&static_cast<cudaColorSpinorField&>(out), fatGauge, longGauge,
+    if (checkLocation(out, in, fatGauge, longGauge) == QUDA_CUDA_FIELD_LOCATION) {
+      improvedStaggeredDslashCuda(&static_cast<cudaColorSpinorField&>(out),
+				  static_cast<cudaGaugeField&>(fatGauge), static_cast<cudaGaugeField&>(longGauge),
 				  &static_cast<const cudaColorSpinorField&>(in), parity, 
 				  dagger, 0, 0, commDim, profile);
     } else {
-      errorQuda("Not supported");
+      ApplyImprovedStaggered(out, in, fatGauge, longGauge, 0.0, nullptr, parity, dagger == QUDA_DAG_YES);
     }  
 
     flops += 1146ll*in.Volume();
@@ -82,12 +90,13 @@ namespace quda {
   {    
     checkParitySpinor(in, out);
 
-    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
-      improvedStaggeredDslashCuda(&static_cast<cudaColorSpinorField&>(out), fatGauge, longGauge,
+    if (checkLocation(out, in, x, fatGauge, longGauge) == QUDA_CUDA_FIELD_LOCATION) {
+      improvedStaggeredDslashCuda(&static_cast<cudaColorSpinorField&>(out),
+			  static_cast<cudaGaugeField&>(fatGauge), static_cast<cudaGaugeField&>(longGauge),
 			  &static_cast<const cudaColorSpinorField&>(in), parity, dagger, 
 			  &static_cast<const cudaColorSpinorField&>(x), k, commDim, profile);
     } else {
-      errorQuda("Not supported");
+      ApplyImprovedStaggered(out, in, fatGauge, longGauge, k, &x, parity, dagger == QUDA_DAG_YES);
     }  
 
     flops += 1158ll*in.Volume();
@@ -8,6 +8,29 @@ namespace quda {
 #include <dslash_init.cuh>
   }
 
+  /**
+     @brief Fifth-dimension operator of the host branches: Dslash4pre
+     is b_5 + 0.5 c_5 D5, and Dslash5 (Dslash5inv) is (the inverse
+     of) 1 + kappa_5 D5 with kappa_5 = 0.5 (c_5 (4+m5) - 1) / (b_5 (4+m5) + 1)
+   */
+  static DomainWall5DParam mobiusM5(int Ls, const double *b_5, const double *c_5, double m5, double mass,
+				    bool pre, bool inverse)
+  {
+    DomainWall5DParam param(Ls, mass, inverse);
+    for (int s=0; s<Ls; s++) {
+      param.a[s] = pre ? b_5[s] : 1.0;
+      param.b[s] = pre ? 0.5*c_5[s] : 0.5*(c_5[s]*(4.0+m5) - 1.0)/(b_5[s]*(4.0+m5) + 1.0);
+    }
+    return param;
+  }
+
+  // the device xpay kernels scale by k kappa_b(s)^2
+  static double mobiusXpayScale(double b_5, double m5, double k)
+  {
+    double kappa_b = 0.5 / (b_5*(4.0+m5) + 1.0);
+    return k * kappa_b * kappa_b;
+  }
+
   DiracMobius::DiracMobius(const DiracParam &param) : DiracDomainWall(param) {
     memcpy(b_5, param.b_5, sizeof(double)*param.Ls);
     memcpy(c_5, param.c_5, sizeof(double)*param.Ls);
@@ -56,11 +79,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
 
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 1, profile);   
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 1, profile);
+    } else {
+      ApplyDomainWall5D(out, in, nullptr, mobiusM5(in.X(4), b_5, c_5, m5, mass, true, false), dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -74,11 +101,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
  
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
-    
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 2, profile);   
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 2, profile);
+    } else {
+      ApplyDomainWall5D(out, in, nullptr, mobiusM5(in.X(4), b_5, c_5, m5, mass, false, false), dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -113,12 +144,18 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
 
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 1, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 1, profile);
+    } else {
+      DomainWall5DParam param = mobiusM5(in.X(4), b_5, c_5, m5, mass, true, false);
+      for (int s=0; s<in.X(4); s++) param.alpha[s] = mobiusXpayScale(b_5[s], m5, k);
+      ApplyDomainWall5D(out, in, &x, param, dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -134,12 +171,18 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
 
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 2, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 2, profile);
+    } else {
+      DomainWall5DParam param = mobiusM5(in.X(4), b_5, c_5, m5, mass, false, false);
+      for (int s=0; s<in.X(4); s++) param.beta[s] = mobiusXpayScale(b_5[s], m5, k);
+      ApplyDomainWall5D(out, in, &x, param, dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     long long bulk = (Ls-2)*(in.Volume()/Ls);
@@ -223,11 +266,15 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+    if (checkLocation(out, in) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
 
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, 0, mass, 0, commDim, 3, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, 0, mass, 0, commDim, 3, profile);
+    } else {
+      ApplyDomainWall5D(out, in, nullptr, mobiusM5(in.X(4), b_5, c_5, m5, mass, false, true), dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     flops += 144LL*(long long)in.Volume()*Ls + 3LL*Ls*(Ls-1LL);
@@ -242,12 +289,18 @@ namespace quda {
     checkParitySpinor(in, out);
     checkSpinorAlias(in, out);
 
-    mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
+    if (checkLocation(out, in, x) == QUDA_CUDA_FIELD_LOCATION) {
+      mobius::initMDWFConstants(b_5, c_5, in.X(4), m5, profile);
 
-    MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
-		   &static_cast<const cudaColorSpinorField&>(in),
-		   parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
-		   mass, k, commDim, 3, profile);
+      MDWFDslashCuda(&static_cast<cudaColorSpinorField&>(out), *gauge,
+		     &static_cast<const cudaColorSpinorField&>(in),
+		     parity, dagger, &static_cast<const cudaColorSpinorField&>(x),
+		     mass, k, commDim, 3, profile);
+    } else {
+      DomainWall5DParam param = mobiusM5(in.X(4), b_5, c_5, m5, mass, false, true);
+      for (int s=0; s<in.X(4); s++) param.alpha[s] = mobiusXpayScale(b_5[s], m5, k);
+      ApplyDomainWall5D(out, in, &x, param, dagger == QUDA_DAG_YES);
+    }
 
     long long Ls = in.X(4);
     flops +=  (144LL*Ls + 48LL)*(long long)in.Volume() + 3LL*Ls*(Ls-1LL);
@@ -164,6 +164,21 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracTwistedMass::MultiFlavorM(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+				      const std::vector<double> &kappa, const std::vector<double> &mu) const
+  {
+    if (kappa.size() != in.size() || mu.size() != in.size())
+      errorQuda("Number of kappa %lu and mu %lu values must match the number of fields %lu", kappa.size(), mu.size(), in.size());
+
+    std::vector<WilsonFlavorParam> flavor;
+    for (unsigned int f=0; f<in.size(); f++) {
+      // the non-degenerate doublet already shares the links between its two flavours
+      if (in[f]->TwistFlavor() != QUDA_TWIST_SINGLET) errorQuda("Twist flavor %d not supported", in[f]->TwistFlavor());
+      flavor.push_back(WilsonFlavorParam(-kappa[f], 1.0, 0.0, 2.0*kappa[f]*mu[f]));
+    }
+    MultiFlavorApply(out, in, flavor, nullptr);
+  }
+
   void DiracTwistedMass::prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 				 ColorSpinorField &x, ColorSpinorField &b, 
 				 const QudaSolutionType solType) const
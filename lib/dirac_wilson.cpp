@@ -116,6 +116,42 @@ namespace quda {
     deleteTmp(&tmp1, reset);
   }
 
+  void DiracWilson::MultiFlavorApply(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+				     const std::vector<WilsonFlavorParam> &flavor, const CloverField *A) const
+  {
+    if (out.size() != in.size()) errorQuda("Number of output %lu and input %lu fields differ", out.size(), in.size());
+    for (unsigned int f=0; f<in.size(); f++) {
+      checkFullSpinor(*out[f], *in[f]);
+      checkSpinorAlias(*out[f], *in[f]);
+    }
+
+    for (int parity=0; parity<2; parity++) {
+      std::vector<ColorSpinorField*> out_p, in_p, x_p;
+      for (unsigned int f=0; f<in.size(); f++) {
+	out_p.push_back(parity == QUDA_EVEN_PARITY ? &out[f]->Even() : &out[f]->Odd());
+	in_p.push_back(parity == QUDA_EVEN_PARITY ? &in[f]->Odd() : &in[f]->Even());
+	x_p.push_back(parity == QUDA_EVEN_PARITY ? &in[f]->Even() : &in[f]->Odd());
+      }
+      ApplyWilsonMultiFlavor(out_p, in_p, x_p, *gauge, A, flavor, parity, dagger == QUDA_DAG_YES);
+    }
+
+    flops += (1320ll + 72ll + (A ? 552ll : 0ll))*in.size()*in[0]->Volume();
+  }
+
+  void DiracWilson::MultiFlavorM(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+				 const std::vector<double> &kappa, const std::vector<double> &mu) const
+  {
+    if (kappa.size() != in.size() || mu.size() != in.size())
+      errorQuda("Number of kappa %lu and mu %lu values must match the number of fields %lu", kappa.size(), mu.size(), in.size());
+
+    std::vector<WilsonFlavorParam> flavor;
+    for (unsigned int f=0; f<in.size(); f++) {
+      if (mu[f] != 0.0) errorQuda("Twisted mass %e not supported by the Wilson operator", mu[f]);
+      flavor.push_back(WilsonFlavorParam(-kappa[f], 1.0));
+    }
+    MultiFlavorApply(out, in, flavor, nullptr);
+  }
+
   void DiracWilson::prepare(ColorSpinorField* &src, ColorSpinorField* &sol,
 			    ColorSpinorField &x, ColorSpinorField &b, 
 			    const QudaSolutionType solType) const
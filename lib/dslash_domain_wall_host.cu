@@ -0,0 +1,534 @@
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <color_spinor.h>
+#include <color_spinor_field.h>
+#include <color_spinor_field_order.h>
+#include <quda_matrix_soa.h>
+#include <stencil.h>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+/**
+   This is the host engine for the fifth dimension of domain-wall
+   type operators.  The fifth-dimension operator only depends on the
+   slice index, so blocks of host_simd_width 4-d sites are transposed
+   into a structure of arrays, split into the two chiral halves that
+   the fifth-dimension hopping term keeps apart, and every slice
+   update then runs across the sites of the block under omp simd.
+   Along the fifth dimension M5 is cyclic bidiagonal in each chiral
+   half, so M5^{-1} is applied with two O(Ls) recurrences instead of
+   the dense O(Ls^2) sum used by the device kernels.
+*/
+
+namespace quda {
+
+  /**
+     @brief Parameter structure for driving the host domain-wall
+     engine.  The per-slice coefficients are stored in the precision
+     of the fields, together with the derived coefficients of the
+     recurrences that apply M5^{-1}.
+   */
+  template <typename Float, int nColor, typename F_, typename G_, bool xpay>
+  struct DomainWallHostArg {
+    typedef F_ F;
+    typedef G_ G;
+
+    F out;                // output vector field
+    const F in;           // input vector field
+    const F x;            // input vector when doing xpay
+    const G U;            // the gauge field (4-d hopping term only)
+    std::vector<Float> a; // site coefficient of each slice
+    std::vector<Float> b; // hopping coefficient of each slice
+    std::vector<Float> alpha; // scale of the result in each slice
+    std::vector<Float> beta;  // scale of x in each slice
+    std::vector<Float> a_inv; // 1/a_s for the inverse
+    std::vector<Float> c;     // -2 b_s / a_s, the recurrence coefficient of the inverse
+    Float norm;           // 1/(1 + mf prod_s c_s), the wall normalization of the inverse
+    const Float mf;       // quark mass coupling the walls
+    const bool inverse;   // whether we apply M5^{-1}
+    const bool ukqcd;     // whether the fields are in the UKQCD basis (else DeGrand-Rossi)
+    const int parity;     // only use this for single parity fields
+    const int nParity;    // number of parities we're working on
+    const int nFace;      // hard code to 1 for now
+    const int dim[5];     // full lattice dimensions, with Ls in dim[4]
+    const int gdim[5];    // full lattice dimensions of the gauge field
+    const int commDim[4]; // whether a given dimension is partitioned or not
+    const int volume4CB;  // checkerboarded 4-d volume
+    const int Ls;         // size of the fifth dimension
+
+    __host__ __device__ static constexpr bool isXpay() { return xpay; }
+
+    DomainWallHostArg(ColorSpinorField &out, const ColorSpinorField &in, const G &U,
+		      const ColorSpinorField *x, const DomainWall5DParam &m5, int parity)
+      : out(out), in(in), x(xpay ? *x : in), U(U), a(m5.a.begin(), m5.a.end()), b(m5.b.begin(), m5.b.end()),
+	alpha(m5.alpha.begin(), m5.alpha.end()), beta(m5.beta.begin(), m5.beta.end()),
+	a_inv(in.X(4)), c(in.X(4)), norm(1.0), mf(m5.mf), inverse(m5.inverse),
+	ukqcd(in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS), parity(parity), nParity(in.SiteSubset()), nFace(1),
+	dim{ (3-nParity) * in.X(0), in.X(1), in.X(2), in.X(3), in.X(4) },
+	gdim{ (3-nParity) * in.X(0), in.X(1), in.X(2), in.X(3), 1 },
+      commDim{comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3)},
+      volume4CB(in.VolumeCB() / in.X(4)), Ls(in.X(4))
+    {
+      if (inverse) {
+	double prod = 1.0;
+	for (int s=0; s<Ls; s++) {
+	  if (m5.a[s] == 0.0) errorQuda("Singular fifth-dimension operator: a[%d] = 0", s);
+	  a_inv[s] = 1.0 / m5.a[s];
+	  c[s] = -2.0 * m5.b[s] / m5.a[s];
+	  prod *= -2.0 * m5.b[s] / m5.a[s];
+	}
+	if (1.0 + m5.mf * prod == 0.0) errorQuda("Singular fifth-dimension operator: 1 + mf prod c = 0");
+	norm = 1.0 / (1.0 + m5.mf * prod);
+      }
+    }
+  };
+
+  /**
+     @brief Placeholder gauge accessor used when only the
+     fifth-dimension operator is applied
+   */
+  struct NoGaugeOrder {
+    NoGaugeOrder() { }
+  };
+
+  /**
+     @brief Structure-of-arrays buffer holding the chiral halves of a
+     block of W 4-d sites over the whole fifth dimension.  Half h
+     (h = 0, 1) of slice s is stored as N = 4*nColor reals per lane,
+     with element k of lane w at v[((h*Ls + s)*N + k)*W + w].
+
+     In the DeGrand-Rossi basis half 0 is spins (0,1) and half 1 is
+     spins (2,3); in the UKQCD basis they are (psi_0 + psi_2)/2 and
+     (psi_0 - psi_2)/2 (and likewise for spins 1 and 3).  Without
+     dagger half 0 hops from s-1 and half 1 from s+1.
+   */
+  template <typename Float, int nColor, int W>
+  struct ChiralBlock {
+    static constexpr int N = 4*nColor;
+    const int Ls;
+    std::vector<Float> v;
+
+    ChiralBlock(int Ls) : Ls(Ls), v(2*Ls*N*W) { }
+    inline Float* operator()(int h, int s) { return &v[(h*Ls + s)*N*W]; }
+    inline const Float* operator()(int h, int s) const { return &v[(h*Ls + s)*N*W]; }
+
+    /** @brief Split vector in into its chiral halves in lane w of slice s */
+    inline void insert(const ColorSpinor<Float,nColor,4> &in, int s, int w, bool ukqcd) {
+      Float *lo = (*this)(0,s), *hi = (*this)(1,s);
+      for (int sp=0; sp<2; sp++) {
+	for (int col=0; col<nColor; col++) {
+	  const int k = 2*(sp*nColor + col);
+	  complex<Float> l = in(sp,col), h = in(sp+2,col);
+	  if (ukqcd) { complex<Float> t = l; l = static_cast<Float>(0.5)*(t + h); h = static_cast<Float>(0.5)*(t - h); }
+	  lo[(k+0)*W + w] = l.real(); lo[(k+1)*W + w] = l.imag();
+	  hi[(k+0)*W + w] = h.real(); hi[(k+1)*W + w] = h.imag();
+	}
+      }
+    }
+
+    /** @brief Recombine the chiral halves in lane w of slice s */
+    inline ColorSpinor<Float,nColor,4> extract(int s, int w, bool ukqcd) const {
+      ColorSpinor<Float,nColor,4> out;
+      const Float *lo = (*this)(0,s), *hi = (*this)(1,s);
+      for (int sp=0; sp<2; sp++) {
+	for (int col=0; col<nColor; col++) {
+	  const int k = 2*(sp*nColor + col);
+	  complex<Float> l(lo[(k+0)*W + w], lo[(k+1)*W + w]), h(hi[(k+0)*W + w], hi[(k+1)*W + w]);
+	  out(sp,col) = ukqcd ? l + h : l;
+	  out(sp+2,col) = ukqcd ? l - h : h;
+	}
+      }
+      return out;
+    }
+
+    /** @brief Zero lane w of slice s, used to pad partial blocks */
+    inline void zero(int s, int w) {
+      for (int h=0; h<2; h++) {
+	Float *p = (*this)(h,s);
+	for (int k=0; k<N; k++) p[k*W + w] = 0.0;
+      }
+    }
+  };
+
+  /**
+     @brief Apply M5 to one chiral half of a block
+
+     y(s) = a_s x(s) + 2 b_s x(s-dir)
+
+     where dir = +1 (-1) hops from s-1 (s+1) and the hop across the
+     wall is multiplied by -mf.
+   */
+  template <typename Float, int N, int W, typename Arg>
+  inline void applyM5(const Arg &arg, Float *y, const Float *x, int dir)
+  {
+    const int Ls = arg.Ls;
+    for (int s=0; s<Ls; s++) {
+      const int sp = s - dir;
+      const bool wall = (sp < 0 || sp >= Ls);
+      const Float a = arg.a[s];
+      const Float b = 2 * arg.b[s] * (wall ? -arg.mf : static_cast<Float>(1.0));
+      const Float *xs = x + s*N*W;
+      const Float *xp = x + ((sp + Ls) % Ls)*N*W;
+      Float *ys = y + s*N*W;
+      for (int k=0; k<N; k++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) ys[k*W+w] = a * xs[k*W+w] + b * xp[k*W+w];
+      }
+    }
+  }
+
+  /**
+     @brief Apply M5^{-1} to one chiral half of a block.  With
+     g(s) = x(s)/a_s and c_s = -2 b_s/a_s the system M5 y = x reads
+
+     y(s) = g(s) + c_s y(s-dir),  with y(s-dir) -> -mf y(s-dir) across the wall
+
+     Accumulating the cycle once gives the slice next to the wall,
+     y_last = norm sum_j (prod_{i after j} c_i) g(j), after which a
+     single sweep recovers every other slice.
+   */
+  template <typename Float, int N, int W, typename Arg>
+  inline void applyM5inv(const Arg &arg, Float *y, const Float *x, int dir)
+  {
+    const int Ls = arg.Ls;
+    const int first = dir > 0 ? 0 : Ls-1; // the slice that hops across the wall
+    const int last = dir > 0 ? Ls-1 : 0;  // the slice it hops from
+    Float acc[N][W];
+    for (int k=0; k<N; k++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) acc[k][w] = 0.0;
+    }
+
+    for (int i=0; i<Ls; i++) {
+      const int s = first + i*dir;
+      const Float c = arg.c[s], ai = arg.a_inv[s];
+      const Float *xs = x + s*N*W;
+      for (int k=0; k<N; k++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) acc[k][w] = c * acc[k][w] + ai * xs[k*W+w];
+      }
+    }
+
+    Float *yl = y + last*N*W;
+    for (int k=0; k<N; k++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) yl[k*W+w] = arg.norm * acc[k][w];
+    }
+
+    for (int i=0; i<Ls-1; i++) {
+      const int s = first + i*dir;
+      const int sp = (i == 0) ? last : s - dir;
+      const Float c = arg.c[s] * (i == 0 ? -arg.mf : static_cast<Float>(1.0)), ai = arg.a_inv[s];
+      const Float *xs = x + s*N*W;
+      const Float *yp = y + sp*N*W;
+      Float *ys = y + s*N*W;
+      for (int k=0; k<N; k++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) ys[k*W+w] = ai * xs[k*W+w] + c * yp[k*W+w];
+      }
+    }
+  }
+
+  /**
+     @brief Apply M5 or M5^{-1} to both chiral halves of a block.
+     Dagger exchanges the direction in which the two halves hop.
+   */
+  template <typename Float, int nColor, int W, bool dagger, typename Arg>
+  inline void applyFifthDim(const Arg &arg, ChiralBlock<Float,nColor,W> &y, const ChiralBlock<Float,nColor,W> &x)
+  {
+    constexpr int N = ChiralBlock<Float,nColor,W>::N;
+    for (int h=0; h<2; h++) {
+      const int dir = (h == 0) != dagger ? 1 : -1;
+      if (arg.inverse) applyM5inv<Float,N,W>(arg, y(h,0), x(h,0), dir);
+      else applyM5<Float,N,W>(arg, y(h,0), x(h,0), dir);
+    }
+  }
+
+  /**
+     @brief Store a block, out(s) = alpha_s y(s) + beta_s x(s)
+   */
+  template <typename Float, int nColor, int W, typename Arg>
+  inline void storeBlock(Arg &arg, const ChiralBlock<Float,nColor,W> &y, int x0, int nLane, int parity)
+  {
+    typedef ColorSpinor<Float,nColor,4> Vector;
+    const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+    for (int s=0; s<arg.Ls; s++) {
+      for (int w=0; w<nLane; w++) {
+	const int idx = s*arg.volume4CB + x0 + w;
+	Vector out = arg.alpha[s] * y.extract(s, w, arg.ukqcd);
+	if (arg.isXpay()) {
+	  Vector x = arg.x(idx, my_spinor_parity);
+	  out += arg.beta[s] * x;
+	}
+	arg.out(idx, my_spinor_parity) = out;
+      }
+    }
+  }
+
+  /**
+     Applies the fifth-dimension operator to the block of W 4-d sites
+     starting at x0
+
+     out(s) = alpha_s (M5^{+-1} in)(s) + beta_s x(s)
+   */
+  template <typename Float, int nColor, bool dagger, typename Arg>
+  void domainWall5DBlock(Arg &arg, ChiralBlock<Float,nColor,host_simd_width> &in,
+			 ChiralBlock<Float,nColor,host_simd_width> &out, int x0, int parity)
+  {
+    typedef ColorSpinor<Float,nColor,4> Vector;
+    constexpr int W = host_simd_width;
+    const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+    const int nLane = std::min(W, arg.volume4CB - x0);
+    for (int s=0; s<arg.Ls; s++) {
+      for (int w=0; w<nLane; w++) {
+	Vector v = arg.in(s*arg.volume4CB + x0 + w, my_spinor_parity);
+	in.insert(v, s, w, arg.ukqcd);
+      }
+      for (int w=nLane; w<W; w++) in.zero(s, w);
+    }
+    applyFifthDim<Float,nColor,W,dagger>(arg, out, in);
+    storeBlock<Float,nColor,W>(arg, out, x0, nLane, parity);
+  }
+
+  /**
+     @brief Gather the input vector one hop away from coord in
+     dimension d, reading from the ghost zone when the neighbour is
+     off-node
+   */
+  template <typename Vector, int dir, typename Arg>
+  __device__ __host__ inline Vector gatherNeighbor(const Arg &arg, const int coord[5], int d, int parity)
+  {
+    const int y = dir ? coord[d] + 1 : coord[d] - 1;
+    int c[5] = { coord[0], coord[1], coord[2], coord[3], coord[4] };
+    if ( arg.commDim[d] && (y < 0 || y >= arg.dim[d]) ) {
+      return arg.in.Ghost(d, dir, ghostFaceIndex<dir>(coord, arg.dim, d, arg.nFace), parity);
+    } else {
+      c[d] = (y + arg.dim[d]) % arg.dim[d];
+      return arg.in(linkIndex(c, arg.dim) + coord[4]*arg.volume4CB, parity);
+    }
+  }
+
+  /**
+     Applies the 4-d Wilson hopping term followed by the
+     fifth-dimension operator to the block of W 4-d sites starting at
+     x0
+
+     out(s) = alpha_s (M5^{+-1} D4 in)(s) + beta_s x(s)
+
+     The eight links of each site are loaded once for all Ls slices,
+     and the hopping term of the whole block stays in the chiral
+     buffer while the fifth-dimension operator is applied to it.
+   */
+  template <typename Float, int nColor, bool dagger, typename Arg>
+  void domainWall4DBlock(Arg &arg, ChiralBlock<Float,nColor,host_simd_width> &hop,
+			 ChiralBlock<Float,nColor,host_simd_width> &out, int x0, int parity)
+  {
+    typedef ColorSpinor<Float,nColor,4> Vector;
+    typedef ColorSpinor<Float,nColor,2> HalfVector;
+    typedef Matrix<complex<Float>,nColor> Link;
+    constexpr int W = host_simd_width;
+    const int their_spinor_parity = (arg.nParity == 2) ? 1-parity : 0;
+    const int fwd_sign = dagger ? 1 : -1;
+    const int nLane = std::min(W, arg.volume4CB - x0);
+
+    for (int w=0; w<nLane; w++) {
+      const int x_cb = x0 + w;
+      int coord[5];
+      getCoords(coord, x_cb, arg.dim, parity);
+      coord[4] = 0;
+
+      Link Ufwd[4], Uback[4];
+#pragma unroll
+      for (int d=0; d<4; d++) {
+	Ufwd[d] = arg.U(d, x_cb, parity);
+	if ( arg.commDim[d] && (coord[d] - arg.nFace < 0) ) {
+	  const int ghost_idx = ghostFaceIndex<0>(coord, arg.gdim, d, arg.nFace);
+	  Uback[d] = arg.U.Ghost(d, ghost_idx, 1-parity);
+	} else {
+	  Uback[d] = arg.U(d, linkIndexM1(coord, arg.gdim, d), 1-parity);
+	}
+      }
+
+      for (int s=0; s<arg.Ls; s++) {
+	coord[4] = s;
+	Vector sum;
+#pragma unroll
+	for (int d=0; d<4; d++) {
+	  Vector fwd = gatherNeighbor<Vector,1>(arg, coord, d, their_spinor_parity);
+	  HalfVector fwd_proj = Ufwd[d] * fwd.project(d, fwd_sign);
+	  sum += fwd_proj.reconstruct(d, fwd_sign);
+
+	  Vector back = gatherNeighbor<Vector,0>(arg, coord, d, their_spinor_parity);
+	  HalfVector back_proj = conj(Uback[d]) * back.project(d, -fwd_sign);
+	  sum += back_proj.reconstruct(d, -fwd_sign);
+	}
+	hop.insert(sum, s, w, arg.ukqcd);
+      }
+    }
+    for (int s=0; s<arg.Ls; s++) for (int w=nLane; w<W; w++) hop.zero(s, w);
+
+    applyFifthDim<Float,nColor,W,dagger>(arg, out, hop);
+    storeBlock<Float,nColor,W>(arg, out, x0, nLane, parity);
+  }
+
+  // select the hopping (4-d) or site-diagonal (5-d) block at compile time
+  template <typename Float, int nColor, bool dagger, typename Arg, typename Block>
+  inline void domainWallBlock(Arg &arg, Block &in, Block &out, int x0, int parity, std::true_type)
+  {
+    domainWall4DBlock<Float,nColor,dagger>(arg, in, out, x0, parity);
+  }
+
+  template <typename Float, int nColor, bool dagger, typename Arg, typename Block>
+  inline void domainWallBlock(Arg &arg, Block &in, Block &out, int x0, int parity, std::false_type)
+  {
+    domainWall5DBlock<Float,nColor,dagger>(arg, in, out, x0, parity);
+  }
+
+  // CPU kernel for applying the domain-wall engine over blocks of 4-d sites
+  template <typename Float, int nColor, bool dagger, bool hopping, typename Arg>
+  void domainWallCPU(Arg arg)
+  {
+    constexpr int W = host_simd_width;
+    const int nBlock = (arg.volume4CB + W - 1) / W;
+
+    for (int parity= 0; parity < arg.nParity; parity++) {
+      // for full fields then set parity from loop else use arg setting
+      parity = (arg.nParity == 2) ? parity : arg.parity;
+
+#pragma omp parallel
+      {
+	// per-thread chiral buffers, reused for every block
+	ChiralBlock<Float,nColor,W> in(arg.Ls), out(arg.Ls);
+#pragma omp for
+	for (int b = 0; b < nBlock; b++) {
+	  domainWallBlock<Float,nColor,dagger>(arg, in, out, b*W, parity, std::integral_constant<bool,hopping>());
+	}
+      }
+    } // parity
+  }
+
+  template <typename Float, int nColor, bool hopping, typename F, typename G>
+  void ApplyDomainWallHost(ColorSpinorField &out, const ColorSpinorField &in, const G &U,
+			   const ColorSpinorField *x, const DomainWall5DParam &m5, int parity, bool dagger)
+  {
+    if (x) {
+      DomainWallHostArg<Float,nColor,F,G,true> arg(out, in, U, x, m5, parity);
+      if (dagger) domainWallCPU<Float,nColor,true,hopping>(arg);
+      else domainWallCPU<Float,nColor,false,hopping>(arg);
+    } else {
+      DomainWallHostArg<Float,nColor,F,G,false> arg(out, in, U, x, m5, parity);
+      if (dagger) domainWallCPU<Float,nColor,true,hopping>(arg);
+      else domainWallCPU<Float,nColor,false,hopping>(arg);
+    }
+  }
+
+  // template on the field orders
+  template <typename Float, int nColor>
+  void ApplyDomainWallHost(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField *U,
+			   const ColorSpinorField *x, const DomainWall5DParam &m5, int parity, bool dagger)
+  {
+    if (in.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Unsupported field order %d", in.FieldOrder());
+    typedef typename colorspinor::SpaceSpinorColorOrder<Float,4,nColor> F;
+
+    if (!U) {
+      ApplyDomainWallHost<Float,nColor,false,F>(out, in, NoGaugeOrder(), x, m5, parity, dagger);
+    } else if (U->Reconstruct() != QUDA_RECONSTRUCT_NO) {
+      errorQuda("Unsupported reconstruct type %d\n", U->Reconstruct());
+    } else if (U->Order() == QUDA_QDP_GAUGE_ORDER) {
+      typedef gauge::QDPOrder<Float,2*nColor*nColor> G;
+      ApplyDomainWallHost<Float,nColor,true,F>(out, in, G(*U), x, m5, parity, dagger);
+    } else if (U->Order() == QUDA_MILC_GAUGE_ORDER) {
+      typedef gauge::MILCOrder<Float,2*nColor*nColor> G;
+      ApplyDomainWallHost<Float,nColor,true,F>(out, in, G(*U), x, m5, parity, dagger);
+    } else {
+      errorQuda("Unsupported gauge field order %d", U->Order());
+    }
+  }
+
+  // template on the number of colors
+  template <typename Float>
+  void ApplyDomainWallHost(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField *U,
+			   const ColorSpinorField *x, const DomainWall5DParam &m5, int parity, bool dagger)
+  {
+    if (in.Ncolor() == 3) {
+      ApplyDomainWallHost<Float,3>(out, in, U, x, m5, parity, dagger);
+    } else {
+      errorQuda("Unsupported number of colors %d\n", in.Ncolor());
+    }
+  }
+
+  // template on the precision
+  static void ApplyDomainWallHost(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField *U,
+				  const ColorSpinorField *x, const DomainWall5DParam &m5, int parity, bool dagger)
+  {
+    if (in.V() == out.V()) errorQuda("Aliasing pointers");
+    if (in.Ndim() != 5 || out.Ndim() != 5) errorQuda("Wrong number of dimensions %d %d", in.Ndim(), out.Ndim());
+    if (in.Nspin() != 4) errorQuda("Unsupported number of spins %d", in.Nspin());
+    if (in.FieldOrder() != out.FieldOrder())
+      errorQuda("Field order mismatch in = %d, out = %d", in.FieldOrder(), out.FieldOrder());
+    if (in.GammaBasis() != out.GammaBasis())
+      errorQuda("Gamma basis mismatch in = %d, out = %d", in.GammaBasis(), out.GammaBasis());
+    if (in.GammaBasis() != QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS)
+      errorQuda("Unsupported gamma basis %d", in.GammaBasis());
+
+    const int Ls = in.X(4);
+    if ((int)m5.a.size() != Ls || (int)m5.b.size() != Ls || (int)m5.alpha.size() != Ls || (int)m5.beta.size() != Ls)
+      errorQuda("Fifth-dimension coefficients do not match Ls = %d", Ls);
+
+    checkPrecision(out, in);
+    checkLocation(out, in);
+    if (x) {
+      if (x->V() == out.V()) errorQuda("Aliasing pointers");
+      checkPrecision(out, *x);
+      checkLocation(out, *x);
+    }
+    if (in.Location() != QUDA_CPU_FIELD_LOCATION)
+      errorQuda("Domain-wall engine only supported on the host");
+
+    if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+      ApplyDomainWallHost<double>(out, in, U, x, m5, parity, dagger);
+    } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+      ApplyDomainWallHost<float>(out, in, U, x, m5, parity, dagger);
+    } else {
+      errorQuda("Unsupported precision %d\n", in.Precision());
+    }
+  }
+
+  // Apply the fifth-dimension operator
+  // out(s) = alpha_s (M5^{+-1} in)(s) + beta_s x(s)
+  void ApplyDomainWall5D(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField *x,
+			 const DomainWall5DParam &m5, bool dagger)
+  {
+    // the operator is site diagonal in 4-d, so the parity only labels the output
+    ApplyDomainWallHost(out, in, nullptr, x, m5, 0, dagger);
+  }
+
+  // Apply the 4-d hopping term fused with the fifth-dimension operator
+  // out(s) = alpha_s (M5^{+-1} D4 in)(s) + beta_s x(s)
+  void ApplyDomainWall4D(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			 const ColorSpinorField *x, const DomainWall5DParam &m5, int parity, bool dagger)
+  {
+    if (in.GammaBasis() != QUDA_UKQCD_GAMMA_BASIS)
+      errorQuda("4-d hopping term requires the UKQCD gamma basis, not %d", in.GammaBasis());
+    if (in.DWFPCtype() != QUDA_4D_PC) errorQuda("4-d hopping term requires 4-d preconditioned fields");
+    checkPrecision(in, U);
+    checkLocation(in, U);
+
+    const int nFace = 1;
+    for (int d=0; d<4; d++) {
+      if (!comm_dim_partitioned(d)) continue;
+      if (U.GhostExchange() != QUDA_GHOST_EXCHANGE_PAD || U.Nface() < nFace)
+	errorQuda("Partitioned dimension %d requires a gauge ghost zone (nFace=%d)", d, U.Nface());
+    }
+
+    in.exchangeGhost((QudaParity)(1-parity), nFace, dagger);
+
+    ApplyDomainWallHost(out, in, &U, x, m5, parity, dagger);
+  }
+
+} // namespace quda
@@ -0,0 +1,260 @@
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <color_spinor.h>
+#include <color_spinor_field.h>
+#include <color_spinor_field_order.h>
+#include <stencil.h>
+
+/**
+   This is the host improved-staggered operator: one-hop fat links
+   and three-hop (Naik) long links, with a three-deep ghost zone in
+   the partitioned dimensions.
+*/
+
+namespace quda {
+
+  /**
+     @brief Parameter structure for driving the host improved
+     staggered operator
+   */
+  template <typename Float, int nColor, typename F_, typename G_, bool xpay>
+  struct ImprovedStaggeredArg {
+    typedef F_ F;
+    typedef G_ G;
+
+    F out;                // output vector field
+    const F in;           // input vector field
+    const F x;            // input vector when doing xpay
+    const G U;            // the fat links
+    const G L;            // the long links
+    const Float a;        // xpay scale factor
+    const int parity;     // only use this for single parity fields
+    const int nParity;    // number of parities we're working on
+    const int nFace;      // depth of the spinor ghost zone
+    const int nFaceU;     // depth of the fat-link ghost zone
+    const int nFaceL;     // depth of the long-link ghost zone
+    const int dim[5];     // full lattice dimensions, with the number of sources in dim[4]
+    const int gdim[5];    // full lattice dimensions of the gauge field
+    const int commDim[4]; // whether a given dimension is partitioned or not
+    const int volume4CB;  // checkerboarded 4-d volume
+    const int Ls;         // number of sources (size of the fifth dimension)
+
+    __host__ __device__ static constexpr bool isXpay() { return xpay; }
+
+    ImprovedStaggeredArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			 const GaugeField &L, Float a, const ColorSpinorField *x, int parity)
+      : out(out), in(in, 3), x(xpay ? *x : in), U(U), L(L), a(a), parity(parity),
+	nParity(in.SiteSubset()), nFace(3), nFaceU(U.Nface()), nFaceL(L.Nface()),
+	dim{ (3-nParity) * in.X(0), in.X(1), in.X(2), in.X(3), in.Ndim() == 5 ? in.X(4) : 1 },
+	gdim{ (3-nParity) * in.X(0), in.X(1), in.X(2), in.X(3), 1 },
+      commDim{comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3)},
+      volume4CB(in.VolumeCB() / (in.Ndim() == 5 ? in.X(4) : 1)), Ls(in.Ndim() == 5 ? in.X(4) : 1)
+    { }
+  };
+
+  /**
+     @brief Gather the input vector hop sites away from coord in
+     dimension d, reading from the ghost zone when the neighbour is
+     off-node.  The ghost zone is nFace deep and its slices are
+     ordered outwards-in, so the neighbour at -1 is the last slice of
+     the backwards ghost and the neighbour at X[d] the first slice of
+     the forwards ghost.
+   */
+  template <typename Vector, int dir, typename Arg>
+  __device__ __host__ inline Vector gatherHop(const Arg &arg, const int coord[5], int d, int hop, int parity)
+  {
+    const int y = dir ? coord[d] + hop : coord[d] - hop;
+    int c[5] = { coord[0], coord[1], coord[2], coord[3], coord[4] };
+    if ( arg.commDim[d] && (y < 0 || y >= arg.dim[d]) ) {
+      c[d] = dir ? y - arg.nFace : y + arg.nFace;
+      return arg.in.Ghost(d, dir, ghostFaceIndex<dir>(c, arg.dim, d, arg.nFace), parity);
+    } else {
+      c[d] = (y + arg.dim[d]) % arg.dim[d];
+      return arg.in(linkIndex(c, arg.dim) + coord[4]*arg.volume4CB, parity);
+    }
+  }
+
+  /**
+     @brief Load the link pointing into coord from the site hop sites
+     behind it in dimension d, reading from the gauge ghost zone when
+     that site is off-node
+   */
+  template <typename Link, typename G, typename Arg>
+  __device__ __host__ inline Link backLink(const G &U, int nFace, const Arg &arg, const int coord[5],
+					   int d, int hop, int parity)
+  {
+    const int y = coord[d] - hop;
+    int c[5] = { coord[0], coord[1], coord[2], coord[3], 0 };
+    if ( arg.commDim[d] && y < 0 ) {
+      c[d] = y + nFace;
+      return U.Ghost(d, ghostFaceIndex<0>(c, arg.gdim, d, nFace), parity);
+    } else {
+      c[d] = (y + arg.gdim[d]) % arg.gdim[d];
+      return U(d, linkIndex(c, arg.gdim), parity);
+    }
+  }
+
+  /**
+     Applies the improved staggered operator at 4-d site x_cb to
+     every source in the fifth dimension
+
+     out(x) = \sum_mu F_mu(x) in(x+mu) + L_mu(x) in(x+3mu)
+                   - F^\dagger_mu(x-mu) in(x-mu) - L^\dagger_mu(x-3mu) in(x-3mu)
+
+     negated when applying the Hermitian conjugate, and replaced by
+     a * x - out for xpay.  The sixteen links touching the site are
+     loaded once and reused for every source.
+
+     @param[in] arg Parameter struct
+     @param[in] x_cb The checkerboarded 4-d site index
+     @param[in] parity The site parity
+   */
+  template <typename Float, int nColor, bool dagger, typename Arg>
+  __device__ __host__ inline void improvedStaggered(Arg &arg, int x_cb, int parity)
+  {
+    typedef ColorSpinor<Float,nColor,1> Vector;
+    typedef Matrix<complex<Float>,nColor> Link;
+    const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+    const int their_spinor_parity = (arg.nParity == 2) ? 1-parity : 0;
+
+    int coord[5];
+    getCoords(coord, x_cb, arg.dim, parity);
+    coord[4] = 0;
+
+    Link Ufwd[4], Lfwd[4], Uback[4], Lback[4];
+#pragma unroll
+    for (int d=0; d<4; d++) {
+      Ufwd[d] = arg.U(d, x_cb, parity);
+      Lfwd[d] = arg.L(d, x_cb, parity);
+      Uback[d] = backLink<Link>(arg.U, arg.nFaceU, arg, coord, d, 1, 1-parity);
+      Lback[d] = backLink<Link>(arg.L, arg.nFaceL, arg, coord, d, 3, 1-parity);
+    }
+
+    for (int s=0; s<arg.Ls; s++) {
+      coord[4] = s;
+
+      Vector fwd, back;
+#pragma unroll
+      for (int d=0; d<4; d++) {
+	fwd += Ufwd[d] * gatherHop<Vector,1>(arg, coord, d, 1, their_spinor_parity);
+	fwd += Lfwd[d] * gatherHop<Vector,1>(arg, coord, d, 3, their_spinor_parity);
+	back += conj(Uback[d]) * gatherHop<Vector,0>(arg, coord, d, 1, their_spinor_parity);
+	back += conj(Lback[d]) * gatherHop<Vector,0>(arg, coord, d, 3, their_spinor_parity);
+      }
+
+      Vector out = dagger ? back - fwd : fwd - back;
+      const int idx = s*arg.volume4CB + x_cb;
+      if (arg.isXpay()) {
+	Vector x = arg.x(idx, my_spinor_parity);
+	out = arg.a * x - out;
+      }
+      arg.out(idx, my_spinor_parity) = out;
+    }
+  }
+
+  // CPU kernel for applying the improved staggered operator
+  template <typename Float, int nColor, bool dagger, typename Arg>
+  void improvedStaggeredCPU(Arg arg)
+  {
+    for (int parity= 0; parity < arg.nParity; parity++) {
+      // for full fields then set parity from loop else use arg setting
+      parity = (arg.nParity == 2) ? parity : arg.parity;
+
+#pragma omp parallel for
+      for (int x_cb = 0; x_cb < arg.volume4CB; x_cb++) { // 4-d volume
+	improvedStaggered<Float,nColor,dagger>(arg, x_cb, parity);
+      } // 4-d volumeCB
+    } // parity
+  }
+
+  template <typename Float, int nColor, typename F, typename G>
+  void ApplyImprovedStaggered(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			      const GaugeField &L, double a, const ColorSpinorField *x, int parity, bool dagger)
+  {
+    if (x) {
+      ImprovedStaggeredArg<Float,nColor,F,G,true> arg(out, in, U, L, a, x, parity);
+      if (dagger) improvedStaggeredCPU<Float,nColor,true>(arg);
+      else improvedStaggeredCPU<Float,nColor,false>(arg);
+    } else {
+      ImprovedStaggeredArg<Float,nColor,F,G,false> arg(out, in, U, L, a, x, parity);
+      if (dagger) improvedStaggeredCPU<Float,nColor,true>(arg);
+      else improvedStaggeredCPU<Float,nColor,false>(arg);
+    }
+  }
+
+  // template on the field orders
+  template <typename Float, int nColor>
+  void ApplyImprovedStaggered(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			      const GaugeField &L, double a, const ColorSpinorField *x, int parity, bool dagger)
+  {
+    if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+	U.Reconstruct() == QUDA_RECONSTRUCT_NO && L.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+      typedef typename colorspinor::SpaceSpinorColorOrder<Float,1,nColor> F;
+      if (U.Order() != L.Order()) errorQuda("Fat link order %d and long link order %d differ", U.Order(), L.Order());
+      if (U.Order() == QUDA_QDP_GAUGE_ORDER) {
+	ApplyImprovedStaggered<Float,nColor,F,gauge::QDPOrder<Float,2*nColor*nColor> >(out, in, U, L, a, x, parity, dagger);
+      } else if (U.Order() == QUDA_MILC_GAUGE_ORDER) {
+	ApplyImprovedStaggered<Float,nColor,F,gauge::MILCOrder<Float,2*nColor*nColor> >(out, in, U, L, a, x, parity, dagger);
+      } else {
+	errorQuda("Unsupported gauge field order %d", U.Order());
+      }
+    } else {
+      errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in.FieldOrder(), U.FieldOrder());
+    }
+  }
+
+  // template on the number of colors
+  template <typename Float>
+  void ApplyImprovedStaggered(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			      const GaugeField &L, double a, const ColorSpinorField *x, int parity, bool dagger)
+  {
+    if (in.Ncolor() == 3) {
+      ApplyImprovedStaggered<Float,3>(out, in, U, L, a, x, parity, dagger);
+    } else {
+      errorQuda("Unsupported number of colors %d\n", in.Ncolor());
+    }
+  }
+
+  // Apply the improved staggered operator
+  // out(x) = D in, or out(x) = a x - D in when x is defined
+  void ApplyImprovedStaggered(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+			      const GaugeField &L, double a, const ColorSpinorField *x, int parity, bool dagger)
+  {
+    if (in.V() == out.V()) errorQuda("Aliasing pointers");
+    if (in.FieldOrder() != out.FieldOrder())
+      errorQuda("Field order mismatch in = %d, out = %d", in.FieldOrder(), out.FieldOrder());
+
+    // check all precisions match
+    checkPrecision(out, in, U, L);
+
+    // check all locations match
+    checkLocation(out, in, U, L);
+    if (in.Location() != QUDA_CPU_FIELD_LOCATION)
+      errorQuda("Improved staggered operator only supported on the host");
+
+    const int nFace = 3;
+    for (int d=0; d<4; d++) {
+      if (!comm_dim_partitioned(d)) continue;
+      if (U.GhostExchange() != QUDA_GHOST_EXCHANGE_PAD || U.Nface() < 1 ||
+	  L.GhostExchange() != QUDA_GHOST_EXCHANGE_PAD || L.Nface() < nFace)
+	errorQuda("Partitioned dimension %d requires fat (nFace=%d) and long (nFace=%d) link ghost zones",
+		  d, U.Nface(), L.Nface());
+      const int X = (d == 0 ? 3-in.SiteSubset() : 1) * in.X(d);
+      if (X < nFace) errorQuda("Local extent %d in dimension %d is smaller than the ghost depth %d", X, d, nFace);
+    }
+
+    in.exchangeGhost((QudaParity)(1-parity), nFace, dagger);
+
+    if (U.Precision() == QUDA_DOUBLE_PRECISION) {
+      ApplyImprovedStaggered<double>(out, in, U, L, a, x, parity, dagger);
+    } else if (U.Precision() == QUDA_SINGLE_PRECISION) {
+      ApplyImprovedStaggered<float>(out, in, U, L, a, x, parity, dagger);
+    } else {
+      errorQuda("Unsupported precision %d\n", U.Precision());
+    }
+  }
+
+} // namespace quda
@@ -0,0 +1,472 @@
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <clover_field.h>
+#include <clover_field_order.h>
+#include <index_helper.cuh>
+#include <color_spinor.h>
+#include <color_spinor_field.h>
+#include <color_spinor_field_order.h>
+#include <tune_quda.h>
+#include <stencil.h>
+#include <algorithm>
+
+/**
+   This is a multi-flavour Wilson-type operator: the hopping term is
+   independent of the quark mass, so the links of each site are loaded
+   once and applied to every flavour, with only the site-diagonal term
+   depending on the flavour.
+*/
+
+namespace quda {
+
+  // maximum number of flavours applied per pass
+  static constexpr int max_flavor = 4;
+
+  /**
+     @brief Placeholder clover accessor used when no clover term is
+     applied
+   */
+  struct NoCloverOrder {
+    template <typename T> __device__ __host__ inline void load(T *, int, int, int) const { }
+  };
+
+  /**
+     @brief Parameter structure for driving the multi-flavour Wilson
+     operator.  The out, in and x accessors are repointed at each
+     flavour in turn from the stored per-flavour field and ghost
+     pointers.
+   */
+  template <typename Float, int nColor, typename F_, typename G_, typename C_>
+  struct WilsonMultiFlavorArg {
+    typedef F_ F;
+    typedef G_ G;
+    typedef C_ C;
+
+    F out;                // output vector field accessor
+    F in;                 // input vector field accessor
+    F x;                  // site-diagonal input accessor
+    const G U;            // the gauge field
+    const C A;            // the clover field (if any)
+    Float *out_v[max_flavor];        // output field of each flavour
+    Float *in_v[max_flavor];         // input field of each flavour
+    Float *x_v[max_flavor];          // site-diagonal input field of each flavour
+    Float *in_ghost[max_flavor][8];  // input ghost zones of each flavour
+    Float a[max_flavor];  // hopping coefficient of each flavour
+    Float b[max_flavor];  // identity coefficient of each flavour
+    Float c[max_flavor];  // clover coefficient of each flavour
+    Float d[max_flavor];  // i*gamma_5 coefficient of each flavour
+    const int nFlavor;    // number of flavours
+    const int parity;     // only use this for single parity fields
+    const int nParity;    // number of parities we're working on
+    const int nFace;      // hard code to 1 for now
+    const int dim[5];     // full lattice dimensions
+    const int commDim[4]; // whether a given dimension is partitioned or not
+    const int volumeCB;   // checkerboarded volume
+
+    WilsonMultiFlavorArg(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			 const std::vector<ColorSpinorField*> &x, const GaugeField &U, const C &A,
+			 const std::vector<WilsonFlavorParam> &flavor, int parity)
+      : out(*out[0]), in(*in[0]), x(*x[0]), U(U), A(A), nFlavor(in.size()), parity(parity),
+	nParity(in[0]->SiteSubset()), nFace(1),
+	dim{ (3-nParity) * in[0]->X(0), in[0]->X(1), in[0]->X(2), in[0]->X(3), 1 },
+      commDim{comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3)},
+      volumeCB(in[0]->VolumeCB())
+    {
+      if (nFlavor > max_flavor) errorQuda("Number of flavors %d exceeds maximum %d", nFlavor, max_flavor);
+      for (int f=0; f<nFlavor; f++) {
+	out_v[f] = static_cast<Float*>(out[f]->V());
+	in_v[f] = static_cast<Float*>(in[f]->V());
+	x_v[f] = static_cast<Float*>(x[f]->V());
+	for (int i=0; i<8; i++) in_ghost[f][i] = static_cast<Float*>(in[f]->Ghost()[i]);
+	a[f] = flavor[f].a;
+	b[f] = flavor[f].b;
+	c[f] = flavor[f].c;
+	d[f] = flavor[f].d;
+      }
+    }
+  };
+
+  /**
+     @brief Apply one chiral block of the clover term, stored in the
+     packed format described in clover_field_order.h, to a chiral
+     half spinor
+   */
+  template <typename Float, int nColor>
+  __device__ __host__ inline void applyCloverBlock(complex<Float> out[2*nColor], const Float A[36],
+						   const complex<Float> in[2*nColor]) {
+    constexpr int N = 2*nColor;
+#pragma unroll
+    for (int i=0; i<N; i++) out[i] = A[i] * in[i];
+    int k = N;
+#pragma unroll
+    for (int col=0; col<N; col++) {
+#pragma unroll
+      for (int row=col+1; row<N; row++) {
+	const complex<Float> A_rc(A[k], A[k+1]);
+	out[row] += A_rc * in[col];
+	out[col] += conj(A_rc) * in[row];
+	k += 2;
+      }
+    }
+  }
+
+  /**
+     @brief Apply the clover term to a spinor in the UKQCD basis,
+     rotating to the chiral basis and back as in clover_core.h (the
+     factor of 1/2 from the rotation is included in the clover
+     normalization)
+   */
+  template <typename Float, int nColor>
+  __device__ __host__ inline ColorSpinor<Float,nColor,4> applyClover(const Float A[2][36], const ColorSpinor<Float,nColor,4> &in) {
+    ColorSpinor<Float,nColor,4> out;
+    complex<Float> chi[2][2*nColor], psi[2][2*nColor];
+#pragma unroll
+    for (int c=0; c<nColor; c++) {
+      chi[0][0*nColor+c] = -in(1,c) - in(3,c);
+      chi[0][1*nColor+c] =  in(0,c) + in(2,c);
+      chi[1][0*nColor+c] = -in(1,c) + in(3,c);
+      chi[1][1*nColor+c] =  in(0,c) - in(2,c);
+    }
+    applyCloverBlock<Float,nColor>(psi[0], A[0], chi[0]);
+    applyCloverBlock<Float,nColor>(psi[1], A[1], chi[1]);
+#pragma unroll
+    for (int c=0; c<nColor; c++) {
+      out(0,c) =  psi[0][1*nColor+c] + psi[1][1*nColor+c];
+      out(1,c) = -psi[0][0*nColor+c] - psi[1][0*nColor+c];
+      out(2,c) =  psi[0][1*nColor+c] - psi[1][1*nColor+c];
+      out(3,c) = -psi[0][0*nColor+c] + psi[1][0*nColor+c];
+    }
+    return out;
+  }
+
+  /**
+     Computes for each flavour f
+
+     out_f(x) = a_f * D in_f(x) + b_f x_f(x) + c_f A x_f(x) + i d_f gamma_5 x_f(x)
+
+     where D is the Wilson hopping term and A the clover term.  The
+     eight links of the site, and the clover term, are loaded once
+     and applied to every flavour.
+   */
+  template <typename Float, int nColor, bool dagger, bool clover, typename Arg>
+  __device__ __host__ inline void wilsonMultiFlavor(Arg &arg, int x_cb, int parity)
+  {
+    typedef ColorSpinor<Float,nColor,4> Vector;
+    typedef ColorSpinor<Float,nColor,2> HalfVector;
+    typedef Matrix<complex<Float>,nColor> Link;
+    const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+    const int their_spinor_parity = (arg.nParity == 2) ? 1-parity : 0;
+    const int fwd_sign = dagger ? 1 : -1;
+
+    int coord[5];
+    getCoords(coord, x_cb, arg.dim, parity);
+    coord[4] = 0;
+
+    Link Ufwd[4], Uback[4];
+#pragma unroll
+    for (int d=0; d<4; d++) {
+      Ufwd[d] = arg.U(d, x_cb, parity);
+      if ( arg.commDim[d] && (coord[d] - arg.nFace < 0) ) {
+	const int ghost_idx = ghostFaceIndex<0>(coord, arg.dim, d, arg.nFace);
+	Uback[d] = arg.U.Ghost(d, ghost_idx, 1-parity);
+      } else {
+	Uback[d] = arg.U(d, linkIndexM1(coord, arg.dim, d), 1-parity);
+      }
+    }
+
+    Float A[2][36];
+    if (clover) {
+      arg.A.load(A[0], x_cb, parity, 0);
+      arg.A.load(A[1], x_cb, parity, 1);
+    }
+
+    for (int f=0; f<arg.nFlavor; f++) {
+      // point the accessors at this flavour
+      typename Arg::F in = arg.in;
+      in.field = arg.in_v[f];
+#pragma unroll
+      for (int i=0; i<8; i++) in.ghost[i] = arg.in_ghost[f][i];
+
+      Vector out;
+#pragma unroll
+      for (int d=0; d<4; d++) {
+	//Forward gather - compute fwd offset for spinor fetch
+	Vector fwd;
+	if ( arg.commDim[d] && (coord[d] + arg.nFace >= arg.dim[d]) ) {
+	  const int ghost_idx = ghostFaceIndex<1>(coord, arg.dim, d, arg.nFace);
+	  fwd = in.Ghost(d, 1, ghost_idx, their_spinor_parity);
+	} else {
+	  fwd = in(linkIndexP1(coord, arg.dim, d), their_spinor_parity);
+	}
+	HalfVector fwd_proj = Ufwd[d] * fwd.project(d, fwd_sign);
+	out += fwd_proj.reconstruct(d, fwd_sign);
+
+	//Backward gather - compute back offset for spinor fetch
+	Vector back;
+	if ( arg.commDim[d] && (coord[d] - arg.nFace < 0) ) {
+	  const int ghost_idx = ghostFaceIndex<0>(coord, arg.dim, d, arg.nFace);
+	  back = in.Ghost(d, 0, ghost_idx, their_spinor_parity);
+	} else {
+	  back = in(linkIndexM1(coord, arg.dim, d), their_spinor_parity);
+	}
+	HalfVector back_proj = conj(Uback[d]) * back.project(d, -fwd_sign);
+	out += back_proj.reconstruct(d, -fwd_sign);
+      }
+
+      typename Arg::F x = arg.x;
+      x.field = arg.x_v[f];
+      Vector x_site = x(x_cb, my_spinor_parity);
+      Vector diag = arg.b[f] * x_site;
+      if (clover) diag += arg.c[f] * applyClover<Float,nColor>(A, x_site);
+      if (arg.d[f] != static_cast<Float>(0.0)) {
+	// i d gamma_5 in the UKQCD basis swaps the upper and lower spins
+	const complex<Float> id(0.0, dagger ? -arg.d[f] : arg.d[f]);
+#pragma unroll
+	for (int c=0; c<nColor; c++) {
+	  diag(0,c) += id * x_site(2,c);
+	  diag(1,c) += id * x_site(3,c);
+	  diag(2,c) += id * x_site(0,c);
+	  diag(3,c) += id * x_site(1,c);
+	}
+      }
+
+      typename Arg::F o = arg.out;
+      o.field = arg.out_v[f];
+      o(x_cb, my_spinor_parity) = arg.a[f] * out + diag;
+    }
+  }
+
+  // CPU kernel for applying the multi-flavour operator
+  template <typename Float, int nColor, bool dagger, bool clover, typename Arg>
+  void wilsonMultiFlavorCPU(Arg arg)
+  {
+    for (int parity= 0; parity < arg.nParity; parity++) {
+      // for full fields then set parity from loop else use arg setting
+      parity = (arg.nParity == 2) ? parity : arg.parity;
+
+#pragma omp parallel for
+      for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
+	wilsonMultiFlavor<Float,nColor,dagger,clover>(arg, x_cb, parity);
+      } // 4-d volumeCB
+    } // parity
+  }
+
+  // GPU Kernel for applying the multi-flavour operator
+  template <typename Float, int nColor, bool dagger, bool clover, typename Arg>
+  __global__ void wilsonMultiFlavorGPU(Arg arg)
+  {
+    int x_cb = blockIdx.x*blockDim.x + threadIdx.x;
+
+    // for full fields set parity from y thread index else use arg setting
+    int parity = blockDim.y*blockIdx.y + threadIdx.y;
+
+    if (x_cb >= arg.volumeCB) return;
+    if (parity >= arg.nParity) return;
+    parity = (arg.nParity == 2) ? parity : arg.parity;
+
+    wilsonMultiFlavor<Float,nColor,dagger,clover>(arg, x_cb, parity);
+  }
+
+  template <typename Float, int nColor, bool clover, typename Arg>
+  class WilsonMultiFlavor : public TunableVectorY {
+
+  protected:
+    Arg &arg;
+    const ColorSpinorField &meta;
+    const bool dagger;
+
+    long long flops() const
+    {
+      // Wilson hopping term, site term and axpy, plus the clover term
+      long long site = 1320ll + 72ll + (clover ? 552ll : 0ll);
+      return site*arg.nFlavor*arg.nParity*(long long)meta.VolumeCB();
+    }
+    long long bytes() const
+    {
+      return (arg.out.Bytes() + 9*arg.in.Bytes() + arg.x.Bytes())*arg.nFlavor +
+	arg.nParity*(8*arg.U.Bytes() + (clover ? 72*sizeof(Float) : 0))*meta.VolumeCB();
+    }
+    bool tuneGridDim() const { return false; }
+    unsigned int minThreads() const { return arg.volumeCB; }
+    unsigned int maxBlockSize() const { return deviceProp.maxThreadsPerBlock / arg.nParity; }
+
+  public:
+    WilsonMultiFlavor(Arg &arg, const ColorSpinorField &meta, bool dagger)
+      : TunableVectorY(arg.nParity), arg(arg), meta(meta), dagger(dagger)
+    {
+      strcpy(aux, meta.AuxString());
+      strcat(aux, comm_dim_partitioned_string());
+      char nflavor[16];
+      sprintf(nflavor, ",nflavor=%d", arg.nFlavor);
+      strcat(aux, nflavor);
+      if (dagger) strcat(aux, ",dagger");
+    }
+    virtual ~WilsonMultiFlavor() { }
+
+    void apply(const cudaStream_t &stream) {
+      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
+	if (dagger) wilsonMultiFlavorCPU<Float,nColor,true,clover>(arg);
+	else wilsonMultiFlavorCPU<Float,nColor,false,clover>(arg);
+      } else {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	if (dagger) wilsonMultiFlavorGPU<Float,nColor,true,clover> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
+	else wilsonMultiFlavorGPU<Float,nColor,false,clover> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
+      }
+    }
+
+    TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
+  };
+
+  template <typename Float, int nColor, typename F, typename G, typename C, bool clover>
+  void ApplyWilsonMultiFlavor(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const C &A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    typedef WilsonMultiFlavorArg<Float,nColor,F,G,C> Arg;
+    Arg arg(out, in, x, U, A, flavor, parity);
+    WilsonMultiFlavor<Float,nColor,clover,Arg> wilson(arg, *in[0], dagger);
+    wilson.apply(0);
+  }
+
+  // template on the clover field order
+  template <typename Float, int nColor, typename F, typename G>
+  void ApplyWilsonMultiFlavor(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    if (!A) {
+      ApplyWilsonMultiFlavor<Float,nColor,F,G,NoCloverOrder,false>(out, in, x, U, NoCloverOrder(), flavor, parity, dagger);
+    } else if (A->isNative()) {
+      typedef typename clover_mapper<Float>::type C;
+      ApplyWilsonMultiFlavor<Float,nColor,F,G,C,true>(out, in, x, U, C(*A, false), flavor, parity, dagger);
+    } else if (A->Order() == QUDA_PACKED_CLOVER_ORDER) {
+      typedef clover::QDPOrder<Float,72> C;
+      ApplyWilsonMultiFlavor<Float,nColor,F,G,C,true>(out, in, x, U, C(*A, false), flavor, parity, dagger);
+    } else {
+      errorQuda("Unsupported clover field order %d", A->Order());
+    }
+  }
+
+  // template on the field orders
+  template <typename Float, int nColor, QudaReconstructType recon>
+  void ApplyWilsonMultiFlavor(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    if (in[0]->isNative() && U.isNative()) {
+      typedef typename colorspinor_mapper<Float,4,nColor>::type F;
+      typedef typename gauge_mapper<Float,recon>::type G;
+      ApplyWilsonMultiFlavor<Float,nColor,F,G>(out, in, x, U, A, flavor, parity, dagger);
+    } else if (in[0]->FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && recon == QUDA_RECONSTRUCT_NO) {
+      typedef typename colorspinor::SpaceSpinorColorOrder<Float,4,nColor> F;
+      if (U.Order() == QUDA_QDP_GAUGE_ORDER) {
+	ApplyWilsonMultiFlavor<Float,nColor,F,gauge::QDPOrder<Float,2*nColor*nColor> >(out, in, x, U, A, flavor, parity, dagger);
+      } else if (U.Order() == QUDA_MILC_GAUGE_ORDER) {
+	ApplyWilsonMultiFlavor<Float,nColor,F,gauge::MILCOrder<Float,2*nColor*nColor> >(out, in, x, U, A, flavor, parity, dagger);
+      } else {
+	errorQuda("Unsupported gauge field order %d", U.Order());
+      }
+    } else {
+      errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in[0]->FieldOrder(), U.FieldOrder());
+    }
+  }
+
+  // template on the gauge reconstruction
+  template <typename Float, int nColor>
+  void ApplyWilsonMultiFlavor(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    if (U.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+      ApplyWilsonMultiFlavor<Float,nColor,QUDA_RECONSTRUCT_NO>(out, in, x, U, A, flavor, parity, dagger);
+    } else if (U.Reconstruct() == QUDA_RECONSTRUCT_12) {
+      ApplyWilsonMultiFlavor<Float,nColor,QUDA_RECONSTRUCT_12>(out, in, x, U, A, flavor, parity, dagger);
+    } else if (U.Reconstruct() == QUDA_RECONSTRUCT_8) {
+      ApplyWilsonMultiFlavor<Float,nColor,QUDA_RECONSTRUCT_8>(out, in, x, U, A, flavor, parity, dagger);
+    } else {
+      errorQuda("Unsupported reconstruct type %d\n", U.Reconstruct());
+    }
+  }
+
+  // template on the number of colors
+  template <typename Float>
+  void ApplyWilsonMultiFlavor(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    if (in[0]->Ncolor() == 3) {
+      ApplyWilsonMultiFlavor<Float,3>(out, in, x, U, A, flavor, parity, dagger);
+    } else {
+      errorQuda("Unsupported number of colors %d\n", in[0]->Ncolor());
+    }
+  }
+
+  // template on the precision
+  static void ApplyWilsonMultiFlavorBatch(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+					  const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+					  const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    const int nFace = 1;
+    for (unsigned int f=0; f<in.size(); f++) in[f]->exchangeGhost((QudaParity)(1-parity), nFace, 0); // last parameter is dummy
+
+    if (U.Precision() == QUDA_DOUBLE_PRECISION) {
+      ApplyWilsonMultiFlavor<double>(out, in, x, U, A, flavor, parity, dagger);
+    } else if (U.Precision() == QUDA_SINGLE_PRECISION) {
+      ApplyWilsonMultiFlavor<float>(out, in, x, U, A, flavor, parity, dagger);
+    } else {
+      errorQuda("Unsupported precision %d\n", U.Precision());
+    }
+  }
+
+  void ApplyWilsonMultiFlavor(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+			      const std::vector<ColorSpinorField*> &x, const GaugeField &U, const CloverField *A,
+			      const std::vector<WilsonFlavorParam> &flavor, int parity, bool dagger)
+  {
+    if (in.size() != out.size() || x.size() != out.size() || flavor.size() != out.size())
+      errorQuda("Number of output %lu, input %lu, site %lu vectors and flavors %lu differ",
+		out.size(), in.size(), x.size(), flavor.size());
+    if (in.size() == 0) return;
+
+    for (unsigned int f=0; f<in.size(); f++) {
+      if (in[f]->V() == out[f]->V() || x[f]->V() == out[f]->V()) errorQuda("Aliasing pointers");
+      if (in[f]->Nspin() != 4 || out[f]->Nspin() != 4 || x[f]->Nspin() != 4)
+	errorQuda("Unsupported number of spins %d", in[f]->Nspin());
+      if (in[f]->GammaBasis() != QUDA_UKQCD_GAMMA_BASIS || out[f]->GammaBasis() != QUDA_UKQCD_GAMMA_BASIS ||
+	  x[f]->GammaBasis() != QUDA_UKQCD_GAMMA_BASIS)
+	errorQuda("Unsupported gamma basis in = %d, out = %d, x = %d", in[f]->GammaBasis(), out[f]->GammaBasis(), x[f]->GammaBasis());
+      if (in[f]->FieldOrder() != in[0]->FieldOrder() || out[f]->FieldOrder() != in[0]->FieldOrder() ||
+	  x[f]->FieldOrder() != in[0]->FieldOrder())
+	errorQuda("Field order mismatch in = %d, out = %d, x = %d", in[f]->FieldOrder(), out[f]->FieldOrder(), x[f]->FieldOrder());
+
+      // check all precisions match
+      checkPrecision(*out[f], *in[f], U);
+      checkPrecision(*x[f], *in[0]);
+
+      // check all locations match
+      checkLocation(*out[f], *in[f], U);
+      checkLocation(*x[f], *in[0]);
+    }
+    if (A) {
+      checkPrecision(*A, U);
+      checkLocation(*A, U);
+    }
+
+    // device ghost zones share a single receive buffer, so with
+    // communication each flavour has to be exchanged and applied in turn
+    bool comms = false;
+    for (int d=0; d<4; d++) comms = comms || comm_dim_partitioned(d);
+    const int batch = (comms && in[0]->Location() == QUDA_CUDA_FIELD_LOCATION) ? 1 : max_flavor;
+
+    for (unsigned int f=0; f<in.size(); f+=batch) {
+      const unsigned int end = std::min<unsigned int>(f+batch, in.size());
+      std::vector<ColorSpinorField*> out_batch(out.begin()+f, out.begin()+end);
+      std::vector<ColorSpinorField*> in_batch(in.begin()+f, in.begin()+end);
+      std::vector<ColorSpinorField*> x_batch(x.begin()+f, x.begin()+end);
+      std::vector<WilsonFlavorParam> flavor_batch(flavor.begin()+f, flavor.begin()+end);
+      ApplyWilsonMultiFlavorBatch(out_batch, in_batch, x_batch, U, A, flavor_batch, parity, dagger);
+    }
+  }
+
+} // namespace quda
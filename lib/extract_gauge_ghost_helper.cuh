@@ -61,6 +61,15 @@ namespace quda {
 		int oddness = (a+b+c+d) & 1;
 		if (oddness == parity) {
 #ifdef FINE_GRAINED_ACCESS
+		  if (Order::fixedPoint) {
+		    if (extract) {
+		      arg.order.setGhostMax(dim+arg.offset, (parity+arg.localParity[dim])&1, indexGhost,
+					    arg.order.abs_max(dim+arg.offset, parity, indexCB));
+		    } else {
+		      arg.order.setMax(dim+arg.offset, parity, indexCB,
+				       arg.order.ghost_abs_max(dim+arg.offset, (parity+arg.localParity[dim])&1, indexGhost));
+		    }
+		  }
 		  for (int i=0; i<gauge::Ncolor(length); i++) {
 		    for (int j=0; j<gauge::Ncolor(length); j++) {
 		      if (extract) {
@@ -131,6 +140,15 @@ namespace quda {
 	int oddness = (a+b+c+d)&1;
 	if (oddness == parity) {
 #ifdef FINE_GRAINED_ACCESS
+	  if (Order::fixedPoint) {
+	    if (extract) {
+	      arg.order.setGhostMax(dim+arg.offset, (parity+arg.localParity[dim])&1, X>>1,
+				    arg.order.abs_max(dim+arg.offset, parity, indexCB));
+	    } else {
+	      arg.order.setMax(dim+arg.offset, parity, indexCB,
+			       arg.order.ghost_abs_max(dim+arg.offset, (parity+arg.localParity[dim])&1, X>>1));
+	    }
+	  }
 	  for (int i=0; i<gauge::Ncolor(length); i++) {
 	    for (int j=0; j<gauge::Ncolor(length); j++) {
 	      if (extract) {
@@ -22,7 +22,7 @@ namespace quda {
     if (u.isNative()) {
       if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 #ifdef FINE_GRAINED_ACCESS
-	typedef typename gauge::FieldOrder<Float,Nc,1,QUDA_FLOAT2_GAUGE_ORDER,false> G;
+	typedef typename gauge::FieldOrder<typename mapper<Float>::type,Nc,1,QUDA_FLOAT2_GAUGE_ORDER,false,Float> G;
 	extractGhost<Float,length>(G(const_cast<GaugeField&>(u), 0, (void**)Ghost), u, location, extract, offset);
 #else
 	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO,length>::type G;
@@ -33,7 +33,7 @@ namespace quda {
       
 #ifdef BUILD_QDP_INTERFACE
 #ifdef FINE_GRAINED_ACCESS
-      typedef typename gauge::FieldOrder<Float,Nc,1,QUDA_QDP_GAUGE_ORDER> G;
+      typedef typename gauge::FieldOrder<typename mapper<Float>::type,Nc,1,QUDA_QDP_GAUGE_ORDER,true,Float> G;
       extractGhost<Float,length>(G(const_cast<GaugeField&>(u), 0, (void**)Ghost), u, location, extract, offset);
 #else
       extractGhost<Float,length>(QDPOrder<Float,length>(u, 0, Ghost), u, location, extract, offset);
@@ -81,6 +81,8 @@ namespace quda {
 #endif
     } else if (u.Precision() == QUDA_SINGLE_PRECISION) {
       extractGhostMG(u, (float**)ghost, extract, offset);
+    } else if (u.Precision() == QUDA_HALF_PRECISION) {
+      extractGhostMG(u, (short**)ghost, extract, offset);
     } else {
       errorQuda("Unknown precision type %d", u.Precision());
     }
@@ -0,0 +1,110 @@
+#include <string.h>
+#include <vector>
+#include <field_hash.h>
+
+namespace quda {
+
+  // XXH64 primes
+  static const uint64_t P1 = 11400714785074694791ULL;
+  static const uint64_t P2 = 14029467366897019727ULL;
+  static const uint64_t P3 =  1609587929392839161ULL;
+  static const uint64_t P4 =  9650029242287828579ULL;
+  static const uint64_t P5 =  2870177450012600261ULL;
+
+  // chunk size for the threaded hash: large enough to amortize the
+  // per-chunk finalization, small enough to balance across threads
+  static const size_t hash_chunk_bytes = 1 << 20;
+
+  static inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+  static inline uint64_t read64(const unsigned char *p) { uint64_t v; memcpy(&v, p, sizeof(v)); return v; }
+  static inline uint32_t read32(const unsigned char *p) { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+
+  static inline uint64_t round(uint64_t acc, uint64_t in)
+  {
+    acc += in * P2;
+    acc = rotl(acc, 31);
+    return acc * P1;
+  }
+
+  static inline uint64_t mergeRound(uint64_t acc, uint64_t val)
+  {
+    acc ^= round(0, val);
+    return acc * P1 + P4;
+  }
+
+  uint64_t xxHash64(const void *buf, size_t bytes, uint64_t seed)
+  {
+    const unsigned char *p = static_cast<const unsigned char*>(buf);
+    const unsigned char *end = p + bytes;
+    uint64_t h;
+
+    if (bytes >= 32) {
+      const unsigned char *limit = end - 32;
+      uint64_t v1 = seed + P1 + P2;
+      uint64_t v2 = seed + P2;
+      uint64_t v3 = seed;
+      uint64_t v4 = seed - P1;
+
+      do {
+	v1 = round(v1, read64(p));      p += 8;
+	v2 = round(v2, read64(p));      p += 8;
+	v3 = round(v3, read64(p));      p += 8;
+	v4 = round(v4, read64(p));      p += 8;
+      } while (p <= limit);
+
+      h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+      h = mergeRound(h, v1);
+      h = mergeRound(h, v2);
+      h = mergeRound(h, v3);
+      h = mergeRound(h, v4);
+    } else {
+      h = seed + P5;
+    }
+
+    h += static_cast<uint64_t>(bytes);
+
+    for ( ; p + 8 <= end; p += 8) {
+      h ^= round(0, read64(p));
+      h = rotl(h, 27) * P1 + P4;
+    }
+
+    if (p + 4 <= end) {
+      h ^= static_cast<uint64_t>(read32(p)) * P1;
+      h = rotl(h, 23) * P2 + P3;
+      p += 4;
+    }
+
+    for ( ; p < end; p++) {
+      h ^= (*p) * P5;
+      h = rotl(h, 11) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+
+    return h;
+  }
+
+  uint64_t hostHash(const void *buf, size_t bytes, uint64_t seed)
+  {
+    const unsigned char *p = static_cast<const unsigned char*>(buf);
+    const long n_chunk = (bytes + hash_chunk_bytes - 1) / hash_chunk_bytes;
+    std::vector<uint64_t> chunk(n_chunk);
+
+#pragma omp parallel for
+    for (long i=0; i<n_chunk; i++) {
+      size_t offset = i * hash_chunk_bytes;
+      size_t length = (offset + hash_chunk_bytes < bytes) ? hash_chunk_bytes : bytes - offset;
+      chunk[i] = xxHash64(p + offset, length, seed);
+    }
+
+    // the total length is folded into the seed so zero-length and
+    // differently chunked buffers cannot collide trivially
+    return xxHash64(chunk.data(), n_chunk * sizeof(uint64_t), seed + bytes);
+  }
+
+} // namespace quda
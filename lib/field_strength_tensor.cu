@@ -213,6 +213,7 @@ namespace quda {
   template<typename Float, typename Fmunu, typename Gauge>
   void computeFmunuCPU(FmunuArg<Float,Fmunu,Gauge>& arg) {
     for (int parity=0; parity<2; parity++) {
+#pragma omp parallel for
       for (int idx=0; idx<arg.threads; idx++) {
 	computeFmunuCore(arg,parity,idx);
       }
@@ -261,13 +262,37 @@ namespace quda {
     FmunuArg<Float,Fmunu,Gauge> arg(f_munu, gauge, meta, meta_ex);
     FmunuCompute<Float,Fmunu,Gauge> fmunuCompute(arg, meta, location);
     fmunuCompute.apply(0);
-    cudaDeviceSynchronize();
-    checkCudaError();
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      cudaDeviceSynchronize();
+      checkCudaError();
+    }
+  }
+
+  template<typename Float, typename Gauge>
+  void computeFmunuHost(GaugeField &Fmunu, Gauge gauge, const GaugeField &meta_ex) {
+    if (Fmunu.Order() == QUDA_MILC_GAUGE_ORDER) {
+      typedef gauge::MILCOrder<Float,18> F;
+      computeFmunu<Float>(F(Fmunu), gauge, Fmunu, meta_ex, QUDA_CPU_FIELD_LOCATION);
+    } else {
+      errorQuda("Fmunu field order %d not supported on the host", Fmunu.Order());
+    }
   }
 
   template<typename Float>
   void computeFmunu(GaugeField &Fmunu, const GaugeField &gauge, QudaFieldLocation location) {
-    if (Fmunu.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      for (int d=0; d<4; d++)
+	if (comm_dim_partitioned(d) && gauge.X()[d] == Fmunu.X()[d])
+	  errorQuda("Host Fmunu requires an extended gauge field when dimension %d is partitioned", d);
+
+      if (gauge.Order() == QUDA_QDP_GAUGE_ORDER) {
+	computeFmunuHost<Float>(Fmunu, gauge::QDPOrder<Float,18>(gauge), gauge);
+      } else if (gauge.Order() == QUDA_MILC_GAUGE_ORDER) {
+	computeFmunuHost<Float>(Fmunu, gauge::MILCOrder<Float,18>(gauge), gauge);
+      } else {
+	errorQuda("Gauge field order %d not supported on the host", gauge.Order());
+      }
+    } else if (Fmunu.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
       if (gauge.isNative()) {
 	typedef gauge::FloatNOrder<Float, 18, 2, 18> F;
 
@@ -27,7 +27,9 @@ namespace quda {
   GaugeField::GaugeField(const GaugeFieldParam &param) :
     LatticeField(param), bytes(0), phase_offset(0), phase_bytes(0), nColor(param.nColor), nFace(param.nFace),
     geometry(param.geometry), reconstruct(param.reconstruct), 
-    nInternal(reconstruct != QUDA_RECONSTRUCT_NO ? reconstruct : nColor * nColor * 2),
+    // half-precision coarse links carry a float scale per link matrix in two extra shorts
+    nInternal(reconstruct != QUDA_RECONSTRUCT_NO ? reconstruct :
+	      nColor * nColor * 2 + (param.link_type == QUDA_COARSE_LINKS && param.precision == QUDA_HALF_PRECISION ? 2 : 0)),
     order(param.order), fixed(param.fixed), link_type(param.link_type), t_boundary(param.t_boundary), 
     anisotropy(param.anisotropy), tadpole(param.tadpole), fat_link_max(0.0), scale(param.scale),  
     create(param.create),
@@ -230,8 +232,9 @@ namespace quda {
     output << "nColor = " << param.nColor << std::endl;
     output << "nFace = " << param.nFace << std::endl;
     output << "reconstruct = " << param.reconstruct << std::endl;
-    int nInternal = (param.reconstruct != QUDA_RECONSTRUCT_NO ? 
-		     param.reconstruct : param.nColor * param.nColor * 2);
+    int nInternal = (param.reconstruct != QUDA_RECONSTRUCT_NO ? param.reconstruct :
+		     param.nColor * param.nColor * 2 +
+		     (param.link_type == QUDA_COARSE_LINKS && param.precision == QUDA_HALF_PRECISION ? 2 : 0));
     output << "nInternal = " << nInternal << std::endl;
     output << "order = " << param.order << std::endl;
     output << "fixed = " << param.fixed << std::endl;
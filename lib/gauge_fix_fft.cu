@@ -13,6 +13,8 @@
 
 #ifdef GPU_GAUGE_ALG
 #include <CUFFT_Plans.h>
+#include <FFT_Host.h>
+#include <gauge_fix_host.h>
 #endif
 
 namespace quda {
@@ -1187,6 +1189,219 @@ namespace quda {
     }
   }
 
+
+
+  /**
+   * @brief Host version of fft_rotate_kernel_2D2D, direction 0
+   * rotates xyzt -> ztxy and direction 1 rotates back
+   */
+  template <typename Float>
+  void fftRotateHost(const int X[4], int direction, const complex<Float> *in, complex<Float> *out){
+    const int volume = X[0] * X[1] * X[2] * X[3];
+#pragma omp parallel for
+    for ( int id = 0; id < volume; id++ ) {
+      int x0 = id % X[0];
+      int x1 = (id / X[0]) % X[1];
+      int x2 = (id / (X[0] * X[1])) % X[2];
+      int x3 = id / (X[0] * X[1] * X[2]);
+      int id_rot = x2 + (x3 + (x0 + x1 * X[0]) * X[3]) * X[2];
+      if ( direction == 0 ) out[id_rot] = in[id];
+      else out[id] = in[id_rot];
+    }
+  }
+
+  /**
+   * @brief Host version of kernel_gauge_set_invpsq, in the rotated ztxy layout
+   */
+  template <typename Float>
+  void setInvPsqHost(const int X[4], Float *invpsq){
+    const int volume = X[0] * X[1] * X[2] * X[3];
+#pragma omp parallel for
+    for ( int id = 0; id < volume; id++ ) {
+      int x1 = id / (X[2] * X[3] * X[0]);
+      int x0 = (id / (X[2] * X[3])) % X[0];
+      int x3 = (id / X[2]) % X[3];
+      int x2 = id % X[2];
+      Float sx = sin( (Float)x0 * FL_UNITARIZE_PI / (Float)X[0]);
+      Float sy = sin( (Float)x1 * FL_UNITARIZE_PI / (Float)X[1]);
+      Float sz = sin( (Float)x2 * FL_UNITARIZE_PI / (Float)X[2]);
+      Float st = sin( (Float)x3 * FL_UNITARIZE_PI / (Float)X[3]);
+      Float sinsq = sx * sx + sy * sy + sz * sz + st * st;
+      Float prcfact = 0.0;
+      //The FFT normalization is done here
+      if ( sinsq > 0.00001 ) prcfact = 4.0 / (sinsq * (Float)volume);
+      invpsq[id] = prcfact;
+    }
+  }
+
+  /**
+   * @brief Build g(x) = reunit(1 + alpha/2 Delta(x)) from the stored elements of Delta
+   */
+  template <typename Float>
+  inline Matrix<complex<Float>,3> gaugeTransformHost(const complex<Float> *delta, int idx, int volume, Float half_alpha){
+    typedef complex<Float> Cmplx;
+    Matrix<Cmplx,3> de;
+    de(0,0) = delta[idx + 0 * volume];
+    de(0,1) = delta[idx + 1 * volume];
+    de(0,2) = delta[idx + 2 * volume];
+    de(1,1) = delta[idx + 3 * volume];
+    de(1,2) = delta[idx + 4 * volume];
+    de(2,2) = delta[idx + 5 * volume];
+    de(1,0) = Cmplx(-de(0,1).x, de(0,1).y);
+    de(2,0) = Cmplx(-de(0,2).x, de(0,2).y);
+    de(2,1) = Cmplx(-de(1,2).x, de(1,2).y);
+    Matrix<Cmplx,3> g;
+    setIdentity(&g);
+    g += de * half_alpha;
+    reunit_link<Float>( g );
+    return g;
+  }
+
+  /**
+   * @brief Host version of kernel_gauge_fix_U_EO_NEW, U_mu(x) <- g(x) U_mu(x) g(x+mu)^dagger
+   */
+  template <typename Float, typename Gauge>
+  void gaugeFixUpdateHost(Gauge &dataOr, const int X[4], const complex<Float> *delta, Float half_alpha){
+    typedef complex<Float> Cmplx;
+    const int volume = X[0] * X[1] * X[2] * X[3];
+    const int volumeCB = volume / 2;
+#pragma omp parallel for
+    for ( int i = 0; i < volume; i++ ) {
+      int id = i % volumeCB;
+      int parity = i / volumeCB;
+      int x[4];
+      getCoords(x, id, X, parity);
+      int idx = ((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0];
+      Matrix<Cmplx,3> g = gaugeTransformHost<Float>(delta, idx, volume, half_alpha);
+      for ( int mu = 0; mu < 4; mu++ ) {
+        Matrix<Cmplx,3> U;
+        dataOr.load((Float*)(U.data), id, mu, parity);
+        Matrix<Cmplx,3> g0 = gaugeTransformHost<Float>(delta, linkNormalIndexP1(x,X,mu), volume, half_alpha);
+        U = g * U * conj(g0);
+        dataOr.save((Float*)(U.data), id, mu, parity);
+      }
+    }
+  }
+
+
+  template<typename Float, typename Gauge, int gauge_dir>
+  void gaugefixingFFT( Gauge dataOr,  cpuGaugeField& data, \
+                       const int Nsteps, const int verbose_interval, \
+                       const Float alpha0, const int autotune, const double tolerance, \
+                       const int stopWtheta) {
+
+    TimeProfile profileInternalGaugeFixFFT("InternalGaugeFixQudaFFTHost", false);
+
+    profileInternalGaugeFixFFT.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    Float alpha = alpha0;
+    printfQuda("\tAlpha parameter of the Steepest Descent Method: %lf\n", (double)alpha);
+    printfQuda("\tAuto tune active: %s\n", autotune ? "yes" : "no");
+    printfQuda("\tStop criterium: %lf\n", tolerance);
+    if ( stopWtheta ) printfQuda("\tStop criterium method: theta\n");
+    else printfQuda("\tStop criterium method: Delta\n");
+    printfQuda("\tMaximum number of iterations: %d\n", Nsteps);
+    printfQuda("\tPrint convergence results at every %d steps\n", verbose_interval);
+
+    int X[4];
+    for ( int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
+    const int volume = X[0] * X[1] * X[2] * X[3];
+    int4 size = make_int4( X[0], X[1], X[2], X[3] );
+
+    FFTHostPlan2DMany<Float> plan_xy;
+    FFTHostPlan2DMany<Float> plan_zt;
+    SetPlanFFT2DMany( plan_zt, size, 0);     //for space and time ZT
+    SetPlanFFT2DMany( plan_xy, size, 1);    //with space only XY
+
+    complex<Float> *delta = (complex<Float>*)safe_malloc(sizeof(complex<Float>) * volume * 6);
+    complex<Float> *gx = (complex<Float>*)safe_malloc(sizeof(complex<Float>) * volume);
+    Float *invpsq = (Float*)safe_malloc(sizeof(Float) * volume);
+    setInvPsqHost(X, invpsq);
+
+    double2 quality = fixQualityHost<Float, Gauge, gauge_dir>(dataOr, X, delta);
+    double action0 = quality.x;
+    printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\n", 0, quality.x, quality.y);
+
+    double diff = 0.0;
+    int iter = 0;
+    for ( iter = 0; iter < Nsteps; iter++ ) {
+      for ( int k = 0; k < 6; k++ ) {
+        // the same 2D+2D sequence as the device, with gx as temporary array
+        complex<Float> *_array = delta + k * volume;
+        ApplyFFT(plan_xy, _array, gx, FFT_HOST_FORWARD);
+        fftRotateHost(X, 0, gx, _array);
+        ApplyFFT(plan_zt, _array, gx, FFT_HOST_FORWARD);
+#pragma omp parallel for
+        for ( int id = 0; id < volume; id++ ) gx[id] *= invpsq[id];
+        ApplyFFT(plan_zt, gx, _array, FFT_HOST_INVERSE);
+        fftRotateHost(X, 1, _array, gx);
+        ApplyFFT(plan_xy, gx, _array, FFT_HOST_INVERSE);
+      }
+      gaugeFixUpdateHost(dataOr, X, delta, (Float)(alpha * 0.5));
+
+      quality = fixQualityHost<Float, Gauge, gauge_dir>(dataOr, X, delta);
+      double action = quality.x;
+      diff = fabs(action0 - action);
+      if ((iter % verbose_interval) == (verbose_interval - 1))
+        printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter + 1, quality.x, quality.y, diff);
+      if ( autotune && ((action - action0) < -1e-14) ) {
+        if ( alpha > 0.01 ) {
+          alpha = 0.95 * alpha;
+          printfQuda(">>>>>>>>>>>>>> Warning: changing alpha down -> %.4e\n", (double)alpha );
+        }
+      }
+      if ( stopWtheta ) { if ( quality.y < tolerance ) break; }
+      else { if ( diff < tolerance ) break; }
+
+      action0 = action;
+    }
+    if ((iter % verbose_interval) != 0 )
+      printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter, quality.x, quality.y, diff);
+
+    reunitarizeHost<Float>(dataOr, volume / 2);
+
+    host_free(invpsq);
+    host_free(gx);
+    host_free(delta);
+    profileInternalGaugeFixFFT.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    if (getVerbosity() > QUDA_SUMMARIZE){
+      double secs = profileInternalGaugeFixFFT.Last(QUDA_PROFILE_COMPUTE);
+      double fftflop = 5.0 * (log2((double)( X[0] * X[1]) ) + log2( (double)(X[2] * X[3] ))) * volume;
+      // per iteration: 6 forward and inverse 2D+2D transforms, the update and the quality measure
+      double flop = (2.0 * fftflop + 2.0 * volume) * 6 + 2414.0 * volume + (36.0 * gauge_dir + 65.0) * volume;
+      double gflops = (flop * iter * 1e-9) / secs;
+      printfQuda("Time: %6.6f s, Gflop/s = %6.1f, iterations/s = %6.2f\n", secs, gflops, iter / secs);
+    }
+  }
+
+  template<typename Float, typename Gauge>
+  void gaugefixingFFT( Gauge dataOr,  cpuGaugeField& data, const int gauge_dir, \
+                       const int Nsteps, const int verbose_interval, const Float alpha, const int autotune, \
+                       const double tolerance, const int stopWtheta) {
+    if ( gauge_dir != 3 ) {
+      printfQuda("Starting Landau gauge fixing with FFTs on the host...\n");
+      gaugefixingFFT<Float, Gauge, 4>(dataOr, data, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    }
+    else {
+      printfQuda("Starting Coulomb gauge fixing with FFTs on the host...\n");
+      gaugefixingFFT<Float, Gauge, 3>(dataOr, data, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    }
+  }
+
+  template<typename Float>
+  void gaugefixingFFT( cpuGaugeField& data, const int gauge_dir, \
+                       const int Nsteps, const int verbose_interval, const Float alpha, const int autotune, \
+                       const double tolerance, const int stopWtheta) {
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      gaugefixingFFT<Float>(gauge::QDPOrder<Float,18>(data), data, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      gaugefixingFFT<Float>(gauge::MILCOrder<Float,18>(data), data, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    } else {
+      errorQuda("Invalid Gauge Order %d\n", data.Order());
+    }
+  }
+
 #endif // GPU_GAUGE_ALG
 
 
@@ -1221,10 +1436,41 @@ namespace quda {
       errorQuda("Precision %d not supported", data.Precision());
     }
 #else
-    errorQuda("Gauge fixing has bot been built");
+    errorQuda("Gauge fixing has not been built");
 #endif
   }
 
 
 
+
+  /**
+   * @brief Host gauge fixing with the Fourier accelerated steepest descent method, mirroring the device 2D+2D transform
+   * sequence with a bundled mixed-radix FFT and threaded site loops.  The action and theta are measured as on the device.
+   * @param[in,out] data, host gauge field, QDP or MILC ordered and not extended
+   * @param[in] gauge_dir, 3 for Coulomb gauge fixing, other for Landau gauge fixing
+   * @param[in] Nsteps, maximum number of steps to perform gauge fixing
+   * @param[in] verbose_interval, print gauge fixing info when iteration count is a multiple of this
+   * @param[in] alpha, gauge fixing parameter of the method, most common value is 0.08
+   * @param[in] autotune, 1 to autotune the method, i.e., if the Fg inverts its tendency we decrease the alpha value 
+   * @param[in] tolerance, torelance value to stop the method, if this value is zero then the method stops when iteration reachs the maximum number of steps defined by Nsteps
+   * @param[in] stopWtheta, 0 for MILC criterium and 1 to use the theta value
+   */
+  void gaugefixingFFT( cpuGaugeField& data, const int gauge_dir, \
+                       const int Nsteps, const int verbose_interval, const double alpha, const int autotune, \
+                       const double tolerance, const int stopWtheta) {
+
+#ifdef GPU_GAUGE_ALG
+    checkGaugeFixHost(data);
+    if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+      gaugefixingFFT<float> (data, gauge_dir, Nsteps, verbose_interval, (float)alpha, autotune, tolerance, stopWtheta);
+    } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+      gaugefixingFFT<double>(data, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+#else
+    errorQuda("Gauge fixing has not been built");
+#endif
+  }
+
 }
@@ -0,0 +1,117 @@
+#ifndef _GAUGE_FIX_HOST_H
+#define _GAUGE_FIX_HOST_H
+
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <gauge_field.h>
+#include <cub_helper.cuh>
+#include <index_helper.cuh>
+
+namespace quda {
+
+  /**
+   * @brief Host gauge fixing quality of a single site, the same
+   * measure as the device computeFix_quality kernels.  Optionally
+   * stores the six independent elements of Delta(x) in lexicographic
+   * order, with stride volume, as used by the FFT method.
+   * @return (action, theta) contributions of the site
+   */
+  template<typename Float, typename Gauge, int gauge_dir>
+  inline double2 fixQualitySiteHost(const Gauge &dataOr, const int X[4], int idx, int parity,
+                                    complex<Float> *delta_out, int volume){
+    typedef complex<Float> Cmplx;
+    int x[4];
+    getCoords(x, idx, X, parity);
+    Matrix<Cmplx,3> delta;
+    setZero(&delta);
+    for ( int mu = 0; mu < gauge_dir; mu++ ) {
+      Matrix<Cmplx,3> U;
+      dataOr.load((Float*)(U.data), idx, mu, parity);
+      delta -= U;
+    }
+    double2 data;
+    data.x = -delta(0,0).x - delta(1,1).x - delta(2,2).x;
+    for ( int mu = 0; mu < gauge_dir; mu++ ) {
+      Matrix<Cmplx,3> U;
+      dataOr.load((Float*)(U.data), linkIndexM1(x,X,mu), mu, 1 - parity);
+      delta += U;
+    }
+    delta -= conj(delta);
+    SubTraceUnit(delta);
+    if ( delta_out ) {
+      int id = getIndexFull(idx, X, parity);
+      delta_out[id] = delta(0,0);
+      delta_out[id + volume] = delta(0,1);
+      delta_out[id + 2 * volume] = delta(0,2);
+      delta_out[id + 3 * volume] = delta(1,1);
+      delta_out[id + 4 * volume] = delta(1,2);
+      delta_out[id + 5 * volume] = delta(2,2);
+    }
+    data.y = getRealTraceUVdagger(delta, delta);
+    return data;
+  }
+
+  /**
+   * @brief Threaded host gauge fixing quality with a reproducible
+   * reduction, normalized as on the device so that the convergence of
+   * host and device runs can be compared directly
+   * @return (action, theta)
+   */
+  template<typename Float, typename Gauge, int gauge_dir>
+  double2 fixQualityHost(const Gauge &dataOr, const int X[4], complex<Float> *delta_out = 0){
+    const int volumeCB = X[0] * X[1] * X[2] * X[3] / 2;
+    double2 result = hostReduce<double2>(2 * volumeCB, [&](int i) {
+        return fixQualitySiteHost<Float, Gauge, gauge_dir>(dataOr, X, i % volumeCB, i / volumeCB, delta_out, 2 * volumeCB);
+      });
+    result.x /= (double)(3 * gauge_dir * 2 * volumeCB);
+    result.y /= (double)(3 * 2 * volumeCB);
+    return result;
+  }
+
+  /**
+   * @brief Threaded host reunitarization of all links by Gram-Schmidt
+   * orthonormalization of the first two rows
+   */
+  template<typename Float, typename Gauge>
+  void reunitarizeHost(Gauge &dataOr, int volumeCB){
+#pragma omp parallel for
+    for ( int i = 0; i < 2 * volumeCB; i++ ) {
+      for ( int mu = 0; mu < 4; mu++ ) {
+        Matrix<complex<Float>,3> U;
+        dataOr.load((Float*)(U.data), i % volumeCB, mu, i / volumeCB);
+        Float t1 = 0.0;
+        for ( int c = 0; c < 3; c++ ) t1 += norm(U(0,c));
+        t1 = (Float)1.0 / sqrt(t1);
+        for ( int c = 0; c < 3; c++ ) U(0,c) *= t1;
+        complex<Float> t2((Float)0.0, (Float)0.0);
+        for ( int c = 0; c < 3; c++ ) t2 += conj(U(0,c)) * U(1,c);
+        for ( int c = 0; c < 3; c++ ) U(1,c) -= t2 * U(0,c);
+        t1 = 0.0;
+        for ( int c = 0; c < 3; c++ ) t1 += norm(U(1,c));
+        t1 = (Float)1.0 / sqrt(t1);
+        for ( int c = 0; c < 3; c++ ) U(1,c) *= t1;
+        U(2,0) = conj(U(0,1) * U(1,2) - U(0,2) * U(1,1));
+        U(2,1) = conj(U(0,2) * U(1,0) - U(0,0) * U(1,2));
+        U(2,2) = conj(U(0,0) * U(1,1) - U(0,1) * U(1,0));
+        dataOr.save((Float*)(U.data), i % volumeCB, mu, i / volumeCB);
+      }
+    }
+  }
+
+  /**
+   * @brief Check that a host gauge field can be gauge fixed on the host
+   */
+  inline void checkGaugeFixHost(const cpuGaugeField &data){
+    if ( data.Reconstruct() != QUDA_RECONSTRUCT_NO )
+      errorQuda("Reconstruction type %d of host gauge field not supported", data.Reconstruct());
+    if ( data.Order() != QUDA_QDP_GAUGE_ORDER && data.Order() != QUDA_MILC_GAUGE_ORDER )
+      errorQuda("Order %d of host gauge field not supported", data.Order());
+    for ( int d = 0; d < 4; d++ ) {
+      if ( data.R()[d] != 0 ) errorQuda("Extended host gauge fields are not supported");
+      if ( comm_dim_partitioned(d) ) errorQuda("Host gauge fixing does not support partitioned dimensions");
+    }
+  }
+
+}
+
+#endif
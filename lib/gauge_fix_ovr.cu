@@ -8,6 +8,7 @@
 #include <comm_quda.h>
 #include <gauge_fix_ovr_extra.h>
 #include <gauge_fix_ovr_hit_devf.cuh>
+#include <gauge_fix_host.h>
 #include <cub_helper.cuh>
 #include <index_helper.cuh>
 
@@ -1790,6 +1791,136 @@ namespace quda {
     }
   }
 
+
+
+  /**
+   * @brief Threaded host overrelaxation sweep over the sites of one
+   * parity.  Sites of the same parity share no links, so they can be
+   * updated concurrently.
+   */
+  template<typename Float, typename Gauge, int gauge_dir>
+  void gaugeFixSweepHost(Gauge &dataOr, const int X[4], int parity, Float relax_boost){
+    const int volumeCB = X[0] * X[1] * X[2] * X[3] / 2;
+#pragma omp parallel for
+    for ( int idx = 0; idx < volumeCB; idx++ ) {
+      int x[4];
+      getCoords(x, idx, X, parity);
+      Matrix<complex<Float>,3> link[8];
+      for ( int mu = 0; mu < 4; mu++ ) {
+        dataOr.load((Float*)(link[mu].data), idx, mu, parity);
+        dataOr.load((Float*)(link[mu + 4].data), linkIndexM1(x,X,mu), mu, 1 - parity);
+      }
+      GaugeFixHitHost<Float, gauge_dir, 3>(link, relax_boost);
+      for ( int mu = 0; mu < 4; mu++ ) {
+        dataOr.save((Float*)(link[mu].data), idx, mu, parity);
+        dataOr.save((Float*)(link[mu + 4].data), linkIndexM1(x,X,mu), mu, 1 - parity);
+      }
+    }
+  }
+
+  template<typename Float, typename Gauge, int gauge_dir>
+  void gaugefixingOVR( Gauge dataOr,  cpuGaugeField& data,
+		       const int Nsteps, const int verbose_interval,
+		       const Float relax_boost, const double tolerance,
+		       const int reunit_interval, const int stopWtheta) {
+
+    TimeProfile profileInternalGaugeFixOVR("InternalGaugeFixQudaOVRHost", false);
+
+    profileInternalGaugeFixOVR.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    printfQuda("\tOverrelaxation boost parameter: %lf\n", (double)relax_boost);
+    printfQuda("\tStop criterium: %lf\n", tolerance);
+    if ( stopWtheta ) printfQuda("\tStop criterium method: theta\n");
+    else printfQuda("\tStop criterium method: Delta\n");
+    printfQuda("\tMaximum number of iterations: %d\n", Nsteps);
+    printfQuda("\tReunitarize at every %d steps\n", reunit_interval);
+    printfQuda("\tPrint convergence results at every %d steps\n", verbose_interval);
+
+    int X[4];
+    for ( int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
+    const int volumeCB = X[0] * X[1] * X[2] * X[3] / 2;
+
+    double2 quality = fixQualityHost<Float, Gauge, gauge_dir>(dataOr, X);
+    double action0 = quality.x;
+    printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\n", 0, quality.x, quality.y);
+
+    reunitarizeHost<Float>(dataOr, volumeCB);
+
+    int iter = 0;
+    for ( iter = 0; iter < Nsteps; iter++ ) {
+      for ( int p = 0; p < 2; p++ ) gaugeFixSweepHost<Float, Gauge, gauge_dir>(dataOr, X, p, relax_boost);
+      if ((iter % reunit_interval) == (reunit_interval - 1)) reunitarizeHost<Float>(dataOr, volumeCB);
+      quality = fixQualityHost<Float, Gauge, gauge_dir>(dataOr, X);
+      double action = quality.x;
+      double diff = fabs(action0 - action);
+      if ((iter % verbose_interval) == (verbose_interval - 1))
+        printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter + 1, quality.x, quality.y, diff);
+      if ( stopWtheta ) {
+        if ( quality.y < tolerance ) break;
+      }
+      else{
+        if ( diff < tolerance ) break;
+      }
+      action0 = action;
+    }
+    if ((iter % reunit_interval) != 0 ) reunitarizeHost<Float>(dataOr, volumeCB);
+    if ((iter % verbose_interval) != 0 ) {
+      quality = fixQualityHost<Float, Gauge, gauge_dir>(dataOr, X);
+      printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter + 1, quality.x, quality.y, fabs(action0 - quality.x));
+    }
+
+    profileInternalGaugeFixOVR.TPSTOP(QUDA_PROFILE_COMPUTE);
+    if (getVerbosity() > QUDA_SUMMARIZE){
+      double secs = profileInternalGaugeFixOVR.Last(QUDA_PROFILE_COMPUTE);
+      printfQuda("Time: %6.6f s, sweeps/s = %6.2f\n", secs, iter / secs);
+    }
+  }
+
+  template<typename Float, typename Gauge>
+  void gaugefixingOVR( Gauge dataOr,  cpuGaugeField& data, const int gauge_dir, const int Nsteps, const int verbose_interval,
+                       const Float relax_boost, const double tolerance, const int reunit_interval, const int stopWtheta) {
+    if ( gauge_dir != 3 ) {
+      printfQuda("Starting Landau gauge fixing on the host...\n");
+      gaugefixingOVR<Float, Gauge, 4>(dataOr, data, Nsteps, verbose_interval, relax_boost, tolerance, reunit_interval, stopWtheta);
+    }
+    else {
+      printfQuda("Starting Coulomb gauge fixing on the host...\n");
+      gaugefixingOVR<Float, Gauge, 3>(dataOr, data, Nsteps, verbose_interval, relax_boost, tolerance, reunit_interval, stopWtheta);
+    }
+  }
+
+  template<typename Float>
+  void gaugefixingOVR( cpuGaugeField& data, const int gauge_dir, const int Nsteps, const int verbose_interval,
+		       const Float relax_boost, const double tolerance, const int reunit_interval, const int stopWtheta) {
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      gaugefixingOVR<Float>(gauge::QDPOrder<Float,18>(data), data, gauge_dir, Nsteps, verbose_interval, relax_boost, tolerance, reunit_interval, stopWtheta);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      gaugefixingOVR<Float>(gauge::MILCOrder<Float,18>(data), data, gauge_dir, Nsteps, verbose_interval, relax_boost, tolerance, reunit_interval, stopWtheta);
+    } else {
+      errorQuda("Invalid Gauge Order %d\n", data.Order());
+    }
+  }
+
+  template<typename Float, typename Gauge>
+  double2 gaugeFixQuality( const Gauge &dataOr, const cpuGaugeField& data, const int gauge_dir) {
+    int X[4];
+    for ( int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
+    if ( gauge_dir != 3 ) return fixQualityHost<Float, Gauge, 4>(dataOr, X);
+    else return fixQualityHost<Float, Gauge, 3>(dataOr, X);
+  }
+
+  template<typename Float>
+  double2 gaugeFixQuality( const cpuGaugeField& data, const int gauge_dir) {
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      return gaugeFixQuality<Float>(gauge::QDPOrder<Float,18>(data), data, gauge_dir);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      return gaugeFixQuality<Float>(gauge::MILCOrder<Float,18>(data), data, gauge_dir);
+    } else {
+      errorQuda("Invalid Gauge Order %d\n", data.Order());
+    }
+    return make_double2(0.0, 0.0);
+  }
+
 #endif // GPU_GAUGE_ALG
 
 
@@ -1823,4 +1954,58 @@ namespace quda {
   }
 
 
+
+  /**
+   * @brief Host gauge fixing with overrelaxation, using threaded checkerboard sweeps.  The action and theta are
+   * measured as on the device.
+   * @param[in,out] data, host gauge field, QDP or MILC ordered and not extended
+   * @param[in] gauge_dir, 3 for Coulomb gauge fixing, other for Landau gauge fixing
+   * @param[in] Nsteps, maximum number of steps to perform gauge fixing
+   * @param[in] verbose_interval, print gauge fixing info when iteration count is a multiple of this
+   * @param[in] relax_boost, gauge fixing parameter of the overrelaxation method, most common value is 1.5 or 1.7.
+   * @param[in] tolerance, torelance value to stop the method, if this value is zero then the method stops when iteration reachs the maximum number of steps defined by Nsteps
+   * @param[in] reunit_interval, reunitarize gauge field when iteration count is a multiple of this
+   * @param[in] stopWtheta, 0 for MILC criterium and 1 to use the theta value
+   */
+  void gaugefixingOVR( cpuGaugeField& data, const int gauge_dir, const int Nsteps, const int verbose_interval, const double relax_boost,
+                       const double tolerance, const int reunit_interval, const int stopWtheta) {
+#ifdef GPU_GAUGE_ALG
+    checkGaugeFixHost(data);
+    if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+      gaugefixingOVR<float> (data, gauge_dir, Nsteps, verbose_interval, (float)relax_boost, tolerance, reunit_interval, stopWtheta);
+    } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+      gaugefixingOVR<double>(data, gauge_dir, Nsteps, verbose_interval, relax_boost, tolerance, reunit_interval, stopWtheta);
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+#else
+    errorQuda("Gauge fixing has not been built");
+#endif // GPU_GAUGE_ALG
+  }
+
+
+  /**
+   * @brief Gauge fixing quality of a host gauge field, the functional and theta reported by gaugefixingOVR and
+   * gaugefixingFFT.
+   * @param[in] data, host gauge field, QDP or MILC ordered and not extended
+   * @param[in] gauge_dir, 3 for Coulomb gauge fixing, other for Landau gauge fixing
+   * @return (functional, theta)
+   */
+  double2 gaugeFixQuality( const cpuGaugeField& data, const int gauge_dir) {
+#ifdef GPU_GAUGE_ALG
+    checkGaugeFixHost(data);
+    if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+      return gaugeFixQuality<float>(data, gauge_dir);
+    } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+      return gaugeFixQuality<double>(data, gauge_dir);
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+#else
+    errorQuda("Gauge fixing has not been built");
+#endif // GPU_GAUGE_ALG
+    return make_double2(0.0, 0.0);
+  }
+
+
 }   //namespace quda
@@ -642,5 +642,57 @@ namespace quda {
     }
   }
 
+
+  /**
+   * Host function to perform the overrelaxation hit of a single site,
+   * with the same arithmetic as the device functions above.
+   * @param[in,out] link, the four upward links U_mu(x) followed by the four downward links U_mu(x-mu)
+   * @param[in] relax_boost, overrelaxation boost parameter
+   */
+  template<typename Float, int gauge_dir, int NCOLORS>
+  inline void GaugeFixHitHost(Matrix<complex<Float>,NCOLORS> link[8], const Float relax_boost){
+    for ( int block = 0; block < (NCOLORS * (NCOLORS - 1) / 2); block++ ) {
+      int p, q;
+      IndexBlock<NCOLORS>(block, p, q);
+      Float elems[4] = { 0.0, 0.0, 0.0, 0.0 };
+      for ( int mu = 0; mu < gauge_dir; mu++ ) {
+        for ( int dn = 0; dn < 2; dn++ ) {
+          const Matrix<complex<Float>,NCOLORS> &l = link[mu + 4 * dn];
+          Float asq = dn ? 1.0 : -1.0;
+          elems[0] += l(p,p).x + l(q,q).x;
+          elems[1] += (l(p,q).y + l(q,p).y) * asq;
+          elems[2] += (l(p,q).x - l(q,p).x) * asq;
+          elems[3] += (l(p,p).y - l(q,q).y) * asq;
+        }
+      }
+      //Over-relaxation boost
+      Float asq = elems[1] * elems[1] + elems[2] * elems[2] + elems[3] * elems[3];
+      Float a0sq = elems[0] * elems[0];
+      Float x = (relax_boost * a0sq + asq) / (a0sq + asq);
+      Float r = (Float)1.0 / sqrt((a0sq + x * x * asq));
+      elems[0] *= r;
+      elems[1] *= x * r;
+      elems[2] *= x * r;
+      elems[3] *= x * r;
+      for ( int mu = 0; mu < 4; mu++ ) {
+        complex<Float> m0;
+        //Do SU(2) hit on the upward link, link <- u * link
+        Matrix<complex<Float>,NCOLORS> &l = link[mu];
+        for ( int j = 0; j < NCOLORS; j++ ) {
+          m0 = l(p,j);
+          l(p,j) = complex<Float>( elems[0], elems[3] ) * m0 + complex<Float>( elems[2], elems[1] ) * l(q,j);
+          l(q,j) = complex<Float>(-elems[2], elems[1]) * m0 + complex<Float>( elems[0],-elems[3] ) * l(q,j);
+        }
+        //Do SU(2) hit on the downward link, link <- link * u_adj
+        Matrix<complex<Float>,NCOLORS> &l1 = link[mu + 4];
+        for ( int j = 0; j < NCOLORS; j++ ) {
+          m0 = l1(j,p);
+          l1(j,p) = complex<Float>( elems[0], -elems[3] ) * m0 + complex<Float>( elems[2], -elems[1] ) * l1(j,q);
+          l1(j,q) = complex<Float>(-elems[2], -elems[1]) * m0 + complex<Float>( elems[0], elems[3] ) * l1(j,q);
+        }
+      }
+    }
+  }
+
 }
 #endif
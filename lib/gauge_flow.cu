@@ -0,0 +1,592 @@
+#include <quda_internal.h>
+#include <quda_matrix.h>
+#include <tune_quda.h>
+#include <gauge_field.h>
+#include <gauge_field_order.h>
+#include <gauge_tools.h>
+#include <launch_kernel.cuh>
+#include <atomic.cuh>
+#include <cub_helper.cuh>
+#include <index_helper.cuh>
+
+#ifndef Pi2
+#define Pi2   6.2831853071795864769252867665590
+#endif
+
+namespace quda {
+
+#ifdef GPU_GAUGE_TOOLS
+
+  /**
+     Coefficients of the Luscher third-order Runge-Kutta integrator
+     (arXiv:1006.4518) written in low-storage form:
+       A_i = a_i A_{i-1} + eps Z(W_i),  W_{i+1} = exp(b_i A_i) W_i
+   */
+  static const double flow_a[3] = { 0.0, -17.0/32.0, -32.0/27.0 };
+  static const double flow_b[3] = { 1.0/4.0, 8.0/9.0, 3.0/4.0 };
+
+  enum GaugeFlowKernel { FLOW_FORCE, FLOW_ZEUTHEN, FLOW_UPDATE, FLOW_COMBINE };
+  enum GaugeFlowReduction { FLOW_OBSERVABLES, FLOW_ERROR };
+
+  template <typename Float, typename Gauge>
+  struct GaugeFlowArg : public ReduceArg<double2> {
+    int threads; // number of active threads required
+    int X[4]; // true grid dimensions
+    int E[4]; // extended grid dimensions
+    int border[4];
+    Gauge W; // the links being flowed
+    Gauge A; // Runge-Kutta accumulator
+    Gauge Z; // Symanzik force when using the Zeuthen kernel
+    Gauge W0; // links at the start of the step when adaptive
+    Gauge Zp; // increment of the embedded second-order scheme when adaptive
+    Float a; // coefficient of the existing field in the kernel being applied
+    Float b; // coefficient of the new contribution in the kernel being applied
+    Float eps; // step size
+    const QudaGaugeFlowType type;
+
+    GaugeFlowArg(GaugeField &W, GaugeField &A, GaugeField &Z, GaugeField &W0, GaugeField &Zp,
+		 QudaGaugeFlowType type)
+      : ReduceArg<double2>(), threads(1), W(W), A(A), Z(Z), W0(W0), Zp(Zp),
+	a(0.0), b(0.0), eps(0.0), type(type)
+    {
+      for (int dir=0; dir<4; ++dir) {
+	border[dir] = W.R()[dir];
+	E[dir] = W.X()[dir];
+	X[dir] = E[dir] - 2*border[dir];
+	threads *= X[dir];
+      }
+      threads /= 2;
+    }
+  };
+
+  /**
+     Multiply the links along a path starting at the extended
+     coordinate x.  Steps 0-3 move forwards along that direction,
+     steps 4-7 move backwards along direction step-4.
+   */
+  template <typename Float, typename Gauge, int length>
+  __device__ __host__ inline Matrix<complex<Float>,3> pathProduct(const Gauge &U, const int x[4], const int E[4],
+								 int parity, const int (&path)[length]) {
+    typedef Matrix<complex<Float>,3> Link;
+    Link P, L;
+    setIdentity(&P);
+
+    int dx[4] = {0, 0, 0, 0};
+    for (int i=0; i<length; i++) {
+      const int d = path[i] % 4;
+      if (path[i] < 4) {
+	L = U(d, linkIndexShift(x,dx,E), parity);
+	P = P * L;
+	dx[d]++;
+	parity = 1 - parity;
+      } else {
+	dx[d]--;
+	parity = 1 - parity;
+	L = U(d, linkIndexShift(x,dx,E), parity);
+	P = P * conj(L);
+      }
+    }
+    return P;
+  }
+
+  /**
+     Traceless anti-hermitian part of a matrix
+   */
+  template <typename Float>
+  __device__ __host__ inline Matrix<complex<Float>,3> projectTA(const Matrix<complex<Float>,3> &M) {
+    typedef Matrix<complex<Float>,3> Link;
+    Link T = M - conj(M);
+    complex<Float> tr = static_cast<Float>(1.0/3.0) * getTrace(T);
+    Link I;
+    setIdentity(&I);
+    T = T - tr * I;
+    return static_cast<Float>(0.5) * T;
+  }
+
+  /**
+     exp(X) for X traceless anti-hermitian, using the Cayley-Hamilton
+     exponential of the hermitian matrix -iX
+   */
+  template <typename Float>
+  __device__ __host__ inline Matrix<complex<Float>,3> expTA(const Matrix<complex<Float>,3> &X) {
+    typedef Matrix<complex<Float>,3> Link;
+    const complex<Float> mi(0.0, -1.0);
+    Link Q = mi * X;
+    Link expQ;
+    exponentiate_iQ(Q, &expQ);
+    return expQ;
+  }
+
+  /**
+     Sum of the paths connecting x to x+mu that complete the action
+     loops containing the link U_mu(x): the six plaquette staples, and
+     for the Symanzik and Zeuthen kernels also the eighteen rectangle
+     staples weighted with the tree-level coefficients.
+   */
+  template <typename Float, typename Arg>
+  __device__ __host__ inline Matrix<complex<Float>,3> computeFlowStaple(const Arg &arg, const int x[4], int parity, int mu) {
+    typedef Matrix<complex<Float>,3> Link;
+    Link plaq, rect;
+    setZero(&plaq);
+    setZero(&rect);
+
+    for (int nu=0; nu<4; nu++) {
+      if (nu == mu) continue;
+      for (int s=0; s<2; s++) {
+	const int up = s == 0 ? nu : nu+4;
+	const int dn = s == 0 ? nu+4 : nu;
+
+	const int staple[3] = { up, mu, dn };
+	plaq += pathProduct<Float>(arg.W, x, arg.E, parity, staple);
+
+	if (arg.type != QUDA_FLOW_WILSON) {
+	  const int rect1[5] = { up, mu, mu, dn, mu+4 };
+	  const int rect2[5] = { mu+4, up, mu, mu, dn };
+	  const int rect3[5] = { up, up, mu, dn, dn };
+	  rect += pathProduct<Float>(arg.W, x, arg.E, parity, rect1);
+	  rect += pathProduct<Float>(arg.W, x, arg.E, parity, rect2);
+	  rect += pathProduct<Float>(arg.W, x, arg.E, parity, rect3);
+	}
+      }
+    }
+
+    if (arg.type == QUDA_FLOW_WILSON) return plaq;
+    // tree-level Symanzik coefficients c0 = 5/3 and c1 = -1/12
+    return static_cast<Float>(5.0/3.0) * plaq + static_cast<Float>(-1.0/12.0) * rect;
+  }
+
+  template <typename Float, typename Arg>
+  __device__ __host__ inline void accumulateFlow(Arg &arg, int x_cb, int parity, int dir, const Matrix<complex<Float>,3> &Z) {
+    typedef Matrix<complex<Float>,3> Link;
+    Link A = Z;
+    if (arg.a != static_cast<Float>(0.0)) {
+      Link A0 = arg.A(dir, x_cb, parity);
+      A = arg.a * A0 + Z;
+    }
+    arg.A(dir, x_cb, parity) = A;
+  }
+
+  template <typename Float, int kernel, typename Arg>
+  __device__ __host__ inline void gaugeFlowSite(Arg &arg, int idx, int parity, int dir) {
+    typedef Matrix<complex<Float>,3> Link;
+
+    int x[4];
+    getCoords(x, idx, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+    const int e_cb = linkIndex(x, arg.E);
+
+    switch (kernel) {
+    case FLOW_FORCE:
+      {
+	Link U = arg.W(dir, e_cb, parity);
+	Link C = computeFlowStaple<Float>(arg, x, parity, dir);
+	Link Z = arg.eps * projectTA<Float>(C * conj(U));
+	if (arg.type == QUDA_FLOW_ZEUTHEN) arg.Z(dir, e_cb, parity) = Z;
+	else accumulateFlow<Float>(arg, e_cb, parity, dir, Z);
+      }
+      break;
+    case FLOW_ZEUTHEN:
+      {
+	// apply (1 + a^2/12 D*_mu D_mu) to the Symanzik force (arXiv:1408.0212)
+	int dx[4] = {0, 0, 0, 0};
+	Link Zx = arg.Z(dir, e_cb, parity);
+	Link U = arg.W(dir, e_cb, parity);
+	dx[dir]++;
+	Link Zf = arg.Z(dir, linkIndexShift(x,dx,arg.E), 1-parity);
+	dx[dir] -= 2;
+	Link Ub = arg.W(dir, linkIndexShift(x,dx,arg.E), 1-parity);
+	Link Zb = arg.Z(dir, linkIndexShift(x,dx,arg.E), 1-parity);
+
+	Link lap = U * Zf * conj(U) + conj(Ub) * Zb * Ub - static_cast<Float>(2.0) * Zx;
+	Link Z = Zx + static_cast<Float>(1.0/12.0) * lap;
+	accumulateFlow<Float>(arg, e_cb, parity, dir, Z);
+      }
+      break;
+    case FLOW_UPDATE:
+      {
+	Link A = arg.A(dir, e_cb, parity);
+	Link U = arg.W(dir, e_cb, parity);
+	U = expTA<Float>(arg.b * A) * U;
+	arg.W(dir, e_cb, parity) = U;
+      }
+      break;
+    case FLOW_COMBINE:
+      {
+	Link A = arg.A(dir, e_cb, parity);
+	Link Zp = arg.b * A;
+	if (arg.a != static_cast<Float>(0.0)) {
+	  Link Zp0 = arg.Zp(dir, e_cb, parity);
+	  Zp = arg.a * Zp0 + Zp;
+	}
+	arg.Zp(dir, e_cb, parity) = Zp;
+      }
+      break;
+    }
+  }
+
+  template <typename Float, int kernel, typename Arg>
+  __global__ void gaugeFlowKernel(Arg arg) {
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y + blockIdx.y*blockDim.y;
+    int dir = threadIdx.z + blockIdx.z*blockDim.z;
+    if (idx >= arg.threads) return;
+    if (dir >= 4) return;
+    gaugeFlowSite<Float,kernel>(arg, idx, parity, dir);
+  }
+
+  template <typename Float, int kernel, typename Arg>
+  void gaugeFlowCPU(Arg &arg) {
+#pragma omp parallel for
+    for (int i=0; i<2*4*arg.threads; i++) {
+      const int idx = i % arg.threads;
+      const int dir = (i / arg.threads) % 4;
+      const int parity = i / (4*arg.threads);
+      gaugeFlowSite<Float,kernel>(arg, idx, parity, dir);
+    }
+  }
+
+  template <typename Float, int kernel, typename Arg>
+  class GaugeFlowStep : TunableVectorYZ {
+    Arg arg;
+    const GaugeField &meta;
+    GaugeField &out; // field written by this kernel, saved during tuning
+
+  private:
+    bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
+    unsigned int minThreads() const { return arg.threads; }
+
+  public:
+    // (2,4) --- 2 for parity in the y thread dim, 4 corresponds to mapping direction to the z thread dim
+    GaugeFlowStep(Arg &arg, const GaugeField &meta, GaugeField &out)
+      : TunableVectorYZ(2,4), arg(arg), meta(meta), out(out) { }
+    virtual ~GaugeFlowStep() { }
+
+    void apply(const cudaStream_t &stream) {
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	gaugeFlowKernel<Float,kernel><<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
+      } else {
+	gaugeFlowCPU<Float,kernel>(arg);
+      }
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",prec=" << sizeof(Float) << ",type=" << arg.type;
+      return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    void preTune() { out.backup(); }
+    void postTune() { out.restore(); }
+
+    long long flops() const {
+      long long staple = (arg.type == QUDA_FLOW_WILSON ? 6*2 : 6*2 + 18*4) * 198ll;
+      switch (kernel) {
+      case FLOW_FORCE: return 2ll*4*arg.threads*(staple + 198 + 36);
+      case FLOW_ZEUTHEN: return 2ll*4*arg.threads*(4*198 + 4*18);
+      case FLOW_UPDATE: return 2ll*4*arg.threads*(2*198); // approximating the exponential by a multiplication
+      case FLOW_COMBINE: return 2ll*4*arg.threads*36;
+      default: return 0;
+      }
+    }
+
+    long long bytes() const {
+      long long link = arg.W.Bytes();
+      long long staple = arg.type == QUDA_FLOW_WILSON ? 6*3 : 6*3 + 18*5;
+      switch (kernel) {
+      case FLOW_FORCE: return 2ll*4*arg.threads*(staple + 3)*link;
+      case FLOW_ZEUTHEN: return 2ll*4*arg.threads*(7*link);
+      case FLOW_UPDATE: return 2ll*4*arg.threads*(3*link);
+      case FLOW_COMBINE: return 2ll*4*arg.threads*(3*link);
+      default: return 0;
+      }
+    }
+  };
+
+  /**
+     Clover action density (x) and topological charge density (y) at
+     a site, computed from the traceless clover field strength held
+     in registers rather than a stored Fmunu field.
+   */
+  template <typename Float, typename Arg>
+  __device__ __host__ inline double2 flowObservablesSite(const Arg &arg, const int x[4], int parity) {
+    typedef Matrix<complex<Float>,3> Link;
+    Link F[6];
+
+    for (int mu=0; mu<4; mu++) {
+      for (int nu=0; nu<mu; nu++) {
+	const int leaf0[4] = { mu, nu, mu+4, nu+4 };
+	const int leaf1[4] = { nu, mu+4, nu+4, mu };
+	const int leaf2[4] = { nu+4, mu, nu, mu+4 };
+	const int leaf3[4] = { mu+4, nu+4, mu, nu };
+
+	Link C = pathProduct<Float>(arg.W, x, arg.E, parity, leaf0);
+	C += pathProduct<Float>(arg.W, x, arg.E, parity, leaf1);
+	C += pathProduct<Float>(arg.W, x, arg.E, parity, leaf2);
+	C += pathProduct<Float>(arg.W, x, arg.E, parity, leaf3);
+
+	int munu_idx = (mu*(mu-1))/2 + nu; // lower-triangular indexing
+	F[munu_idx] = static_cast<Float>(0.25) * projectTA<Float>(C);
+      }
+    }
+
+    double2 obs = make_double2(0.0, 0.0);
+    for (int i=0; i<6; i++) obs.x -= getTrace(F[i] * F[i]).x;
+    obs.y = (getTrace(F[0]*F[5]).x + getTrace(F[3]*F[2]).x - getTrace(F[1]*F[4]).x) / (Pi2*Pi2);
+    return obs;
+  }
+
+  /**
+     Squared distance at a site between the third-order solution and
+     the embedded second-order solution exp(2 Z_1 - Z_0) W_0
+   */
+  template <typename Float, typename Arg>
+  __device__ __host__ inline double2 flowErrorSite(const Arg &arg, int e_cb, int parity) {
+    typedef Matrix<complex<Float>,3> Link;
+    double2 dist = make_double2(0.0, 0.0);
+    for (int dir=0; dir<4; dir++) {
+      Link U = arg.W(dir, e_cb, parity);
+      Link U0 = arg.W0(dir, e_cb, parity);
+      Link Zp = arg.Zp(dir, e_cb, parity);
+      Link D = U - expTA<Float>(Zp) * U0;
+      dist.x += getRealTraceUVdagger(D, D);
+    }
+    return dist;
+  }
+
+  template <typename Float, int reduction, typename Arg>
+  __device__ __host__ inline double2 gaugeFlowReduceSite(const Arg &arg, int idx, int parity) {
+    int x[4];
+    getCoords(x, idx, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+    return reduction == FLOW_OBSERVABLES ? flowObservablesSite<Float>(arg, x, parity) :
+      flowErrorSite<Float>(arg, linkIndex(x, arg.E), parity);
+  }
+
+  template <int blockSize, typename Float, int reduction, typename Arg>
+  __global__ void gaugeFlowReduceKernel(Arg arg) {
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y;
+
+    double2 val = make_double2(0.0, 0.0);
+    if (idx < arg.threads) val = gaugeFlowReduceSite<Float,reduction>(arg, idx, parity);
+
+    // perform final inter-block reduction and write out result
+    reduce2d<blockSize,2>(arg, val);
+  }
+
+  template <typename Float, int reduction, typename Arg>
+  class GaugeFlowReduce : TunableLocalParity {
+    Arg &arg;
+    const GaugeField &meta;
+
+  private:
+    unsigned int minThreads() const { return arg.threads; }
+
+  public:
+    GaugeFlowReduce(Arg &arg, const GaugeField &meta) : arg(arg), meta(meta) { }
+    virtual ~GaugeFlowReduce() { }
+
+    void apply(const cudaStream_t &stream) {
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	arg.result_h[0] = make_double2(0.0, 0.0);
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	LAUNCH_KERNEL_LOCAL_PARITY(gaugeFlowReduceKernel, tp, stream, arg, Float, reduction, Arg);
+	cudaDeviceSynchronize();
+      } else {
+	// both parities are folded into a single index range for the deterministic reduction
+	arg.result_h[0] = hostReduce<double2>(2*arg.threads, [&](int i) {
+	    return gaugeFlowReduceSite<Float,reduction>(arg, i % arg.threads, i / arg.threads);
+	  });
+      }
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",prec=" << sizeof(Float);
+      return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    long long flops() const {
+      return reduction == FLOW_OBSERVABLES ? 2ll*arg.threads*(6*(16*198 + 4*18) + 9*198) :
+	2ll*arg.threads*4*(2*198 + 18 + 36);
+    }
+    long long bytes() const {
+      return reduction == FLOW_OBSERVABLES ? 2ll*arg.threads*6*16*arg.W.Bytes() : 2ll*arg.threads*4*3*arg.W.Bytes();
+    }
+  };
+
+  template <typename Float, int kernel, typename Arg>
+  void applyFlow(Arg &arg, const GaugeField &W, GaugeField &out) {
+    GaugeFlowStep<Float,kernel,Arg> step(arg, W, out);
+    step.apply(0);
+  }
+
+  template <typename Float, int reduction, typename Arg>
+  double2 reduceFlow(Arg &arg, const GaugeField &W) {
+    GaugeFlowReduce<Float,reduction,Arg> reduce(arg, W);
+    reduce.apply(0);
+    comm_allreduce_array((double*)arg.result_h, 2);
+    return arg.result_h[0];
+  }
+
+  static void exchangeFlowGhost(GaugeField &U) {
+    if (U.Location() == QUDA_CUDA_FIELD_LOCATION)
+      static_cast<cudaGaugeField&>(U).exchangeExtendedGhost(U.R(), true);
+    else
+      static_cast<cpuGaugeField&>(U).exchangeExtendedGhost(U.R(), true);
+  }
+
+  /**
+     One Runge-Kutta step of size eps.  When adaptive the increment of
+     the embedded second-order scheme is accumulated in Zp.
+   */
+  template <typename Float, typename Arg>
+  void flowStep(Arg &arg, GaugeField &W, GaugeField &A, GaugeField &Z, GaugeField &Zp, double eps, bool adaptive) {
+    arg.eps = eps;
+
+    for (int i=0; i<3; i++) {
+      arg.a = flow_a[i];
+      if (arg.type == QUDA_FLOW_ZEUTHEN) {
+	applyFlow<Float,FLOW_FORCE>(arg, W, Z);
+	exchangeFlowGhost(Z);
+	applyFlow<Float,FLOW_ZEUTHEN>(arg, W, A);
+      } else {
+	applyFlow<Float,FLOW_FORCE>(arg, W, A);
+      }
+
+      if (adaptive && i < 2) {
+	// Zp = Z_0 after the first stage and 2 Z_1 - Z_0 = 2 A_1 + Z_0 / 16 after the second
+	arg.a = i == 0 ? 0.0 : 1.0/16.0;
+	arg.b = i == 0 ? 1.0 : 2.0;
+	applyFlow<Float,FLOW_COMBINE>(arg, W, Zp);
+      }
+
+      arg.b = flow_b[i];
+      applyFlow<Float,FLOW_UPDATE>(arg, W, W);
+      exchangeFlowGhost(W);
+    }
+  }
+
+  template <typename Float, typename Gauge>
+  void gradientFlow(GaugeField &W, GaugeField &A, GaugeField &Z, GaugeField &W0, GaugeField &Zp, GaugeFlowParam &param) {
+    GaugeFlowArg<Float,Gauge> arg(W, A, Z, W0, Zp, param.type);
+    const bool adaptive = param.tol > 0.0;
+    const double volume = 2.0*arg.threads*comm_size();
+
+    double t = 0.0;
+    double eps = param.epsilon;
+    param.steps = 0;
+    param.rejected = 0;
+
+    int m = 0;
+    while (m < param.n_meas) {
+      const double dt = param.t_meas[m] - t;
+
+      if (dt <= 1e-12*(1.0 + t)) { // measure at this flow time
+	double2 obs = reduceFlow<Float,FLOW_OBSERVABLES>(arg, W);
+	param.E[m] = obs.x / volume;
+	param.t2E[m] = param.t_meas[m] * param.t_meas[m] * param.E[m];
+	param.Q[m] = obs.y;
+	if (getVerbosity() >= QUDA_VERBOSE)
+	  printfQuda("Flow t = %e: E = %e, t^2 E = %e, Q = %e (%d steps, %d rejected)\n",
+		     param.t_meas[m], param.E[m], param.t2E[m], param.Q[m], param.steps, param.rejected);
+	m++;
+	continue;
+      }
+
+      // shorten the step to land on the next measurement time
+      const bool truncated = dt < eps;
+      const double h = truncated ? dt : eps;
+
+      if (adaptive) W0.copy(W);
+      flowStep<Float>(arg, W, A, Z, Zp, h, adaptive);
+
+      if (adaptive) {
+	// root-mean-square deviation per link, relative to the norm of an SU(3) matrix
+	double dist = sqrt(reduceFlow<Float,FLOW_ERROR>(arg, W).x / (4*3*volume));
+	double scale = dist > 0.0 ? 0.95 * cbrt(param.tol / dist) : 2.0;
+	scale = std::min(2.0, std::max(0.2, scale));
+
+	if (dist > param.tol) {
+	  W.copy(W0);
+	  eps = h * scale;
+	  param.rejected++;
+	  if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+	    printfQuda("Flow step rejected at t = %e: eps = %e, distance = %e\n", t, h, dist);
+	  continue;
+	}
+
+	if (!truncated) eps = h * scale;
+      }
+
+      t += h;
+      param.steps++;
+    }
+  }
+
+  template <typename Float>
+  void gradientFlow(GaugeField &W, GaugeField &A, GaugeField &Z, GaugeField &W0, GaugeField &Zp, GaugeFlowParam &param) {
+    if (W.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type G;
+      gradientFlow<Float,G>(W, A, Z, W0, Zp, param);
+    } else if (W.Order() == QUDA_QDP_GAUGE_ORDER) {
+      gradientFlow<Float,gauge::QDPOrder<Float,18> >(W, A, Z, W0, Zp, param);
+    } else if (W.Order() == QUDA_MILC_GAUGE_ORDER) {
+      gradientFlow<Float,gauge::MILCOrder<Float,18> >(W, A, Z, W0, Zp, param);
+    } else {
+      errorQuda("Gauge field order %d not supported on the host", W.Order());
+    }
+  }
+
+  static GaugeField* createFlowField(const GaugeFieldParam &param, QudaFieldLocation location) {
+    if (location == QUDA_CUDA_FIELD_LOCATION) return new cudaGaugeField(param);
+    return new cpuGaugeField(param);
+  }
+#endif
+
+  void gradientFlow(GaugeField &U, GaugeFlowParam &param) {
+#ifdef GPU_GAUGE_TOOLS
+    if (U.Reconstruct() != QUDA_RECONSTRUCT_NO)
+      errorQuda("Reconstruction type %d not supported", U.Reconstruct());
+    if (U.Location() == QUDA_CUDA_FIELD_LOCATION && !U.isNative())
+      errorQuda("Order %d with %d reconstruct not supported", U.Order(), U.Reconstruct());
+    if (param.type == QUDA_FLOW_INVALID) errorQuda("Invalid flow type");
+    if (param.epsilon <= 0.0) errorQuda("Invalid step size %e", param.epsilon);
+    if (param.n_meas <= 0) errorQuda("No measurement flow times requested");
+    for (int m=0; m<param.n_meas; m++)
+      if (param.t_meas[m] < 0.0 || (m > 0 && param.t_meas[m] < param.t_meas[m-1]))
+	errorQuda("Measurement flow times must be non-negative and ascending");
+
+    // the rectangles of the Symanzik action reach two sites beyond the local volume
+    const int depth = param.type == QUDA_FLOW_WILSON ? 1 : 2;
+    for (int d=0; d<4; d++)
+      if (comm_dim_partitioned(d) && U.R()[d] < depth)
+	errorQuda("Flow requires a border of depth %d in partitioned dimension %d (have %d)", depth, d, U.R()[d]);
+
+    GaugeFieldParam param_aux(U);
+    param_aux.create = QUDA_NULL_FIELD_CREATE;
+    GaugeField *A = createFlowField(param_aux, U.Location());
+    GaugeField *Z = param.type == QUDA_FLOW_ZEUTHEN ? createFlowField(param_aux, U.Location()) : A;
+    GaugeField *W0 = param.tol > 0.0 ? createFlowField(param_aux, U.Location()) : &U;
+    GaugeField *Zp = param.tol > 0.0 ? createFlowField(param_aux, U.Location()) : A;
+
+    if (U.Precision() == QUDA_DOUBLE_PRECISION) {
+      gradientFlow<double>(U, *A, *Z, *W0, *Zp, param);
+    } else if (U.Precision() == QUDA_SINGLE_PRECISION) {
+      gradientFlow<float>(U, *A, *Z, *W0, *Zp, param);
+    } else {
+      errorQuda("Precision %d not supported", U.Precision());
+    }
+
+    if (Zp != A) delete Zp;
+    if (W0 != &U) delete W0;
+    if (Z != A) delete Z;
+    delete A;
+#else
+    errorQuda("Gauge tools are not build");
+#endif
+  }
+
+} // namespace quda
@@ -1,15 +1,256 @@
 #include <gauge_field_order.h>
 #include <quda_matrix.h>
+#include <quda_matrix_soa.h>
 #include <index_helper.cuh>
 #include <generics/ldg.h>
+#include <gauge_force_quda.h>
+#include <tune_quda.h>
+#include <launch_kernel.cuh>
+#include <cub_helper.cuh>
+#include <vector>
+#include <algorithm>
 
 namespace quda {
 
+  /**
+     Maximum depth of the path tree, i.e., the maximum path length,
+     evaluated with shared sub-paths.  Deeper trees need a longer stack
+     of partial products per thread, so longer paths fall back to
+     evaluating each path independently.
+   */
+  static constexpr int gauge_force_max_depth = 8;
+
+  /**
+     A node of the path tree.  The link offset is relative to the site
+     the force is computed at, so the evaluation needs no position
+     state beyond the stack of partial products.
+   */
+  struct GaugeForcePathNode {
+    signed char dx[4]; // offset of the link from the site
+    signed char dir;   // link direction
+    signed char dagger; // whether the link is traversed backwards
+    signed char depth; // depth in the tree, 0 for the first link of a path
+    signed char pad;
+    double coeff;      // summed coefficient of all paths ending at this node
+  };
+
+  struct PathTrieNode {
+    int step;
+    double coeff;
+    std::vector<int> child;
+    PathTrieNode(int step) : step(step), coeff(0.0) { }
+  };
+
+  static void flattenPathTree(std::vector<GaugeForcePathNode> &tree, const std::vector<PathTrieNode> &trie,
+			      int t, int depth, int pos[4]) {
+    const PathTrieNode &node = trie[t];
+    GaugeForcePathNode n;
+    int step = node.step;
+    bool forwards = step <= 3;
+    int lnkdir = forwards ? step : 7 - step;
+    if (!forwards) pos[lnkdir]--; // if we are going backwards the link is on the adjacent site
+    for (int d=0; d<4; d++) n.dx[d] = pos[d];
+    if (forwards) pos[lnkdir]++;
+    n.dir = lnkdir;
+    n.dagger = !forwards;
+    n.depth = depth;
+    n.pad = 0;
+    n.coeff = node.coeff;
+    tree.push_back(n);
+
+    for (unsigned int c=0; c<node.child.size(); c++) {
+      int child_pos[4] = {pos[0], pos[1], pos[2], pos[3]};
+      flattenPathTree(tree, trie, node.child[c], depth+1, child_pos);
+    }
+  }
+
+  /**
+     @brief Compile the paths of one direction into a prefix tree,
+     flattened depth first so that the parent product of each node is
+     on the stack when the node is evaluated.  Paths with zero
+     coefficient are dropped and identical paths are merged.
+     @param[out] tree The flattened tree
+     @param[in] dir The direction of the force
+     @param[in] input_path Paths of this direction
+     @param[in] length Length of each path
+     @param[in] path_coeff Coefficient of each path
+     @param[in] num_paths Number of paths
+     @return The number of roots, i.e., distinct first links
+   */
+  static int compilePathTree(std::vector<GaugeForcePathNode> &tree, int dir, int **input_path,
+			     const int *length, const double *path_coeff, int num_paths) {
+    std::vector<PathTrieNode> trie(1, PathTrieNode(-1));
+    for (int i=0; i<num_paths; i++) {
+      if (path_coeff[i] == 0) continue;
+      int t = 0;
+      for (int j=0; j<length[i]; j++) {
+	int step = input_path[i][j];
+	if (step < 0 || step > 7) errorQuda("Invalid step %d in path %d", step, i);
+	int next = -1;
+	for (unsigned int c=0; c<trie[t].child.size(); c++)
+	  if (trie[trie[t].child[c]].step == step) next = trie[t].child[c];
+	if (next < 0) {
+	  next = trie.size();
+	  trie[t].child.push_back(next);
+	  trie.push_back(PathTrieNode(step));
+	}
+	t = next;
+      }
+      trie[t].coeff += path_coeff[i];
+    }
+
+    tree.clear();
+    for (unsigned int c=0; c<trie[0].child.size(); c++) {
+      int pos[4] = {0, 0, 0, 0};
+      pos[dir]++; // start from end of link in direction dir
+      flattenPathTree(tree, trie, trie[0].child[c], 0, pos);
+    }
+    return trie[0].child.size();
+  }
+
+  long long gaugeForceFlops(int ***input_path, const int *length, const double *path_coeff, int num_paths, bool tree)
+  {
+    int max_length = 0;
+    for (int i=0; i<num_paths; i++) max_length = length[i] > max_length ? length[i] : max_length;
+    if (max_length > gauge_force_max_depth) tree = false;
+
+    long long mults = 0;
+    for (int dir=0; dir<4; dir++) {
+      if (tree) {
+	std::vector<GaugeForcePathNode> nodes;
+	int roots = compilePathTree(nodes, dir, input_path[dir], length, path_coeff, num_paths);
+	mults += nodes.size() - roots + 1;
+      } else {
+	mults += 1;
+	for (int i=0; i<num_paths; i++) if (path_coeff[i] != 0) mults += length[i] - 1;
+      }
+    }
+    return mults * 198ll;
+  }
+
 #ifdef GPU_GAUGE_FORCE
 
-  template <typename Mom, typename Gauge>
-  struct GaugeForceArg {
-    Mom mom;
+  /**
+     The paths of a gauge action in the layout read by the kernels:
+     the flattened path arrays and, when every path fits, the path
+     tree of each direction.  They are copied to the device for
+     device fields and freed on destruction.
+   */
+  struct GaugeForcePaths {
+    const bool device;
+    int *input_path_d[4];
+    int *length_d;
+    double *path_coeff_d;
+    int num_paths;
+    int path_max_length;
+    int count; // equal to sum of all path lengths
+    bool tree; // whether the paths are evaluated as a path tree
+    GaugeForcePathNode *node_d; // flattened path trees of all directions
+    int num_nodes[4];
+    int num_roots[4];
+
+    GaugeForcePaths(int ***input_path, const int *length_h, const double *path_coeff_h, int num_paths,
+		    int path_max_length, bool device, bool tree_eval)
+      : device(device), num_paths(num_paths), path_max_length(path_max_length), count(0), tree(false),
+	node_d(nullptr), num_nodes{ 0, 0, 0, 0 }, num_roots{ 0, 0, 0, 0 }
+    {
+      size_t bytes = num_paths*path_max_length*sizeof(int);
+      int max_length = 0;
+      for (int dir=0; dir<4; dir++) {
+	int* input_path_h = (int*)safe_malloc(bytes);
+	memset(input_path_h, 0, bytes);
+
+	// flatten the input_path array for copying to the device
+	for (int i=0; i < num_paths; i++) {
+	  for (int j=0; j < length_h[i]; j++) {
+	    input_path_h[i*path_max_length + j] = input_path[dir][i][j];
+	    if (dir==0) count++;
+	  }
+	  if (length_h[i] > max_length) max_length = length_h[i];
+	}
+
+	if (device) {
+	  input_path_d[dir] = (int*)device_malloc(bytes);
+	  qudaMemcpy(input_path_d[dir], input_path_h, bytes, cudaMemcpyHostToDevice);
+	  host_free(input_path_h);
+	} else {
+	  input_path_d[dir] = input_path_h;
+	}
+      }
+
+      //length
+      length_d = const_cast<int*>(length_h);
+      if (device) {
+	length_d = (int*)device_malloc(num_paths*sizeof(int));
+	qudaMemcpy(length_d, length_h, num_paths*sizeof(int), cudaMemcpyHostToDevice);
+      }
+
+      //path_coeff
+      path_coeff_d = const_cast<double*>(path_coeff_h);
+      if (device) {
+	path_coeff_d = (double*)device_malloc(num_paths*sizeof(double));
+	qudaMemcpy(path_coeff_d, path_coeff_h, num_paths*sizeof(double), cudaMemcpyHostToDevice);
+      }
+
+      // compile the paths into a tree of shared sub-paths
+      tree = tree_eval && max_length <= gauge_force_max_depth;
+      if (!tree) return;
+
+      std::vector<GaugeForcePathNode> nodes[4];
+      size_t total = 0;
+      for (int dir=0; dir<4; dir++) {
+	num_roots[dir] = compilePathTree(nodes[dir], dir, input_path[dir], length_h, path_coeff_h, num_paths);
+	num_nodes[dir] = nodes[dir].size();
+	total += nodes[dir].size();
+      }
+
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+	int links = 0;
+	for (int i=0; i<num_paths; i++) if (path_coeff_h[i] != 0) links += length_h[i];
+	printfQuda("Gauge force path tree: %d links per direction in %d paths, tree nodes = %d %d %d %d\n",
+		   links, num_paths, num_nodes[0], num_nodes[1], num_nodes[2], num_nodes[3]);
+      }
+
+      node_d = device ? (GaugeForcePathNode*)device_malloc(total*sizeof(GaugeForcePathNode)) :
+	(GaugeForcePathNode*)safe_malloc(total*sizeof(GaugeForcePathNode));
+      size_t offset = 0;
+      for (int dir=0; dir<4; dir++) {
+	size_t tree_bytes = nodes[dir].size()*sizeof(GaugeForcePathNode);
+	if (device) {
+	  if (tree_bytes) qudaMemcpy(node_d + offset, nodes[dir].data(), tree_bytes, cudaMemcpyHostToDevice);
+	} else {
+	  memcpy(node_d + offset, nodes[dir].data(), tree_bytes);
+	}
+	offset += nodes[dir].size();
+      }
+    }
+
+    // offset of the path tree of direction dir
+    const GaugeForcePathNode *Tree(int dir) const {
+      size_t offset = 0;
+      for (int d=0; d<dir; d++) offset += num_nodes[d];
+      return node_d ? node_d + offset : nullptr;
+    }
+
+    ~GaugeForcePaths() {
+      if (device) {
+	device_free(length_d);
+	device_free(path_coeff_d);
+	for (int dir=0; dir<4; dir++) device_free(input_path_d[dir]);
+	if (node_d) device_free(node_d);
+      } else {
+	for (int dir=0; dir<4; dir++) host_free(input_path_d[dir]);
+	if (node_d) host_free(node_d);
+      }
+    }
+  };
+
+  /**
+     The gauge field and paths read by the path evaluation, common to
+     the force and the action
+   */
+  template <typename Gauge>
+  struct GaugePathArg {
     const Gauge u;
 
     int threads;
@@ -20,30 +261,51 @@ namespace quda {
     int num_paths;
     int path_max_length;
 
-    double coeff;
-
     const int *input_path_d[4];
     const int *length_d;
     const double *path_coeff_d;
 
     int count; // equal to sum of all path lengths.  Used a convenience for computing perf
 
-    GaugeForceArg(Mom &mom, const Gauge &u, int num_paths, int path_max_length, double coeff,
-                  int **input_path_d, const int *length_d, const double* path_coeff_d, int count,
-		  const GaugeField &meta_mom, const GaugeField &meta_u)
-      : mom(mom), u(u), threads(meta_mom.VolumeCB()), num_paths(num_paths),
-	path_max_length(path_max_length), coeff(coeff),
-	input_path_d{ input_path_d[0], input_path_d[1], input_path_d[2], input_path_d[3] },
-	length_d(length_d), path_coeff_d(path_coeff_d), count(count)
+    bool tree; // whether the paths are evaluated as a path tree
+    const GaugeForcePathNode *node_d[4]; // flattened path tree of each direction
+    int num_nodes[4];
+    int num_roots[4];
+
+    GaugePathArg(const Gauge &u, const GaugeForcePaths &paths, const int *X_, const GaugeField &meta_u)
+      : u(u), num_paths(paths.num_paths), path_max_length(paths.path_max_length),
+	input_path_d{ paths.input_path_d[0], paths.input_path_d[1], paths.input_path_d[2], paths.input_path_d[3] },
+	length_d(paths.length_d), path_coeff_d(paths.path_coeff_d), count(paths.count), tree(paths.tree),
+	node_d{ paths.Tree(0), paths.Tree(1), paths.Tree(2), paths.Tree(3) },
+	num_nodes{ paths.num_nodes[0], paths.num_nodes[1], paths.num_nodes[2], paths.num_nodes[3] },
+	num_roots{ paths.num_roots[0], paths.num_roots[1], paths.num_roots[2], paths.num_roots[3] }
     {
       for(int i=0; i<4; i++) {
-	X[i] = meta_mom.X()[i];
+	X[i] = X_[i];
 	E[i] = meta_u.X()[i];
 	border[i] = (E[i] - X[i])/2;
       }
+      threads = X[0]*X[1]*X[2]*X[3]/2;
     }
+  };
+
+  template <typename Mom, typename Gauge>
+  struct GaugeForceArg : public GaugePathArg<Gauge> {
+    Mom mom;
+    double coeff;
+
+    GaugeForceArg(Mom &mom, const Gauge &u, double coeff, const GaugeForcePaths &paths,
+		  const GaugeField &meta_mom, const GaugeField &meta_u)
+      : GaugePathArg<Gauge>(u, paths, meta_mom.X(), meta_u), mom(mom), coeff(coeff) { }
+  };
 
-    virtual ~GaugeForceArg() { }
+  /**
+     Reduction of the path traces Re Tr[U_mu(x) P(x)] over the lattice
+   */
+  template <typename Gauge>
+  struct GaugeLoopActionArg : public ReduceArg<double>, public GaugePathArg<Gauge> {
+    GaugeLoopActionArg(const Gauge &u, const GaugeForcePaths &paths, const int *X, const GaugeField &meta_u)
+      : ReduceArg<double>(), GaugePathArg<Gauge>(u, paths, X, meta_u) { }
   };
 
   __device__ __host__ inline static int flipDir(int dir) { return (7-dir); }
@@ -59,14 +321,41 @@ namespace quda {
 #endif
   }
 
+  /**
+     @brief Sum of the paths of direction dir evaluated from the path
+     tree: each node costs one link load and, unless it is a root, one
+     multiplication with its parent product.
+   */
   template<typename Float, typename Arg, int dir>
-  __device__ __host__ inline void GaugeForceKernel(Arg &arg, int idx, int parity)
+  __device__ __host__ inline Matrix<complex<Float>,3> pathTreeStaple(Arg &arg, const int x[4], int parity)
   {
     typedef Matrix<complex<Float>,3> Link;
+    Link staple;
+    Link prod[gauge_force_max_depth];
+
+    const GaugeForcePathNode *node = arg.node_d[dir];
+    for (int n=0; n<arg.num_nodes[dir]; n++) {
+      const GaugeForcePathNode nd = node[n];
+      const int dx[4] = { nd.dx[0], nd.dx[1], nd.dx[2], nd.dx[3] };
+      const int link_parity = (parity + dx[0] + dx[1] + dx[2] + dx[3]) & 1;
+
+      Link U;
+      arg.u.load((Float*)U.data, linkIndexShift(x,dx,arg.E), nd.dir, link_parity);
+      if (nd.dagger) U = conj(U);
+      prod[nd.depth] = (nd.depth == 0) ? U : prod[nd.depth-1] * U;
+      if (nd.coeff != 0) staple = staple + static_cast<Float>(nd.coeff)*prod[nd.depth];
+    }
+    return staple;
+  }
 
-    int x[4] = {0, 0, 0, 0};
-    getCoords(x, idx, arg.X, parity);
-    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+  /**
+     @brief Sum of the paths of direction dir with each path
+     evaluated independently
+   */
+  template<typename Float, typename Arg, int dir>
+  __device__ __host__ inline Matrix<complex<Float>,3> pathStaple(Arg &arg, const int x[4], int parity)
+  {
+    typedef Matrix<complex<Float>,3> Link;
 
     //linkA: current matrix
     //linkB: the loaded matrix in this round
@@ -126,7 +415,22 @@ namespace quda {
       staple = staple + coeff*linkA;
     } //i
 
+    return staple;
+  }
+
+  template<typename Float, typename Arg, int dir>
+  __device__ __host__ inline void GaugeForceKernel(Arg &arg, int idx, int parity)
+  {
+    typedef Matrix<complex<Float>,3> Link;
+
+    int x[4] = {0, 0, 0, 0};
+    getCoords(x, idx, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+    Link staple = arg.tree ? pathTreeStaple<Float,Arg,dir>(arg, x, parity) : pathStaple<Float,Arg,dir>(arg, x, parity);
+
     // multiply by U(x)
+    Link linkA;
     arg.u.load((Float*)linkA.data, linkIndex(x,arg.E), dir, parity);
     linkA = linkA * staple;
 
@@ -139,10 +443,84 @@ namespace quda {
     return;
   }
 
+  /**
+     @brief Host evaluation of the path tree and momentum update at
+     host_simd_width consecutive sites of one parity, vectorized
+     across the sites with the structure-of-arrays matrix primitives.
+     Lanes beyond the end of the checkerboard repeat the first site
+     and are discarded.
+   */
+  template<typename Float, typename Arg>
+  void GaugeForceBatchHost(Arg &arg, int dir, int x0, int parity)
+  {
+    constexpr int W = host_simd_width;
+    const int n = std::min(W, arg.threads - x0);
+    MatrixSoA<Float,W> staple, U, prod[gauge_force_max_depth];
+
+    int x[W][4];
+    for (int w=0; w<W; w++) {
+      getCoords(x[w], x0 + (w < n ? w : 0), arg.X, parity);
+      for (int dr=0; dr<4; ++dr) x[w][dr] += arg.border[dr]; // extended grid coordinates
+    }
+
+    staple.zero();
+    const GaugeForcePathNode *node = arg.node_d[dir];
+    for (int i=0; i<arg.num_nodes[dir]; i++) {
+      const GaugeForcePathNode nd = node[i];
+      const int dx[4] = { nd.dx[0], nd.dx[1], nd.dx[2], nd.dx[3] };
+      const int link_parity = (parity + dx[0] + dx[1] + dx[2] + dx[3]) & 1;
+
+      for (int w=0; w<W; w++) {
+	Float v[18];
+	arg.u.load(v, linkIndexShift(x[w],dx,arg.E), nd.dir, link_parity);
+	U.insert(v, w);
+      }
+      if (nd.dagger) adjoint(U, U);
+
+      if (nd.depth == 0) prod[0] = U;
+      else mulNN(prod[nd.depth], prod[nd.depth-1], U);
+      if (nd.coeff != 0) axpy(static_cast<Float>(nd.coeff), prod[nd.depth], staple);
+    }
+
+    // multiply by U(x)
+    for (int w=0; w<W; w++) {
+      Float v[18];
+      arg.u.load(v, linkIndex(x[w],arg.E), dir, parity);
+      U.insert(v, w);
+    }
+    mulNN(prod[0], U, staple);
+
+    // update mom(x)
+    for (int w=0; w<n; w++) {
+      Float v[18];
+      arg.mom.load(v, x0+w, dir, parity);
+      U.insert(v, w);
+    }
+    axpy(static_cast<Float>(-arg.coeff), prod[0], U);
+    makeAntiHerm(U);
+    for (int w=0; w<n; w++) {
+      Float v[18];
+      U.extract(v, w);
+      arg.mom.save(v, x0+w, dir, parity);
+    }
+  }
+
   template <typename Float, typename Arg>
   void GaugeForceCPU(Arg &arg) {
+    if (arg.tree) {
+      const int nBlock = (arg.threads + host_simd_width - 1) / host_simd_width;
+#pragma omp parallel for
+      for (int i=0; i<4*2*nBlock; i++) {
+	const int dir = i / (2*nBlock);
+	const int parity = (i / nBlock) % 2;
+	GaugeForceBatchHost<Float,Arg>(arg, dir, (i % nBlock)*host_simd_width, parity);
+      }
+      return;
+    }
+
     for (int dir=0; dir<4; dir++) {
       for (int parity=0; parity<2; parity++) {
+#pragma omp parallel for
         for (int idx=0; idx<arg.threads; idx++) {
 	  switch(dir) {
 	  case 0:
@@ -215,8 +593,18 @@ namespace quda {
     void preTune() { arg.mom.save(); }
     void postTune() { arg.mom.load(); } 
   
-    long long flops() const { return (arg.count - arg.num_paths + 1) * 198ll * 2 * arg.mom.volumeCB * 4; }
-    long long bytes() const { return ((arg.count + 1ll) * arg.u.Bytes() + 2ll*arg.mom.Bytes()) * 2 * arg.mom.volumeCB * 4; }
+    long long flops() const {
+      if (!arg.tree) return (arg.count - arg.num_paths + 1) * 198ll * 2 * arg.mom.volumeCB * 4;
+      long long mults = 0;
+      for (int dir=0; dir<4; dir++) mults += arg.num_nodes[dir] - arg.num_roots[dir] + 1;
+      return mults * 198ll * 2 * arg.mom.volumeCB;
+    }
+    long long bytes() const {
+      if (!arg.tree) return ((arg.count + 1ll) * arg.u.Bytes() + 2ll*arg.mom.Bytes()) * 2 * arg.mom.volumeCB * 4;
+      long long links = 0;
+      for (int dir=0; dir<4; dir++) links += arg.num_nodes[dir] + 1;
+      return (links * arg.u.Bytes() + 4 * 2ll*arg.mom.Bytes()) * 2 * arg.mom.volumeCB;
+    }
 
     TuneKey tuneKey() const {
       std::stringstream aux;
@@ -227,6 +615,7 @@ namespace quda {
       comm[3] = (commDimPartitioned(3) ? '1' : '0');
       comm[4] = '\0';
       aux << "comm=" << comm << ",threads=" << arg.threads << ",num_paths=" << arg.num_paths;
+      if (arg.tree) aux << ",tree=" << arg.num_nodes[0] << "," << arg.num_nodes[1] << "," << arg.num_nodes[2] << "," << arg.num_nodes[3];
       return TuneKey(vol_str, typeid(*this).name(), aux.str().c_str());
     }  
 
@@ -266,53 +655,21 @@ namespace quda {
   
   template <typename Float, typename Mom, typename Gauge>
   void gaugeForce(Mom mom, const Gauge &u, GaugeField& meta_mom, const GaugeField& meta_u, const double coeff,
-		  int ***input_path, const int* length_h, const double* path_coeff_h, const int num_paths, const int path_max_length)
+		  int ***input_path, const int* length_h, const double* path_coeff_h, const int num_paths, const int path_max_length,
+		  bool tree_eval)
   {
-    size_t bytes = num_paths*path_max_length*sizeof(int);
-    int *input_path_d[4];
-
-    int count = 0;
-    for (int dir=0; dir<4; dir++) {
-      input_path_d[dir] = (int*)device_malloc(bytes);
-      cudaMemset(input_path_d[dir], 0, bytes);
-
-      int* input_path_h = (int*)safe_malloc(bytes);
-      memset(input_path_h, 0, bytes);
-      
-      // flatten the input_path array for copying to the device
-      for (int i=0; i < num_paths; i++) {
-	for (int j=0; j < length_h[i]; j++) {
-	  input_path_h[i*path_max_length + j] = input_path[dir][i][j];
-          if (dir==0) count++;
-	}
-      }
-      qudaMemcpy(input_path_d[dir], input_path_h, bytes, cudaMemcpyHostToDevice);
-
-      host_free(input_path_h);
-    }
-      
-    //length
-    int* length_d = (int*)device_malloc(num_paths*sizeof(int));
-    qudaMemcpy(length_d, length_h, num_paths*sizeof(int), cudaMemcpyHostToDevice);
+    const bool device = meta_mom.Location() == QUDA_CUDA_FIELD_LOCATION;
+    GaugeForcePaths paths(input_path, length_h, path_coeff_h, num_paths, path_max_length, device, tree_eval);
 
-    //path_coeff
-    double* path_coeff_d = (double*)device_malloc(num_paths*sizeof(double));
-    qudaMemcpy(path_coeff_d, path_coeff_h, num_paths*sizeof(double), cudaMemcpyHostToDevice);
-
-    GaugeForceArg<Mom,Gauge> arg(mom, u, num_paths, path_max_length, coeff, input_path_d,
-				 length_d, path_coeff_d, count, meta_mom, meta_u);
+    GaugeForceArg<Mom,Gauge> arg(mom, u, coeff, paths, meta_mom, meta_u);
     GaugeForce<Float,GaugeForceArg<Mom,Gauge> > gauge_force(arg, meta_mom, meta_u);
     gauge_force.apply(0);
-    checkCudaError();
-
-    device_free(length_d);
-    device_free(path_coeff_d);
-    for (int dir=0; dir<4; dir++) device_free(input_path_d[dir]);
+    if (device) checkCudaError();
   }
 
   template <typename Float>
   void gaugeForce(GaugeField& mom, const GaugeField& u, const double coeff, int ***input_path,
-		  const int* length, const double* path_coeff, const int num_paths, const int max_length)
+		  const int* length, const double* path_coeff, const int num_paths, const int max_length, bool tree)
   {
     if (mom.Reconstruct() != QUDA_RECONSTRUCT_10)
       errorQuda("Reconstruction type %d not supported", mom.Reconstruct());
@@ -321,23 +678,193 @@ namespace quda {
       typedef typename gauge::FloatNOrder<Float,18,2,11> M;
       if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type G;
-	gaugeForce<Float,M,G>(M(mom), G(u), mom, u, coeff, input_path, length, path_coeff, num_paths, max_length);
+	gaugeForce<Float,M,G>(M(mom), G(u), mom, u, coeff, input_path, length, path_coeff, num_paths, max_length, tree);
       } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
 	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type G;
-	gaugeForce<Float,M,G>(M(mom), G(u), mom, u, coeff, input_path, length, path_coeff, num_paths, max_length);	
+	gaugeForce<Float,M,G>(M(mom), G(u), mom, u, coeff, input_path, length, path_coeff, num_paths, max_length, tree);	
       } else {
 	errorQuda("Reconstruction type %d not supported", u.Reconstruct());
       }
+    } else if (mom.Order() == QUDA_MILC_GAUGE_ORDER) {
+      // host HMC: the force is accumulated straight into the compressed momentum
+      typedef typename gauge::MILCMomOrder<Float> M;
+      if (u.Reconstruct() != QUDA_RECONSTRUCT_NO)
+	errorQuda("Reconstruction type %d not supported", u.Reconstruct());
+      if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+	typedef typename gauge::MILCOrder<Float,18> G;
+	gaugeForce<Float,M,G>(M(mom), G(u), mom, u, coeff, input_path, length, path_coeff, num_paths, max_length, tree);
+      } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+	typedef typename gauge::QDPOrder<Float,18> G;
+	gaugeForce<Float,M,G>(M(mom), G(u), mom, u, coeff, input_path, length, path_coeff, num_paths, max_length, tree);
+      } else {
+	errorQuda("Gauge Field order %d not supported", u.Order());
+      }
     } else {
       errorQuda("Gauge Field order %d not supported", mom.Order());
     }
 
   }
+  /**
+     @brief Sum of Re Tr[U_mu(x) P(x)] over the paths of direction dir
+   */
+  template<typename Float, typename Arg, int dir>
+  __device__ __host__ inline double loopTrace(Arg &arg, const int x[4], int parity)
+  {
+    typedef Matrix<complex<Float>,3> Link;
+    Link staple = arg.tree ? pathTreeStaple<Float,Arg,dir>(arg, x, parity) : pathStaple<Float,Arg,dir>(arg, x, parity);
+    Link U;
+    arg.u.load((Float*)U.data, linkIndex(x,arg.E), dir, parity);
+    return getTrace(U * staple).x;
+  }
+
+  template<typename Float, typename Arg>
+  __device__ __host__ inline double loopActionSite(Arg &arg, int idx, int parity)
+  {
+    int x[4] = {0, 0, 0, 0};
+    getCoords(x, idx, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+    return loopTrace<Float,Arg,0>(arg, x, parity) + loopTrace<Float,Arg,1>(arg, x, parity) +
+      loopTrace<Float,Arg,2>(arg, x, parity) + loopTrace<Float,Arg,3>(arg, x, parity);
+  }
+
+  template<int blockSize, typename Float, typename Arg>
+  __global__ void computeGaugeLoopAction(Arg arg)
+  {
+    int x = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y;
+    double action = 0.0;
+
+    if (x < arg.threads) action = loopActionSite<Float>(arg, x, parity);
+
+    // perform final inter-block reduction and write out result
+    reduce2d<blockSize,2>(arg, action);
+  }
+
+  template <typename Float, typename Arg>
+  class GaugeLoopAction : TunableLocalParity {
+    Arg &arg;
+    const GaugeField &meta;
+
+  private:
+    unsigned int sharedBytesPerThread() const { return 4; } // for dynamic indexing array
+    unsigned int minThreads() const { return arg.threads; }
+
+  public:
+    GaugeLoopAction(Arg &arg, const GaugeField &meta) : arg(arg), meta(meta) { }
+    virtual ~GaugeLoopAction() { }
+
+    void apply(const cudaStream_t &stream) {
+      if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) {
+	arg.result_h[0] = 0.0;
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	LAUNCH_KERNEL_LOCAL_PARITY(computeGaugeLoopAction, tp, stream, arg, Float, Arg);
+      } else {
+	arg.result_h[0] = hostReduce<double>(2*arg.threads, [&](int i) {
+	    const int parity = i / arg.threads;
+	    return loopActionSite<Float>(arg, i - parity*arg.threads, parity);
+	  });
+      }
+    }
+
+    TuneKey tuneKey() const {
+      std::stringstream aux;
+      aux << "threads=" << arg.threads << ",num_paths=" << arg.num_paths;
+      if (arg.tree) aux << ",tree=" << arg.num_nodes[0] << "," << arg.num_nodes[1] << "," << arg.num_nodes[2] << "," << arg.num_nodes[3];
+      return TuneKey(meta.VolString(), typeid(*this).name(), aux.str().c_str());
+    }
+
+    long long flops() const {
+      if (!arg.tree) return (arg.count - arg.num_paths + 1) * 198ll * 2 * arg.threads * 4;
+      long long mults = 0;
+      for (int dir=0; dir<4; dir++) mults += arg.num_nodes[dir] - arg.num_roots[dir] + 1;
+      return mults * 198ll * 2 * arg.threads;
+    }
+    long long bytes() const {
+      if (!arg.tree) return (arg.count + 1ll) * arg.u.Bytes() * 2 * arg.threads * 4;
+      long long links = 0;
+      for (int dir=0; dir<4; dir++) links += arg.num_nodes[dir] + 1;
+      return links * arg.u.Bytes() * 2 * arg.threads;
+    }
+  };
+
+  template <typename Float, typename Gauge>
+  double gaugeLoopAction(const Gauge &u, const GaugeField &meta_u, int ***input_path, const int *length,
+			 const double *path_coeff, int num_paths, int max_length)
+  {
+    // each loop through the link U_mu(x) appears once among the paths
+    // of each of its links, so it is weighted by one over its length
+    std::vector<double> coeff(num_paths);
+    for (int i=0; i<num_paths; i++) coeff[i] = path_coeff[i] / (length[i] + 1);
+
+    const bool device = meta_u.Location() == QUDA_CUDA_FIELD_LOCATION;
+    GaugeForcePaths paths(input_path, length, coeff.data(), num_paths, max_length, device, true);
+
+    int X[4];
+    for (int d=0; d<4; d++) X[d] = meta_u.X()[d] - 2*meta_u.R()[d];
+    GaugeLoopActionArg<Gauge> arg(u, paths, X, meta_u);
+    GaugeLoopAction<Float,GaugeLoopActionArg<Gauge> > action(arg, meta_u);
+    action.apply(0);
+    if (device) {
+      cudaDeviceSynchronize();
+      checkCudaError();
+    }
+
+    comm_allreduce((double*)arg.result_h);
+    return arg.result_h[0];
+  }
+
+  template <typename Float>
+  double gaugeLoopAction(const GaugeField& u, int ***input_path, const int* length, const double* path_coeff,
+			 int num_paths, int max_length)
+  {
+    if (u.Order() == QUDA_FLOAT2_GAUGE_ORDER || u.Order() == QUDA_FLOAT4_GAUGE_ORDER) {
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type G;
+	return gaugeLoopAction<Float,G>(G(u), u, input_path, length, path_coeff, num_paths, max_length);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type G;
+	return gaugeLoopAction<Float,G>(G(u), u, input_path, length, path_coeff, num_paths, max_length);
+      } else {
+	errorQuda("Reconstruction type %d not supported", u.Reconstruct());
+      }
+    } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+      typedef typename gauge::MILCOrder<Float,18> G;
+      return gaugeLoopAction<Float,G>(G(u), u, input_path, length, path_coeff, num_paths, max_length);
+    } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+      typedef typename gauge::QDPOrder<Float,18> G;
+      return gaugeLoopAction<Float,G>(G(u), u, input_path, length, path_coeff, num_paths, max_length);
+    } else {
+      errorQuda("Gauge Field order %d not supported", u.Order());
+    }
+    return 0.0;
+  }
 #endif // GPU_GAUGE_FORCE
 
 
+  double gaugeLoopAction(const GaugeField& u, double coeff, int ***input_path, int *length, double *path_coeff,
+			 int num_paths, int max_length)
+  {
+#ifdef GPU_GAUGE_FORCE
+    if (u.Reconstruct() != QUDA_RECONSTRUCT_NO && u.Location() == QUDA_CPU_FIELD_LOCATION)
+      errorQuda("Reconstruction type %d not supported", u.Reconstruct());
+
+    switch(u.Precision()) {
+    case QUDA_DOUBLE_PRECISION:
+      return -coeff * gaugeLoopAction<double>(u, input_path, length, path_coeff, num_paths, max_length);
+    case QUDA_SINGLE_PRECISION:
+      return -coeff * gaugeLoopAction<float>(u, input_path, length, path_coeff, num_paths, max_length);
+    default:
+      errorQuda("Unsupported precision %d", u.Precision());
+    }
+#else
+    errorQuda("Gauge force has not been built");
+#endif // GPU_GAUGE_FORCE
+    return 0.0;
+  }
+
   void gaugeForce(GaugeField& mom, const GaugeField& u, double coeff, int ***input_path, 
-		  int *length, double *path_coeff, int num_paths, int max_length)
+		  int *length, double *path_coeff, int num_paths, int max_length, bool tree)
   {
 #ifdef GPU_GAUGE_FORCE
     if (mom.Precision() != u.Precision()) errorQuda("Mixed precision not supported");
@@ -345,10 +872,10 @@ namespace quda {
 
     switch(mom.Precision()) {
     case QUDA_DOUBLE_PRECISION:
-      gaugeForce<double>(mom, u, coeff, input_path, length, path_coeff, num_paths, max_length);
+      gaugeForce<double>(mom, u, coeff, input_path, length, path_coeff, num_paths, max_length, tree);
       break;
     case QUDA_SINGLE_PRECISION:
-      gaugeForce<float>(mom, u, coeff, input_path, length, path_coeff, num_paths, max_length);
+      gaugeForce<float>(mom, u, coeff, input_path, length, path_coeff, num_paths, max_length, tree);
       break;
     default:
       errorQuda("Unsupported precision %d", mom.Precision());
@@ -34,15 +34,17 @@ namespace quda {
     }
   };
 
-  template<int blockSize, typename Float, typename Gauge>
-  __global__ void computePlaq(GaugePlaqArg<Gauge> arg){
+  /**
+     Compute the spatial (x) and temporal (y) plaquette sums at a
+     given site.  Shared between the device kernel and the host.
+   */
+  template<typename Float, typename Gauge>
+  __device__ __host__ inline double2 plaquetteSite(GaugePlaqArg<Gauge> &arg, int idx, int parity) {
     typedef Matrix<complex<Float>,3> Link;
-    int idx = threadIdx.x + blockIdx.x*blockDim.x;
-    int parity = threadIdx.y;
 
     double2 plaq = make_double2(0.0,0.0);
 
-    if(idx < arg.threads) {
+    {
       int x[4];
       getCoords(x, idx, arg.X, parity);
       for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
@@ -76,10 +78,29 @@ namespace quda {
       }
     }
 
+    return plaq;
+  }
+
+  template<int blockSize, typename Float, typename Gauge>
+  __global__ void computePlaq(GaugePlaqArg<Gauge> arg){
+    int idx = threadIdx.x + blockIdx.x*blockDim.x;
+    int parity = threadIdx.y;
+
+    double2 plaq = make_double2(0.0,0.0);
+    if (idx < arg.threads) plaq = plaquetteSite<Float>(arg, idx, parity);
+
     // perform final inter-block reduction and write out result
     reduce2d<blockSize,2>(arg, plaq);
   }
 
+  template<typename Float, typename Gauge>
+  void computePlaqCPU(GaugePlaqArg<Gauge> &arg) {
+    // both parities are folded into a single index range for the deterministic reduction
+    arg.result_h[0] = hostReduce<double2>(2*arg.threads, [&](int i) {
+	return plaquetteSite<Float>(arg, i % arg.threads, i / arg.threads);
+      });
+  }
+
   template<typename Float, typename Gauge>
     class GaugePlaq : TunableLocalParity {
       GaugePlaqArg<Gauge> arg;
@@ -101,7 +122,7 @@ namespace quda {
 	  LAUNCH_KERNEL_LOCAL_PARITY(computePlaq, tp, stream, arg, Float, Gauge);
 	  cudaDeviceSynchronize();
         } else {
-          errorQuda("CPU not supported yet\n");
+	  computePlaqCPU<Float>(arg);
         }
       }
 
@@ -131,7 +152,22 @@ namespace quda {
 
   template<typename Float>
   void plaquette(const GaugeField& data, double2 &plq, QudaFieldLocation location) {
-    INSTANTIATE_RECONSTRUCT(plaquette<Float>, data, plq, location);
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      // the host field is only extended when partitioned, otherwise we wrap around locally
+      for (int d=0; d<4; d++)
+	if (comm_dim_partitioned(d) && data.R()[d] == 0)
+	  errorQuda("Host plaquette requires an extended gauge field when dimension %d is partitioned", d);
+
+      if (data.Order() == QUDA_QDP_GAUGE_ORDER) {
+	plaquette<Float>(gauge::QDPOrder<Float,18>(data), data, plq, location);
+      } else if (data.Order() == QUDA_MILC_GAUGE_ORDER) {
+	plaquette<Float>(gauge::MILCOrder<Float,18>(data), data, plq, location);
+      } else {
+	errorQuda("Gauge field order %d not supported on the host", data.Order());
+      }
+    } else {
+      INSTANTIATE_RECONSTRUCT(plaquette<Float>, data, plq, location);
+    }
   }
 #endif
 
@@ -38,7 +38,7 @@ namespace quda {
 
 
   template<typename Float>
-  __device__ __host__  Matrix<complex<Float>,3> genGaussSU3(cuRNGState &localState){
+  __device__ __host__  Matrix<complex<Float>,3> genGaussSU3(PhiloxState &localState){
        Matrix<complex<Float>, 3> ret;
 	       //ret(i,j) = 0.0;
 	       //ret(i,j) = complex<Float>( (Float)(Random<Float>(localState) - 0.5), (Float)(Random<Float>(localState) - 0.5) );
@@ -75,30 +75,38 @@ namespace quda {
   }
 
 
+  /**
+     @brief Generate the Gaussian links of one site.  The links are
+     drawn from the stream of the site, so host and device produce the
+     same field.
+   */
   template<typename Float, typename Gauge>
-  __global__ void computeGenGauss(GaugeGaussArg<Gauge> arg){
+  __device__ __host__ inline void genGaussSite(GaugeGaussArg<Gauge> &arg, int idx, int parity){
     typedef Matrix<complex<Float>,3> Link;
+    int x[4];
+    getCoords(x, idx, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+    int dx[4] = {0, 0, 0, 0};
+    PhiloxState localState = arg.rngstate.State(idx, parity);
+    for(int mu = 0; mu < 4; mu++){
+      Link U = genGaussSU3<Float>(localState);
+      arg.dataDs(mu, linkIndexShift(x,dx,arg.E), parity) = U;
+    }
+  }
+
+  template<typename Float, typename Gauge>
+  __global__ void computeGenGauss(GaugeGaussArg<Gauge> arg){
     int idx = threadIdx.x + blockIdx.x*blockDim.x;
     int parity = threadIdx.y + blockIdx.y*blockDim.y;
+    if(idx < arg.threads) genGaussSite<Float>(arg, idx, parity);
+  }
 
-    typedef Matrix<complex<Float>,3> Link;
-
-
-    if(idx < arg.threads) {
-	int x[4];
-	getCoords(x, idx, arg.X, parity);
-	for (int dr=0; dr<4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
-
-	int dx[4] = {0, 0, 0, 0};
-	for(int mu = 0; mu < 4; mu++){
-	    cuRNGState localState = arg.rngstate.State()[idx + parity*arg.threads];
-
-	    Link U = genGaussSU3<Float>(localState);
-
-	    arg.rngstate.State()[ idx + parity*arg.threads ] = localState;
-	    arg.dataDs(mu, linkIndexShift(x,dx,arg.X), parity) = U;
-	}
-
+  template<typename Float, typename Gauge>
+  void computeGenGaussCPU(GaugeGaussArg<Gauge> &arg){
+    for (int parity=0; parity<2; parity++) {
+#pragma omp parallel for
+      for (int idx=0; idx<arg.threads; idx++) genGaussSite<Float>(arg, idx, parity);
     }
   }
 
@@ -123,7 +131,7 @@ namespace quda {
           computeGenGauss<Float><<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
 	  cudaDeviceSynchronize();
         } else {
-          errorQuda("Randomize GaugeFields on CPU not supported yet\n");
+          computeGenGaussCPU<Float>(arg);
         }
       }
 
@@ -137,16 +145,6 @@ namespace quda {
       long long flops() const { return 0; }
       long long bytes() const { return 0; } 
 
-
-      void preTune(){
-	  //gf.backup();
-	  arg.rngstate.backup();
-      }
-      void postTune(){
-	  //gf.restore();
-	  arg.rngstate.restore();
-      }
-
     }; 
 
   template<typename Float, typename Gauge>
@@ -154,6 +152,8 @@ namespace quda {
       GaugeGaussArg<Gauge> arg(dataDs, data, rngstate);
       GaugeGauss<Float,Gauge> gaugeGauss(arg, data);
       gaugeGauss.apply(0);
+      // launches during tuning regenerate the same field, so the counter is only advanced here
+      rngstate.advance();
 
     }
 
@@ -162,7 +162,17 @@ namespace quda {
   template<typename Float>
   void gaugeGauss(GaugeField &dataDs, RNG &rngstate) {
 
-      if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+      if (dataDs.Location() == QUDA_CPU_FIELD_LOCATION) {
+	  if (dataDs.Reconstruct() != QUDA_RECONSTRUCT_NO)
+	    errorQuda("Reconstruction type %d of host gauge field not supported", dataDs.Reconstruct());
+	  if (dataDs.Order() == QUDA_QDP_GAUGE_ORDER) {
+	    genGauss<Float>(gauge::QDPOrder<Float,18>(dataDs), dataDs, rngstate);
+	  } else if (dataDs.Order() == QUDA_MILC_GAUGE_ORDER) {
+	    genGauss<Float>(gauge::MILCOrder<Float,18>(dataDs), dataDs, rngstate);
+	  } else {
+	    errorQuda("Order %d not supported on the host", dataDs.Order());
+	  }
+      } else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 	  typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type Gauge;
 	  genGauss<Float>(Gauge(dataDs), dataDs, rngstate);
       }else if(dataDs.Reconstruct() == QUDA_RECONSTRUCT_12){
@@ -187,7 +197,7 @@ namespace quda {
 	  errorQuda("Half precision not supported\n");
       }
 
-      if (!dataDs.isNative())
+      if (dataDs.Location() == QUDA_CUDA_FIELD_LOCATION && !dataDs.isNative())
 	  errorQuda("Order %d with %d reconstruct not supported", dataDs.Order(), dataDs.Reconstruct());
 
       if (dataDs.Precision() == QUDA_SINGLE_PRECISION){
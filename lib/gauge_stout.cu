@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <quda_internal.h>
 #include <quda_matrix.h>
+#include <quda_matrix_soa.h>
 #include <su3_project.cuh>
 #include <tune_quda.h>
 #include <gauge_field.h>
@@ -200,6 +202,53 @@ namespace quda {
     }
   }
 
+  /**
+     Host STOUT step of host_simd_width consecutive sites of one
+     parity.  The staples are gathered site by site with
+     computeStaple, after which Omega = rho S U^dagger, its traceless
+     anti-hermitian part iQ, exp(iQ) and the smeared link exp(iQ) U
+     are all computed vectorized across the sites with the
+     structure-of-arrays matrix primitives.  Lanes beyond the end of
+     the checkerboard repeat the first site and are discarded.
+   */
+  template<typename Float, typename GaugeOr, typename GaugeDs>
+  void computeSTOUTStepBatchHost(GaugeSTOUTArg<Float,GaugeOr,GaugeDs> &arg, int dir, int x0, int parity)
+  {
+    typedef Matrix<complex<Float>,3> Link;
+    constexpr int W = host_simd_width;
+    const int n = std::min(W, arg.threads - x0);
+    MatrixSoA<Float,W> U, Stap, Omega, exp_iQ;
+
+    int X[4];
+    for (int dr=0; dr<4; ++dr) X[dr] = arg.X[dr] + 2*arg.border[dr];
+
+    int x[W][4];
+    for (int w=0; w<W; w++) {
+      const int idx = x0 + (w < n ? w : 0);
+      Link S;
+      computeStaple<Float,GaugeOr,GaugeDs,complex<Float> >(arg, idx, parity, dir, S);
+      Stap.insert((Float*)S.data, w);
+
+      getCoords(x[w], idx, arg.X, parity);
+      for (int dr=0; dr<4; ++dr) x[w][dr] += arg.border[dr];
+      Link Uw = arg.origin(dir, linkIndex(x[w],X), parity);
+      U.insert((Float*)Uw.data, w);
+    }
+
+    // Omega = rho * S * U^dagger, and iQ is its traceless anti-hermitian part
+    mulNA(Omega, Stap, U);
+    scale(arg.rho, Omega);
+    makeAntiHerm(Omega);
+    exponentiate(exp_iQ, Omega);
+    mulNN(Stap, exp_iQ, U);
+
+    for (int w=0; w<n; w++) {
+      Link Uw;
+      Stap.extract((Float*)Uw.data, w);
+      arg.dest(dir, linkIndex(x[w],X), parity) = Uw;
+    }
+  }
+
   template<typename Float, typename GaugeOr, typename GaugeDs>
   class GaugeSTOUT : TunableVectorYZ {
       GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg;
@@ -220,8 +269,11 @@ namespace quda {
           TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
           computeSTOUTStep<<<tp.grid,tp.block,tp.shared_bytes>>>(arg);
         } else {
-          errorQuda("CPU not supported yet\n");
-          //computeSTOUTStepCPU(arg);
+          const int nBlock = (arg.threads + host_simd_width - 1) / host_simd_width;
+#pragma omp parallel for
+          for (int i=0; i<3*2*nBlock; i++) {
+            computeSTOUTStepBatchHost(arg, i / (2*nBlock), (i % nBlock)*host_simd_width, (i / nBlock) % 2);
+          }
         }
       }
 
@@ -240,7 +292,23 @@ namespace quda {
     GaugeSTOUTArg<Float,GaugeOr,GaugeDs> arg(origin, dest, dataOr, rho, dataOr.Precision() == QUDA_DOUBLE_PRECISION ? DOUBLE_TOL : SINGLE_TOL);
     GaugeSTOUT<Float,GaugeOr,GaugeDs> gaugeSTOUT(arg,dataOr);
     gaugeSTOUT.apply(0);
-    cudaDeviceSynchronize();
+    if (dataOr.Location() == QUDA_CUDA_FIELD_LOCATION) cudaDeviceSynchronize();
+  }
+
+  template<typename Float>
+  void STOUTStepHost(GaugeField &dataDs, const GaugeField& dataOr, Float rho) {
+    if (dataDs.Order() != dataOr.Order())
+      errorQuda("Origin (%d) and destination (%d) orders must match", dataOr.Order(), dataDs.Order());
+
+    if (dataOr.Order() == QUDA_MILC_GAUGE_ORDER) {
+      typedef gauge::MILCOrder<Float,18> G;
+      STOUTStep(G(dataOr), G(dataDs), dataOr, rho);
+    } else if (dataOr.Order() == QUDA_QDP_GAUGE_ORDER) {
+      typedef gauge::QDPOrder<Float,18> G;
+      STOUTStep(G(dataOr), G(dataDs), dataOr, rho);
+    } else {
+      errorQuda("Gauge field order %d not supported", dataOr.Order());
+    }
   }
 
   template<typename Float>
@@ -309,6 +377,18 @@ namespace quda {
       errorQuda("Half precision not supported\n");
     }
 
+    // host fields, which must be extended with filled borders as on the device
+    if (dataOr.Location() == QUDA_CPU_FIELD_LOCATION && dataDs.Location() == QUDA_CPU_FIELD_LOCATION) {
+      if (dataDs.Precision() == QUDA_SINGLE_PRECISION) {
+	STOUTStepHost<float>(dataDs, dataOr, (float) rho);
+      } else if (dataDs.Precision() == QUDA_DOUBLE_PRECISION) {
+	STOUTStepHost<double>(dataDs, dataOr, rho);
+      } else {
+	errorQuda("Precision %d not supported", dataDs.Precision());
+      }
+      return;
+    }
+
     if (!dataOr.isNative())
       errorQuda("Order %d with %d reconstruct not supported", dataOr.Order(), dataOr.Reconstruct());
 
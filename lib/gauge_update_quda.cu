@@ -1,13 +1,16 @@
 #include <cstdio>
 #include <cstdlib>
+#include <algorithm>
 #include <cuda.h>
 #include <quda_internal.h>
 #include <tune_quda.h>
 #include <gauge_field.h>
 #include <gauge_field_order.h>
 #include <quda_matrix.h>
+#include <quda_matrix_soa.h>
 #include <float_vector.h>
 #include <complex_quda.h>
+#include <index_helper.cuh>
 
 namespace quda {
 
@@ -20,11 +23,38 @@ namespace quda {
     Mom momentum;
     Float dt;
     int nDim;
-    UpdateGaugeArg(const Gauge &out, const Gauge &in, 
-		   const Mom &momentum, Float dt, int nDim)
-      : out(out), in(in), momentum(momentum), dt(dt), nDim(nDim) { }
+    int threads;   // sites of one parity of the momentum
+    int X[4];      // the regular volume parameters
+    int E[4];      // the volume parameters of the gauge field
+    int border[4]; // radius of border, non-zero when the gauge field is extended
+    bool extended;
+    UpdateGaugeArg(const Gauge &out, const Gauge &in, const Mom &momentum, Float dt, int nDim,
+		   const GaugeField &meta_mom, const GaugeField &meta_u)
+      : out(out), in(in), momentum(momentum), dt(dt), nDim(nDim),
+	threads(meta_mom.VolumeCB()), extended(false) {
+      for (int i=0; i<4; i++) {
+	X[i] = meta_mom.X()[i];
+	E[i] = meta_u.X()[i];
+	border[i] = (E[i] - X[i])/2;
+	if (border[i]) extended = true;
+      }
+    }
   };
 
+  /**
+     Index of the link at momentum site x in the gauge field, which
+     is the same site unless the gauge field is extended, in which
+     case only its interior is updated
+   */
+  template <typename Arg>
+  __device__ __host__ inline int updateLinkIndex(const Arg &arg, int x, int parity) {
+    if (!arg.extended) return x;
+    int y[4];
+    getCoords(y, x, arg.X, parity);
+    for (int dr=0; dr<4; ++dr) y[dr] += arg.border[dr]; // extended grid coordinates
+    return linkIndex(y, arg.E);
+  }
+
   /**
      Direct port of the TIFR expsu3 algorithm
   */
@@ -113,8 +143,9 @@ namespace quda {
     typedef complex<Float> Complex;
 
     Matrix<Complex,3> link, result, mom;
+    const int y = updateLinkIndex(arg, x, parity);
     for(int dir=0; dir<arg.nDim; ++dir){
-      arg.in.load((Float*)(link.data), x, dir, parity);
+      arg.in.load((Float*)(link.data), y, dir, parity);
       arg.momentum.load((Float*)(mom.data), x, dir, parity);
 
       Complex trace = getTrace(mom);
@@ -146,20 +177,87 @@ namespace quda {
 	result = link;
       }
 
-      arg.out.save((Float*)(result.data), x, dir, parity);
+      arg.out.save((Float*)(result.data), y, dir, parity);
     } // dir
 
   }
 
+  /**
+     Host update of host_simd_width consecutive sites of one parity,
+     vectorized across the sites with the structure-of-arrays matrix
+     primitives.  The truncated expansion is the same as
+     updateGaugeFieldCompute, while the exact update uses the
+     Cayley-Hamilton exponential of the traceless anti-hermitian
+     momentum in place of expsu3.  Lanes beyond the end of the
+     checkerboard are padded with the identity and discarded.
+   */
   template<typename Float, typename Gauge, typename Mom, int N,
 	   bool conj_mom, bool exact>
-  void updateGaugeField(UpdateGaugeArg<Float,Gauge,Mom> arg) {
+  void updateGaugeFieldBatchHost(UpdateGaugeArg<Float,Gauge,Mom> &arg, int x0, int parity) {
+    constexpr int W = host_simd_width;
+    const int n = std::min(W, arg.threads - x0);
+    MatrixSoA<Float,W> link, mom, result, tmp;
+
+    int y[W];
+    for (int w=0; w<n; w++) y[w] = updateLinkIndex(arg, x0+w, parity);
+
+    for (int dir=0; dir<arg.nDim; ++dir) {
+      for (int w=0; w<W; w++) {
+	if (w < n) {
+	  Float v[18];
+	  arg.in.load(v, y[w], dir, parity);
+	  link.insert(v, w);
+	  arg.momentum.load(v, x0+w, dir, parity);
+	  mom.insert(v, w);
+	} else {
+	  link.identity(w);
+	  mom.identity(w);
+	}
+      }
+
+      if (conj_mom) adjoint(mom, mom);
+
+      // remove the trace
+#pragma omp simd
+      for (int w=0; w<W; w++) {
+	const Float tr_re = (mom.re[0][w] + mom.re[4][w] + mom.re[8][w]) / static_cast<Float>(3.0);
+	const Float tr_im = (mom.im[0][w] + mom.im[4][w] + mom.im[8][w]) / static_cast<Float>(3.0);
+	for (int i=0; i<3; i++) { mom.re[i*4][w] -= tr_re; mom.im[i*4][w] -= tr_im; }
+      }
+
+      if (!exact) {
+	// Nth order expansion of exponential
+	result = link;
+	for (int r=N; r>0; r--) {
+	  mulNN(tmp, mom, result);
+	  result = link;
+	  axpy(arg.dt/r, tmp, result);
+	}
+      } else {
+	scale(arg.dt, mom);
+	exponentiate(tmp, mom);
+	mulNN(result, tmp, link);
+      }
 
-    for (unsigned int parity=0; parity<2; parity++) {
-      for (int x=0; x<arg.out.volumeCB; x++) {
-	updateGaugeFieldCompute<Float,Gauge,Mom,N,conj_mom,exact>
-	  (arg, x, parity);
+      for (int w=0; w<n; w++) {
+	Float v[18];
+	result.extract(v, w);
+	arg.out.save(v, y[w], dir, parity);
       }
+    } // dir
+  }
+
+  template<typename Float, typename Gauge, typename Mom, int N,
+	   bool conj_mom, bool exact>
+  void updateGaugeField(UpdateGaugeArg<Float,Gauge,Mom> arg) {
+    const int nBlock = (arg.threads + host_simd_width - 1) / host_simd_width;
+
+#pragma omp parallel for
+    for (int i=0; i<2*nBlock; i++) {
+      const int parity = i / nBlock;
+      const int b = i % nBlock;
+      updateGaugeFieldBatchHost<Float,Gauge,Mom,N,conj_mom,exact>
+	(arg, b*host_simd_width, parity);
     }
   }
 
@@ -167,9 +265,9 @@ namespace quda {
 	   bool conj_mom, bool exact>
   __global__ void updateGaugeFieldKernel(UpdateGaugeArg<Float,Gauge,Mom> arg) {
     int idx = blockIdx.x*blockDim.x + threadIdx.x;
-    if (idx >= 2*arg.out.volumeCB) return;
-    int parity = (idx >= arg.out.volumeCB) ? 1 : 0;
-    idx -= parity*arg.out.volumeCB;
+    if (idx >= 2*arg.threads) return;
+    int parity = (idx >= arg.threads) ? 1 : 0;
+    idx -= parity*arg.threads;
 
     updateGaugeFieldCompute<Float,Gauge,Mom,N,conj_mom,exact>(arg, idx, parity);
  }
@@ -185,15 +283,15 @@ namespace quda {
     unsigned int sharedBytesPerThread() const { return 0; }
     unsigned int sharedBytesPerBlock(const TuneParam &) const { return 0; }
 
-    unsigned int minThreads() const { return 2*arg.in.volumeCB; }
+    unsigned int minThreads() const { return 2*arg.threads; }
     bool tuneGridDim() const { return false; }
     
   public:
     UpdateGaugeField(const UpdateGaugeArg<Float,Gauge,Mom> &arg,
 		     const GaugeField &meta, QudaFieldLocation location)
       : arg(arg), meta(meta), location(location) {
-      writeAuxString("threads=%d,prec=%lu,stride=%d", 
-		     2*arg.in.volumeCB, sizeof(Float), arg.in.stride);
+      writeAuxString("threads=%d,prec=%lu,stride=%d%s", 
+		     2*arg.threads, sizeof(Float), arg.in.stride, arg.extended ? ",extended" : "");
     }
     virtual ~UpdateGaugeField() { }
     
@@ -209,11 +307,11 @@ namespace quda {
     
     long long flops() const { 
       const int Nc = 3;
-      return arg.nDim*2*arg.in.volumeCB*N*(Nc*Nc*2 +                 // scalar-matrix multiply
+      return arg.nDim*2*arg.threads*N*(Nc*Nc*2 +                 // scalar-matrix multiply
 					   (8*Nc*Nc*Nc - 2*Nc*Nc) +  // matrix-matrix multiply
 					   Nc*Nc*2);                 // matrix-matrix addition
     }
-    long long bytes() const { return arg.nDim*2*arg.in.volumeCB*
+    long long bytes() const { return arg.nDim*2*arg.threads*
 	(arg.in.Bytes() + arg.out.Bytes() + arg.momentum.Bytes()); }
     
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -221,28 +319,28 @@ namespace quda {
   
   template <typename Float, typename Gauge, typename Mom>
   void updateGaugeField(Gauge &out, const Gauge &in, const Mom &mom, 
-			double dt, const GaugeField &meta, bool conj_mom, bool exact,
+			double dt, const GaugeField &meta, const GaugeField &meta_u, bool conj_mom, bool exact,
 			QudaFieldLocation location) {
     // degree of exponential expansion
     const int N = 8;
 
     if (conj_mom) {
       if (exact) {
-	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4);
+	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4, meta, meta_u);
 	UpdateGaugeField<Float,Gauge,Mom,N,true,true> updateGauge(arg, meta, location);
 	updateGauge.apply(0); 
       } else {
-	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4);
+	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4, meta, meta_u);
 	UpdateGaugeField<Float,Gauge,Mom,N,true,false> updateGauge(arg, meta, location);
 	updateGauge.apply(0); 
       }
     } else {
       if (exact) {
-	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4);
+	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4, meta, meta_u);
 	UpdateGaugeField<Float,Gauge,Mom,N,false,true> updateGauge(arg, meta, location);
 	updateGauge.apply(0);
       } else {
-	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4);
+	UpdateGaugeArg<Float, Gauge, Mom> arg(out, in, mom, dt, 4, meta, meta_u);
 	UpdateGaugeField<Float,Gauge,Mom,N,false,false> updateGauge(arg, meta, location);
 	updateGauge.apply(0); 
       }
@@ -253,18 +351,19 @@ namespace quda {
   }
 
   template <typename Float, typename Gauge>
-    void updateGaugeField(Gauge out, const Gauge &in, const GaugeField &mom, 
+    void updateGaugeField(Gauge out, const Gauge &in, const GaugeField &mom, const GaugeField &meta_u,
 			  double dt, bool conj_mom, bool exact, 
 			  QudaFieldLocation location) {
     if (mom.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
       if (mom.Reconstruct() == QUDA_RECONSTRUCT_10) {
 	// FIX ME - 11 is a misnomer to avoid confusion in template instantiation
-	updateGaugeField<Float>(out, in, gauge::FloatNOrder<Float,18,2,11>(mom), dt, mom, conj_mom, exact, location);
+	updateGaugeField<Float>(out, in, gauge::FloatNOrder<Float,18,2,11>(mom), dt, mom, meta_u, conj_mom, exact, location);
       } else {
 	errorQuda("Reconstruction type not supported");
       }
     } else if (mom.Order() == QUDA_MILC_GAUGE_ORDER) {
-      updateGaugeField<Float>(out, in, gauge::MILCOrder<Float,10>(mom), dt, mom, conj_mom, exact, location);
+      // MILC momentum is stored compressed, so it must be unpacked to the full matrix
+      updateGaugeField<Float>(out, in, gauge::MILCMomOrder<Float>(mom), dt, mom, meta_u, conj_mom, exact, location);
     } else {
       errorQuda("Gauge Field order %d not supported", mom.Order());
     }
@@ -284,20 +383,27 @@ namespace quda {
       errorQuda("Input and output gauge field ordering and reconstruction must match");
     }
 
+    for (int d=0; d<4; d++) {
+      if (out.X()[d] != in.X()[d])
+	errorQuda("Input and output gauge field dimensions must match: %d != %d", in.X()[d], out.X()[d]);
+      if (out.X()[d] != mom.X()[d] && (out.GhostExchange() != QUDA_GHOST_EXCHANGE_EXTENDED || (out.X()[d] - mom.X()[d]) % 4))
+	errorQuda("Gauge field dimension %d = %d does not match the momentum or its extension", out.X()[d], mom.X()[d]);
+    }
+
     if (out.isNative()) {
       if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type G;
-	updateGaugeField<Float>(G(out),G(in), mom, dt, conj_mom, exact, location);
+	updateGaugeField<Float>(G(out),G(in), mom, out, dt, conj_mom, exact, location);
       } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
 	typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_12>::type G;
-	updateGaugeField<Float>(G(out), G(in), mom, dt, conj_mom, exact, location);
+	updateGaugeField<Float>(G(out), G(in), mom, out, dt, conj_mom, exact, location);
       } else {
 	errorQuda("Reconstruction type not supported");
       }
     } else if (out.Order() == QUDA_MILC_GAUGE_ORDER) {
       updateGaugeField<Float>(gauge::MILCOrder<Float, Nc*Nc*2>(out),
 			      gauge::MILCOrder<Float, Nc*Nc*2>(in), 
-			      mom, dt, conj_mom, exact, location);
+			      mom, out, dt, conj_mom, exact, location);
     } else {
       errorQuda("Gauge Field order %d not supported", out.Order());
     }
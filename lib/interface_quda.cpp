@@ -78,6 +78,7 @@ extern void exchange_cpu_sitelink_ex(int* X, int *R, void** sitelink, QudaGaugeF
 #include <contractQuda.h>
 
 #include <momentum.h>
+#include <field_hash.h>
 
 
 using namespace quda;
@@ -140,6 +141,396 @@ cudaCloverField *cloverPrecondition = NULL;
 cudaGaugeField *momResident = NULL;
 cudaGaugeField *extendedGaugeResident = NULL;
 
+/**
+   Content hash of the host field most recently loaded into a
+   resident field, used to skip repeated loads of an unchanged field.
+   A zero hash means the resident content is unknown (e.g., it was
+   modified on the device or loaded from a device pointer).
+ */
+struct ResidentHash {
+  uint64_t hash;      // hash of the host field content and load parameters
+  QudaLinkType type;  // link type of the gauge load
+  const void *field;  // resident precise field the hash describes
+  double GiB;         // device memory reported by the original load
+  double trlog[2];    // clover trace log returned by the original load
+};
+
+// gaugeHash[0] tracks gaugePrecise (Wilson or fat links), gaugeHash[1] gaugeLongPrecise
+static ResidentHash gaugeHash[2] = { };
+static ResidentHash cloverHash = { };
+
+/**
+   The sloppy, preconditioner and extended copies of a resident
+   precise gauge field are derived lazily: loadGaugeQuda only records
+   the reconstruct types requested for them, checkGauge materialises
+   the variants a solve needs on first use, and they are refreshed
+   only after the precise field has changed.
+ */
+struct DerivedGauge {
+  QudaReconstructType recon_sloppy;       // reconstruct of the sloppy copy
+  QudaReconstructType recon_precondition; // reconstruct of the preconditioner copy
+  int overlap;                            // domain overlap of the extended copy (if any)
+  bool dirty;                             // the precise field changed since the copies were made
+};
+
+// derivedGauge[0] tracks gaugePrecise (Wilson or fat links), derivedGauge[1] gaugeLongPrecise
+static DerivedGauge derivedGauge[2] = { { QUDA_RECONSTRUCT_INVALID, QUDA_RECONSTRUCT_INVALID, 0, false },
+					 { QUDA_RECONSTRUCT_INVALID, QUDA_RECONSTRUCT_INVALID, 0, false } };
+
+// whether the derived clover copies carry the inverse (not for dynamic clover)
+static bool cloverDerivedInverse = true;
+
+// whether the interior of extendedGaugeResident lags behind gaugePrecise
+static bool extendedGaugeStale = true;
+
+/**
+   Record that the resident gauge fields have been modified or
+   replaced other than by loadGaugeQuda: their content hashes are
+   forgotten and the derived copies are marked stale.
+ */
+static void residentGaugeChanged()
+{
+  gaugeHash[0] = ResidentHash();
+  gaugeHash[1] = ResidentHash();
+  derivedGauge[0].dirty = true;
+  derivedGauge[1].dirty = true;
+  extendedGaugeStale = true;
+}
+
+/**
+   Return the resident extended copy of gaugePrecise, creating it if
+   needed.  The interior is only copied from gaugePrecise when the
+   latter has changed since the last copy, after which the borders are
+   refreshed by the halo exchange; an up-to-date copy is returned
+   without any copy or communication.  Must be called in the INIT
+   phase of the profile.
+   @param recon Reconstruct type of the extended copy
+   @param profile The profile the halo exchange is timed in
+   @return The extended gauge field
+ */
+static cudaGaugeField* residentExtendedGauge(QudaReconstructType recon, TimeProfile &profile)
+{
+  if (!gaugePrecise) errorQuda("No resident gauge field to extend");
+
+  if (extendedGaugeResident) {
+    bool match = extendedGaugeResident->Precision() == gaugePrecise->Precision() &&
+      extendedGaugeResident->Reconstruct() == recon;
+    for (int dir=0; dir<4; ++dir) if (extendedGaugeResident->R()[dir] != R[dir]) match = false;
+    if (!match) {
+      delete extendedGaugeResident;
+      extendedGaugeResident = NULL;
+    }
+  }
+
+  if (!extendedGaugeResident) {
+    int y[4];
+    for (int dir=0; dir<4; ++dir) y[dir] = gaugePrecise->X()[dir] + 2*R[dir];
+    GaugeFieldParam gParamEx(y, gaugePrecise->Precision(), recon, 0,
+			     QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+    gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+    gParamEx.order = gaugePrecise->Order();
+    gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+    gParamEx.t_boundary = gaugePrecise->TBoundary();
+    gParamEx.nFace = 1;
+    gParamEx.tadpole = gaugePrecise->Tadpole();
+    for (int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
+    extendedGaugeResident = new cudaGaugeField(gParamEx);
+    extendedGaugeStale = true;
+  }
+
+  if (extendedGaugeStale) {
+    copyExtendedGauge(*extendedGaugeResident, *gaugePrecise, QUDA_CUDA_FIELD_LOCATION);
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_COMMS);
+    extendedGaugeResident->exchangeExtendedGhost(R, redundant_comms);
+    profile.TPSTOP(QUDA_PROFILE_COMMS);
+    profile.TPSTART(QUDA_PROFILE_INIT);
+    extendedGaugeStale = false;
+  }
+
+  return extendedGaugeResident;
+}
+
+/**
+   Hash a host gauge field together with every parameter that affects
+   the resident fields built from it.
+   @param h_gauge Host gauge field
+   @param param Gauge field parameters
+   @return The hash, or zero if the field cannot be hashed
+ */
+static uint64_t hostGaugeHash(void *h_gauge, const QudaGaugeParam &param)
+{
+  if (!h_gauge || param.location != QUDA_CPU_FIELD_LOCATION || param.use_resident_gauge) return 0;
+
+  const int *X = param.X;
+  const size_t link_bytes = 18 * param.cpu_prec;
+  const size_t volume = static_cast<size_t>(X[0]) * X[1] * X[2] * X[3];
+
+  uint64_t hash = 0;
+  switch (param.gauge_order) {
+  case QUDA_QDP_GAUGE_ORDER:
+    for (int d=0; d<4; d++) hash = hashCombine(hash, hostHash(static_cast<void**>(h_gauge)[d], volume * link_bytes));
+    break;
+  case QUDA_CPS_WILSON_GAUGE_ORDER:
+  case QUDA_MILC_GAUGE_ORDER:
+  case QUDA_TIFR_GAUGE_ORDER:
+    hash = hostHash(h_gauge, 4 * volume * link_bytes);
+    break;
+  case QUDA_TIFR_PADDED_GAUGE_ORDER:
+    hash = hostHash(h_gauge, 4 * static_cast<size_t>(X[0]) * X[1] * (X[2]+4) * X[3] * link_bytes);
+    break;
+  case QUDA_BQCD_GAUGE_ORDER:
+    hash = hostHash(h_gauge, 4 * static_cast<size_t>(X[0]+4) * (X[1]+2) * (X[2]+2) * (X[3]+2) * link_bytes);
+    break;
+  default:
+    return 0;
+  }
+
+  const double dmeta[] = { param.anisotropy, param.tadpole_coeff, param.scale, param.i_mu };
+  const int imeta[] = { X[0], X[1], X[2], X[3], param.type, param.gauge_order, param.t_boundary, param.cpu_prec,
+			param.cuda_prec, param.reconstruct, param.cuda_prec_sloppy, param.reconstruct_sloppy,
+			param.cuda_prec_precondition, param.reconstruct_precondition, param.gauge_fix, param.ga_pad,
+			param.staggered_phase_type, param.staggered_phase_applied, param.overlap };
+  hash = xxHash64(dmeta, sizeof(dmeta), hash);
+  hash = xxHash64(imeta, sizeof(imeta), hash);
+  return hash ? hash : 1;
+}
+
+/**
+   Whether a gauge load with the given hash would rebuild exactly the
+   fields that are already resident.  The decision is made
+   collectively since the rebuild communicates.
+ */
+static bool gaugeLoadIsRedundant(uint64_t hash, const QudaGaugeParam &param)
+{
+  const bool is_long = param.type == QUDA_ASQTAD_LONG_LINKS;
+  const ResidentHash &resident = gaugeHash[is_long ? 1 : 0];
+  const cudaGaugeField *precise = is_long ? gaugeLongPrecise : gaugePrecise;
+
+  // the derived copies are rebuilt on demand so only the precise field need match
+  bool match = hash != 0 && hash == resident.hash && param.type == resident.type &&
+    precise && precise == resident.field;
+
+  int mismatch = match ? 0 : 1;
+  comm_allreduce_int(&mismatch);
+  return mismatch == 0;
+}
+
+/**
+   Hash the host clover field (or, when the clover term is computed
+   on the device, the resident gauge field it is computed from)
+   together with every parameter that affects the resident fields.
+   @return The hash, or zero if the field cannot be hashed
+ */
+static uint64_t hostCloverHash(void *h_clover, void *h_clovinv, const QudaInvertParam &param, bool device_calc)
+{
+  uint64_t hash = 0;
+  if (device_calc) {
+    if (gaugeHash[0].type != QUDA_WILSON_LINKS || gaugeHash[0].field != gaugePrecise) return 0;
+    hash = gaugeHash[0].hash;
+  } else {
+    if (param.clover_location != QUDA_CPU_FIELD_LOCATION || param.clover_order != QUDA_PACKED_CLOVER_ORDER) return 0;
+    const size_t bytes = gaugePrecise->Volume() * 72 * param.clover_cpu_prec;
+    if (h_clover) hash = hashCombine(hash, hostHash(h_clover, bytes));
+    if (h_clovinv) hash = hashCombine(hash, hostHash(h_clovinv, bytes));
+  }
+  if (hash == 0) return 0;
+
+  const double dmeta[] = { param.clover_coeff, param.clover_rho, param.kappa, param.mu };
+  const int imeta[] = { device_calc, h_clover != nullptr, h_clovinv != nullptr, param.dslash_type, param.clover_order,
+			param.clover_cpu_prec, param.clover_cuda_prec, param.clover_cuda_prec_sloppy,
+			param.clover_cuda_prec_precondition, param.compute_clover, param.compute_clover_inverse,
+			param.solve_type, param.solution_type, param.matpc_type, param.cl_pad };
+  hash = xxHash64(dmeta, sizeof(dmeta), hash);
+  hash = xxHash64(imeta, sizeof(imeta), hash);
+  return hash ? hash : 1;
+}
+
+/**
+   Whether a clover load with the given hash would rebuild exactly the
+   fields that are already resident.  Loads that return the clover
+   field to the host are never skipped.
+ */
+static bool cloverLoadIsRedundant(uint64_t hash, const QudaInvertParam &param)
+{
+  bool match = hash != 0 && hash == cloverHash.hash && cloverPrecise && cloverPrecise == cloverHash.field &&
+    !param.return_clover && !param.return_clover_inverse;
+
+  int mismatch = match ? 0 : 1;
+  comm_allreduce_int(&mismatch);
+  return mismatch == 0;
+}
+
+/**
+   Free the sloppy, preconditioner and extended copies of a resident
+   gauge field, leaving the precise field in place.
+   @param slot 0 for the Wilson or fat links, 1 for the long links
+ */
+static void freeDerivedGauge(int slot)
+{
+  cudaGaugeField *&precise = slot ? gaugeLongPrecise : gaugePrecise;
+  cudaGaugeField *&sloppy = slot ? gaugeLongSloppy : gaugeSloppy;
+  cudaGaugeField *&precondition = slot ? gaugeLongPrecondition : gaugePrecondition;
+  cudaGaugeField *&extended = slot ? gaugeLongExtended : gaugeExtended;
+
+  if (sloppy != precondition && precondition) delete precondition;
+  if (precise != sloppy && sloppy) delete sloppy;
+  if (extended) delete extended;
+
+  precondition = NULL;
+  sloppy = NULL;
+  extended = NULL;
+  derivedGauge[slot].overlap = 0;
+}
+
+/**
+   Make the given field the resident precise gauge field.  If it
+   replaces the current field, that field is freed together with its
+   derived copies, which may alias it; an update in place only marks
+   the copies stale.
+   @param field The new resident precise gauge field
+ */
+static void setResidentGauge(cudaGaugeField *field)
+{
+  if (gaugePrecise != field) {
+    freeDerivedGauge(0);
+    if (gaugePrecise) delete gaugePrecise;
+    gaugePrecise = field;
+  }
+  residentGaugeChanged();
+}
+
+/**
+   Make sure the sloppy and preconditioner copies (and, if overlap is
+   non-zero, the extended preconditioner copy) of a resident gauge
+   field exist at the requested precisions and reflect the current
+   precise field.  Copies of the right type are refreshed in place so
+   that pointers held by existing Dirac operators remain valid.
+   @param slot 0 for the Wilson or fat links, 1 for the long links
+   @param prec_sloppy Precision of the sloppy copy
+   @param prec_precondition Precision of the preconditioner copy
+   @param overlap Domain overlap of the extended copy (0 for none)
+ */
+static void refreshDerivedGauge(int slot, QudaPrecision prec_sloppy, QudaPrecision prec_precondition, int overlap)
+{
+  cudaGaugeField *&precise = slot ? gaugeLongPrecise : gaugePrecise;
+  cudaGaugeField *&sloppy = slot ? gaugeLongSloppy : gaugeSloppy;
+  cudaGaugeField *&precondition = slot ? gaugeLongPrecondition : gaugePrecondition;
+  cudaGaugeField *&extended = slot ? gaugeLongExtended : gaugeExtended;
+  DerivedGauge &derived = derivedGauge[slot];
+  if (!precise) return;
+
+  if (prec_precondition == QUDA_INVALID_PRECISION) prec_precondition = prec_sloppy;
+  QudaReconstructType recon_sloppy = derived.recon_sloppy != QUDA_RECONSTRUCT_INVALID ?
+    derived.recon_sloppy : precise->Reconstruct();
+  QudaReconstructType recon_precondition = derived.recon_precondition != QUDA_RECONSTRUCT_INVALID ?
+    derived.recon_precondition : recon_sloppy;
+
+  bool same_type = sloppy && sloppy->Precision() == prec_sloppy && sloppy->Reconstruct() == recon_sloppy &&
+    precondition && precondition->Precision() == prec_precondition &&
+    precondition->Reconstruct() == recon_precondition;
+  bool same_extended = !overlap || (extended && derived.overlap == overlap);
+  if (same_type && same_extended && !derived.dirty) return;
+
+  GaugeFieldParam gauge_param(*precise);
+  gauge_param.create = QUDA_NULL_FIELD_CREATE;
+
+  if (same_type) {
+    // refresh the existing copies in place
+    if (derived.dirty && sloppy != precise) sloppy->copy(*precise);
+    if (derived.dirty && precondition != sloppy) precondition->copy(*sloppy);
+  } else {
+    freeDerivedGauge(slot);
+
+    gauge_param.reconstruct = recon_sloppy;
+    gauge_param.setPrecision(prec_sloppy);
+    if (prec_sloppy != precise->Precision() || recon_sloppy != precise->Reconstruct()) {
+      sloppy = new cudaGaugeField(gauge_param);
+      sloppy->copy(*precise);
+    } else {
+      sloppy = precise;
+    }
+
+    gauge_param.reconstruct = recon_precondition;
+    gauge_param.setPrecision(prec_precondition);
+    if (prec_precondition != sloppy->Precision() || recon_precondition != sloppy->Reconstruct()) {
+      precondition = new cudaGaugeField(gauge_param);
+      precondition->copy(*sloppy);
+    } else {
+      precondition = sloppy;
+    }
+  }
+
+  // the extended preconditioning field for domain-decomposed solvers
+  if (overlap) {
+    int R[4]; // domain-overlap widths in different directions
+    for (int i=0; i<4; ++i) R[i] = overlap*commDimPartitioned(i);
+
+    if (!same_extended || !same_type) {
+      if (extended) delete extended;
+      GaugeFieldParam ex_param(*precondition);
+      ex_param.create = QUDA_NULL_FIELD_CREATE;
+      for (int i=0; i<4; ++i) ex_param.x[i] += 2*R[i];
+      // the extended field does not require any ghost padding
+      ex_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+      extended = new cudaGaugeField(ex_param);
+      derived.overlap = overlap;
+    }
+
+    // copy the unextended preconditioning field into the interior of the extended field
+    copyExtendedGauge(*extended, *precondition, QUDA_CUDA_FIELD_LOCATION);
+    // now perform communication and fill the overlap regions
+    extended->exchangeExtendedGhost(R);
+  } else if (extended && derived.dirty) {
+    // a stale extended copy that is not needed now is simply dropped
+    delete extended;
+    extended = NULL;
+    derived.overlap = 0;
+  }
+
+  derived.dirty = false;
+}
+
+/**
+   Make sure the sloppy and preconditioner copies of the resident
+   clover field exist at the requested precisions.  The resident
+   clover field only changes through loadCloverQuda, which frees the
+   copies, so there is nothing to refresh.
+   @param prec_sloppy Precision of the sloppy copy
+   @param prec_precondition Precision of the preconditioner copy
+ */
+static void refreshDerivedClover(QudaPrecision prec_sloppy, QudaPrecision prec_precondition)
+{
+  if (!cloverPrecise) return;
+  if (prec_precondition == QUDA_INVALID_PRECISION) prec_precondition = prec_sloppy;
+  if (cloverSloppy && cloverSloppy->Precision() == prec_sloppy &&
+      cloverPrecondition && cloverPrecondition->Precision() == prec_precondition) return;
+
+  if (cloverPrecondition != cloverSloppy && cloverPrecondition) delete cloverPrecondition;
+  if (cloverSloppy != cloverPrecise && cloverSloppy) delete cloverSloppy;
+
+  CloverFieldParam clover_param(*cloverPrecise);
+  clover_param.create = QUDA_NULL_FIELD_CREATE;
+  clover_param.direct = true;
+  clover_param.inverse = cloverDerivedInverse;
+
+  clover_param.setPrecision(prec_sloppy);
+  if (prec_sloppy != cloverPrecise->Precision()) {
+    cloverSloppy = new cudaCloverField(clover_param);
+    cloverSloppy->copy(*cloverPrecise, clover_param.inverse);
+  } else {
+    cloverSloppy = cloverPrecise;
+  }
+
+  clover_param.setPrecision(prec_precondition);
+  if (prec_precondition != cloverSloppy->Precision()) {
+    cloverPrecondition = new cudaCloverField(clover_param);
+    cloverPrecondition->copy(*cloverSloppy, clover_param.inverse);
+  } else {
+    cloverPrecondition = cloverSloppy;
+  }
+}
+
 std::vector<cudaColorSpinorField*> solutionResident;
 
 // vector of spinors used for forecasting solutions in HMC
@@ -221,6 +612,9 @@ static TimeProfile profileSTOUT("STOUTQuda");
 //!< Profiler for OvrImpSTOUTQuda
 static TimeProfile profileOvrImpSTOUT("OvrImpSTOUTQuda");
 
+//!< Profiler for performGradientFlowQuda
+static TimeProfile profileFlow("performGradientFlowQuda");
+
 //!< Profiler for projectSU3Quda
 static TimeProfile profileProject("projectSU3Quda");
 
@@ -236,6 +630,12 @@ static TimeProfile profileCovDev("covDevQuda");
 //!< Profiler for contractions
 static TimeProfile profileMomAction("momActionQuda");
 
+//!< Profiler for integrateTrajectoryQuda
+static TimeProfile profileIntegrator("integrateTrajectoryQuda");
+
+//!< Profiler for computeCloverHostQuda
+static TimeProfile profileCloverHost("computeCloverHostQuda");
+
 //!< Profiler for endQuda
 static TimeProfile profileEnd("endQuda");
 
@@ -538,6 +938,22 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 
   checkGaugeParam(param);
 
+  // skip the upload and rebuild entirely if this host field is already resident
+  profileGauge.TPSTART(QUDA_PROFILE_PREAMBLE);
+  const uint64_t hash = param->type != QUDA_SMEARED_LINKS ? hostGaugeHash(h_gauge, *param) : 0;
+  const bool redundant = param->type != QUDA_SMEARED_LINKS && gaugeLoadIsRedundant(hash, *param);
+  profileGauge.TPSTOP(QUDA_PROFILE_PREAMBLE);
+
+  if (redundant) {
+    ResidentHash &resident = gaugeHash[param->type == QUDA_ASQTAD_LONG_LINKS ? 1 : 0];
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Gauge field unchanged (hash %016llx), skipping load\n", (unsigned long long)hash);
+    param->gaugeGiB += resident.GiB;
+    profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
+    return;
+  }
+  const double gaugeGiB = param->gaugeGiB;
+
   profileGauge.TPSTART(QUDA_PROFILE_INIT);
   // Set the specific input parameters and create the cpu gauge field
   GaugeFieldParam gauge_param(h_gauge, *param);
@@ -556,18 +972,12 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   // free any current gauge field before new allocations to reduce memory overhead
   switch (param->type) {
     case QUDA_WILSON_LINKS:
-      if (gaugeSloppy != gaugePrecondition && gaugePrecondition) delete gaugePrecondition;
-      if (gaugePrecise != gaugeSloppy && gaugeSloppy) delete gaugeSloppy;
-      if (gaugePrecise && !param->use_resident_gauge) delete gaugePrecise;
-      break;
     case QUDA_ASQTAD_FAT_LINKS:
-      if (gaugeFatSloppy != gaugeFatPrecondition && gaugeFatPrecondition) delete gaugeFatPrecondition;
-      if (gaugeFatPrecise != gaugeFatSloppy && gaugeFatSloppy) delete gaugeFatSloppy;
-      if (gaugeFatPrecise && !param->use_resident_gauge) delete gaugeFatPrecise;
+      freeDerivedGauge(0);
+      if (gaugePrecise && !param->use_resident_gauge) delete gaugePrecise;
       break;
     case QUDA_ASQTAD_LONG_LINKS:
-      if (gaugeLongSloppy != gaugeLongPrecondition && gaugeLongPrecondition) delete gaugeLongPrecondition;
-      if (gaugeLongPrecise != gaugeLongSloppy && gaugeLongSloppy) delete gaugeLongSloppy;
+      freeDerivedGauge(1);
       if (gaugeLongPrecise) delete gaugeLongPrecise;
       break;
     case QUDA_SMEARED_LINKS:
@@ -629,92 +1039,24 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     return;
   }
 
-  // creating sloppy fields isn't really compute, but it is work done on the gpu
-  profileGauge.TPSTART(QUDA_PROFILE_COMPUTE);
-
-  // switch the parameters for creating the mirror sloppy cuda gauge field
-  gauge_param.precision = param->cuda_prec_sloppy;
-  gauge_param.reconstruct = param->reconstruct_sloppy;
-  gauge_param.order = (gauge_param.precision == QUDA_DOUBLE_PRECISION ||
-      gauge_param.reconstruct == QUDA_RECONSTRUCT_NO ) ?
-    QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
-  cudaGaugeField *sloppy = NULL;
-  if (param->cuda_prec != param->cuda_prec_sloppy ||
-      param->reconstruct != param->reconstruct_sloppy) {
-    sloppy = new cudaGaugeField(gauge_param);
-    sloppy->copy(*precise);
-    param->gaugeGiB += sloppy->GBytes();
-  } else {
-    sloppy = precise;
-  }
-
-  // switch the parameters for creating the mirror preconditioner cuda gauge field
-  gauge_param.precision = param->cuda_prec_precondition;
-  gauge_param.reconstruct = param->reconstruct_precondition;
-  gauge_param.order = (gauge_param.precision == QUDA_DOUBLE_PRECISION ||
-      gauge_param.reconstruct == QUDA_RECONSTRUCT_NO ) ?
-    QUDA_FLOAT2_GAUGE_ORDER : QUDA_FLOAT4_GAUGE_ORDER;
-  cudaGaugeField *precondition = NULL;
-  if (param->cuda_prec_sloppy != param->cuda_prec_precondition ||
-      param->reconstruct_sloppy != param->reconstruct_precondition) {
-    precondition = new cudaGaugeField(gauge_param);
-    precondition->copy(*sloppy);
-    param->gaugeGiB += precondition->GBytes();
-  } else {
-    precondition = sloppy;
-  }
-
-  // create an extended preconditioning field
-  cudaGaugeField* extended = NULL;
-  if(param->overlap){
-    int R[4]; // domain-overlap widths in different directions
-    for(int i=0; i<4; ++i){
-      R[i] = param->overlap*commDimPartitioned(i);
-      gauge_param.x[i] += 2*R[i];
-    }
-    // the extended field does not require any ghost padding
-    gauge_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
-    extended = new cudaGaugeField(gauge_param);
-
-    // copy the unextended preconditioning field into the interior of the extended field
-    copyExtendedGauge(*extended, *precondition, QUDA_CUDA_FIELD_LOCATION);
-    // now perform communication and fill the overlap regions
-    extended->exchangeExtendedGhost(R);
-  }
-
-  profileGauge.TPSTOP(QUDA_PROFILE_COMPUTE);
-
-  switch (param->type) {
-    case QUDA_WILSON_LINKS:
-      gaugePrecise = precise;
-      gaugeSloppy = sloppy;
-      gaugePrecondition = precondition;
-
-      if(param->overlap) gaugeExtended = extended;
-      break;
-    case QUDA_ASQTAD_FAT_LINKS:
-      gaugeFatPrecise = precise;
-      gaugeFatSloppy = sloppy;
-      gaugeFatPrecondition = precondition;
+  // the sloppy, preconditioner and extended copies are only built
+  // when a solve first needs them (see refreshDerivedGauge)
+  const int slot = param->type == QUDA_ASQTAD_LONG_LINKS ? 1 : 0;
+  if (slot == 1) gaugeLongPrecise = precise;
+  else gaugePrecise = precise;
 
-      if(param->overlap){
-        if(gaugeFatExtended) errorQuda("Extended gauge fat field already allocated");
-	gaugeFatExtended = extended;
-      }
-      break;
-    case QUDA_ASQTAD_LONG_LINKS:
-      gaugeLongPrecise = precise;
-      gaugeLongSloppy = sloppy;
-      gaugeLongPrecondition = precondition;
+  DerivedGauge &derived = derivedGauge[slot];
+  derived.recon_sloppy = param->reconstruct_sloppy;
+  derived.recon_precondition = param->reconstruct_precondition;
+  derived.overlap = 0;
+  derived.dirty = false;
 
-      if(param->overlap){
-        if(gaugeLongExtended) errorQuda("Extended gauge long field already allocated");
-   	gaugeLongExtended = extended;
-      }
-      break;
-    default:
-      errorQuda("Invalid gauge type %d", param->type);
-  }
+  // record what is now resident so that an identical reload can be skipped
+  ResidentHash &resident = gaugeHash[slot];
+  resident.hash = hash;
+  resident.type = param->type;
+  resident.field = precise;
+  resident.GiB = param->gaugeGiB - gaugeGiB;
 
   profileGauge.TPSTART(QUDA_PROFILE_FREE);
   delete in;
@@ -800,6 +1142,30 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
     errorQuda("Wrong dslash_type %d in loadCloverQuda()", inv_param->dslash_type);
   }
 
+  // skip the upload and rebuild entirely if this clover field is already resident
+  profileClover.TPSTOP(QUDA_PROFILE_INIT);
+  profileClover.TPSTART(QUDA_PROFILE_PREAMBLE);
+  const uint64_t hash = hostCloverHash(h_clover, h_clovinv, *inv_param, device_calc);
+  const bool redundant = cloverLoadIsRedundant(hash, *inv_param);
+  profileClover.TPSTOP(QUDA_PROFILE_PREAMBLE);
+
+  if (redundant) {
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Clover field unchanged (hash %016llx), skipping load\n", (unsigned long long)hash);
+    inv_param->cloverGiB = cloverHash.GiB;
+    if (inv_param->compute_clover_trlog) {
+      inv_param->trlogA[0] = cloverHash.trlog[0];
+      inv_param->trlogA[1] = cloverHash.trlog[1];
+    }
+    popVerbosity();
+    profileClover.TPSTOP(QUDA_PROFILE_TOTAL);
+    return;
+  }
+
+  // replace any clover field left resident by a previous load
+  if (cloverPrecise) freeCloverQuda();
+  profileClover.TPSTART(QUDA_PROFILE_INIT);
+
   // determines whether operator is preconditioned when calling invertQuda()
   bool pc_solve = (inv_param->solve_type == QUDA_DIRECT_PC_SOLVE ||
       inv_param->solve_type == QUDA_NORMOP_PC_SOLVE ||
@@ -896,34 +1262,9 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 
   if (inv_param->clover_rho != 0.0) cloverRho(*cloverPrecise, inv_param->clover_rho);
 
-  // create the mirror sloppy clover field
-  if (inv_param->clover_cuda_prec != inv_param->clover_cuda_prec_sloppy) {
-    profileClover.TPSTART(QUDA_PROFILE_INIT);
-
-    clover_param.setPrecision(inv_param->clover_cuda_prec_sloppy);
-    cloverSloppy = new cudaCloverField(clover_param);
-    cloverSloppy->copy(*cloverPrecise, clover_param.inverse);
-
-    inv_param->cloverGiB += cloverSloppy->GBytes();
-    profileClover.TPSTOP(QUDA_PROFILE_INIT);
-  } else {
-    cloverSloppy = cloverPrecise;
-  }
-
-  // create the mirror preconditioner clover field
-  if (inv_param->clover_cuda_prec_sloppy != inv_param->clover_cuda_prec_precondition &&
-      inv_param->clover_cuda_prec_precondition != QUDA_INVALID_PRECISION) {
-    profileClover.TPSTART(QUDA_PROFILE_INIT);
-
-    clover_param.setPrecision(inv_param->clover_cuda_prec_precondition);
-    cloverPrecondition = new cudaCloverField(clover_param);
-    cloverPrecondition->copy(*cloverSloppy, clover_param.inverse);
-
-    inv_param->cloverGiB += cloverPrecondition->GBytes();
-    profileClover.TPSTOP(QUDA_PROFILE_INIT);
-  } else {
-    cloverPrecondition = cloverSloppy;
-  }
+  // the sloppy and preconditioner copies are only built when a solve
+  // first needs them (see refreshDerivedClover)
+  cloverDerivedInverse = clover_param.inverse;
 
   // if requested, copy back the clover / inverse field
   if ( inv_param->return_clover || inv_param->return_clover_inverse ) {
@@ -970,6 +1311,13 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
     checkCudaError();
   }
 
+  // record what is now resident so that an identical reload can be skipped
+  cloverHash.hash = hash;
+  cloverHash.field = cloverPrecise;
+  cloverHash.GiB = inv_param->cloverGiB;
+  cloverHash.trlog[0] = inv_param->trlogA[0];
+  cloverHash.trlog[1] = inv_param->trlogA[1];
+
   profileClover.TPSTART(QUDA_PROFILE_FREE);
   if (in) delete in; // delete object referencing input field
   profileClover.TPSTOP(QUDA_PROFILE_FREE);
@@ -1055,6 +1403,7 @@ void freeGaugeQuda(void)
   if (gaugeSmeared) delete gaugeSmeared;
 
   gaugeSmeared = NULL;
+  residentGaugeChanged();
   // Need to merge extendedGaugeResident and gaugeFatPrecise/gaugePrecise
   if (extendedGaugeResident) {
     delete extendedGaugeResident;
@@ -1088,105 +1437,9 @@ void freeSloppyGaugeQuda(void)
 
 void loadSloppyGaugeQuda(QudaPrecision prec_sloppy, QudaPrecision prec_precondition)
 {
-  // first do SU3 links (if they exist)
-  if (gaugePrecise) {
-    GaugeFieldParam gauge_param(*gaugePrecise);
-    gauge_param.setPrecision(prec_sloppy);
-    //gauge_param.reconstruct = param->reconstruct_sloppy; // FIXME
-
-    if (gaugeSloppy) errorQuda("gaugeSloppy already exists");
-
-    if (gauge_param.precision != gaugePrecise->Precision() ||
-	gauge_param.reconstruct != gaugePrecise->Reconstruct()) {
-      gaugeSloppy = new cudaGaugeField(gauge_param);
-      gaugeSloppy->copy(*gaugePrecise);
-    } else {
-      gaugeSloppy = gaugePrecise;
-    }
-
-    // switch the parameters for creating the mirror preconditioner cuda gauge field
-    gauge_param.setPrecision(prec_precondition);
-    //gauge_param.reconstruct = param->reconstruct_precondition; // FIXME
-
-    if (gaugePrecondition) errorQuda("gaugePrecondition already exists");
-
-    if (gauge_param.precision != gaugeSloppy->Precision() ||
-	gauge_param.reconstruct != gaugeSloppy->Reconstruct()) {
-      gaugePrecondition = new cudaGaugeField(gauge_param);
-      gaugePrecondition->copy(*gaugeSloppy);
-    } else {
-      gaugePrecondition = gaugeSloppy;
-    }
-  }
-
-  // fat links (if they exist)
-  if (gaugeFatPrecise) {
-    GaugeFieldParam gauge_param(*gaugeFatPrecise);
-
-    if (gaugeFatSloppy != gaugeSloppy) {
-      gauge_param.setPrecision(prec_sloppy);
-      //gauge_param.reconstruct = param->reconstruct_sloppy; // FIXME
-
-      if (gaugeFatSloppy) errorQuda("gaugeFatSloppy already exists");
-      if (gaugeFatSloppy != gaugeFatPrecise) delete gaugeFatSloppy;
-
-      if (gauge_param.precision != gaugeFatPrecise->Precision() ||
-	  gauge_param.reconstruct != gaugeFatPrecise->Reconstruct()) {
-	gaugeFatSloppy = new cudaGaugeField(gauge_param);
-	gaugeFatSloppy->copy(*gaugeFatPrecise);
-      } else {
-	gaugeFatSloppy = gaugeFatPrecise;
-      }
-    }
-
-    if (gaugeFatPrecondition != gaugePrecondition) {
-      // switch the parameters for creating the mirror preconditioner cuda gauge field
-      gauge_param.setPrecision(prec_precondition);
-      //gauge_param.reconstruct = param->reconstruct_precondition; // FIXME
-
-      if (gaugeFatPrecondition) errorQuda("gaugeFatPrecondition already exists\n");
-
-      if (gauge_param.precision != gaugeFatSloppy->Precision() ||
-	  gauge_param.reconstruct != gaugeFatSloppy->Reconstruct()) {
-	gaugeFatPrecondition = new cudaGaugeField(gauge_param);
-	gaugeFatPrecondition->copy(*gaugeFatSloppy);
-      } else {
-	gaugeFatPrecondition = gaugeFatSloppy;
-      }
-    }
-  }
-
-  // long links (if they exist)
-  if (gaugeLongPrecise) {
-    GaugeFieldParam gauge_param(*gaugeLongPrecise);
-    gauge_param.setPrecision(prec_sloppy);
-    //gauge_param.reconstruct = param->reconstruct_sloppy; // FIXME
-
-    if (gaugeLongSloppy) errorQuda("gaugeLongSloppy already exists");
-    if (gaugeLongSloppy != gaugeLongPrecise) delete gaugeLongSloppy;
-
-    if (gauge_param.precision != gaugeLongPrecise->Precision() ||
-	gauge_param.reconstruct != gaugeLongPrecise->Reconstruct()) {
-      gaugeLongSloppy = new cudaGaugeField(gauge_param);
-      gaugeLongSloppy->copy(*gaugeLongPrecise);
-    } else {
-      gaugeLongSloppy = gaugeLongPrecise;
-    }
-
-    // switch the parameters for creating the mirror preconditioner cuda gauge field
-    gauge_param.setPrecision(prec_precondition);
-    //gauge_param.reconstruct = param->reconstruct_precondition; // FIXME
-
-    if (gaugeLongPrecondition) warningQuda("gaugeLongPrecondition already exists\n");
-
-    if (gauge_param.precision != gaugeLongSloppy->Precision() ||
-	gauge_param.reconstruct != gaugeLongSloppy->Reconstruct()) {
-      gaugeLongPrecondition = new cudaGaugeField(gauge_param);
-      gaugeLongPrecondition->copy(*gaugeLongSloppy);
-    } else {
-      gaugeLongPrecondition = gaugeLongSloppy;
-    }
-  }
+  // SU3 or fat links, then long links (if they exist), keeping any extended copies
+  refreshDerivedGauge(0, prec_sloppy, prec_precondition, derivedGauge[0].overlap);
+  refreshDerivedGauge(1, prec_sloppy, prec_precondition, derivedGauge[1].overlap);
 }
 
 void freeCloverQuda(void)
@@ -1199,6 +1452,19 @@ void freeCloverQuda(void)
   cloverPrecondition = NULL;
   cloverSloppy = NULL;
   cloverPrecise = NULL;
+  cloverHash = ResidentHash();
+}
+
+unsigned long long gaugeHashQuda(QudaLinkType type)
+{
+  const ResidentHash &resident = gaugeHash[type == QUDA_ASQTAD_LONG_LINKS ? 1 : 0];
+  const cudaGaugeField *precise = type == QUDA_ASQTAD_LONG_LINKS ? gaugeLongPrecise : gaugePrecise;
+  return (resident.type == type && precise && resident.field == precise) ? resident.hash : 0;
+}
+
+unsigned long long cloverHashQuda(void)
+{
+  return (cloverPrecise && cloverHash.field == cloverPrecise) ? cloverHash.hash : 0;
 }
 
 void freeSloppyCloverQuda(void)
@@ -1297,9 +1563,11 @@ void endQuda(void)
     profilePlaq.Print();
     profileAPE.Print();
     profileSTOUT.Print();
+    profileFlow.Print();
     profileProject.Print();
     profilePhase.Print();
     profileMomAction.Print();
+    profileIntegrator.Print();
     profileEnd.Print();
 
     profileInit2End.Print();
@@ -1927,34 +2195,29 @@ void checkClover(QudaInvertParam *param) {
     return;
   }
 
+  if (cloverPrecise == NULL) errorQuda("Precise gauge field doesn't exist");
   if (param->cuda_prec != cloverPrecise->Precision()) {
     errorQuda("Solve precision %d doesn't match clover precision %d", param->cuda_prec, cloverPrecise->Precision());
   }
 
-  if (param->cuda_prec_sloppy != cloverSloppy->Precision() ||
-      param->cuda_prec_precondition != cloverPrecondition->Precision()) {
-    freeSloppyCloverQuda();
-    loadSloppyCloverQuda(param->cuda_prec_sloppy, param->cuda_prec_precondition);
-  }
+  // build the sloppy and preconditioner copies on first use
+  refreshDerivedClover(param->cuda_prec_sloppy, param->cuda_prec_precondition);
 
-  if (cloverPrecise == NULL) errorQuda("Precise gauge field doesn't exist");
   if (cloverSloppy == NULL) errorQuda("Sloppy gauge field doesn't exist");
   if (cloverPrecondition == NULL) errorQuda("Precondition gauge field doesn't exist");
 }
 
 quda::cudaGaugeField* checkGauge(QudaInvertParam *param) {
 
+  if (gaugePrecise == NULL) errorQuda("Precise gauge field doesn't exist");
   if (param->cuda_prec != gaugePrecise->Precision()) {
     errorQuda("Solve precision %d doesn't match gauge precision %d", param->cuda_prec, gaugePrecise->Precision());
   }
 
   quda::cudaGaugeField *cudaGauge = NULL;
   if (param->dslash_type != QUDA_ASQTAD_DSLASH) {
-    if (param->cuda_prec_sloppy != gaugeSloppy->Precision() ||
-	param->cuda_prec_precondition != gaugePrecondition->Precision()) {
-      freeSloppyGaugeQuda();
-      loadSloppyGaugeQuda(param->cuda_prec_sloppy, param->cuda_prec_precondition);
-    }
+    // build (or refresh) the sloppy, preconditioner and extended copies on first use
+    refreshDerivedGauge(0, param->cuda_prec_sloppy, param->cuda_prec_precondition, param->overlap);
 
     if (gaugePrecise == NULL) errorQuda("Precise gauge field doesn't exist");
     if (gaugeSloppy == NULL) errorQuda("Sloppy gauge field doesn't exist");
@@ -1964,13 +2227,8 @@ quda::cudaGaugeField* checkGauge(QudaInvertParam *param) {
     }
     cudaGauge = gaugePrecise;
   } else {
-    if (param->cuda_prec_sloppy != gaugeFatSloppy->Precision() ||
-	param->cuda_prec_precondition != gaugeFatPrecondition->Precision() ||
-	param->cuda_prec_sloppy != gaugeLongSloppy->Precision() ||
-	param->cuda_prec_precondition != gaugeLongPrecondition->Precision()) {
-      freeSloppyGaugeQuda();
-      loadSloppyGaugeQuda(param->cuda_prec_sloppy, param->cuda_prec_precondition);
-    }
+    refreshDerivedGauge(0, param->cuda_prec_sloppy, param->cuda_prec_precondition, param->overlap);
+    refreshDerivedGauge(1, param->cuda_prec_sloppy, param->cuda_prec_precondition, param->overlap);
 
     if (gaugeFatPrecise == NULL) errorQuda("Precise gauge fat field doesn't exist");
     if (gaugeFatSloppy == NULL) errorQuda("Sloppy gauge fat field doesn't exist");
@@ -2301,13 +2559,18 @@ void destroyMultigridQuda(void *mg) {
 }
 
 void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param) {
+  profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
+  profileInvert.TPSTART(QUDA_PROFILE_INIT);
+
   multigrid_solver *mg = static_cast<multigrid_solver*>(mg_);
 
   QudaInvertParam *param = mg_param->invert_param;
   checkGauge(param);
   checkMultigridParam(mg_param);
 
-  bool outer_pc_solve = (param->solve_type == QUDA_DIRECT_PC_SOLVE) ||
+  pushVerbosity(param->verbosity);
+
+  bool outer_pc_solve = (param->solve_type == QUDA_DIRECT_PC_SOLVE) ||
     (param->solve_type == QUDA_NORMOP_PC_SOLVE);
 
   // free the previous dirac oprators
@@ -2349,9 +2612,21 @@ void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param) {
   mg->mg->destroySmoother();
   mg->mg->createSmoother();
 
-  //mgParam = new MGParam(mg_param, B, *m, *mSmooth, *mSmoothSloppy);
-  //mg = new MG(*mgParam, profile);
+  // rebuild the coarse operators, first refining the null space if requested on any level
+  bool refresh = false;
+  for (int i=0; i<mg_param->n_level-1; i++) if (mg_param->setup_maxiter_refresh[i]) refresh = true;
+  mg->mg->updateCoarseOperator(refresh);
+
   mg->mgParam->updateInvertParam(*param);
+
+  popVerbosity();
+
+  profileInvert.TPSTOP(QUDA_PROFILE_INIT);
+  profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
+
+  saveProfile(__func__);
+  flushProfile();
+  saveTuneCache();
 }
 
 deflated_solver::deflated_solver(QudaEigParam &eig_param, TimeProfile &profile)
@@ -3694,8 +3969,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
 
   profileGaugeForce.TPSTART(QUDA_PROFILE_FREE);
   if (qudaGaugeParam->make_resident_gauge) {
-    if (gaugePrecise && gaugePrecise != cudaSiteLink) delete gaugePrecise;
-    gaugePrecise = cudaSiteLink;
+    setResidentGauge(cudaSiteLink);
   } else {
     delete cudaSiteLink;
   }
@@ -3713,6 +3987,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
   if (qudaGaugeParam->make_resident_gauge) {
     if (extendedGaugeResident) delete extendedGaugeResident;
     extendedGaugeResident = cudaGauge;
+    extendedGaugeStale = false;
   } else {
     delete cudaGauge;
   }
@@ -3734,44 +4009,16 @@ void createCloverQuda(QudaInvertParam* invertParam)
   profileClover.TPSTART(QUDA_PROFILE_INIT);
   if (!cloverPrecise) errorQuda("Clover field not allocated");
 
-  int y[4];
-  for(int dir=0; dir<4; ++dir) y[dir] = gaugePrecise->X()[dir] + 2*R[dir];
   int pad = 0;
+#ifdef MULTI_GPU
   // clover creation not supported from 8-reconstruct presently so convert to 12
   QudaReconstructType recon = (gaugePrecise->Reconstruct() == QUDA_RECONSTRUCT_8) ?
     QUDA_RECONSTRUCT_12 : gaugePrecise->Reconstruct();
-  GaugeFieldParam gParamEx(y, gaugePrecise->Precision(), recon, pad,
-			   QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
-  gParamEx.create = QUDA_ZERO_FIELD_CREATE;
-  gParamEx.order = gaugePrecise->Order();
-  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
-  gParamEx.t_boundary = gaugePrecise->TBoundary();
-  gParamEx.nFace = 1;
-  for (int d=0; d<4; d++) gParamEx.r[d] = R[d];
-
-  cudaGaugeField *cudaGaugeExtended = NULL;
-  if (extendedGaugeResident) {
-    cudaGaugeExtended = extendedGaugeResident;
-    profileClover.TPSTOP(QUDA_PROFILE_INIT);
-  } else {
-    cudaGaugeExtended = new cudaGaugeField(gParamEx);
-
-    // copy gaugePrecise into the extended device gauge field
-    copyExtendedGauge(*cudaGaugeExtended, *gaugePrecise, QUDA_CUDA_FIELD_LOCATION);
-
-    profileClover.TPSTOP(QUDA_PROFILE_INIT);
-    profileClover.TPSTART(QUDA_PROFILE_COMMS);
-    cudaGaugeExtended->exchangeExtendedGhost(R,redundant_comms);
-    profileClover.TPSTOP(QUDA_PROFILE_COMMS);
-  }
-
-#ifdef MULTI_GPU
-  GaugeField *gauge = cudaGaugeExtended;
+  GaugeField *gauge = residentExtendedGauge(recon, profileClover);
 #else
   GaugeField *gauge = gaugePrecise;
 #endif
 
-  profileClover.TPSTART(QUDA_PROFILE_INIT);
   // create the Fmunu field
   GaugeFieldParam tensorParam(gaugePrecise->X(), gauge->Precision(), QUDA_RECONSTRUCT_NO, pad, QUDA_TENSOR_GEOMETRY);
   tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
@@ -3787,9 +4034,6 @@ void createCloverQuda(QudaInvertParam* invertParam)
 
   profileClover.TPSTOP(QUDA_PROFILE_TOTAL);
 
-  // FIXME always preserve the extended gauge
-  extendedGaugeResident = cudaGaugeExtended;
-
   return;
 }
 
@@ -4575,7 +4819,8 @@ void computeCloverForceQuda(void *h_mom, double dt, void **h_x, void **h_p,
 		solutionResident.size(), nvector);
   }
 
-  cudaGaugeField &gaugeEx = *extendedGaugeResident;
+  cudaGaugeField &gaugeEx = *residentExtendedGauge(extendedGaugeResident ? extendedGaugeResident->Reconstruct() :
+						    gaugePrecise->Reconstruct(), profileCloverForce);
 
   // create oprod and trace fields
   fParam.geometry = QUDA_TENSOR_GEOMETRY;
@@ -4746,6 +4991,7 @@ void updateGaugeFieldQuda(void* gauge,
     cudaInGauge->loadCPUField(*cpuGauge);
   } else { // or use resident fields already present
     if (!gaugePrecise) errorQuda("No resident gauge field allocated");
+    freeDerivedGauge(0); // the copies may alias the input, which is freed below
     cudaInGauge = gaugePrecise;
     gaugePrecise = NULL;
   }
@@ -4775,8 +5021,7 @@ void updateGaugeFieldQuda(void* gauge,
 
   profileGaugeUpdate.TPSTART(QUDA_PROFILE_FREE);
   if (param->make_resident_gauge) {
-    if (gaugePrecise != NULL) delete gaugePrecise;
-    gaugePrecise = cudaOutGauge;
+    setResidentGauge(cudaOutGauge);
   } else {
     delete cudaOutGauge;
   }
@@ -4842,8 +5087,7 @@ void updateGaugeFieldQuda(void* gauge,
    profileProject.TPSTOP(QUDA_PROFILE_D2H);
 
    if (param->make_resident_gauge) {
-     if (gaugePrecise != NULL && cudaGauge != gaugePrecise) delete gaugePrecise;
-     gaugePrecise = cudaGauge;
+     setResidentGauge(cudaGauge);
    } else {
      delete cudaGauge;
    }
@@ -4896,8 +5140,7 @@ void updateGaugeFieldQuda(void* gauge,
    profilePhase.TPSTOP(QUDA_PROFILE_D2H);
 
    if (param->make_resident_gauge) {
-     if (gaugePrecise != NULL && cudaGauge != gaugePrecise) delete gaugePrecise;
-     gaugePrecise = cudaGauge;
+     setResidentGauge(cudaGauge);
    } else {
      delete cudaGauge;
    }
@@ -4967,6 +5210,319 @@ double momActionQuda(void* momentum, QudaGaugeParam* param)
   return action;
 }
 
+/**
+   State of a molecular-dynamics trajectory evolved on resident fields
+*/
+struct MDState {
+  QudaIntegratorParam *param;
+  cudaGaugeField *gauge;      // the resident gauge field (gaugePrecise), copied back from gaugeEx on demand
+  cudaGaugeField *gaugeEx;    // extended field evolved in place and read by the gauge force
+  cudaGaugeField *mom;        // the momentum being evolved
+  cudaGaugeField *fg_mom;     // force of the force-gradient shift
+  cudaGaugeField *gauge_save; // extended field saved across the force-gradient shift
+  bool border_stale;          // whether the border of gaugeEx lags behind its interior
+  bool gauge_stale;           // whether gauge lags behind the interior of gaugeEx
+  bool callbacks;             // whether there are callback terms that see the resident fields
+};
+
+// Refresh the border of the evolved extended field; only the surface
+// is exchanged since the interior is updated in place
+static void mdRefreshExtended(MDState &s)
+{
+  if (!s.border_stale) return;
+  s.gaugeEx->exchangeExtendedGhost(R, redundant_comms);
+  s.border_stale = false;
+}
+
+// Bring the resident fields up to date with the evolved extended
+// field: callback terms and the caller see gaugePrecise and the
+// resident extended field
+static void mdSyncResident(MDState &s)
+{
+  mdRefreshExtended(s);
+  if (s.gauge_stale) {
+    copyExtendedGauge(*s.gauge, *s.gaugeEx, QUDA_CUDA_FIELD_LOCATION);
+    s.gauge_stale = false;
+  }
+  if (s.gaugeEx == extendedGaugeResident) extendedGaugeStale = false;
+}
+
+// The interior of the extended field has changed.  The sloppy copies
+// are rebuilt by the next solve that needs them, gauge-action terms
+// refresh the border lazily, and the resident field is only copied
+// back before a callback term or at the end of the trajectory.
+static void mdGaugeChanged(MDState &s)
+{
+  s.border_stale = true;
+  s.gauge_stale = true;
+  residentGaugeChanged();
+}
+
+// mom += dt * F for all force terms of the given level
+static void mdForce(MDState &s, int level, double dt, cudaGaugeField &mom)
+{
+  QudaIntegratorParam &p = *s.param;
+  for (int j=0; j<p.n_term[level]; j++) {
+    QudaForceTerm &t = p.term[level][j];
+    if (t.type == QUDA_GAUGE_FORCE_TERM) {
+      mdRefreshExtended(s);
+      gaugeForce(mom, *s.gaugeEx, dt*t.coeff, t.input_path_buf, t.path_length, t.loop_coeff,
+		 t.num_paths, t.max_length);
+      p.n_force[0]++;
+    } else {
+      mdSyncResident(s);
+      cudaGaugeField *mom_resident = momResident;
+      momResident = &mom;
+      t.callback(dt, t.context);
+      if (momResident != &mom || gaugePrecise != s.gauge)
+	errorQuda("Force callback replaced a resident field; it must use and keep the resident gauge and momentum");
+      momResident = mom_resident;
+      p.n_force[1]++;
+    }
+  }
+}
+
+// action of all gauge-force terms on the current gauge field
+static double mdGaugeAction(MDState &s)
+{
+  const QudaIntegratorParam &p = *s.param;
+  double action = 0.0;
+  mdRefreshExtended(s);
+  for (int i=0; i<p.n_level; i++) {
+    for (int j=0; j<p.n_term[i]; j++) {
+      const QudaForceTerm &t = p.term[i][j];
+      if (t.type != QUDA_GAUGE_FORCE_TERM) continue;
+      action += gaugeLoopAction(*s.gaugeEx, t.coeff, t.input_path_buf, t.path_length, t.loop_coeff,
+				t.num_paths, t.max_length);
+    }
+  }
+  return action;
+}
+
+static void mdUpdateGauge(MDState &s, double dt)
+{
+  updateGaugeField(*s.gaugeEx, dt, *s.gaugeEx, *s.mom, false, true);
+  mdGaugeChanged(s);
+}
+
+// Force-gradient momentum update mom += weight * dt * F(U') with the
+// shifted field U' = exp(dt^2/24 F(U)) U, which approximates the
+// force-gradient term of the weight 2/3 update without second
+// derivatives (Yin and Mawhinney).
+static void mdForceGradient(MDState &s, int level, double weight, double dt)
+{
+  s.fg_mom->zero();
+  mdForce(s, level, 1.0, *s.fg_mom);
+  s.gauge_save->copy(*s.gaugeEx);
+  const bool border_stale = s.border_stale;
+  updateGaugeField(*s.gaugeEx, dt*dt/24.0, *s.gaugeEx, *s.fg_mom, false, true);
+  mdGaugeChanged(s);
+
+  mdForce(s, level, weight*dt, *s.mom);
+
+  // the saved copy includes its border
+  s.gaugeEx->copy(*s.gauge_save);
+  mdGaugeChanged(s);
+  s.border_stale = border_stale;
+}
+
+// Integrate level over the interval tau.  The gauge-field updates of
+// a level are integrations of the next level, and the innermost level
+// updates the gauge field.  The outer momentum updates of consecutive
+// steps are merged into one.
+static void mdIntegrate(MDState &s, int level, double tau)
+{
+  const QudaIntegratorParam &p = *s.param;
+  const QudaIntegratorType type = p.integrator[level];
+  const int n = p.n_step[level];
+  const double dt = tau / n;
+  const double lambda = p.lambda;
+
+  auto drift = [&](double h) {
+    if (level+1 < p.n_level) mdIntegrate(s, level+1, h);
+    else mdUpdateGauge(s, h);
+  };
+  auto kick = [&](double h) { mdForce(s, level, h, *s.mom); };
+
+  double outer = 0.0; // weight of the first and last momentum update of a step
+  switch (type) {
+  case QUDA_LEAPFROG_INTEGRATOR: outer = 0.5; break;
+  case QUDA_OMELYAN_INTEGRATOR: outer = lambda; break;
+  case QUDA_FORCE_GRADIENT_INTEGRATOR: outer = 1.0/6.0; break;
+  default: errorQuda("Integrator type %d not supported", type);
+  }
+
+  kick(outer*dt);
+  for (int i=0; i<n; i++) {
+    switch (type) {
+    case QUDA_LEAPFROG_INTEGRATOR:
+      drift(dt);
+      break;
+    case QUDA_OMELYAN_INTEGRATOR:
+      drift(0.5*dt);
+      kick((1.0-2.0*lambda)*dt);
+      drift(0.5*dt);
+      break;
+    case QUDA_FORCE_GRADIENT_INTEGRATOR:
+      drift(0.5*dt);
+      mdForceGradient(s, level, 2.0/3.0, dt);
+      drift(0.5*dt);
+      break;
+    default: errorQuda("Integrator type %d not supported", type);
+    }
+    kick((i < n-1 ? 2.0 : 1.0)*outer*dt);
+  }
+}
+
+double integrateTrajectoryQuda(void *h_gauge, void *h_mom, QudaIntegratorParam *md_param, QudaGaugeParam *param)
+{
+  double action = 0.0;
+#ifdef GPU_GAUGE_FORCE
+  profileIntegrator.TPSTART(QUDA_PROFILE_TOTAL);
+  profileIntegrator.TPSTART(QUDA_PROFILE_INIT);
+  checkGaugeParam(param);
+  checkIntegratorParam(md_param);
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaIntegratorParam(md_param);
+  profileIntegrator.TPSTOP(QUDA_PROFILE_INIT);
+
+  // the evolved field is the resident Wilson-type gauge field (gaugePrecise)
+  QudaGaugeParam link_param = *param;
+  link_param.type = QUDA_WILSON_LINKS;
+  if (!param->use_resident_gauge) loadGaugeQuda(h_gauge, &link_param);
+  if (!gaugePrecise) errorQuda("No resident gauge field to use");
+  if (gaugePrecise->Reconstruct() == QUDA_RECONSTRUCT_8)
+    errorQuda("Reconstruction type %d not supported", gaugePrecise->Reconstruct());
+  residentGaugeChanged(); // the trajectory evolves the resident field in place
+
+  profileIntegrator.TPSTART(QUDA_PROFILE_INIT);
+  MDState s;
+  s.param = md_param;
+  s.gauge = gaugePrecise;
+  s.callbacks = false;
+  bool force_gradient = false;
+  for (int i=0; i<md_param->n_level; i++) {
+    if (md_param->integrator[i] == QUDA_FORCE_GRADIENT_INTEGRATOR) force_gradient = true;
+    for (int j=0; j<md_param->n_term[i]; j++)
+      if (md_param->term[i][j].type == QUDA_CALLBACK_FORCE_TERM) s.callbacks = true;
+  }
+
+  // momentum field
+  GaugeFieldParam gParamMom(h_mom, *param, QUDA_ASQTAD_MOM_LINKS);
+  if (gParamMom.order == QUDA_QDP_GAUGE_ORDER) gParamMom.order = QUDA_MILC_GAUGE_ORDER;
+  if (gParamMom.order == QUDA_TIFR_GAUGE_ORDER || gParamMom.order == QUDA_TIFR_PADDED_GAUGE_ORDER) gParamMom.reconstruct = QUDA_RECONSTRUCT_NO;
+  else gParamMom.reconstruct = QUDA_RECONSTRUCT_10;
+  bool need_cpu = !param->use_resident_mom || param->return_result_mom;
+  cpuGaugeField *cpuMom = need_cpu ? new cpuGaugeField(gParamMom) : NULL;
+
+  if (param->use_resident_mom) {
+    if (!momResident) errorQuda("No resident momentum field to use");
+    s.mom = momResident;
+  } else {
+    gParamMom.create = QUDA_NULL_FIELD_CREATE;
+    gParamMom.order = QUDA_FLOAT2_GAUGE_ORDER;
+    gParamMom.reconstruct = QUDA_RECONSTRUCT_10;
+    gParamMom.precision = gaugePrecise->Precision();
+    s.mom = new cudaGaugeField(gParamMom);
+  }
+  if (s.mom->Precision() != gaugePrecise->Precision())
+    errorQuda("Momentum precision %d does not match gauge precision %d", s.mom->Precision(), gaugePrecise->Precision());
+
+  // extended gauge field, which is left resident afterwards
+  if (extendedGaugeResident && (extendedGaugeResident->Precision() != gaugePrecise->Precision() ||
+				extendedGaugeResident->Reconstruct() != gaugePrecise->Reconstruct())) {
+    delete extendedGaugeResident;
+    extendedGaugeResident = NULL;
+  }
+  if (!extendedGaugeResident) {
+    int y[4];
+    for (int dir=0; dir<4; ++dir) y[dir] = gaugePrecise->X()[dir] + 2*R[dir];
+    GaugeFieldParam gParamEx(y, gaugePrecise->Precision(), gaugePrecise->Reconstruct(),
+			     0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+    gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+    gParamEx.order = gaugePrecise->Order();
+    gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+    gParamEx.t_boundary = gaugePrecise->TBoundary();
+    gParamEx.nFace = 1;
+    gParamEx.tadpole = gaugePrecise->Tadpole();
+    for (int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
+    extendedGaugeResident = new cudaGaugeField(gParamEx);
+  }
+  s.gaugeEx = extendedGaugeResident;
+
+  s.fg_mom = NULL;
+  s.gauge_save = NULL;
+  if (force_gradient) {
+    GaugeFieldParam gParamFG(*s.mom);
+    gParamFG.create = QUDA_ZERO_FIELD_CREATE;
+    s.fg_mom = new cudaGaugeField(gParamFG);
+    GaugeFieldParam gParamSave(*s.gaugeEx);
+    gParamSave.create = QUDA_NULL_FIELD_CREATE;
+    s.gauge_save = new cudaGaugeField(gParamSave);
+  }
+  profileIntegrator.TPSTOP(QUDA_PROFILE_INIT);
+
+  if (!param->use_resident_mom) {
+    profileIntegrator.TPSTART(QUDA_PROFILE_H2D);
+    s.mom->loadCPUField(*cpuMom);
+    profileIntegrator.TPSTOP(QUDA_PROFILE_H2D);
+  }
+
+  // integrate the trajectory
+  profileIntegrator.TPSTART(QUDA_PROFILE_COMPUTE);
+  // the trajectory evolves the interior of the extended field, so the
+  // full volume is only copied here and back at the end
+  copyExtendedGauge(*s.gaugeEx, *s.gauge, QUDA_CUDA_FIELD_LOCATION);
+  s.border_stale = true;
+  s.gauge_stale = false;
+  md_param->n_force[0] = 0;
+  md_param->n_force[1] = 0;
+  md_param->mom_action[0] = computeMomAction(*s.mom);
+  // the gauge action is only known when there are no callback terms
+  md_param->gauge_action[0] = s.callbacks ? 0.0 : mdGaugeAction(s);
+  mdIntegrate(s, 0, md_param->tau);
+  md_param->mom_action[1] = computeMomAction(*s.mom);
+  md_param->gauge_action[1] = s.callbacks ? 0.0 : mdGaugeAction(s);
+
+  // leave the resident and extended fields current; the sloppy copies follow on demand
+  mdSyncResident(s);
+  profileIntegrator.TPSTOP(QUDA_PROFILE_COMPUTE);
+  md_param->secs = profileIntegrator.Last(QUDA_PROFILE_COMPUTE);
+  action = md_param->mom_action[1] - md_param->mom_action[0] + md_param->gauge_action[1] - md_param->gauge_action[0];
+
+  if (getVerbosity() >= QUDA_VERBOSE)
+    printfQuda("Trajectory of length %g: %d gauge and %d callback force evaluations in %g secs, %s = %e\n",
+	       md_param->tau, md_param->n_force[0], md_param->n_force[1], md_param->secs,
+	       s.callbacks ? "dS_mom" : "dH", action);
+
+  if (param->return_result_gauge) saveGaugeQuda(h_gauge, &link_param);
+
+  if (param->return_result_mom) {
+    profileIntegrator.TPSTART(QUDA_PROFILE_D2H);
+    s.mom->saveCPUField(*cpuMom);
+    profileIntegrator.TPSTOP(QUDA_PROFILE_D2H);
+  }
+
+  profileIntegrator.TPSTART(QUDA_PROFILE_FREE);
+  if (param->make_resident_mom) {
+    if (momResident && momResident != s.mom) delete momResident;
+    momResident = s.mom;
+  } else {
+    if (momResident == s.mom) momResident = NULL;
+    delete s.mom;
+  }
+  if (s.fg_mom) delete s.fg_mom;
+  if (s.gauge_save) delete s.gauge_save;
+  if (cpuMom) delete cpuMom;
+  profileIntegrator.TPSTOP(QUDA_PROFILE_FREE);
+
+  checkCudaError();
+  profileIntegrator.TPSTOP(QUDA_PROFILE_TOTAL);
+#else
+  errorQuda("Gauge force has not been built");
+#endif // GPU_GAUGE_FORCE
+  return action;
+}
+
 /*
   The following functions are for the Fortran interface.
 */
@@ -5147,6 +5703,7 @@ void apply_staggered_phase_quda_() {
   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("applying staggered phase\n");
   if (gaugePrecise) {
     gaugePrecise->applyStaggeredPhase();
+    residentGaugeChanged();
   } else {
     errorQuda("No persistent gauge field");
   }
@@ -5157,6 +5714,7 @@ void remove_staggered_phase_quda_() {
   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("removing staggered phase\n");
   if (gaugePrecise) {
     gaugePrecise->removeStaggeredPhase();
+    residentGaugeChanged();
   } else {
     errorQuda("No persistent gauge field");
   }
@@ -5221,17 +5779,12 @@ void gaussGaugeQuda(long seed)
   RNG* randstates = new RNG(data->Volume(), seed, data->X());
   randstates->Init();
   quda::gaugeGauss(*data, *randstates);
+  residentGaugeChanged();
   randstates->Release();
   delete randstates;
   profileGauss.TPSTOP(QUDA_PROFILE_COMPUTE);
 
   profileGauss.TPSTOP(QUDA_PROFILE_TOTAL);
-  
-  if (extendedGaugeResident) {
-
-    extendedGaugeResident = gaugePrecise;
-    extendedGaugeResident -> exchangeExtendedGhost(R,redundant_comms);
-  }
 #else
   errorQuda("Gauge tools are not build");
 #endif
@@ -5258,34 +5811,8 @@ void plaqQuda (double plq[3])
 #ifndef MULTI_GPU
   data = gaugePrecise;
 #else
-  if (extendedGaugeResident) {
-    data = extendedGaugeResident;
-  } else {
-    int y[4];
-    for(int dir=0; dir<4; ++dir) y[dir] = gaugePrecise->X()[dir] + 2*R[dir];
-    int pad = 0;
-    GaugeFieldParam gParamEx(y, gaugePrecise->Precision(), gaugePrecise->Reconstruct(),
-			     pad, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
-    gParamEx.create = QUDA_ZERO_FIELD_CREATE;
-    gParamEx.order = gaugePrecise->Order();
-    gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
-    gParamEx.t_boundary = gaugePrecise->TBoundary();
-    gParamEx.nFace = 1;
-    gParamEx.tadpole = gaugePrecise->Tadpole();
-    for(int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
-
-    data = new cudaGaugeField(gParamEx);
-
-    copyExtendedGauge(*data, *gaugePrecise, QUDA_CUDA_FIELD_LOCATION);
-    profilePlaq.TPSTOP(QUDA_PROFILE_INIT);
-
-    profilePlaq.TPSTART(QUDA_PROFILE_COMMS);
-    data->exchangeExtendedGhost(R,redundant_comms);
-    profilePlaq.TPSTOP(QUDA_PROFILE_COMMS);
-
-    profilePlaq.TPSTART(QUDA_PROFILE_INIT);
-    extendedGaugeResident = data;
-  }
+  data = residentExtendedGauge(extendedGaugeResident ? extendedGaugeResident->Reconstruct() :
+			       gaugePrecise->Reconstruct(), profilePlaq);
 #endif
 
   profilePlaq.TPSTOP(QUDA_PROFILE_INIT);
@@ -5341,16 +5868,11 @@ void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *inv_param,
 
   cudaParam.create = QUDA_NULL_FIELD_CREATE;
   cudaColorSpinorField out(in, cudaParam);
+  cudaColorSpinorField tmp(in, cudaParam);
   int parity = 0;
 
-  for (unsigned int i=0; i<nSteps; i++) {
-    if(i) in = out;
-    wuppertalStep(out, in, parity, *precise, alpha);
-    if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
-      double norm = blas::norm2(out);
-      printfQuda("Step %d, vector norm %e\n", i, norm);
-    }
-  }
+  // ping-pong between out and tmp
+  wuppertalSmear(out, in, tmp, parity, *precise, alpha, nSteps);
 
   cpuParam.v = h_out;
   cpuParam.location = inv_param->output_location;
@@ -5374,6 +5896,123 @@ void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *inv_param,
   profileWuppertal.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+void performWuppertalnStepHost(void **h_out, void **h_in, int n_vec, void *h_gauge,
+                               QudaGaugeParam *gauge_param, QudaInvertParam *inv_param,
+                               unsigned int nSteps, double alpha)
+{
+  profileWuppertal.TPSTART(QUDA_PROFILE_TOTAL);
+
+  pushVerbosity(inv_param->verbosity);
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printQudaInvertParam(inv_param);
+
+  if (gauge_param->gauge_order != QUDA_QDP_GAUGE_ORDER && gauge_param->gauge_order != QUDA_MILC_GAUGE_ORDER)
+    errorQuda("Gauge field order %d not supported on the host", gauge_param->gauge_order);
+
+  profileWuppertal.TPSTART(QUDA_PROFILE_INIT);
+  GaugeFieldParam gParam(h_gauge, *gauge_param);
+  cpuGaugeField cpuGauge(gParam);
+  cpuGauge.exchangeGhost();
+
+  ColorSpinorParam cpuParam(h_in[0], *inv_param, cpuGauge.X(), 0, QUDA_CPU_FIELD_LOCATION);
+  std::vector<ColorSpinorField*> in, out, tmp;
+  for (int v=0; v<n_vec; v++) {
+    cpuParam.create = QUDA_REFERENCE_FIELD_CREATE;
+    cpuParam.v = h_in[v];
+    in.push_back(ColorSpinorField::Create(cpuParam));
+    cpuParam.v = h_out[v];
+    out.push_back(ColorSpinorField::Create(cpuParam));
+    cpuParam.create = QUDA_NULL_FIELD_CREATE;
+    if (nSteps > 1) tmp.push_back(ColorSpinorField::Create(cpuParam));
+  }
+  profileWuppertal.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileWuppertal.TPSTART(QUDA_PROFILE_COMPUTE);
+  int parity = 0;
+  wuppertalSmear(out, in, tmp, parity, cpuGauge, alpha, nSteps);
+  profileWuppertal.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+    for (int v=0; v<n_vec; v++) printfQuda("Vector %d in %e out %e\n", v, blas::norm2(*in[v]), blas::norm2(*out[v]));
+  }
+
+  profileWuppertal.TPSTART(QUDA_PROFILE_FREE);
+  for (int v=0; v<n_vec; v++) {
+    delete in[v];
+    delete out[v];
+  }
+  for (unsigned int v=0; v<tmp.size(); v++) delete tmp[v];
+  profileWuppertal.TPSTOP(QUDA_PROFILE_FREE);
+
+  popVerbosity();
+
+  profileWuppertal.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
+static void createPropagator(std::vector<ColorSpinorField*> &prop, void **h_prop, QudaInvertParam *param)
+{
+  ColorSpinorParam cpuParam(h_prop[0], *param, gaugePrecise->X(), false, QUDA_CPU_FIELD_LOCATION);
+  for (int j=0; j<12; j++) {
+    cpuParam.v = h_prop[j];
+    prop.push_back(ColorSpinorField::Create(cpuParam));
+  }
+}
+
+void contractMesonsQuda(double *corr, void **h_prop1, void **h_prop2, int n_snk, const int *gamma_snk,
+                        int n_src, const int *gamma_src, int n_mom, const int *mom, QudaInvertParam *param)
+{
+  profileContract.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (gaugePrecise == NULL) errorQuda("Gauge field must be loaded");
+
+  pushVerbosity(param->verbosity);
+
+  profileContract.TPSTART(QUDA_PROFILE_INIT);
+  std::vector<ColorSpinorField*> prop1, prop2;
+  createPropagator(prop1, h_prop1, param);
+  createPropagator(prop2, h_prop2, param);
+  std::vector<int> snk(gamma_snk, gamma_snk + n_snk), src(gamma_src, gamma_src + n_src), p(mom, mom + 3*n_mom);
+  profileContract.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileContract.TPSTART(QUDA_PROFILE_COMPUTE);
+  std::vector<Complex> result;
+  contractMesons(result, prop1, prop2, snk, src, p);
+  profileContract.TPSTOP(QUDA_PROFILE_COMPUTE);
+  for (unsigned int i=0; i<result.size(); i++) { corr[2*i] = result[i].real(); corr[2*i+1] = result[i].imag(); }
+
+  for (int j=0; j<12; j++) { delete prop1[j]; delete prop2[j]; }
+
+  popVerbosity();
+  profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
+void contractBaryonsQuda(double *corr, void **h_prop_u, void **h_prop_d, int n_mom, const int *mom,
+                         QudaInvertParam *param)
+{
+  profileContract.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (gaugePrecise == NULL) errorQuda("Gauge field must be loaded");
+
+  pushVerbosity(param->verbosity);
+
+  profileContract.TPSTART(QUDA_PROFILE_INIT);
+  std::vector<ColorSpinorField*> prop_u, prop_d;
+  createPropagator(prop_u, h_prop_u, param);
+  createPropagator(prop_d, h_prop_d, param);
+  std::vector<int> p(mom, mom + 3*n_mom);
+  profileContract.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileContract.TPSTART(QUDA_PROFILE_COMPUTE);
+  std::vector<Complex> result;
+  contractBaryons(result, prop_u, prop_d, p);
+  profileContract.TPSTOP(QUDA_PROFILE_COMPUTE);
+  for (unsigned int i=0; i<result.size(); i++) { corr[2*i] = result[i].real(); corr[2*i+1] = result[i].imag(); }
+
+  for (int j=0; j<12; j++) { delete prop_u[j]; delete prop_d[j]; }
+
+  popVerbosity();
+  profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 void performAPEnStep(unsigned int nSteps, double alpha)
 {
   profileAPE.TPSTART(QUDA_PROFILE_TOTAL);
@@ -5509,6 +6148,78 @@ void performSTOUTnStep(unsigned int nSteps, double rho)
   profileOvrImpSTOUT.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+int performGradientFlowQuda(QudaGaugeFlowType type, double epsilon, double tol, int n_meas,
+			    const double *t_meas, double *E, double *t2E, double *Q)
+{
+  profileFlow.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (gaugePrecise == NULL) errorQuda("Gauge field must be loaded");
+
+  GaugeFieldParam gParam(*gaugePrecise);
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.setPrecision(gParam.precision);
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  for(int dir=0; dir<4; ++dir) {
+    gParam.x[dir] = gaugePrecise->X()[dir] + 2 * R[dir];
+    gParam.r[dir] = R[dir];
+  }
+
+  if (gaugeSmeared != NULL) delete gaugeSmeared;
+
+  gaugeSmeared = new cudaGaugeField(gParam);
+
+  copyExtendedGauge(*gaugeSmeared, *gaugePrecise, QUDA_CUDA_FIELD_LOCATION);
+  gaugeSmeared->exchangeExtendedGhost(R,redundant_comms);
+
+  GaugeFlowParam flowParam = { type, epsilon, tol, n_meas, t_meas, E, t2E, Q, 0, 0 };
+  gradientFlow(*gaugeSmeared, flowParam);
+
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("Gradient flow to t = %e took %d steps (%d rejected)\n",
+	       t_meas[n_meas-1], flowParam.steps, flowParam.rejected);
+
+  profileFlow.TPSTOP(QUDA_PROFILE_TOTAL);
+  return flowParam.steps;
+}
+
+int performGradientFlowHostQuda(void *h_gauge, QudaGaugeParam *param, QudaGaugeFlowType type,
+				double epsilon, double tol, int n_meas, const double *t_meas,
+				double *E, double *t2E, double *Q)
+{
+  profileFlow.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (param->gauge_order != QUDA_QDP_GAUGE_ORDER && param->gauge_order != QUDA_MILC_GAUGE_ORDER)
+    errorQuda("Gauge field order %d not supported on the host", param->gauge_order);
+
+  GaugeFieldParam gauge_param(h_gauge, *param);
+  cpuGaugeField cpuGauge(gauge_param);
+
+  // extend by two sites in each partitioned dimension for the rectangle staples
+  int R_host[4];
+  for (int d=0; d<4; d++) R_host[d] = comm_dim_partitioned(d) ? 2 : 0;
+
+  GaugeFieldParam gParamEx(gauge_param);
+  for (int d=0; d<4; d++) {
+    gParamEx.x[d] = gauge_param.x[d] + 2*R_host[d];
+    gParamEx.r[d] = R_host[d];
+  }
+  gParamEx.create = QUDA_NULL_FIELD_CREATE;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  cpuGaugeField gaugeEx(gParamEx);
+
+  copyExtendedGauge(gaugeEx, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  gaugeEx.exchangeExtendedGhost(R_host, true);
+
+  GaugeFlowParam flowParam = { type, epsilon, tol, n_meas, t_meas, E, t2E, Q, 0, 0 };
+  gradientFlow(gaugeEx, flowParam);
+
+  // copy the flowed interior back into the user's field
+  copyExtendedGauge(cpuGauge, gaugeEx, QUDA_CPU_FIELD_LOCATION);
+
+  profileFlow.TPSTOP(QUDA_PROFILE_TOTAL);
+  return flowParam.steps;
+}
+
 
 int computeGaugeFixingOVRQuda(void* gauge, const unsigned int gauge_dir,  const unsigned int Nsteps, \
   const unsigned int verbose_interval, const double relax_boost, const double tolerance, const unsigned int reunit_interval, \
@@ -5605,8 +6316,7 @@ int computeGaugeFixingOVRQuda(void* gauge, const unsigned int gauge_dir,  const
   GaugeFixOVRQuda.TPSTOP(QUDA_PROFILE_TOTAL);
 
   if (param->make_resident_gauge) {
-    if (gaugePrecise != NULL) delete gaugePrecise;
-    gaugePrecise = cudaInGauge;
+    setResidentGauge(cudaInGauge);
   } else {
     delete cudaInGauge;
   }
@@ -5682,8 +6392,7 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
   GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_TOTAL);
 
   if (param->make_resident_gauge) {
-    if (gaugePrecise != NULL) delete gaugePrecise;
-    gaugePrecise = cudaInGauge;
+    setResidentGauge(cudaInGauge);
   } else {
     delete cudaInGauge;
   }
@@ -5698,6 +6407,58 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
   return 0;
 }
 
+int computeGaugeFixingOVRHostQuda(void* gauge, const unsigned int gauge_dir,  const unsigned int Nsteps, \
+  const unsigned int verbose_interval, const double relax_boost, const double tolerance, const unsigned int reunit_interval, \
+  const unsigned int  stopWtheta, QudaGaugeParam* param , double* timeinfo)
+{
+  GaugeFixOVRQuda.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (param->gauge_order != QUDA_QDP_GAUGE_ORDER && param->gauge_order != QUDA_MILC_GAUGE_ORDER)
+    errorQuda("Gauge field order %d not supported on the host", param->gauge_order);
+
+  GaugeFieldParam gParam(gauge, *param);
+  cpuGaugeField cpuGauge(gParam);
+
+  GaugeFixOVRQuda.TPSTART(QUDA_PROFILE_COMPUTE);
+  gaugefixingOVR(cpuGauge, gauge_dir, Nsteps, verbose_interval, relax_boost, tolerance, reunit_interval, stopWtheta);
+  GaugeFixOVRQuda.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  GaugeFixOVRQuda.TPSTOP(QUDA_PROFILE_TOTAL);
+
+  if(timeinfo){
+    timeinfo[0] = 0.0;
+    timeinfo[1] = GaugeFixOVRQuda.Last(QUDA_PROFILE_COMPUTE);
+    timeinfo[2] = 0.0;
+  }
+  return 0;
+}
+
+int computeGaugeFixingFFTHostQuda(void* gauge, const unsigned int gauge_dir,  const unsigned int Nsteps, \
+  const unsigned int verbose_interval, const double alpha, const unsigned int autotune, const double tolerance, \
+  const unsigned int  stopWtheta, QudaGaugeParam* param , double* timeinfo)
+{
+  GaugeFixFFTQuda.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (param->gauge_order != QUDA_QDP_GAUGE_ORDER && param->gauge_order != QUDA_MILC_GAUGE_ORDER)
+    errorQuda("Gauge field order %d not supported on the host", param->gauge_order);
+
+  GaugeFieldParam gParam(gauge, *param);
+  cpuGaugeField cpuGauge(gParam);
+
+  GaugeFixFFTQuda.TPSTART(QUDA_PROFILE_COMPUTE);
+  gaugefixingFFT(cpuGauge, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+  GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_TOTAL);
+
+  if(timeinfo){
+    timeinfo[0] = 0.0;
+    timeinfo[1] = GaugeFixFFTQuda.Last(QUDA_PROFILE_COMPUTE);
+    timeinfo[2] = 0.0;
+  }
+  return 0;
+}
+
 /**
  * Compute a volume or time-slice contraction of two spinors.
  * @param x     Spinor to contract. This is conjugated before contraction.
@@ -5742,32 +6503,15 @@ double qChargeCuda ()
   else
     data = gaugeSmeared;
 #else
-  if ((!gaugeSmeared) && (extendedGaugeResident)) {
-    data = extendedGaugeResident;
+  if (!gaugeSmeared) {
+    profileExtendedGauge.TPSTART(QUDA_PROFILE_TOTAL);
+    profileExtendedGauge.TPSTART(QUDA_PROFILE_INIT);
+    data = residentExtendedGauge(extendedGaugeResident ? extendedGaugeResident->Reconstruct() :
+				 gaugePrecise->Reconstruct(), profileExtendedGauge);
+    profileExtendedGauge.TPSTOP(QUDA_PROFILE_INIT);
+    profileExtendedGauge.TPSTOP(QUDA_PROFILE_TOTAL);
   } else {
-    if (!gaugeSmeared) {
-      int y[4];
-      for(int dir=0; dir<4; ++dir) y[dir] = gaugePrecise->X()[dir] + 2 * R[dir];
-      int pad = 0;
-      GaugeFieldParam gParamEx(y, gaugePrecise->Precision(), gaugePrecise->Reconstruct(),
-        pad, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
-      gParamEx.create = QUDA_ZERO_FIELD_CREATE;
-      gParamEx.order = gaugePrecise->Order();
-      gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
-      gParamEx.t_boundary = gaugePrecise->TBoundary();
-      gParamEx.nFace = 1;
-      gParamEx.tadpole = gaugePrecise->Tadpole();
-      for(int dir=0; dir<4; ++dir) gParamEx.r[dir] = R[dir];
-
-      data = new cudaGaugeField(gParamEx);
-
-      copyExtendedGauge(*data, *gaugePrecise, QUDA_CUDA_FIELD_LOCATION);
-      data->exchangeExtendedGhost(R,redundant_comms);
-      extendedGaugeResident = data;
-      cudaDeviceSynchronize();
-    } else {
-      data = gaugeSmeared;
-    }
+    data = gaugeSmeared;
   }
                                  // Do we keep the smeared extended field on memory, or the unsmeared one?
 #endif
@@ -5784,3 +6528,123 @@ double qChargeCuda ()
   computeFmunu(Fmunu, *data, QUDA_CUDA_FIELD_LOCATION);
   return quda::computeQCharge(Fmunu, QUDA_CUDA_FIELD_LOCATION);
 }
+
+double gaugeObservablesHostQuda(double plq[3], void *h_gauge, QudaGaugeParam *param)
+{
+  if (param->gauge_order != QUDA_QDP_GAUGE_ORDER && param->gauge_order != QUDA_MILC_GAUGE_ORDER)
+    errorQuda("Gauge field order %d not supported on the host", param->gauge_order);
+
+  GaugeFieldParam gauge_param(h_gauge, *param);
+  cpuGaugeField cpuGauge(gauge_param);
+
+  // extend by one site in each partitioned dimension for the nearest-neighbour stencils
+  int R_host[4];
+  for (int d=0; d<4; d++) R_host[d] = comm_dim_partitioned(d) ? 1 : 0;
+
+  GaugeFieldParam gParamEx(gauge_param);
+  for (int d=0; d<4; d++) {
+    gParamEx.x[d] = gauge_param.x[d] + 2*R_host[d];
+    gParamEx.r[d] = R_host[d];
+  }
+  gParamEx.create = QUDA_NULL_FIELD_CREATE;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  cpuGaugeField gaugeEx(gParamEx);
+
+  copyExtendedGauge(gaugeEx, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  gaugeEx.exchangeExtendedGhost(R_host, true);
+
+  double3 plaq = quda::plaquette(gaugeEx, QUDA_CPU_FIELD_LOCATION);
+  plq[0] = plaq.x;
+  plq[1] = plaq.y;
+  plq[2] = plaq.z;
+
+  GaugeFieldParam tensorParam(cpuGauge.X(), cpuGauge.Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+  tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  tensorParam.order = QUDA_MILC_GAUGE_ORDER;
+  tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField Fmunu(tensorParam);
+
+  computeFmunu(Fmunu, gaugeEx, QUDA_CPU_FIELD_LOCATION);
+  return quda::computeQCharge(Fmunu, QUDA_CPU_FIELD_LOCATION);
+}
+
+void computeCloverHostQuda(void *h_clover, void *h_clovinv, void *h_gauge, QudaGaugeParam *gauge_param,
+			   QudaInvertParam *inv_param)
+{
+  profileCloverHost.TPSTART(QUDA_PROFILE_TOTAL);
+  profileCloverHost.TPSTART(QUDA_PROFILE_INIT);
+  pushVerbosity(inv_param->verbosity);
+
+  if (!h_clover) errorQuda("Host clover field must be allocated");
+  if (gauge_param->gauge_order != QUDA_QDP_GAUGE_ORDER && gauge_param->gauge_order != QUDA_MILC_GAUGE_ORDER)
+    errorQuda("Gauge field order %d not supported on the host", gauge_param->gauge_order);
+  if (inv_param->clover_order != QUDA_PACKED_CLOVER_ORDER)
+    errorQuda("Clover field order %d not supported on the host", inv_param->clover_order);
+  if (inv_param->clover_cpu_prec != gauge_param->cpu_prec)
+    errorQuda("Clover precision %d must match gauge precision %d", inv_param->clover_cpu_prec, gauge_param->cpu_prec);
+  if (inv_param->clover_coeff == 0.0) errorQuda("Clover coefficient not set");
+  if (gauge_param->anisotropy != 1.0) errorQuda("Cannot compute anisotropic clover field");
+
+  GaugeFieldParam gParam(h_gauge, *gauge_param);
+  cpuGaugeField cpuGauge(gParam);
+
+  // extend by one site in each partitioned dimension for the clover-leaf stencil
+  int R_host[4];
+  for (int d=0; d<4; d++) R_host[d] = comm_dim_partitioned(d) ? 1 : 0;
+
+  GaugeFieldParam gParamEx(gParam);
+  for (int d=0; d<4; d++) {
+    gParamEx.x[d] = gParam.x[d] + 2*R_host[d];
+    gParamEx.r[d] = R_host[d];
+  }
+  gParamEx.create = QUDA_NULL_FIELD_CREATE;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  cpuGaugeField gaugeEx(gParamEx);
+
+  GaugeFieldParam tensorParam(cpuGauge.X(), cpuGauge.Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+  tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  tensorParam.order = QUDA_MILC_GAUGE_ORDER;
+  tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField Fmunu(tensorParam);
+
+  bool twisted = inv_param->dslash_type == QUDA_TWISTED_CLOVER_DSLASH ? true : false;
+
+  CloverFieldParam clover_param;
+  clover_param.nDim = 4;
+  clover_param.twisted = twisted;
+  clover_param.mu2 = twisted ? 4.*inv_param->kappa*inv_param->kappa*inv_param->mu*inv_param->mu : 0.0;
+  clover_param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  for (int i=0; i<4; i++) clover_param.x[i] = cpuGauge.X()[i];
+  clover_param.pad = 0;
+  clover_param.precision = inv_param->clover_cpu_prec;
+  clover_param.order = QUDA_PACKED_CLOVER_ORDER;
+  clover_param.direct = true;
+  clover_param.inverse = h_clovinv ? true : false;
+  clover_param.clover = h_clover;
+  clover_param.cloverInv = h_clovinv;
+  clover_param.norm = nullptr;
+  clover_param.invNorm = nullptr;
+  clover_param.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuCloverField clover(clover_param);
+  profileCloverHost.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileCloverHost.TPSTART(QUDA_PROFILE_COMPUTE);
+  copyExtendedGauge(gaugeEx, cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  gaugeEx.exchangeExtendedGhost(R_host, true);
+
+  computeFmunu(Fmunu, gaugeEx, QUDA_CPU_FIELD_LOCATION);
+  computeClover(clover, Fmunu, inv_param->clover_coeff, QUDA_CPU_FIELD_LOCATION);
+
+  if (h_clovinv) {
+    cloverInvert(clover, inv_param->compute_clover_trlog, QUDA_CPU_FIELD_LOCATION);
+    if (inv_param->compute_clover_trlog) {
+      inv_param->trlogA[0] = clover.TrLog()[0];
+      inv_param->trlogA[1] = clover.TrLog()[1];
+    }
+  }
+  profileCloverHost.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  profileCloverHost.TPSTOP(QUDA_PROFILE_TOTAL);
+  if (getVerbosity() >= QUDA_VERBOSE) profileCloverHost.Print();
+  popVerbosity();
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
 
 #include <quda_internal.h>
 #include <color_spinor_field.h>
@@ -9,6 +10,7 @@
 #include <invert_quda.h>
 #include <util_quda.h>
 #include <face_quda.h>
+#include <comm_quda.h>
 
 /*!
  * Generic Multi Shift Solver 
@@ -24,6 +26,53 @@
 
 namespace quda {
 
+  /**
+     Apply the fused update of the shifted solutions and search
+     directions
+
+       x_j = x_j + alpha_j p_j
+       p_j = zeta_j r + beta_j p_j
+
+     to all active shifts j in [j_begin, j_end).  The shifts are
+     batched into a single multi-blas kernel for each precision the
+     search directions are stored in, so the residual is only read
+     once per precision rather than once per shift.
+
+     @param r Residual vector for each shift, stored at the precision of p_j
+     @param p Shifted search directions
+     @param x Shifted solution vectors
+     @param alpha Array of shifted step lengths
+     @param beta Array of shifted search-direction coefficients
+     @param zeta Array of shift residual ratios
+     @param active Whether each shift is still being updated
+     @param j_begin First shift to update
+     @param j_end One past the last shift to update
+   */
+  static void updateShifts(std::vector<ColorSpinorField*> &r, std::vector<ColorSpinorField*> &p,
+			   std::vector<ColorSpinorField*> &x, const double *alpha, const double *beta,
+			   const double *zeta, const bool *active, int j_begin, int j_end)
+  {
+    bool done[QUDA_MAX_MULTI_SHIFT] = { };
+    for (int j=j_begin; j<j_end; j++) {
+      if (!active[j] || done[j]) continue;
+
+      std::vector<ColorSpinorField*> P, X;
+      double a[QUDA_MAX_MULTI_SHIFT], b[QUDA_MAX_MULTI_SHIFT], c[QUDA_MAX_MULTI_SHIFT];
+      int n = 0;
+      for (int k=j; k<j_end; k++) {
+	if (!active[k] || r[k] != r[j]) continue;
+	P.push_back(p[k]);
+	X.push_back(x[k]);
+	a[n] = alpha[k];
+	b[n] = zeta[k];
+	c[n] = beta[k];
+	done[k] = true;
+	n++;
+      }
+      blas::axpyBzpcx(a, P, X, b, *r[j], c);
+    }
+  }
+
   /**
      This worker class is used to update the shifted p and x vectors.
      These updates take place in the subsequent dslash application in
@@ -48,14 +97,15 @@ namespace quda {
    */
   class ShiftUpdate : public Worker {
 
-    ColorSpinorField *r;
-    std::vector<ColorSpinorField*> p;
-    std::vector<ColorSpinorField*> x;
+    std::vector<ColorSpinorField*> &r;
+    std::vector<ColorSpinorField*> &p;
+    std::vector<ColorSpinorField*> &x;
 
     double *alpha;
     double *beta;
     double *zeta;
     double *zeta_old;
+    const bool *active;
 
     const int j_low;
     int n_shift;
@@ -69,10 +119,10 @@ namespace quda {
     int n_update; 
 
   public:
-    ShiftUpdate(ColorSpinorField *r, std::vector<ColorSpinorField*> p, std::vector<ColorSpinorField*> x,
-		double *alpha, double *beta, double *zeta, double *zeta_old, int j_low, int n_shift) :
-      r(r), p(p), x(x), alpha(alpha), beta(beta), zeta(zeta), zeta_old(zeta_old), j_low(j_low), 
-      n_shift(n_shift), n_update( (r->Nspin()==4) ? 4 : 2 ) {
+    ShiftUpdate(std::vector<ColorSpinorField*> &r, std::vector<ColorSpinorField*> &p, std::vector<ColorSpinorField*> &x,
+		double *alpha, double *beta, double *zeta, double *zeta_old, const bool *active, int j_low, int n_shift) :
+      r(r), p(p), x(x), alpha(alpha), beta(beta), zeta(zeta), zeta_old(zeta_old), active(active), j_low(j_low),
+      n_shift(n_shift), n_update( (r[0]->Nspin()==4) ? 4 : 2 ) {
       
     }
     virtual ~ShiftUpdate() { }
@@ -85,23 +135,12 @@ namespace quda {
     void apply(const cudaStream_t &stream) {      
       static int count = 0;
 
-#if 0
-      // on the first call do the first half of the update
-      for (int j= (count*n_shift)/n_update+1; j<=((count+1)*n_shift)/n_update && j<n_shift; j++) {
-	beta[j] = beta[j_low] * zeta[j] * alpha[j] /  ( zeta_old[j] * alpha[j_low] );
-	// update p[i] and x[i]
-	blas::axpyBzpcx(alpha[j], *(p[j]), *(x[j]), zeta[j], *r, beta[j]);
-      }
-#else
-      int zero = (count*n_shift)/n_update+1;
-      std::vector<ColorSpinorField*> P, X;
-      for (int j= (count*n_shift)/n_update+1; j<=((count+1)*n_shift)/n_update && j<n_shift; j++) {
-	beta[j] = beta[j_low] * zeta[j] * alpha[j] /  ( zeta_old[j] * alpha[j_low] );
-	P.push_back(p[j]);
-	X.push_back(x[j]);
-      }
-      if (P.size()) blas::axpyBzpcx(&alpha[zero], P, X, &zeta[zero], *r, &beta[zero]);
-#endif
+      const int j_begin = (count*n_shift)/n_update+1;
+      const int j_end = std::min(((count+1)*n_shift)/n_update+1, n_shift);
+      for (int j=j_begin; j<j_end; j++)
+	if (active[j]) beta[j] = beta[j_low] * zeta[j] * alpha[j] /  ( zeta_old[j] * alpha[j_low] );
+      updateShifts(r, p, x, alpha, beta, zeta, active, j_begin, j_end);
+
       if (++count == n_update) count = 0;
     }
     
@@ -223,6 +262,27 @@ namespace quda {
       csParam.create = QUDA_COPY_FIELD_CREATE;
       r_sloppy = new cudaColorSpinorField(*r, csParam);
     }
+
+    // the search direction of each shift may be stored below the
+    // sloppy precision, in which case the shift is updated from a
+    // copy of the residual at that precision
+    std::vector<ColorSpinorField*> r_shift(num_offset, r_sloppy);
+    std::vector<ColorSpinorField*> r_low;
+    for (int i=1; i<num_offset; i++) {
+      QudaPrecision prec_i = param.precision_offset[i];
+      if (prec_i == QUDA_INVALID_PRECISION || prec_i == param.precision_sloppy) continue;
+      if (prec_i > param.precision_sloppy)
+	errorQuda("Precision %d of shift %d exceeds the sloppy precision %d", prec_i, i, param.precision_sloppy);
+
+      for (auto r_ : r_low) if (r_->Precision() == prec_i) r_shift[i] = r_;
+      if (r_shift[i] == r_sloppy) {
+	ColorSpinorParam lowParam(*r_sloppy);
+	lowParam.create = QUDA_COPY_FIELD_CREATE;
+	lowParam.setPrecision(prec_i);
+	r_low.push_back(new cudaColorSpinorField(*r_sloppy, lowParam));
+	r_shift[i] = r_low.back();
+      }
+    }
   
     if (param.precision_sloppy == x[0]->Precision() ||
 	!param.use_sloppy_partial_accumulator) {
@@ -238,7 +298,7 @@ namespace quda {
   
     std::vector<ColorSpinorField*> p;
     p.resize(num_offset);
-    for (int i=0; i<num_offset; i++) p[i] = new cudaColorSpinorField(*r_sloppy);    
+    for (int i=0; i<num_offset; i++) p[i] = new cudaColorSpinorField(*r_shift[i]);
   
     csParam.create = QUDA_ZERO_FIELD_CREATE;
     cudaColorSpinorField* Ap = new cudaColorSpinorField(*r_sloppy, csParam);
@@ -263,14 +323,12 @@ namespace quda {
     // stopping condition of each shift
     double stop[QUDA_MAX_MULTI_SHIFT];
     double r2[QUDA_MAX_MULTI_SHIFT];
-    int iter[QUDA_MAX_MULTI_SHIFT+1];     // record how many iterations for each shift
+    int iter[QUDA_MAX_MULTI_SHIFT];     // record how many iterations for each shift
     for (int i=0; i<num_offset; i++) {
       r2[i] = b2;
       stop[i] = Solver::stopping(param.tol_offset[i], b2, param.residual_type);
       iter[i] = 0;
     }
-    // this initial condition ensures that the heaviest shift can be removed
-    iter[num_offset] = 1;
 
     double r2_old;
     double pAp;
@@ -305,8 +363,23 @@ namespace quda {
 
     bool aux_update = false;
 
+    // shifts that have converged are retired and no longer updated
+    bool active[QUDA_MAX_MULTI_SHIFT];
+    bool converged[QUDA_MAX_MULTI_SHIFT];
+    for (int i=0; i<num_offset; i++) {
+      active[i] = true;
+      converged[i] = false;
+    }
+
+    // The deferred shift update only pays off when it can be hidden
+    // behind the halo exchange of the next dslash.  Otherwise we
+    // update all shifts, including the unshifted system, in a single
+    // fused pass over the residual.
+    bool fused = true;
+    for (int d=0; d<4; d++) if (comm_dim_partitioned(d)) fused = false;
+
     // now create the worker class for updating the shifted solutions and gradient vectors
-    ShiftUpdate shift_update(r_sloppy, p, x_sloppy, alpha, beta, zeta, zeta_old, j_low, num_offset_now);
+    ShiftUpdate shift_update(r_shift, p, x_sloppy, alpha, beta, zeta, zeta_old, active, j_low, num_offset_now);
     
     profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
     profile.TPSTART(QUDA_PROFILE_COMPUTE);
@@ -324,6 +397,7 @@ namespace quda {
       // update number of shifts now instead of end of previous
       // iteration so that all shifts are updated during the dslash
       shift_update.updateNshift(num_offset_now);
+      for (int j=0; j<num_offset; j++) active[j] = !converged[j];
 
       // at some point we should curry these into the Dirac operator
       if (r->Nspin()==4) pAp = blas::axpyReDot(offset[0], *p[0], *Ap);
@@ -356,20 +430,23 @@ namespace quda {
       if ( !(updateR || updateX) || !reliable) {
 	//beta[0] = r2[0] / r2_old;	
 	beta[0] = zn / r2_old;
-	// update p[0] and x[0]
-	blas::axpyZpbx(alpha[0], *p[0], *x_sloppy[0], *r_sloppy, beta[0]);	
+	for (auto r_ : r_low) blas::copy(*r_, *r_sloppy);
 
-	// this should trigger the shift update in the subsequent sloppy dslash
-	aux_update = true;
-	/*
-	  for (int j=1; j<num_offset_now; j++) {
-	  beta[j] = beta[j_low] * zeta[j] * alpha[j] / (zeta_old[j] * alpha[j_low]);
-	  // update p[i] and x[i]
-	  blas::axpyBzpcx(alpha[j], *p[j], *x_sloppy[j], zeta[j], *r_sloppy, beta[j]);
-	  }
-	*/
+	if (fused) {
+	  // update all p[j] and x[j] in one pass over r
+	  for (int j=1; j<num_offset_now; j++)
+	    if (active[j]) beta[j] = beta[j_low] * zeta[j] * alpha[j] / (zeta_old[j] * alpha[j_low]);
+	  updateShifts(r_shift, p, x_sloppy, alpha, beta, zeta, active, 0, num_offset_now);
+	} else {
+	  // update p[0] and x[0]
+	  blas::axpyZpbx(alpha[0], *p[0], *x_sloppy[0], *r_sloppy, beta[0]);
+
+	  // this should trigger the shift update in the subsequent sloppy dslash
+	  aux_update = true;
+	}
       } else {
 	for (int j=0; j<num_offset_now; j++) {
+	  if (!active[j]) continue;
 	  blas::axpy(alpha[j], *p[j], *x_sloppy[j]);
 	  blas::copy(*x[j], *x_sloppy[j]);
 	  blas::xpy(*x[j], *y[j]);
@@ -379,10 +456,11 @@ namespace quda {
 	if (r->Nspin()==4) blas::axpy(offset[0], *y[0], *r);
 
 	r2[0] = blas::xmyNorm(b, *r);
-	for (int j=1; j<num_offset_now; j++) r2[j] = zeta[j] * zeta[j] * r2[0];
-	for (int j=0; j<num_offset_now; j++) blas::zero(*x_sloppy[j]);
+	for (int j=1; j<num_offset_now; j++) if (active[j]) r2[j] = zeta[j] * zeta[j] * r2[0];
+	for (int j=0; j<num_offset_now; j++) if (active[j]) blas::zero(*x_sloppy[j]);
 
 	blas::copy(*r_sloppy, *r);            
+	for (auto r_ : r_low) blas::copy(*r_, *r_sloppy);
 
 	// break-out check if we have reached the limit of the precision
 	if (sqrt(r2[reliable_shift]) > r0Norm[reliable_shift]) { // reuse r0Norm for this
@@ -401,16 +479,18 @@ namespace quda {
 
 	// explicitly restore the orthogonality of the gradient vector
 	for (int j=0; j<num_offset_now; j++) {
-	  Complex rp = blas::cDotProduct(*r_sloppy, *p[j]) / (r2[0]);
-	  blas::caxpy(-rp, *r_sloppy, *p[j]);
+	  if (!active[j]) continue;
+	  Complex rp = blas::cDotProduct(*r_shift[j], *p[j]) / (r2[0]);
+	  blas::caxpy(-rp, *r_shift[j], *p[j]);
 	}
 
 	// update beta and p
 	beta[0] = r2[0] / r2_old; 
 	blas::xpay(*r_sloppy, beta[0], *p[0]);
 	for (int j=1; j<num_offset_now; j++) {
+	  if (!active[j]) continue;
 	  beta[j] = beta[j_low] * zeta[j] * alpha[j] / (zeta_old[j] * alpha[j_low]);
-	  blas::axpby(zeta[j], *r_sloppy, beta[j], *p[j]);
+	  blas::axpby(zeta[j], *r_shift[j], beta[j], *p[j]);
 	}    
 
 	// update reliable update parameters for the system that triggered the update
@@ -422,25 +502,25 @@ namespace quda {
 	rUpdate++;
       }
 
-      // now we can check if any of the shifts have converged and remove them
-      int converged = 0;
-      for (int j=num_offset_now-1; j>=1; j--) {
-        if (zeta[j] == 0.0 && r2[j+1] < stop[j+1]) {
-          converged++;
-          if (getVerbosity() >= QUDA_VERBOSE)
-              printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
-        } else {
-	  r2[j] = zeta[j] * zeta[j] * r2[0];
-	  // only remove if shift above has converged
-	  if ((r2[j] < stop[j] || sqrt(r2[j] / b2) < prec_tol) && iter[j+1] ) {
-	    converged++;
-	    iter[j] = k+1;
-	    if (getVerbosity() >= QUDA_VERBOSE)
-	      printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
-          }
+      // now we can check if any of the shifts have converged and retire them
+      for (int j=1; j<num_offset_now; j++) {
+	if (converged[j]) continue;
+	r2[j] = zeta[j] * zeta[j] * r2[0];
+	if (zeta[j] == 0.0 || r2[j] < stop[j] || sqrt(r2[j] / b2) < prec_tol) {
+	  converged[j] = true;
+	  iter[j] = k+1;
+	  if (getVerbosity() >= QUDA_VERBOSE)
+	    printfQuda("MultiShift CG: Shift %d converged after %d iterations\n", j, k+1);
 	}
       }
-      num_offset_now -= converged;
+
+      // the fused update has already been applied for this iteration
+      // so retired shifts can be dropped immediately, whereas the
+      // deferred update is only completed during the next dslash
+      if (fused) for (int j=0; j<num_offset; j++) active[j] = !converged[j];
+
+      // shrink the range of shifts once the heaviest ones have all converged
+      while (num_offset_now > 1 && converged[num_offset_now-1]) num_offset_now--;
 
       // this ensure we do the update on any shifted systems that
       // happen to converge when the un-shifted system converges
@@ -452,7 +532,7 @@ namespace quda {
 	shift_update.updateNupdate(1);
 	shift_update.apply(0);
 
-	for (int j=0; j<num_offset_now; j++) iter[j] = k+1;
+	for (int j=0; j<num_offset_now; j++) if (!converged[j]) iter[j] = k+1;
       }
       
       k++;
@@ -533,6 +613,7 @@ namespace quda {
     if (&tmp2 != &tmp1) delete tmp2_p;
 
     if (r_sloppy->Precision() != r->Precision()) delete r_sloppy;
+    for (auto r_ : r_low) delete r_;
     for (int i=0; i<num_offset; i++) 
        if (x_sloppy[i]->Precision() != x[i]->Precision()) delete x_sloppy[i];
   
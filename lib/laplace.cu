@@ -14,10 +14,10 @@ namespace quda {
   /**
      @brief Parameter structure for driving the Laplace operator
    */
-  template <typename Float, int nColor, QudaReconstructType reconstruct, bool xpay>
+  template <typename Float, int nColor, typename F_, typename G_, bool xpay>
   struct LaplaceArg {
-    typedef typename colorspinor_mapper<Float,1,nColor>::type F;
-    typedef typename gauge_mapper<Float,reconstruct>::type G;
+    typedef F_ F;
+    typedef G_ G;
 
     F out;                // output vector field
     const F in;           // input vector field
@@ -39,10 +39,7 @@ namespace quda {
 	dim{ (3-nParity) * in.X(0), in.X(1), in.X(2), in.X(3), 1 },
       commDim{comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2), comm_dim_partitioned(3)},
       volumeCB(in.VolumeCB())
-    {
-      if (in.FieldOrder() != QUDA_FLOAT2_FIELD_ORDER || !U.isNative())
-      errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in.FieldOrder(), U.FieldOrder());
-    }
+    { }
   };
 
   /**
@@ -134,6 +131,7 @@ namespace quda {
       // for full fields then set parity from loop else use arg setting
       parity = (arg.nParity == 2) ? parity : arg.parity;
 
+#pragma omp parallel for
       for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
 	laplace<Float,nDim,nColor>(arg, x_cb, parity);
       } // 4-d volumeCB
@@ -207,22 +205,45 @@ namespace quda {
   };
 
 
-  template <typename Float, int nColor, QudaReconstructType recon>
+  template <typename Float, int nColor, typename F, typename G>
     void ApplyLaplace(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
 		      double kappa, const ColorSpinorField *x, int parity)
   {
     constexpr int nDim = 4;
     if (x) {
-      LaplaceArg<Float,nColor,recon,true> arg(out, in, U, kappa, x, parity);
-      Laplace<Float,nDim,nColor,LaplaceArg<Float,nColor,recon,true> > laplace(arg, in);
+      LaplaceArg<Float,nColor,F,G,true> arg(out, in, U, kappa, x, parity);
+      Laplace<Float,nDim,nColor,LaplaceArg<Float,nColor,F,G,true> > laplace(arg, in);
       laplace.apply(0);
     } else {
-      LaplaceArg<Float,nColor,recon,false> arg(out, in, U, kappa, x, parity);
-      Laplace<Float,nDim,nColor,LaplaceArg<Float,nColor,recon,false> > laplace(arg, in);
+      LaplaceArg<Float,nColor,F,G,false> arg(out, in, U, kappa, x, parity);
+      Laplace<Float,nDim,nColor,LaplaceArg<Float,nColor,F,G,false> > laplace(arg, in);
       laplace.apply(0);
     }
   }
 
+  // template on the field orders
+  template <typename Float, int nColor, QudaReconstructType recon>
+    void ApplyLaplace(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+		      double kappa, const ColorSpinorField *x, int parity)
+  {
+    if (in.isNative() && U.isNative()) {
+      typedef typename colorspinor_mapper<Float,1,nColor>::type F;
+      typedef typename gauge_mapper<Float,recon>::type G;
+      ApplyLaplace<Float,nColor,F,G>(out, in, U, kappa, x, parity);
+    } else if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && recon == QUDA_RECONSTRUCT_NO) {
+      typedef typename colorspinor::SpaceSpinorColorOrder<Float,1,nColor> F;
+      if (U.Order() == QUDA_QDP_GAUGE_ORDER) {
+	ApplyLaplace<Float,nColor,F,gauge::QDPOrder<Float,2*nColor*nColor> >(out, in, U, kappa, x, parity);
+      } else if (U.Order() == QUDA_MILC_GAUGE_ORDER) {
+	ApplyLaplace<Float,nColor,F,gauge::MILCOrder<Float,2*nColor*nColor> >(out, in, U, kappa, x, parity);
+      } else {
+	errorQuda("Unsupported gauge field order %d", U.Order());
+      }
+    } else {
+      errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", in.FieldOrder(), U.FieldOrder());
+    }
+  }
+
   // template on the gauge reconstruction
   template <typename Float, int nColor>
     void ApplyLaplace(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
@@ -24,25 +24,30 @@ using namespace gauge;
     }
   };
 
+  template<typename Float, typename Mom>
+  __device__ __host__ inline double momActionSite(const MomActionArg<Mom> &arg, int x, int parity) {
+    double action = 0.0;
+    // loop over direction
+    for (int mu=0; mu<4; mu++) {
+      Float v[10];
+      arg.mom.load(v, x, mu, parity);
+
+      double local_sum = 0.0;
+      for (int j=0; j<6; j++) local_sum += v[j]*v[j];
+      for (int j=6; j<9; j++) local_sum += 0.5*v[j]*v[j];
+      local_sum -= 4.0;
+      action += local_sum;
+    }
+    return action;
+  }
+
   template<int blockSize, typename Float, typename Mom>
   __global__ void computeMomAction(MomActionArg<Mom> arg){
     int x = threadIdx.x + blockIdx.x*blockDim.x;
     int parity = threadIdx.y;
     double action = 0.0;
     
-    if(x < arg.threads) {  
-      // loop over direction
-      for (int mu=0; mu<4; mu++) {
-	Float v[10];
-	arg.mom.load(v, x, mu, parity);
-
-	double local_sum = 0.0;
-	for (int j=0; j<6; j++) local_sum += v[j]*v[j];
-	for (int j=6; j<9; j++) local_sum += 0.5*v[j]*v[j];
-	local_sum -= 4.0;
-	action += local_sum;
-      }
-    }
+    if(x < arg.threads) action = momActionSite<Float>(arg, x, parity);
     
     // perform final inter-block reduction and write out result
     reduce2d<blockSize,2>(arg, action);
@@ -66,7 +71,10 @@ using namespace gauge;
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	LAUNCH_KERNEL_LOCAL_PARITY(computeMomAction, tp, stream, arg, Float, Mom);
       } else {
-	errorQuda("CPU not supported yet\n");
+	arg.result_h[0] = hostReduce<double>(2*arg.threads, [&](int i) {
+	    const int parity = i / arg.threads;
+	    return momActionSite<Float>(arg, i - parity*arg.threads, parity);
+	  });
       }
     }
 
@@ -86,7 +94,7 @@ using namespace gauge;
     MomAction<Float,Mom> momAction(arg, meta);
 
     momAction.apply(0);
-    cudaDeviceSynchronize();
+    if (meta.Location() == QUDA_CUDA_FIELD_LOCATION) cudaDeviceSynchronize();
 
     comm_allreduce((double*)arg.result_h);
     action = arg.result_h[0];
@@ -102,6 +110,13 @@ using namespace gauge;
       } else {
 	errorQuda("Reconstruction type %d not supported", mom.Reconstruct());
       }
+    } else if (mom.Order() == QUDA_MILC_GAUGE_ORDER) {
+      if (mom.Reconstruct() == QUDA_RECONSTRUCT_10) {
+	// the MILC compressed layout matches FLOAT2 reconstruct-10 element for element
+	momAction<Float>(MILCOrder<Float,10>(mom), mom, action);
+      } else {
+	errorQuda("Reconstruction type %d not supported", mom.Reconstruct());
+      }
     } else {
       errorQuda("Gauge Field order %d not supported", mom.Order());
     }
@@ -141,27 +156,40 @@ using namespace gauge;
     }
   };
 
+  template<typename Float, typename Mom, typename Force>
+  __device__ __host__ inline void updateMomSite(UpdateMomArg<Float, Mom, Force> &arg, int x, int parity) {
+    Matrix<complex<Float>,3> m, f;
+    for (int d=0; d<4; d++) {
+      arg.mom.load(reinterpret_cast<Float*>(m.data), x, d, parity);
+      arg.force.load(reinterpret_cast<Float*>(f.data), x, d, parity);
+
+      m = m + arg.coeff * f;
+      makeAntiHerm(m);
+
+      arg.mom.save(reinterpret_cast<Float*>(m.data), x, d, parity);
+    }
+  }
+
   template<typename Float, typename Mom, typename Force>
   __global__ void UpdateMomKernel(UpdateMomArg<Float, Mom, Force> arg) {
     int x = blockIdx.x*blockDim.x + threadIdx.x;
     int parity = threadIdx.y;
-    Matrix<complex<Float>,3> m, f;
     while(x<arg.threads){
-      for (int d=0; d<4; d++) {
-	arg.mom.load(reinterpret_cast<Float*>(m.data), x, d, parity);
-	arg.force.load(reinterpret_cast<Float*>(f.data), x, d, parity);
-
-	m = m + arg.coeff * f;
-	makeAntiHerm(m);
-
-	arg.mom.save(reinterpret_cast<Float*>(m.data), x, d, parity); 
-      }
-      
+      updateMomSite(arg, x, parity);
       x += gridDim.x*blockDim.x;
     }
     return;
   } // UpdateMom
 
+  template<typename Float, typename Mom, typename Force>
+  void UpdateMomCPU(UpdateMomArg<Float, Mom, Force> &arg) {
+#pragma omp parallel for
+    for (int i=0; i<2*arg.threads; i++) {
+      const int parity = i / arg.threads;
+      updateMomSite(arg, i - parity*arg.threads, parity);
+    }
+  }
+
   
   template<typename Float, typename Mom, typename Force>
   class UpdateMom : TunableLocalParity {
@@ -180,7 +208,7 @@ using namespace gauge;
 	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 	UpdateMomKernel<Float,Mom,Force><<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
       } else {
-	errorQuda("CPU not supported yet\n");
+	UpdateMomCPU(arg);
       }
     }
 
@@ -208,6 +236,21 @@ using namespace gauge;
     if (mom.Reconstruct() != QUDA_RECONSTRUCT_10)
       errorQuda("Momentum field with reconstruct %d not supported", mom.Reconstruct());
 
+    if (mom.Order() == QUDA_MILC_GAUGE_ORDER) {
+      if (force.Order() != QUDA_MILC_GAUGE_ORDER)
+	errorQuda("Unsupported force ordering: %d\n", force.Order());
+      if (force.Reconstruct() == QUDA_RECONSTRUCT_10) {
+	updateMomentum<Float>(MILCMomOrder<Float>(mom), static_cast<Float>(coeff),
+			      MILCMomOrder<Float>(force), force);
+      } else if (force.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	updateMomentum<Float>(MILCMomOrder<Float>(mom), static_cast<Float>(coeff),
+			      MILCOrder<Float,18>(force), force);
+      } else {
+	errorQuda("Unsupported force reconstruction: %d", force.Reconstruct());
+      }
+      return;
+    }
+
     if (force.Reconstruct() == QUDA_RECONSTRUCT_10) {
       updateMomentum<Float>(FloatNOrder<Float, 18, 2, 11>(mom), static_cast<Float>(coeff),
 			      FloatNOrder<Float, 18, 2, 11>(force), force);
@@ -223,7 +266,11 @@ using namespace gauge;
 
   void updateMomentum(GaugeField &mom, double coeff, GaugeField &force) {
 #ifdef GPU_GAUGE_TOOLS
-    if(mom.Order() != QUDA_FLOAT2_GAUGE_ORDER)
+    if (mom.Location() != force.Location())
+      errorQuda("Mixed field locations not supported");
+
+    if (mom.Order() != QUDA_FLOAT2_GAUGE_ORDER &&
+	!(mom.Location() == QUDA_CPU_FIELD_LOCATION && mom.Order() == QUDA_MILC_GAUGE_ORDER))
       errorQuda("Unsupported output ordering: %d\n", mom.Order());
 
     if (mom.Precision() != force.Precision()) 
@@ -15,9 +15,10 @@ namespace quda {
       profile_global(profile_global),
       profile( "MG level " + std::to_string(param.level+1), false ),
       coarse(nullptr), fine(param.fine), coarse_solver(nullptr),
-      param_coarse(nullptr), param_presmooth(nullptr), param_postsmooth(nullptr),
-      r(nullptr), r_coarse(nullptr), x_coarse(nullptr), tmp_coarse(nullptr),
-      diracCoarseResidual(nullptr), diracCoarseSmoother(nullptr), matCoarseResidual(nullptr), matCoarseSmoother(nullptr) {
+      param_coarse(nullptr), param_presmooth(nullptr), param_postsmooth(nullptr), param_coarse_solver(nullptr),
+      r(nullptr), r_coarse(nullptr), x_coarse(nullptr), tmp_coarse(nullptr), y_coarse(nullptr),
+      diracCoarseResidual(nullptr), diracCoarseSmoother(nullptr), diracCoarseSmootherSloppy(nullptr),
+      matCoarseResidual(nullptr), matCoarseSmoother(nullptr), matCoarseSmootherSloppy(nullptr) {
 
     // for reporting level 1 is the fine level but internally use level 0 for indexing
     sprintf(prefix,"MG level %d (%s): ", param.level+1, param.location == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
@@ -30,6 +31,8 @@ namespace quda {
 	if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_YES || param.level == 0) generateNullVectors(param.B);
       } else if (strcmp(param.mg_global.vec_infile,"")!=0) { // only load if infile is defined and not computing
 	loadVectors(param.B);
+	// optionally refine the loaded vectors against the current operator
+	if (param.mg_global.setup_maxiter_refresh[param.level]) generateNullVectors(param.B, true);
       }
     }
 
@@ -65,8 +68,6 @@ namespace quda {
 
     // if not on the coarsest level, construct it
     if (param.level < param.Nlevel-1) {
-      QudaMatPCType matpc_type = param.mg_global.invert_param->matpc_type;
-
       // create transfer operator
       printfQuda("start creating transfer operator\n");
       transfer = new Transfer(param.B, param.Nvec, param.geoBlockSize, param.spinBlockSize,
@@ -85,36 +86,12 @@ namespace quda {
       // create coarse temporary vector
       tmp_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, param.mg_global.location[param.level+1]);
 
-      // check if we are coarsening the preconditioned system then
-      bool preconditioned_coarsen = (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE);
-
-      // create coarse grid operator
-      DiracParam diracParam;
-      diracParam.transfer = transfer;
-
-      diracParam.dirac = preconditioned_coarsen ? const_cast<Dirac*>(param.matSmooth->Expose()) : const_cast<Dirac*>(param.matResidual->Expose());
-      diracParam.kappa = param.matResidual->Expose()->Kappa();
-      diracParam.mu = param.matResidual->Expose()->Mu();
-      diracParam.mu_factor = param.mg_global.mu_factor[param.level+1]-param.mg_global.mu_factor[param.level];
-
-      diracParam.dagger = QUDA_DAG_NO;
-      diracParam.matpcType = matpc_type;
-      diracParam.tmp1 = tmp_coarse;
-      // use even-odd preconditioning for the coarse grid solver
-      diracCoarseResidual = new DiracCoarse(diracParam);
-      matCoarseResidual = new DiracM(*diracCoarseResidual);
-
-      // create smoothing operators
-      diracParam.dirac = const_cast<Dirac*>(param.matSmooth->Expose());
-      diracParam.type = (param.mg_global.smoother_solve_type[param.level+1] == QUDA_DIRECT_PC_SOLVE) ? QUDA_COARSEPC_DIRAC : QUDA_COARSE_DIRAC;
-      diracParam.tmp1 = (param.mg_global.smoother_solve_type[param.level+1] == QUDA_DIRECT_PC_SOLVE) ? &(tmp_coarse->Even()) : tmp_coarse;
-      diracCoarseSmoother = (param.mg_global.smoother_solve_type[param.level+1] == QUDA_DIRECT_PC_SOLVE) ?
-	new DiracCoarsePC(static_cast<DiracCoarse&>(*diracCoarseResidual), diracParam) :
-	new DiracCoarse(static_cast<DiracCoarse&>(*diracCoarseResidual), diracParam);
-      diracCoarseSmootherSloppy = diracCoarseSmoother;  // for coarse grids these always alias for now (FIXME half precision support for coarse op)
-
-      matCoarseSmoother = new DiracM(*diracCoarseSmoother);
-      matCoarseSmootherSloppy = new DiracM(*diracCoarseSmootherSloppy);
+      // the W-cycle needs somewhere to accumulate the second coarse-grid correction
+      if (param.cycle_type == QUDA_MG_CYCLE_WCYCLE && param.level < param.Nlevel-2)
+	y_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, param.mg_global.location[param.level+1]);
+
+      // create the coarse grid operators
+      createCoarseDirac();
 
       printfQuda("Creating coarse null-space vectors\n");
       B_coarse = new std::vector<ColorSpinorField*>();
@@ -142,47 +119,7 @@ namespace quda {
 
       setOutputPrefix(prefix); // restore since we just popped back from coarse grid
 
-      // if on the second to bottom level then we can just use the coarse solver as is
-      if (param.cycle_type == QUDA_MG_CYCLE_VCYCLE || param.level == param.Nlevel-2) {
-	coarse_solver = coarse;
-	printfQuda("Assigned coarse solver to coarse MG operator\n");
-      } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
-	param_coarse_solver = new SolverParam(param);
-
-	param_coarse_solver->inv_type = QUDA_GCR_INVERTER;
-	param_coarse_solver->inv_type_precondition = QUDA_MG_INVERTER;
-	param_coarse_solver->preconditioner = coarse;
-
-	param_coarse_solver->is_preconditioner = false;
-	param_coarse_solver->preserve_source = QUDA_PRESERVE_SOURCE_YES;
-	param_coarse_solver->use_init_guess = QUDA_USE_INIT_GUESS_NO;
-	param_coarse_solver->maxiter = 11; // FIXME - dirty hack
-	param_coarse_solver->Nkrylov = 10;
-	param_coarse_solver->tol = param.mg_global.smoother_tol[param.level+1];
-	param_coarse_solver->global_reduction = true;
-	param_coarse_solver->compute_true_res = false;
-	param_coarse_solver->delta = 1e-8;
-	param_coarse_solver->verbosity_precondition = param.mg_global.verbosity[param.level+1];
-	param_coarse_solver->pipeline = 5;
-
-	// need this to ensure we don't use half precision on the preconditioner in GCR
-	param_coarse_solver->precision_precondition = param_coarse_solver->precision_sloppy;
-
-	if (param.mg_global.coarse_grid_solution_type[param.level+1] == QUDA_MATPC_SOLUTION) {
-	  Solver *solver = Solver::create(*param_coarse_solver, *matCoarseSmoother, *matCoarseSmoother, *matCoarseSmoother, profile);
-	  sprintf(coarse_prefix,"MG level %d (%s): ", param.level+2, param.mg_global.location[param.level+1] == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
-	  coarse_solver = new PreconditionedSolver(*solver, *matCoarseSmoother->Expose(), *param_coarse_solver, profile, coarse_prefix);
-	} else {
-	  Solver *solver = Solver::create(*param_coarse_solver, *matCoarseResidual, *matCoarseResidual, *matCoarseResidual, profile);
-	  sprintf(coarse_prefix,"MG level %d (%s): ", param.level+2, param.mg_global.location[param.level+1] == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
-	  coarse_solver = new PreconditionedSolver(*solver, *matCoarseResidual->Expose(), *param_coarse_solver, profile, coarse_prefix);
-	}
-
-	printfQuda("Assigned coarse solver to preconditioned GCR solver\n");
-      } else {
-	errorQuda("Multigrid cycle type %d not supported", param.cycle_type);
-      }
-
+      createCoarseSolver();
     }
 
     printfQuda("setup completed\n");
@@ -265,13 +202,200 @@ namespace quda {
     param_postsmooth = nullptr;
   }
 
-  MG::~MG() {
+  void MG::createCoarseDirac() {
+    QudaMatPCType matpc_type = param.mg_global.invert_param->matpc_type;
+
+    // check if we are coarsening the preconditioned system then
+    bool preconditioned_coarsen = (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE);
+
+    // create coarse grid operator
+    DiracParam diracParam;
+    diracParam.transfer = transfer;
+
+    diracParam.dirac = preconditioned_coarsen ? const_cast<Dirac*>(param.matSmooth->Expose()) : const_cast<Dirac*>(param.matResidual->Expose());
+    diracParam.kappa = param.matResidual->Expose()->Kappa();
+    diracParam.mu = param.matResidual->Expose()->Mu();
+    diracParam.mu_factor = param.mg_global.mu_factor[param.level+1]-param.mg_global.mu_factor[param.level];
+    diracParam.link_precision = param.mg_global.coarse_link_precision[param.level+1];
+
+    diracParam.dagger = QUDA_DAG_NO;
+    diracParam.matpcType = matpc_type;
+    diracParam.tmp1 = tmp_coarse;
+    // use even-odd preconditioning for the coarse grid solver
+    diracCoarseResidual = new DiracCoarse(diracParam);
+    matCoarseResidual = new DiracM(*diracCoarseResidual);
+
+    // create smoothing operators
+    diracParam.dirac = const_cast<Dirac*>(param.matSmooth->Expose());
+    diracParam.type = (param.mg_global.smoother_solve_type[param.level+1] == QUDA_DIRECT_PC_SOLVE) ? QUDA_COARSEPC_DIRAC : QUDA_COARSE_DIRAC;
+    diracParam.tmp1 = (param.mg_global.smoother_solve_type[param.level+1] == QUDA_DIRECT_PC_SOLVE) ? &(tmp_coarse->Even()) : tmp_coarse;
+    diracCoarseSmoother = (param.mg_global.smoother_solve_type[param.level+1] == QUDA_DIRECT_PC_SOLVE) ?
+      new DiracCoarsePC(static_cast<DiracCoarse&>(*diracCoarseResidual), diracParam) :
+      new DiracCoarse(static_cast<DiracCoarse&>(*diracCoarseResidual), diracParam);
+    diracCoarseSmootherSloppy = diracCoarseSmoother;  // for coarse grids these always alias for now (FIXME half precision support for coarse op)
+
+    matCoarseSmoother = new DiracM(*diracCoarseSmoother);
+    matCoarseSmootherSloppy = new DiracM(*diracCoarseSmootherSloppy);
+  }
+
+  void MG::destroyCoarseDirac() {
+    if (matCoarseSmootherSloppy) delete matCoarseSmootherSloppy;
+    matCoarseSmootherSloppy = nullptr;
+    if (diracCoarseSmootherSloppy && diracCoarseSmootherSloppy != diracCoarseSmoother) delete diracCoarseSmootherSloppy;
+    diracCoarseSmootherSloppy = nullptr;
+    if (matCoarseSmoother) delete matCoarseSmoother;
+    matCoarseSmoother = nullptr;
+    if (diracCoarseSmoother) delete diracCoarseSmoother;
+    diracCoarseSmoother = nullptr;
+    if (matCoarseResidual) delete matCoarseResidual;
+    matCoarseResidual = nullptr;
+    if (diracCoarseResidual) delete diracCoarseResidual;
+    diracCoarseResidual = nullptr;
+  }
+
+  void MG::createCoarseSolver() {
+    // if on the second to bottom level then we can just use the coarse solver as is
+    if (param.cycle_type == QUDA_MG_CYCLE_VCYCLE || param.cycle_type == QUDA_MG_CYCLE_WCYCLE ||
+	param.level == param.Nlevel-2) {
+      coarse_solver = coarse;
+      printfQuda("Assigned coarse solver to coarse MG operator\n");
+    } else if (param.cycle_type == QUDA_MG_CYCLE_KCYCLE) {
+      // K-cycle: a few iterations of flexible GCR on the coarse
+      // operator, preconditioned by the next level's cycle
+      param_coarse_solver = new SolverParam(param);
+
+      param_coarse_solver->inv_type = QUDA_GCR_INVERTER;
+      param_coarse_solver->inv_type_precondition = QUDA_MG_INVERTER;
+      param_coarse_solver->preconditioner = coarse;
+
+      param_coarse_solver->is_preconditioner = false;
+      param_coarse_solver->preserve_source = QUDA_PRESERVE_SOURCE_YES;
+      param_coarse_solver->use_init_guess = QUDA_USE_INIT_GUESS_NO;
+      param_coarse_solver->maxiter = param.mg_global.coarse_solver_maxiter[param.level+1];
+      param_coarse_solver->Nkrylov = param_coarse_solver->maxiter; // never restart within a K-cycle
+      param_coarse_solver->tol = param.mg_global.coarse_solver_tol[param.level+1];
+      param_coarse_solver->global_reduction = true;
+      param_coarse_solver->compute_true_res = false;
+      param_coarse_solver->delta = 1e-8;
+      param_coarse_solver->verbosity_precondition = param.mg_global.verbosity[param.level+1];
+      param_coarse_solver->pipeline = 0;
+
+      // need this to ensure we don't use half precision on the preconditioner in GCR
+      param_coarse_solver->precision_precondition = param_coarse_solver->precision_sloppy;
+
+      DiracMatrix &matCoarse = param.mg_global.coarse_grid_solution_type[param.level+1] == QUDA_MATPC_SOLUTION ?
+	*matCoarseSmoother : *matCoarseResidual;
+
+      // construct GCR directly with the coarse MG as its preconditioner
+      Solver *solver = new GCR(matCoarse, *coarse, matCoarse, matCoarse, *param_coarse_solver, profile);
+      sprintf(coarse_prefix,"MG level %d (%s): ", param.level+2, param.mg_global.location[param.level+1] == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
+      coarse_solver = new PreconditionedSolver(*solver, *matCoarse.Expose(), *param_coarse_solver, profile, coarse_prefix);
+
+      printfQuda("Assigned coarse solver to K-cycle GCR(%d) solver\n", param_coarse_solver->maxiter);
+    } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
+      param_coarse_solver = new SolverParam(param);
+
+      param_coarse_solver->inv_type = QUDA_GCR_INVERTER;
+      param_coarse_solver->inv_type_precondition = QUDA_MG_INVERTER;
+      param_coarse_solver->preconditioner = coarse;
+
+      param_coarse_solver->is_preconditioner = false;
+      param_coarse_solver->preserve_source = QUDA_PRESERVE_SOURCE_YES;
+      param_coarse_solver->use_init_guess = QUDA_USE_INIT_GUESS_NO;
+      param_coarse_solver->maxiter = 11; // FIXME - dirty hack
+      param_coarse_solver->Nkrylov = 10;
+      param_coarse_solver->tol = param.mg_global.smoother_tol[param.level+1];
+      param_coarse_solver->global_reduction = true;
+      param_coarse_solver->compute_true_res = false;
+      param_coarse_solver->delta = 1e-8;
+      param_coarse_solver->verbosity_precondition = param.mg_global.verbosity[param.level+1];
+      param_coarse_solver->pipeline = 5;
+
+      // need this to ensure we don't use half precision on the preconditioner in GCR
+      param_coarse_solver->precision_precondition = param_coarse_solver->precision_sloppy;
+
+      if (param.mg_global.coarse_grid_solution_type[param.level+1] == QUDA_MATPC_SOLUTION) {
+	Solver *solver = Solver::create(*param_coarse_solver, *matCoarseSmoother, *matCoarseSmoother, *matCoarseSmoother, profile);
+	sprintf(coarse_prefix,"MG level %d (%s): ", param.level+2, param.mg_global.location[param.level+1] == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
+	coarse_solver = new PreconditionedSolver(*solver, *matCoarseSmoother->Expose(), *param_coarse_solver, profile, coarse_prefix);
+      } else {
+	Solver *solver = Solver::create(*param_coarse_solver, *matCoarseResidual, *matCoarseResidual, *matCoarseResidual, profile);
+	sprintf(coarse_prefix,"MG level %d (%s): ", param.level+2, param.mg_global.location[param.level+1] == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU" );
+	coarse_solver = new PreconditionedSolver(*solver, *matCoarseResidual->Expose(), *param_coarse_solver, profile, coarse_prefix);
+      }
+
+      printfQuda("Assigned coarse solver to preconditioned GCR solver\n");
+    } else {
+      errorQuda("Multigrid cycle type %d not supported", param.cycle_type);
+    }
+  }
+
+  void MG::destroyCoarseSolver() {
+    if (param.level < param.Nlevel-2 &&
+	(param.cycle_type == QUDA_MG_CYCLE_RECURSIVE || param.cycle_type == QUDA_MG_CYCLE_KCYCLE) ) {
+      if (coarse_solver) delete coarse_solver;
+      if (param_coarse_solver) delete param_coarse_solver;
+    }
+    coarse_solver = nullptr;
+    param_coarse_solver = nullptr;
+  }
+
+  void MG::updateCoarseOperator(bool refresh) {
+    setOutputPrefix(prefix);
+
     if (param.level < param.Nlevel-1) {
-      if (param.level < param.Nlevel-2 && param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
-	delete coarse_solver;
-	delete param_coarse_solver;
+      // refine the existing null space against the new operator (if generated on this level)
+      if (refresh && param.mg_global.setup_maxiter_refresh[param.level] &&
+	  (param.mg_global.generate_all_levels == QUDA_BOOLEAN_YES || param.level == 0) ) {
+	generateNullVectors(param.B, true);
+      }
+
+      // the coarse operator construction requires the full-field null-space components (reset() restores single parity)
+      QudaMatPCType matpc_type = param.mg_global.invert_param->matpc_type;
+      QudaParity parity = (matpc_type == QUDA_MATPC_EVEN_EVEN || matpc_type == QUDA_MATPC_EVEN_EVEN_ASYMMETRIC) ? QUDA_EVEN_PARITY : QUDA_ODD_PARITY;
+      transfer->setSiteSubset(QUDA_FULL_SITE_SUBSET, parity);
+
+      // the prolongator only changes if the null space has changed
+      if (refresh) transfer->reset();
+
+      printfQuda("Updating coarse grid operator\n");
+      destroyCoarseSolver();
+      destroyCoarseDirac();
+      createCoarseDirac();
+
+      // if we're not generating on all levels then we need to propagate the refined vectors down
+      if (refresh && param.mg_global.generate_all_levels == QUDA_BOOLEAN_NO) {
+	for (int i=0; i<param.Nvec; i++) {
+	  zero(*(*B_coarse)[i]);
+	  transfer->R(*(*B_coarse)[i], *(param.B[i]));
+	}
       }
 
+      // point the next level at the new operators and recreate its smoothers
+      param_coarse->matResidual = matCoarseResidual;
+      param_coarse->matSmooth = matCoarseSmoother;
+      param_coarse->matSmoothSloppy = matCoarseSmootherSloppy;
+      coarse->destroySmoother();
+      coarse->createSmoother();
+
+      coarse->updateCoarseOperator(refresh);
+      setOutputPrefix(prefix); // restore since we just popped back from coarse grid
+
+      createCoarseSolver();
+    }
+
+    if (param.level == 0) reset();
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) profile.Print();
+    profile.TPRESET();
+
+    setOutputPrefix(param.level == 0 ? "" : prefix);
+  }
+
+  MG::~MG() {
+    if (param.level < param.Nlevel-1) {
+      destroyCoarseSolver();
+
       if (B_coarse) {
 	int nVec_coarse = std::max(param.Nvec, param.mg_global.n_vec[param.level+1]);
 	for (int i=0; i<nVec_coarse; i++) if ((*B_coarse)[i]) delete (*B_coarse)[i];
@@ -279,12 +403,7 @@ namespace quda {
       }
       if (coarse) delete coarse;
       if (transfer) delete transfer;
-      if (matCoarseSmootherSloppy) delete matCoarseSmootherSloppy;
-      if (diracCoarseSmootherSloppy && diracCoarseSmootherSloppy != diracCoarseSmoother) delete diracCoarseSmootherSloppy;
-      if (matCoarseSmoother) delete matCoarseSmoother;
-      if (diracCoarseSmoother) delete diracCoarseSmoother;
-      if (matCoarseResidual) delete matCoarseResidual;
-      if (diracCoarseResidual) delete diracCoarseResidual;
+      destroyCoarseDirac();
     }
 
     destroySmoother();
@@ -294,6 +413,7 @@ namespace quda {
     if (r_coarse) delete r_coarse;
     if (x_coarse) delete x_coarse;
     if (tmp_coarse) delete tmp_coarse;
+    if (y_coarse) delete y_coarse;
 
     if (param_coarse) delete param_coarse;
 
@@ -544,6 +664,9 @@ namespace quda {
     if ( inner_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type != QUDA_DIRECT_PC_SOLVE)
       errorQuda("For this coarse grid solution type, a preconditioned smoother is required");
 
+    // inclusive time spent at this level (and below) per cycle
+    profile.TPSTART(QUDA_PROFILE_TOTAL);
+
     if ( debug ) printfQuda("entering V-cycle with x2=%e, r2=%e\n", norm2(x), norm2(b));
 
     if (param.level < param.Nlevel-1) {
@@ -597,6 +720,15 @@ namespace quda {
 
       setOutputPrefix(prefix); // restore prefix after return from coarse grid
 
+      // W-cycle: revisit the coarse grid with the updated coarse residual
+      if (y_coarse) {
+	(*param_coarse->matResidual)(*y_coarse, *x_coarse);
+	axpy(-1.0, *y_coarse, *r_coarse);
+	(*coarse_solver)(*y_coarse, *r_coarse);
+	setOutputPrefix(prefix);
+	xpy(*y_coarse, *x_coarse);
+      }
+
       if ( debug ) printfQuda("after coarse solve x_coarse2 = %e r_coarse2 = %e\n", norm2(*x_coarse), norm2(*r_coarse));
 
       // prolongate back to this grid
@@ -641,6 +773,8 @@ namespace quda {
       printfQuda("leaving V-cycle with x2=%e, r2=%e\n", norm2(x), r2);
     }
 
+    profile.TPSTOP(QUDA_PROFILE_TOTAL);
+
     setOutputPrefix(param.level == 0 ? "" : prefix_bkup);
   }
 
@@ -741,13 +875,18 @@ namespace quda {
 #endif
   }
 
-  void MG::generateNullVectors(std::vector<ColorSpinorField*> B) {
-    printfQuda("\nGenerate null vectors\n");
+  void MG::generateNullVectors(std::vector<ColorSpinorField*> B, bool refresh) {
+    printfQuda("\n%s null vectors\n", refresh ? "Refresh" : "Generate");
 
     SolverParam solverParam(param);  // Set solver field parameters:
 
-    // set null-space generation options - need to expose these
-    solverParam.maxiter = 500;
+    // set null-space generation options - when refreshing we only do
+    // a few iterations starting from the existing vectors
+    // a setup_maxiter of zero selects the solver default: CG needs
+    // considerably more iterations than the Krylov solvers to converge
+    solverParam.maxiter = refresh ? param.mg_global.setup_maxiter_refresh[param.level] : param.mg_global.setup_maxiter[param.level];
+    if (!refresh && solverParam.maxiter == 0)
+      solverParam.maxiter = param.mg_global.setup_inv_type[param.level] == QUDA_CG_INVERTER ? 2000 : 500;
     solverParam.tol = param.mg_global.setup_tol[param.level];
     solverParam.use_init_guess = QUDA_USE_INIT_GUESS_YES;
     solverParam.delta = 1e-7; 
@@ -784,7 +923,6 @@ namespace quda {
     const Dirac &diracSloppy = *(param.matSmoothSloppy->Expose());
     DiracMdagM mdagmSloppy(diracSloppy);
     if(solverParam.inv_type == QUDA_CG_INVERTER) {
-      solverParam.maxiter = 2000;
       solve = Solver::create(solverParam, mdagm, mdagmSloppy, mdagmSloppy, profile);
     } else if(solverParam.inv_type == QUDA_GCR_INVERTER) {
       solverParam.inv_type_precondition = param.mg_global.smoother[param.level];
@@ -796,9 +934,11 @@ namespace quda {
       solve = Solver::create(solverParam, *param.matSmooth, *param.matSmoothSloppy, *param.matSmoothSloppy, profile);
     }
 
+    const int iter0 = solverParam.iter;
+
     // Generate sources and launch solver for each source:
     for(unsigned int i=0; i<B.size(); i++) {
-      B[i]->Source(QUDA_RANDOM_SOURCE); //random initial guess
+      if (!refresh) B[i]->Source(QUDA_RANDOM_SOURCE); //random initial guess, else use the existing vector
 
       B_gpu.push_back(ColorSpinorField::Create(csParam));
       ColorSpinorField *x = B_gpu[i];
@@ -830,6 +970,8 @@ namespace quda {
     delete solve;
     delete b;
 
+    printfQuda("%s %lu null vectors in %d total iterations\n", refresh ? "Refreshed" : "Generated", B.size(), solverParam.iter - iter0);
+
     for (int i=0; i<(int)B.size(); i++) {
       *B[i] = *B_gpu[i];
       delete B_gpu[i];
@@ -76,13 +76,15 @@ namespace quda {
   };
 
 
-  template<int NElems, typename Float, typename Gauge, bool pack>
-  __global__ void Kernel_UnPack(int size, GaugeFixUnPackArg<Gauge> arg, \
-                                complex<Float> *array, int parity, int face, int dir, int borderid){
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if ( idx >= size ) return;
-    int X[4];
-    for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
+  /**
+     @brief Return the checkerboarded index of the site idx of a face
+     @param X Field dimensions, including any border
+     @param idx Checkerboarded index within the face
+     @param parity Site parity
+     @param face Dimension normal to the face
+     @param borderid Coordinate of the face in dimension face
+   */
+  __host__ __device__ inline int faceSiteIndex(const int X[4], int idx, int parity, int face, int borderid){
     int x[4];
     int za, xodd;
     switch ( face ) {
@@ -111,6 +113,7 @@ namespace quda {
       x[0] = (2 * idx + xodd)  - za * X[0];
       break;
     case 3: //T FACE
+    default:
       za = idx / ( X[0] / 2);
       x[2] = za / X[1];
       x[1] = za - x[2] * X[1];
@@ -119,7 +122,18 @@ namespace quda {
       x[0] = (2 * idx + xodd)  - za * X[0];
       break;
     }
-    int id = (((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0]) >> 1;
+    return (((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0]) >> 1;
+  }
+
+
+  template<int NElems, typename Float, typename Gauge, bool pack>
+  __global__ void Kernel_UnPack(int size, GaugeFixUnPackArg<Gauge> arg, \
+                                complex<Float> *array, int parity, int face, int dir, int borderid){
+    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if ( idx >= size ) return;
+    int X[4];
+    for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
+    int id = faceSiteIndex(X, idx, parity, face, borderid);
     typedef complex<Float> Complex;
     typedef typename mapper<Float>::type RegType;
     RegType tmp[NElems];
@@ -340,6 +354,88 @@ namespace quda {
     }
   }
 
+
+  /**
+     @brief Threaded host packing (unpacking) of the links in direction
+     dir of a face into (from) a contiguous buffer
+   */
+  template<typename Float, typename Gauge, bool pack>
+  void HostUnPack(int size, Gauge &dataOr, const int X[4], Float *array, int parity, int face, int dir, int borderid){
+#pragma omp parallel for
+    for ( int idx = 0; idx < size; idx++ ) {
+      int id = faceSiteIndex(X, idx, parity, face, borderid);
+      if ( pack ) dataOr.load(array + idx * 18, id, dir, parity);
+      else dataOr.save(array + idx * 18, id, dir, parity);
+    }
+  }
+
+
+  template<typename Float, typename Gauge>
+  void PGaugeExchange( Gauge dataOr,  cpuGaugeField& data, const int dir, const int parity) {
+#ifdef MULTI_GPU
+    int X[4];
+    for ( int d = 0; d < 4; d++ ) X[d] = data.X()[d];
+
+    for ( int d = 0; d < 4; d++ ) {
+      if ( !commDimPartitioned(d)) continue;
+      int faceVolumeCB = X[0] * X[1] * X[2] * X[3] / (2 * X[d]);
+      size_t bytes = faceVolumeCB * 18 * sizeof(Float);
+      Float *send_h = static_cast<Float*>(safe_malloc(bytes));
+      Float *sendg_h = static_cast<Float*>(safe_malloc(bytes));
+      Float *recv_h = static_cast<Float*>(safe_malloc(bytes));
+      Float *recvg_h = static_cast<Float*>(safe_malloc(bytes));
+
+      MsgHandle *mh_recv_back = comm_declare_receive_relative(recv_h, d, -1, bytes);
+      MsgHandle *mh_recv_fwd  = comm_declare_receive_relative(recvg_h, d, +1, bytes);
+      MsgHandle *mh_send_back = comm_declare_send_relative(sendg_h, d, -1, bytes);
+      MsgHandle *mh_send_fwd  = comm_declare_send_relative(send_h, d, +1, bytes);
+
+      comm_start(mh_recv_back);
+      comm_start(mh_recv_fwd);
+
+      //extract top face
+      HostUnPack<Float, Gauge, true>(faceVolumeCB, dataOr, X, send_h, parity, d, dir, X[d] - data.R()[d] - 1);
+      //extract bottom
+      HostUnPack<Float, Gauge, true>(faceVolumeCB, dataOr, X, sendg_h, parity, d, dir, data.R()[d]);
+
+      comm_start(mh_send_fwd);
+      comm_start(mh_send_back);
+
+      comm_wait(mh_recv_back);
+      HostUnPack<Float, Gauge, false>(faceVolumeCB, dataOr, X, recv_h, parity, d, dir, data.R()[d] - 1);
+      comm_wait(mh_recv_fwd);
+      HostUnPack<Float, Gauge, false>(faceVolumeCB, dataOr, X, recvg_h, parity, d, dir, X[d] - data.R()[d]);
+
+      comm_wait(mh_send_back);
+      comm_wait(mh_send_fwd);
+
+      comm_free(mh_send_fwd);
+      comm_free(mh_send_back);
+      comm_free(mh_recv_back);
+      comm_free(mh_recv_fwd);
+      host_free(send_h);
+      host_free(sendg_h);
+      host_free(recv_h);
+      host_free(recvg_h);
+    }
+#endif
+  }
+
+
+  template<typename Float>
+  void PGaugeExchange( cpuGaugeField& data, const int dir, const int parity) {
+    if ( data.Reconstruct() != QUDA_RECONSTRUCT_NO )
+      errorQuda("Reconstruction type %d of gauge field not supported", data.Reconstruct());
+
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      PGaugeExchange<Float>(gauge::QDPOrder<Float,18>(data), data, dir, parity);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      PGaugeExchange<Float>(gauge::MILCOrder<Float,18>(data), data, dir, parity);
+    } else {
+      errorQuda("Invalid Gauge Order %d\n", data.Order());
+    }
+  }
+
 #endif // GPU_GAUGE_ALG
 
   void PGaugeExchange( cudaGaugeField& data, const int dir, const int parity) {
@@ -359,6 +455,25 @@ namespace quda {
       }
     }
 #endif
+#else
+    errorQuda("Pure gauge code has not been built");
+#endif
+  }
+
+  void PGaugeExchange( cpuGaugeField& data, const int dir, const int parity) {
+
+#ifdef GPU_GAUGE_ALG
+#ifdef MULTI_GPU
+    if ( comm_dim_partitioned(0) || comm_dim_partitioned(1) || comm_dim_partitioned(2) || comm_dim_partitioned(3) ) {
+      if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+        PGaugeExchange<float> (data, dir, parity);
+      } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+        PGaugeExchange<double>(data, dir, parity);
+      } else {
+        errorQuda("Precision %d not supported", data.Precision());
+      }
+    }
+#endif
 #else
     errorQuda("Pure gauge code has not been built");
 #endif
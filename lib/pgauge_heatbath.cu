@@ -89,10 +89,10 @@ namespace quda {
     @brief Generate full SU(2) matrix (four real numbers instead of 2x2 complex matrix) and update link matrix.
     Get from MILC code.
     @param al weight
-    @param localstate CURAND rng state
+    @param localstate counter-based rng state of the site
  */
-  template <class T>
-  __device__ static inline Matrix<T,2> generate_su2_matrix_milc(T al, cuRNGState& localState){
+  template <class T, class RNGState>
+  __host__ __device__ static inline Matrix<T,2> generate_su2_matrix_milc(T al, RNGState& localState){
     T xr1, xr2, xr3, xr4, d, r;
     int k;
     xr1 = Random<T>(localState);
@@ -139,13 +139,13 @@ namespace quda {
     a(0,0) = 1.0 - d;
     //compute r
     xr3 = 1.0 - a(0,0) * a(0,0);
-    xr3 = abs(xr3);
+    xr3 = fabs(xr3);
     r = sqrt(xr3);
     //compute a3
     a(1,1) = (2.0 * Random<T>(localState) - 1.0) * r;
     //compute a1 and a2
     xr1 = xr3 - a(1,1) * a(1,1);
-    xr1 = abs(xr1);
+    xr1 = fabs(xr1);
     xr1 = sqrt(xr1);
     //xr2 is a random number between 0 and 2*pi
     xr2 = PII * Random<T>(localState);
@@ -300,11 +300,11 @@ namespace quda {
     @brief Link update by pseudo-heatbath
     @param U link to be updated
     @param F staple
-    @param localstate CURAND rng state
+    @param localstate counter-based rng state of the site
  */
-  template <class Float, int NCOLORS>
-  __device__ inline void heatBathSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F,
-                                      cuRNGState& localState, Float BetaOverNc ){
+  template <class Float, int NCOLORS, class RNGState>
+  __host__ __device__ inline void heatBathSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F,
+                                               RNGState& localState, Float BetaOverNc ){
 
     if ( NCOLORS == 3 ) {
       //////////////////////////////////////////////////////////////////
@@ -436,7 +436,7 @@ namespace quda {
      @param F staple
    */
   template <class Float, int NCOLORS>
-  __device__ inline void overrelaxationSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F ){
+  __host__ __device__ inline void overrelaxationSUN( Matrix<complex<Float>,NCOLORS>& U, Matrix<complex<Float>,NCOLORS> F ){
 
     if ( NCOLORS == 3 ) {
       //////////////////////////////////////////////////////////////////
@@ -600,6 +600,48 @@ namespace quda {
   };
 
 
+  /**
+     @brief Compute the staple of the link in direction mu
+     @param dataOr Gauge field accessor
+     @param x Site coordinates, including any border
+     @param X Field dimensions, including any border
+     @param idx Checkerboarded site index
+     @param mu Link direction
+     @param parity Site parity
+   */
+  template<typename Float, typename Gauge, int NCOLORS>
+  __host__ __device__ inline Matrix<complex<Float>,NCOLORS> computeStaple(const Gauge &dataOr, int x[4], const int X[4],
+                                                                         int idx, int mu, int parity){
+    Matrix<complex<Float>,NCOLORS> staple;
+    setZero(&staple);
+
+    Matrix<complex<Float>,NCOLORS> U;
+    for ( int nu = 0; nu < 4; nu++ ) if ( mu != nu ) {
+        int dx[4] = { 0, 0, 0, 0 };
+        Matrix<complex<Float>,NCOLORS> link;
+        dataOr.load((Float*)(link.data), idx, nu, parity);
+        dx[nu]++;
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
+        link *= U;
+        dx[nu]--;
+        dx[mu]++;
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, 1 - parity);
+        link *= conj(U);
+        staple += link;
+        dx[mu]--;
+        dx[nu]--;
+        dataOr.load((Float*)(link.data), linkIndexShift(x,dx,X), nu, 1 - parity);
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
+        link = conj(link) * U;
+        dx[mu]++;
+        dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, parity);
+        link *= U;
+        staple += link;
+      }
+    return staple;
+  }
+
+
   template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
   __global__ void compute_heatBath(MonteArg<Gauge, Float, NCOLORS> arg, int mu, int parity){
     int idx = threadIdx.x + blockIdx.x * blockDim.x;
@@ -620,37 +662,13 @@ namespace quda {
     idx = linkIndex(x,X);
 #endif
 
-    Matrix<complex<Float>,NCOLORS> staple;
-    setZero(&staple);
+    Matrix<complex<Float>,NCOLORS> staple = computeStaple<Float, Gauge, NCOLORS>(arg.dataOr, x, X, idx, mu, parity);
 
     Matrix<complex<Float>,NCOLORS> U;
-    for ( int nu = 0; nu < 4; nu++ ) if ( mu != nu ) {
-        int dx[4] = { 0, 0, 0, 0 };
-        Matrix<complex<Float>,NCOLORS> link;
-        arg.dataOr.load((Float*)(link.data), idx, nu, parity);
-        dx[nu]++;
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
-        link *= U;
-        dx[nu]--;
-        dx[mu]++;
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, 1 - parity);
-        link *= conj(U);
-        staple += link;
-        dx[mu]--;
-        dx[nu]--;
-        arg.dataOr.load((Float*)(link.data), linkIndexShift(x,dx,X), nu, 1 - parity);
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), mu, 1 - parity);
-        link = conj(link) * U;
-        dx[mu]++;
-        arg.dataOr.load((Float*)(U.data), linkIndexShift(x,dx,X), nu, parity);
-        link *= U;
-        staple += link;
-      }
     arg.dataOr.load((Float*)(U.data), idx, mu, parity);
     if ( HeatbathOrRelax ) {
-      cuRNGState localState = arg.rngstate.State()[ id ];
+      PhiloxState localState = arg.rngstate.State(id, parity);
       heatBathSUN<Float, NCOLORS>( U, conj(staple), localState, arg.BetaOverNc );
-      arg.rngstate.State()[ id ] = localState;
     }
     else{
       overrelaxationSUN<Float, NCOLORS>( U, conj(staple) );
@@ -662,6 +680,7 @@ namespace quda {
   template<typename Float, typename Gauge, int NCOLORS, int NElems, bool HeatbathOrRelax>
   class GaugeHB : Tunable {
     MonteArg<Gauge, Float, NCOLORS> arg;
+    RNG &rngstate;
     int mu;
     int parity;
     mutable char aux_string[128];       // used as a label in the autotuner
@@ -681,8 +700,8 @@ namespace quda {
     }
 
     public:
-    GaugeHB(MonteArg<Gauge, Float, NCOLORS> &arg)
-      : arg(arg), mu(0), parity(0) {
+    GaugeHB(MonteArg<Gauge, Float, NCOLORS> &arg, RNG &rngstate)
+      : arg(arg), rngstate(rngstate), mu(0), parity(0) {
     }
     ~GaugeHB () {
     }
@@ -692,6 +711,7 @@ namespace quda {
     }
     void apply(const cudaStream_t &stream){
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      arg.rngstate = rngstate;
       compute_heatBath<Float, Gauge, NCOLORS, HeatbathOrRelax ><< < tp.grid,tp.block, tp.shared_bytes, stream >> > (arg, mu, parity);
     }
 
@@ -707,11 +727,9 @@ namespace quda {
 
     void preTune() {
       arg.data.backup();
-      if(HeatbathOrRelax) arg.rngstate.backup();
     }
     void postTune() {
       arg.data.restore();
-      if(HeatbathOrRelax) arg.rngstate.restore();
     }
     long long flops() const {
 
@@ -743,13 +761,11 @@ namespace quda {
       //NEED TO CHECK THIS!!!!!!
       if ( NCOLORS == 3 ) {
         long long byte = 20LL * NElems * sizeof(Float);
-        if ( HeatbathOrRelax ) byte += 2LL * sizeof(cuRNGState);
         byte *= arg.threads;
         return byte;
       }
       else{
         long long byte = 20LL * NCOLORS * NCOLORS * 2 * sizeof(Float);
-        if ( HeatbathOrRelax ) byte += 2LL * sizeof(cuRNGState);
         byte *= arg.threads;
         return byte;
       }
@@ -770,12 +786,13 @@ namespace quda {
     TimeProfile profileHBOVR("HeatBath_OR_Relax", false);
     MonteArg<Gauge, Float, NCOLORS> montearg(dataOr, data, Beta, rngstate);
     if ( getVerbosity() >= QUDA_SUMMARIZE ) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
-    GaugeHB<Float, Gauge, NCOLORS, NElems, true> hb(montearg);
+    GaugeHB<Float, Gauge, NCOLORS, NElems, true> hb(montearg, rngstate);
     for ( int step = 0; step < nhb; ++step ) {
       for ( int parity = 0; parity < 2; ++parity ) {
         for ( int mu = 0; mu < 4; ++mu ) {
           hb.SetParam(mu, parity);
           hb.apply(0);
+          rngstate.advance();
         #ifdef MULTI_GPU
           PGaugeExchange( data, mu, parity);
         #endif
@@ -796,7 +813,7 @@ namespace quda {
     }
 
     if ( getVerbosity() >= QUDA_SUMMARIZE ) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
-    GaugeHB<Float, Gauge, NCOLORS, NElems, false> relax(montearg);
+    GaugeHB<Float, Gauge, NCOLORS, NElems, false> relax(montearg, rngstate);
     for ( int step = 0; step < nover; ++step ) {
       for ( int parity = 0; parity < 2; ++parity ) {
         for ( int mu = 0; mu < 4; ++mu ) {
@@ -844,12 +861,121 @@ namespace quda {
       errorQuda("Invalid Gauge Order\n");
     }
   }
+
+
+  template <typename Gauge, typename Float, int NCOLORS>
+  struct MonteHostArg {
+    int threads;       // number of sites per parity
+    int X[4];          // local grid dimensions
+    int border[4];     // border of the extended field
+    Gauge dataOr;
+    Float BetaOverNc;
+    RNG rngstate;
+    MonteHostArg(const Gauge &dataOr, const cpuGaugeField &data, Float Beta, RNG &rngstate)
+      : dataOr(dataOr), rngstate(rngstate) {
+      BetaOverNc = Beta / (Float)NCOLORS;
+      for ( int dir = 0; dir < 4; ++dir ) {
+        border[dir] = data.R()[dir];
+        X[dir] = data.X()[dir] - border[dir] * 2;
+      }
+      threads = X[0] * X[1] * X[2] * X[3] >> 1;
+    }
+  };
+
+  /**
+     @brief Threaded host update of all links in direction mu on the
+     sites of the given parity.  Each site draws from the same
+     counter-based stream as on the device, so the result does not
+     depend on the number of threads or the lattice decomposition and
+     matches the device update.
+   */
+  template<typename Float, typename Gauge, int NCOLORS, bool HeatbathOrRelax>
+  void compute_heatBathCPU(MonteHostArg<Gauge, Float, NCOLORS> &arg, int mu, int parity){
+#pragma omp parallel for
+    for ( int id = 0; id < arg.threads; id++ ) {
+      int X[4], x[4];
+      for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
+      getCoords(x, id, X, parity);
+
+      for ( int dr = 0; dr < 4; ++dr ) {
+        x[dr] += arg.border[dr];
+        X[dr] += 2 * arg.border[dr];
+      }
+      int idx = linkIndex(x,X);
+
+      Matrix<complex<Float>,NCOLORS> staple = computeStaple<Float, Gauge, NCOLORS>(arg.dataOr, x, X, idx, mu, parity);
+
+      Matrix<complex<Float>,NCOLORS> U;
+      arg.dataOr.load((Float*)(U.data), idx, mu, parity);
+      if ( HeatbathOrRelax ) {
+        PhiloxState localState = arg.rngstate.State(id, parity);
+        heatBathSUN<Float, NCOLORS>( U, conj(staple), localState, arg.BetaOverNc );
+      }
+      else{
+        overrelaxationSUN<Float, NCOLORS>( U, conj(staple) );
+      }
+      arg.dataOr.save((Float*)(U.data), idx, mu, parity);
+    }
+  }
+
+  template<typename Float, int NCOLORS, typename Gauge>
+  void Monte( Gauge dataOr,  cpuGaugeField& data, RNG &rngstate, Float Beta, int nhb, int nover) {
+
+    TimeProfile profileHBOVR("HeatBath_OR_Relax_Host", false);
+    MonteHostArg<Gauge, Float, NCOLORS> montearg(dataOr, data, Beta, rngstate);
+
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
+    for ( int step = 0; step < nhb; ++step ) {
+      for ( int parity = 0; parity < 2; ++parity ) {
+        for ( int mu = 0; mu < 4; ++mu ) {
+          montearg.rngstate = rngstate;
+          compute_heatBathCPU<Float, Gauge, NCOLORS, true>(montearg, mu, parity);
+          rngstate.advance();
+          PGaugeExchange( data, mu, parity);
+        }
+      }
+    }
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) {
+      profileHBOVR.TPSTOP(QUDA_PROFILE_COMPUTE);
+      double secs = profileHBOVR.Last(QUDA_PROFILE_COMPUTE);
+      printfQuda("HB host: Time = %6.6f s, sweeps/s = %6.2f\n", secs, nhb / secs);
+    }
+
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) profileHBOVR.TPSTART(QUDA_PROFILE_COMPUTE);
+    for ( int step = 0; step < nover; ++step ) {
+      for ( int parity = 0; parity < 2; ++parity ) {
+        for ( int mu = 0; mu < 4; ++mu ) {
+          compute_heatBathCPU<Float, Gauge, NCOLORS, false>(montearg, mu, parity);
+          PGaugeExchange( data, mu, parity);
+        }
+      }
+    }
+    if ( getVerbosity() >= QUDA_SUMMARIZE ) {
+      profileHBOVR.TPSTOP(QUDA_PROFILE_COMPUTE);
+      double secs = profileHBOVR.Last(QUDA_PROFILE_COMPUTE);
+      printfQuda("OVR host: Time = %6.6f s, sweeps/s = %6.2f\n", secs, nover / secs);
+    }
+  }
+
+  template<typename Float>
+  void Monte( cpuGaugeField& data, RNG &rngstate, Float Beta, int nhb, int nover) {
+    if ( data.Reconstruct() != QUDA_RECONSTRUCT_NO )
+      errorQuda("Reconstruction type %d of gauge field not supported", data.Reconstruct());
+
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      Monte<Float, 3>(gauge::QDPOrder<Float,18>(data), data, rngstate, Beta, nhb, nover);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      Monte<Float, 3>(gauge::MILCOrder<Float,18>(data), data, rngstate, Beta, nhb, nover);
+    } else {
+      errorQuda("Invalid Gauge Order %d\n", data.Order());
+    }
+  }
 #endif // GPU_GAUGE_ALG
 
 /** @brief Perform heatbath and overrelaxation. Performs nhb heatbath steps followed by nover overrelaxation steps.
  *
  * @param[in,out] data Gauge field
- * @param[in,out] rngstate state of the CURAND random number generator
+ * @param[in,out] rngstate counter-based random number generator, advanced by 8 nhb calls
  * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
  * @param[in] nhb number of heatbath steps
  * @param[in] nover number of overrelaxation steps
@@ -869,4 +995,28 @@ namespace quda {
   }
 
 
+
+/** @brief Perform heatbath and overrelaxation on a host gauge field.
+ *
+ * @param[in,out] data Gauge field
+ * @param[in,out] rngstate counter-based random number generator, advanced by 8 nhb calls
+ * @param[in] Beta inverse of the gauge coupling, beta = 2 Nc / g_0^2
+ * @param[in] nhb number of heatbath steps
+ * @param[in] nover number of overrelaxation steps
+ */
+  void Monte( cpuGaugeField& data, RNG &rngstate, double Beta, int nhb, int nover) {
+#ifdef GPU_GAUGE_ALG
+    if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+      Monte<float> (data, rngstate, (float)Beta, nhb, nover);
+    } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+      Monte<double>(data, rngstate, Beta, nhb, nover);
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+#else
+    errorQuda("Pure gauge code has not been built");
+#endif // GPU_GAUGE_ALG
+  }
+
+
 }
@@ -155,6 +155,51 @@ namespace quda {
   }
 
 
+  template<typename Float, int NCOLORS, typename Gauge>
+  void InitGaugeField( Gauge dataOr,  cpuGaugeField& data) {
+    const int volumeCB = data.VolumeCB();
+    for ( int parity = 0; parity < 2; parity++ ) {
+#pragma omp parallel for
+      for ( int idx = 0; idx < volumeCB; idx++ ) {
+        Matrix<complex<Float>,NCOLORS> U;
+        setIdentity(&U);
+        for ( int d = 0; d < 4; d++ )
+          dataOr.save((Float*)(U.data),idx, d, parity);
+      }
+    }
+  }
+
+  template<typename Float>
+  void InitGaugeField( cpuGaugeField& data) {
+    if ( data.Reconstruct() != QUDA_RECONSTRUCT_NO )
+      errorQuda("Reconstruction type %d of gauge field not supported", data.Reconstruct());
+
+    if ( data.Order() == QUDA_QDP_GAUGE_ORDER ) {
+      InitGaugeField<Float, 3>(gauge::QDPOrder<Float,18>(data), data);
+    } else if ( data.Order() == QUDA_MILC_GAUGE_ORDER ) {
+      InitGaugeField<Float, 3>(gauge::MILCOrder<Float,18>(data), data);
+    } else {
+      errorQuda("Invalid Gauge Order %d\n", data.Order());
+    }
+  }
+
+/** @brief Perform a cold start to the host gauge field, identity SU(3) matrix, including the border of an extended field
+ *
+ * @param[in,out] data Gauge field
+ */
+  void InitGaugeField( cpuGaugeField& data) {
+
+    if ( data.Precision() == QUDA_SINGLE_PRECISION ) {
+      InitGaugeField<float> (data);
+    } else if ( data.Precision() == QUDA_DOUBLE_PRECISION ) {
+      InitGaugeField<double>(data);
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+
+  }
+
+
 
 
 
@@ -180,8 +225,6 @@ namespace quda {
 #else
       for ( int dir = 0; dir < 4; ++dir ) X[dir] = data.X()[dir];
 #endif
-      //the optimal number of RNG states in rngstate array must be equal to half the lattice volume
-      //this number is the same used in heatbath...
       threads = X[0] * X[1] * X[2] * X[3] >> 1;
     }
   };
@@ -234,18 +277,18 @@ namespace quda {
 
 /**
     @brief Generate the four random real elements of the SU(2) matrix
-    @param localstate CURAND rng state
+    @param localstate rng state
     @return four real numbers of the SU(2) matrix
  */
   template <class T>
-  __device__ static inline Matrix<T,2> randomSU2(cuRNGState& localState){
+  __host__ __device__ static inline Matrix<T,2> randomSU2(PhiloxState& localState){
     Matrix<T,2> a;
     T aabs, ctheta, stheta, phi;
     a(0,0) = Random<T>(localState, (T)-1.0, (T)1.0);
     aabs = sqrt( 1.0 - a(0,0) * a(0,0));
     ctheta = Random<T>(localState, (T)-1.0, (T)1.0);
     phi = PII * Random<T>(localState);
-    stheta = ( curand(&localState) & 1 ? 1 : -1 ) * sqrt( (T)1.0 - ctheta * ctheta );
+    stheta = ( philoxNext(localState) & 1 ? 1 : -1 ) * sqrt( (T)1.0 - ctheta * ctheta );
     a(0,1) = aabs * stheta * cos( phi );
     a(1,0) = aabs * stheta * sin( phi );
     a(1,1) = aabs * ctheta;
@@ -298,11 +341,11 @@ namespace quda {
 
 /**
     @brief Generate a SU(Nc) random matrix
-    @param localstate CURAND rng state
+    @param localstate rng state
     @return SU(Nc) matrix
  */
   template <class Float, int NCOLORS>
-  __device__ inline Matrix<complex<Float>,NCOLORS> randomize( cuRNGState& localState ){
+  __host__ __device__ inline Matrix<complex<Float>,NCOLORS> randomize( PhiloxState& localState ){
     Matrix<complex<Float>,NCOLORS> U;
 
     for ( int i = 0; i < NCOLORS; i++ )
@@ -330,15 +373,15 @@ namespace quda {
     for ( int dr = 0; dr < 4; ++dr ) X[dr] = arg.X[dr];
     for ( int dr = 0; dr < 4; ++dr ) X[dr] += 2 * arg.border[dr];
     int id = idx;
-    cuRNGState localState = arg.rngstate.State()[ id ];
-  #else
-    cuRNGState localState = arg.rngstate.State()[ idx ];
   #endif
     for ( int parity = 0; parity < 2; parity++ ) {
     #ifdef MULTI_GPU
+      PhiloxState localState = arg.rngstate.State(id, parity);
       getCoords(x, id, arg.X, parity);
       for ( int dr = 0; dr < 4; ++dr ) x[dr] += arg.border[dr];
       idx = linkIndex(x,X);
+    #else
+      PhiloxState localState = arg.rngstate.State(idx, parity);
     #endif
       for ( int d = 0; d < 4; d++ ) {
         Matrix<complex<Float>,NCOLORS> U;
@@ -346,11 +389,6 @@ namespace quda {
         arg.dataOr.save((Float*)(U.data),idx, d, parity);
       }
     }
-  #ifdef MULTI_GPU
-    arg.rngstate.State()[ id ] = localState;
-  #else
-    arg.rngstate.State()[ idx ] = localState;
-  #endif
   }
 
 
@@ -401,8 +439,6 @@ namespace quda {
 
     }
 
-    void preTune(){ arg.rngstate.backup(); }
-    void postTune(){ arg.rngstate.restore(); }
     long long flops() const {
       return 0;
     }                                  // Only correct if there is no link reconstruction, no cub reduction accounted also
@@ -421,6 +457,7 @@ namespace quda {
     InitGaugeHotArg<Gauge> initarg(dataOr, data, rngstate);
     InitGaugeHot<Float, Gauge, NCOLORS> init(initarg);
     init.apply(0);
+    rngstate.advance();
     checkCudaError();
     cudaDeviceSynchronize();
 
@@ -478,7 +515,7 @@ namespace quda {
 /** @brief Perform a hot start to the gauge field, random SU(3) matrix, followed by reunitarization, also exchange borders links in multi-GPU case.
  *
  * @param[in,out] data Gauge field
- * @param[in,out] rngstate state of the CURAND random number generator
+ * @param[in,out] rngstate counter-based random number generator, advanced by one call
  */
   void InitGaugeField( cudaGaugeField& data, RNG &rngstate) {
 #ifdef GPU_GAUGE_ALG
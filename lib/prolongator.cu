@@ -101,6 +101,8 @@ namespace quda {
     for (int parity=0; parity<arg.nParity; parity++) {
       parity = (arg.nParity == 2) ? parity : arg.parity;
 
+      // each fine site is written exactly once, and streams its own rotator block from V
+#pragma omp parallel for
       for (int x_cb=0; x_cb<arg.out.VolumeCB(); x_cb++) {
 	complex<Float> tmp[fineSpin*coarseColor];
 	prolongate<Float,fineSpin,coarseColor>(tmp, arg.in, parity, x_cb, arg.geo_map, arg.spin_map, arg.out.VolumeCB());
@@ -25,15 +25,13 @@ namespace quda {
       : ReduceArg<double>(), data(data), threads(Fmunu.Volume()) {}
   };
 
-  // Core routine for computing the topological charge from the field strength
-  template<int blockSize, typename Float, typename Gauge>
-    __global__
-    void qChargeComputeKernel(QChargeArg<Float,Gauge> arg) {
-      int idx = threadIdx.x + blockIdx.x*blockDim.x;
+  // Core routine for computing the topological charge density from the field strength
+  template<typename Float, typename Gauge>
+    __device__ __host__ inline double qChargeSite(QChargeArg<Float,Gauge> &arg, int idx) {
 
       double tmpQ1 = 0.;
 
-      if(idx < arg.threads) {
+      {
         int parity = 0;  
         if(idx >= arg.threads/2) {
           parity = 1;
@@ -58,10 +56,24 @@ namespace quda {
         tmpQ1 /= (Pi2*Pi2);
       }
 
-      double Q = tmpQ1;
+      return tmpQ1;
+    }
+
+  template<int blockSize, typename Float, typename Gauge>
+    __global__
+    void qChargeComputeKernel(QChargeArg<Float,Gauge> arg) {
+      int idx = threadIdx.x + blockIdx.x*blockDim.x;
+
+      double Q = 0.;
+      if (idx < arg.threads) Q = qChargeSite(arg, idx);
       reduce<blockSize>(arg, Q);
     }
 
+  template<typename Float, typename Gauge>
+    void qChargeComputeCPU(QChargeArg<Float,Gauge> &arg) {
+      arg.result_h[0] = hostReduce<double>(arg.threads, [&](int i) { return qChargeSite(arg, i); });
+    }
+
   template<typename Float, typename Gauge>
     class QChargeCompute : Tunable {
       QChargeArg<Float,Gauge> arg;
@@ -91,8 +103,7 @@ namespace quda {
           LAUNCH_KERNEL(qChargeComputeKernel, tp, stream, arg, Float);
           cudaDeviceSynchronize();
         }else{ // run the CPU code
-	  errorQuda("qChargeComputeKernel not supported on CPU");
-//          qChargeComputeCPU(arg);
+          qChargeComputeCPU(arg);
         }
       }
 
@@ -111,7 +122,7 @@ namespace quda {
       QChargeArg<Float,Gauge> arg(data,Fmunu);
       QChargeCompute<Float,Gauge> qChargeCompute(arg, &Fmunu, location);
       qChargeCompute.apply(0);
-      checkCudaError();
+      if (location == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
       comm_allreduce((double*) arg.result_h);
       qChg = arg.result_h[0];
     }
@@ -120,6 +131,16 @@ namespace quda {
     Float computeQCharge(GaugeField &Fmunu, QudaFieldLocation location){
       Float res = 0.;
 
+      if (location == QUDA_CPU_FIELD_LOCATION) {
+        if (Fmunu.Order() == QUDA_MILC_GAUGE_ORDER) {
+          typedef gauge::MILCOrder<Float,18> Gauge;
+          computeQCharge<Float>(Gauge(Fmunu), Fmunu, location, res);
+        } else {
+          errorQuda("Fmunu field order %d not supported on the host", Fmunu.Order());
+        }
+        return res;
+      }
+
       if (!Fmunu.isNative()) errorQuda("Topological charge computation only supported on native ordered fields");
 
       if (Fmunu.Reconstruct() == QUDA_RECONSTRUCT_NO) {
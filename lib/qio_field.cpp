@@ -1,7 +1,13 @@
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include <set>
+#include <string>
 #include <qio.h>
 #include <qio_util.h>
 #include <quda.h>
 #include <util_quda.h>
+#include <qio_field.h>
 
 QIO_Layout layout;
 int lattice_dim;
@@ -156,6 +162,7 @@ void set_layout(const int *X) {
 }
 
 void read_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X, int argc, char *argv[]) {
+  write_spinor_field_wait(); // the layout is shared with the writer thread
   this_node = mynode();
 
   set_layout(X);
@@ -197,6 +204,7 @@ int read_field(QIO_Reader *infile, int Ninternal, int count, void *field_in[], Q
 
 void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
 		       int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
+  write_spinor_field_wait(); // the layout is shared with the writer thread
   this_node = mynode();
 
   set_layout(X);
@@ -302,27 +310,195 @@ int write_field(QIO_Writer *outfile, int Ninternal, int count, void *field_out[]
   return status;
 }
 
-void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
-		       int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
+// write the spinor fields V, held in cpu_prec, to a file of precision file_prec
+static int write_spinor_file(const char *filename, void *V[], QudaPrecision file_prec, QudaPrecision cpu_prec,
+			      const int *X, int nColor, int nSpin, int Nvec) {
   this_node = mynode();
 
   set_layout(X);
 
-  QudaPrecision file_prec = precision;
-
   char type[128];
   sprintf(type, "QUDA_%sNs%dNc%d_ColorSpinorField", (file_prec == QUDA_DOUBLE_PRECISION) ? "D" : "F", nSpin, nColor);
 
   /* Open the test file for reading */
   QIO_Writer *outfile = open_test_output(filename, QIO_SINGLEFILE, QIO_PARALLEL, QIO_ILDGNO);
-  if(outfile == NULL) { printfQuda("Open file failed\n"); exit(0); }
+  if(outfile == NULL) { printfQuda("Open file failed\n"); return 1; }
 
   /* Read the spinor field record */
   printfQuda("%s: writing %d vector fields\n", __func__, Nvec); fflush(stdout);
-  int status = write_field(outfile, 2*nSpin*nColor, Nvec, V, precision, precision, nSpin, nColor, type);
-  if(status) { errorQuda("write_spinor_fields failed %d\n", status); }
+  int status = write_field(outfile, 2*nSpin*nColor, Nvec, V, file_prec, cpu_prec, nSpin, nColor, type);
 
   /* Close the file */
   QIO_close_write(outfile);
   printfQuda("%s: Closed file for writing\n",__func__);
+  return status;
+}
+
+void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
+		       int nColor, int nSpin, int Nvec, int argc, char *argv[]) {
+  write_spinor_field_wait(); // the layout is shared with the writer thread
+  int status = write_spinor_file(filename, V, precision, precision, X, nColor, nSpin, Nvec);
+  if(status) { errorQuda("write_spinor_fields failed %d\n", status); }
+}
+
+/*
+  Asynchronous spinor output.  The caller thread copies the fields,
+  converting to the file precision, into a job that a single writer
+  thread drains in order.  The number of queued jobs is bounded so
+  that the host memory held by the queue stays at a few fields.
+*/
+
+struct SpinorWriteJob {
+  int id;
+  std::string filename;
+  std::vector<char> buffer;
+  QudaPrecision prec;
+  int X[4];
+  int nColor;
+  int nSpin;
+  int Nvec;
+};
+
+static const size_t max_pending_writes = 2;
+static std::deque<SpinorWriteJob*> write_queue;
+static pthread_mutex_t write_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t write_posted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t write_completed = PTHREAD_COND_INITIALIZER;
+static pthread_t writer_thread;
+static bool writer_running = false;
+static bool writer_shutdown = false;
+static int write_failures = 0;
+static int writes_posted = 0; // id of the most recently queued job
+static int writes_done = 0; // jobs complete in order, so all ids up to this are done
+static std::set<int> failed_writes; // ids of failed jobs not yet reported
+
+static int write_spinor_job(SpinorWriteJob &job) {
+  const size_t bytes = job.buffer.size() / job.Nvec;
+  std::vector<void*> V(job.Nvec);
+  for (int i=0; i<job.Nvec; i++) V[i] = &job.buffer[i*bytes];
+  return write_spinor_file(job.filename.c_str(), V.data(), job.prec, job.prec, job.X, job.nColor, job.nSpin, job.Nvec);
+}
+
+static void *spinorWriter(void *) {
+  pthread_mutex_lock(&write_mutex);
+  while (true) {
+    while (write_queue.empty() && !writer_shutdown) pthread_cond_wait(&write_posted, &write_mutex);
+    if (write_queue.empty()) break;
+
+    // the job stays at the front of the queue until written so that
+    // write_spinor_field_wait cannot return early
+    SpinorWriteJob *job = write_queue.front();
+    pthread_mutex_unlock(&write_mutex);
+    int status = write_spinor_job(*job);
+    pthread_mutex_lock(&write_mutex);
+
+    if (status) {
+      write_failures++;
+      failed_writes.insert(job->id);
+    }
+    writes_done = job->id;
+    write_queue.pop_front();
+    delete job;
+    pthread_cond_broadcast(&write_completed);
+  }
+  pthread_mutex_unlock(&write_mutex);
+  return NULL;
+}
+
+template <typename oFloat, typename iFloat>
+static void convert_spinor(oFloat *out, const iFloat *in, size_t length) {
+#pragma omp parallel for
+  for (size_t i=0; i<length; i++) out[i] = in[i];
+}
+
+int write_spinor_field_async(const char *filename, void *V[], QudaPrecision precision, QudaPrecision file_prec,
+			     const int *X, int nColor, int nSpin, int Nvec) {
+  if (file_prec == QUDA_INVALID_PRECISION) file_prec = precision;
+  if (file_prec != QUDA_DOUBLE_PRECISION && file_prec != QUDA_SINGLE_PRECISION)
+    errorQuda("File precision %d not supported by QIO", file_prec);
+  if (precision != QUDA_DOUBLE_PRECISION && precision != QUDA_SINGLE_PRECISION)
+    errorQuda("Field precision %d not supported", precision);
+
+  const size_t length = (size_t)X[0]*X[1]*X[2]*X[3]*2*nSpin*nColor;
+
+  SpinorWriteJob *job = new SpinorWriteJob;
+  job->filename = filename;
+  job->buffer.resize(Nvec*length*file_prec);
+  job->prec = file_prec;
+  for (int d=0; d<4; d++) job->X[d] = X[d];
+  job->nColor = nColor;
+  job->nSpin = nSpin;
+  job->Nvec = Nvec;
+
+  // the copy is what lets the caller reuse V as soon as we return
+  for (int i=0; i<Nvec; i++) {
+    char *out = &job->buffer[i*length*file_prec];
+    if (precision == QUDA_DOUBLE_PRECISION) {
+      if (file_prec == QUDA_DOUBLE_PRECISION) convert_spinor((double*)out, (const double*)V[i], length);
+      else convert_spinor((float*)out, (const double*)V[i], length);
+    } else {
+      if (file_prec == QUDA_DOUBLE_PRECISION) convert_spinor((double*)out, (const float*)V[i], length);
+      else convert_spinor((float*)out, (const float*)V[i], length);
+    }
+  }
+
+  // QIO communicates through QMP, which we cannot assume to be thread
+  // safe, so with more than one node the write is done here instead
+  if (QMP_get_number_of_nodes() > 1) {
+    write_spinor_field_wait();
+    int status = write_spinor_job(*job);
+    delete job;
+    if (status) errorQuda("write_spinor_fields failed %d\n", status);
+    pthread_mutex_lock(&write_mutex);
+    int id = writes_done = ++writes_posted;
+    pthread_mutex_unlock(&write_mutex);
+    return id;
+  }
+
+  pthread_mutex_lock(&write_mutex);
+  while (write_queue.size() >= max_pending_writes) pthread_cond_wait(&write_completed, &write_mutex);
+  int id = job->id = ++writes_posted;
+  write_queue.push_back(job);
+  if (!writer_running) {
+    writer_shutdown = false;
+    if (pthread_create(&writer_thread, NULL, spinorWriter, NULL)) errorQuda("pthread_create failed");
+    writer_running = true;
+  }
+  pthread_cond_signal(&write_posted);
+  pthread_mutex_unlock(&write_mutex);
+  return id;
+}
+
+void write_spinor_field_wait(int handle) {
+  pthread_mutex_lock(&write_mutex);
+  if (handle <= 0 || handle > writes_posted) {
+    pthread_mutex_unlock(&write_mutex);
+    errorQuda("Invalid spinor write handle %d", handle);
+  }
+  while (writes_done < handle) pthread_cond_wait(&write_completed, &write_mutex);
+  bool failed = failed_writes.erase(handle) > 0;
+  if (failed) write_failures--;
+  pthread_mutex_unlock(&write_mutex);
+
+  if (failed) errorQuda("Asynchronous spinor write %d failed", handle);
+}
+
+void write_spinor_field_wait() {
+  pthread_mutex_lock(&write_mutex);
+  if (!writer_running) {
+    pthread_mutex_unlock(&write_mutex);
+    return;
+  }
+  writer_shutdown = true;
+  pthread_cond_signal(&write_posted);
+  pthread_mutex_unlock(&write_mutex);
+
+  // the writer exits once the queue has been drained
+  if (pthread_join(writer_thread, NULL)) errorQuda("pthread_join failed");
+  writer_running = false;
+
+  int failures = write_failures;
+  write_failures = 0;
+  failed_writes.clear();
+  if (failures) errorQuda("%d asynchronous spinor writes failed", failures);
 }
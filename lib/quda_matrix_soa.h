@@ -0,0 +1,434 @@
+#ifndef _QUDA_MATRIX_SOA_H_
+#define _QUDA_MATRIX_SOA_H_
+
+#include <cmath>
+
+/**
+   @file quda_matrix_soa.h
+
+   Host-only 3x3 complex matrix arithmetic on packs of W matrices,
+   typically the links of W consecutive sites, held as structure of
+   arrays with the real and imaginary parts split.  Every primitive
+   loops over the lanes innermost under omp simd, so the host
+   references and the CPU branches of the gauge kernels vectorize
+   across sites rather than within a single 3x3 product, which the
+   per-element complex arithmetic of Matrix<T,N> cannot.
+
+   Matrices are moved in and out of a pack as 18 interleaved reals,
+   the layout used by the gauge field accessors' load and save.
+   Unless stated otherwise the output of a primitive must not alias
+   its inputs.
+ */
+
+namespace quda {
+
+  /**
+     Default number of lanes in a pack: eight doubles fill an AVX-512
+     register, two AVX2 registers or four SSE registers.
+   */
+  constexpr int host_simd_width = 8;
+
+  template <typename Float, int W = host_simd_width>
+  struct MatrixSoA {
+    Float re[9][W];
+    Float im[9][W];
+
+    /**
+       @brief Insert a matrix into lane w
+       @param v Matrix as 18 interleaved reals
+       @param w Lane index
+     */
+    template <typename T> inline void insert(const T v[18], int w) {
+      for (int i=0; i<9; i++) { re[i][w] = v[2*i]; im[i][w] = v[2*i+1]; }
+    }
+
+    /**
+       @brief Extract the matrix of lane w
+       @param v Matrix as 18 interleaved reals
+       @param w Lane index
+     */
+    template <typename T> inline void extract(T v[18], int w) const {
+      for (int i=0; i<9; i++) { v[2*i] = re[i][w]; v[2*i+1] = im[i][w]; }
+    }
+
+    inline void zero() {
+      for (int i=0; i<9; i++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) { re[i][w] = 0.0; im[i][w] = 0.0; }
+      }
+    }
+
+    inline void identity() {
+      for (int i=0; i<9; i++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) { re[i][w] = (i % 4 == 0) ? 1.0 : 0.0; im[i][w] = 0.0; }
+      }
+    }
+
+    /** @brief Set lane w to the identity, used to pad partial packs */
+    inline void identity(int w) {
+      for (int i=0; i<9; i++) { re[i][w] = (i % 4 == 0) ? 1.0 : 0.0; im[i][w] = 0.0; }
+    }
+  };
+
+  /**
+     @brief C = A B
+   */
+  template <typename Float, int W>
+  inline void mulNN(MatrixSoA<Float,W> &C, const MatrixSoA<Float,W> &A, const MatrixSoA<Float,W> &B)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) {
+	  Float re = 0.0, im = 0.0;
+	  for (int k=0; k<3; k++) {
+	    re += A.re[i*3+k][w]*B.re[k*3+j][w] - A.im[i*3+k][w]*B.im[k*3+j][w];
+	    im += A.re[i*3+k][w]*B.im[k*3+j][w] + A.im[i*3+k][w]*B.re[k*3+j][w];
+	  }
+	  C.re[i*3+j][w] = re; C.im[i*3+j][w] = im;
+	}
+      }
+    }
+  }
+
+  /**
+     @brief C = A^dagger B
+   */
+  template <typename Float, int W>
+  inline void mulAN(MatrixSoA<Float,W> &C, const MatrixSoA<Float,W> &A, const MatrixSoA<Float,W> &B)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) {
+	  Float re = 0.0, im = 0.0;
+	  for (int k=0; k<3; k++) {
+	    re += A.re[k*3+i][w]*B.re[k*3+j][w] + A.im[k*3+i][w]*B.im[k*3+j][w];
+	    im += A.re[k*3+i][w]*B.im[k*3+j][w] - A.im[k*3+i][w]*B.re[k*3+j][w];
+	  }
+	  C.re[i*3+j][w] = re; C.im[i*3+j][w] = im;
+	}
+      }
+    }
+  }
+
+  /**
+     @brief C = A B^dagger
+   */
+  template <typename Float, int W>
+  inline void mulNA(MatrixSoA<Float,W> &C, const MatrixSoA<Float,W> &A, const MatrixSoA<Float,W> &B)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) {
+	  Float re = 0.0, im = 0.0;
+	  for (int k=0; k<3; k++) {
+	    re += A.re[i*3+k][w]*B.re[j*3+k][w] + A.im[i*3+k][w]*B.im[j*3+k][w];
+	    im += A.im[i*3+k][w]*B.re[j*3+k][w] - A.re[i*3+k][w]*B.im[j*3+k][w];
+	  }
+	  C.re[i*3+j][w] = re; C.im[i*3+j][w] = im;
+	}
+      }
+    }
+  }
+
+  /**
+     @brief C = A^dagger (C may alias A)
+   */
+  template <typename Float, int W>
+  inline void adjoint(MatrixSoA<Float,W> &C, const MatrixSoA<Float,W> &A)
+  {
+    for (int i=0; i<3; i++) {
+      for (int j=i; j<3; j++) {
+#pragma omp simd
+	for (int w=0; w<W; w++) {
+	  const Float re = A.re[i*3+j][w], im = A.im[i*3+j][w];
+	  C.re[i*3+j][w] = A.re[j*3+i][w]; C.im[i*3+j][w] = -A.im[j*3+i][w];
+	  C.re[j*3+i][w] = re; C.im[j*3+i][w] = -im;
+	}
+      }
+    }
+  }
+
+  /**
+     @brief C += a A, with a real scalar common to all lanes (C may alias A)
+   */
+  template <typename Float, int W>
+  inline void axpy(Float a, const MatrixSoA<Float,W> &A, MatrixSoA<Float,W> &C)
+  {
+    for (int i=0; i<9; i++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) { C.re[i][w] += a*A.re[i][w]; C.im[i][w] += a*A.im[i][w]; }
+    }
+  }
+
+  /**
+     @brief C = a C, with a real scalar common to all lanes
+   */
+  template <typename Float, int W>
+  inline void scale(Float a, MatrixSoA<Float,W> &C)
+  {
+    for (int i=0; i<9; i++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) { C.re[i][w] *= a; C.im[i][w] *= a; }
+    }
+  }
+
+  /**
+     @brief Complex determinant of each lane
+   */
+  template <typename Float, int W>
+  inline void determinant(Float det_re[W], Float det_im[W], const MatrixSoA<Float,W> &A)
+  {
+#pragma omp simd
+    for (int w=0; w<W; w++) {
+      Float dr = 0.0, di = 0.0;
+      for (int a=0; a<3; a++) {
+	// cyclic terms of the Leibniz expansion: A0a (A1b A2c - A1c A2b)
+	const int b = (a+1)%3, c = (a+2)%3;
+	const Float mr = A.re[3+b][w]*A.re[6+c][w] - A.im[3+b][w]*A.im[6+c][w]
+	  - A.re[3+c][w]*A.re[6+b][w] + A.im[3+c][w]*A.im[6+b][w];
+	const Float mi = A.re[3+b][w]*A.im[6+c][w] + A.im[3+b][w]*A.re[6+c][w]
+	  - A.re[3+c][w]*A.im[6+b][w] - A.im[3+c][w]*A.re[6+b][w];
+	dr += A.re[a][w]*mr - A.im[a][w]*mi;
+	di += A.re[a][w]*mi + A.im[a][w]*mr;
+      }
+      det_re[w] = dr; det_im[w] = di;
+    }
+  }
+
+  /**
+     @brief Replace each lane by its traceless anti-hermitian part,
+     A -> (A - A^dagger)/2 - Tr(A - A^dagger)/6, as makeAntiHerm
+   */
+  template <typename Float, int W>
+  inline void makeAntiHerm(MatrixSoA<Float,W> &A)
+  {
+#pragma omp simd
+    for (int w=0; w<W; w++) {
+      const Float tr = (A.im[0][w] + A.im[4][w] + A.im[8][w]) / static_cast<Float>(3.0);
+      for (int i=0; i<3; i++) {
+	for (int j=i+1; j<3; j++) {
+	  const Float re = static_cast<Float>(0.5)*(A.re[i*3+j][w] - A.re[j*3+i][w]);
+	  const Float im = static_cast<Float>(0.5)*(A.im[i*3+j][w] + A.im[j*3+i][w]);
+	  A.re[i*3+j][w] = re;  A.im[i*3+j][w] = im;
+	  A.re[j*3+i][w] = -re; A.im[j*3+i][w] = im;
+	}
+	A.re[i*4][w] = 0.0;
+	A.im[i*4][w] -= tr;
+      }
+    }
+  }
+
+  /**
+     @brief E = exp(A) for traceless anti-hermitian A.  With A = iQ
+     this is the Cayley-Hamilton form exp(iQ) = f0 + f1 Q + f2 Q^2 of
+     Morningstar and Peardon (hep-lat/0311018), as exponentiate_iQ.
+     For small Q, where their f_j lose precision to cancellation, the
+     f_j are instead summed from the power series, folded back onto
+     {1, Q, Q^2} with Q^3 = c1 Q + c0.
+   */
+  template <typename Float, int W>
+  inline void exponentiate(MatrixSoA<Float,W> &E, const MatrixSoA<Float,W> &A)
+  {
+    MatrixSoA<Float,W> Q, Q2;
+    for (int i=0; i<9; i++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) { Q.re[i][w] = A.im[i][w]; Q.im[i][w] = -A.re[i][w]; }
+    }
+    mulNN(Q2, Q, Q);
+
+    Float f0r[W], f0i[W], f1r[W], f1i[W], f2r[W], f2i[W];
+#pragma omp simd
+    for (int w=0; w<W; w++) {
+      // c0 = det Q = Tr(Q^3)/3, c1 = Tr(Q^2)/2
+      Float c0 = 0.0;
+      for (int i=0; i<3; i++)
+	for (int j=0; j<3; j++) c0 += Q2.re[i*3+j][w]*Q.re[j*3+i][w] - Q2.im[i*3+j][w]*Q.im[j*3+i][w];
+      c0 /= static_cast<Float>(3.0);
+      const Float c1 = static_cast<Float>(0.5)*(Q2.re[0][w] + Q2.re[4][w] + Q2.re[8][w]);
+
+      if (c1 < static_cast<Float>(0.1)) {
+	// exp(iQ) = sum_n (iQ)^n/n!, with Q^n = a0 + a1 Q + a2 Q^2
+	Float a0 = 0.0, a1 = 0.0, a2 = 1.0; // Q^2
+	Float s0r = 1.0, s1i = 1.0, s2r = -0.5, s0i = 0.0, s1r = 0.0, s2i = 0.0;
+	Float fact = 0.5;
+	for (int n=3; n<=18; n++) {
+	  const Float b0 = a2*c0, b1 = a0 + a2*c1, b2 = a1;
+	  a0 = b0; a1 = b1; a2 = b2;
+	  fact /= n;
+	  // i^n cycles through 1, i, -1, -i
+	  const Float cr = (n % 4 == 0) ? fact : (n % 4 == 2) ? -fact : 0.0;
+	  const Float ci = (n % 4 == 1) ? fact : (n % 4 == 3) ? -fact : 0.0;
+	  s0r += cr*a0; s0i += ci*a0;
+	  s1r += cr*a1; s1i += ci*a1;
+	  s2r += cr*a2; s2i += ci*a2;
+	}
+	f0r[w] = s0r; f0i[w] = s0i; f1r[w] = s1r; f1i[w] = s1i; f2r[w] = s2r; f2i[w] = s2i;
+      } else {
+	const Float c0_abs = std::fabs(c0);
+	const Float c0_max = 2*std::pow(c1/static_cast<Float>(3.0), static_cast<Float>(1.5));
+	const Float ratio = c0_abs/c0_max;
+	const Float theta = std::acos(ratio < 1 ? ratio : static_cast<Float>(1.0));
+	const Float u = std::sqrt(c1/static_cast<Float>(3.0))*std::cos(theta/static_cast<Float>(3.0));
+	const Float v = std::sqrt(c1)*std::sin(theta/static_cast<Float>(3.0));
+	const Float u2 = u*u, v2 = v*v;
+	const Float denom_inv = 1/(9*u2 - v2);
+	const Float eu_r = std::cos(u), eu_i = std::sin(u);
+	const Float e2u_r = eu_r*eu_r - eu_i*eu_i, e2u_i = 2*eu_r*eu_i;
+	const Float cos_v = std::cos(v);
+	const Float sinc_v = std::fabs(v) < static_cast<Float>(0.05) ?
+	  1 - (v2/6)*(1 - (v2/20)*(1 - (v2/42)*(1 - (v2/72)))) : std::sin(v)/v;
+
+	f0r[w] = ((u2 - v2)*e2u_r + 8*u2*cos_v*eu_r + 2*u*(3*u2 + v2)*sinc_v*eu_i) * denom_inv;
+	f0i[w] = ((u2 - v2)*e2u_i - 8*u2*cos_v*eu_i + 2*u*(3*u2 + v2)*sinc_v*eu_r) * denom_inv;
+	f1r[w] = (2*u*e2u_r - 2*u*cos_v*eu_r + (3*u2 - v2)*sinc_v*eu_i) * denom_inv;
+	f1i[w] = (2*u*e2u_i + 2*u*cos_v*eu_i + (3*u2 - v2)*sinc_v*eu_r) * denom_inv;
+	f2r[w] = (e2u_r - cos_v*eu_r - 3*u*sinc_v*eu_i) * denom_inv;
+	f2i[w] = (e2u_i + cos_v*eu_i - 3*u*sinc_v*eu_r) * denom_inv;
+
+	// f_j(-c0) = (-1)^j f_j(c0)^*
+	if (c0 < 0) { f0i[w] = -f0i[w]; f1r[w] = -f1r[w]; f2i[w] = -f2i[w]; }
+      }
+    }
+
+    for (int i=0; i<9; i++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) {
+	E.re[i][w] = f1r[w]*Q.re[i][w] - f1i[w]*Q.im[i][w] + f2r[w]*Q2.re[i][w] - f2i[w]*Q2.im[i][w]
+	  + (i % 4 == 0 ? f0r[w] : 0.0);
+	E.im[i][w] = f1r[w]*Q.im[i][w] + f1i[w]*Q.re[i][w] + f2r[w]*Q2.im[i][w] + f2i[w]*Q2.re[i][w]
+	  + (i % 4 == 0 ? f0i[w] : 0.0);
+      }
+    }
+  }
+
+  /**
+     @brief Unitarize each lane, U = V (V^dagger V)^{-1/2}, with the
+     Cayley-Hamilton reciprocal square root used for the HISQ
+     reunitarization.  Lanes where the eigenvalues of V^dagger V are
+     not trustworthy are flagged for an SVD fallback.
+     @param U The unitarized pack
+     @param ok Whether each lane passed the eigenvalue checks
+     @param V The pack to unitarize
+     @param eps Eigenvalue degeneracy threshold (unitarize_eps)
+     @param abs_error Smallest accepted |det V^dagger V| (svd_abs_error)
+     @param rel_error Largest accepted relative error of the
+     eigenvalue product against the determinant (svd_rel_error)
+   */
+  template <typename Float, int W>
+  inline void unitarize(MatrixSoA<Float,W> &U, bool ok[W], const MatrixSoA<Float,W> &V,
+			double eps, double abs_error, double rel_error)
+  {
+    const Float one_third = 0.333333333333333333333;
+    const Float one_ninth = 0.111111111111111111111;
+    const Float one_eighteenth = 0.055555555555555555555;
+    const Float pi = 3.14159265358979323846;
+    const Float pi23 = pi*0.66666666666666666666;
+
+    MatrixSoA<Float,W> Q, S;
+    mulAN(Q, V, V);
+    mulNN(S, Q, Q);
+
+    Float f0[W], f1[W], f2[W];
+#pragma omp simd
+    for (int w=0; w<W; w++) {
+      const Float c0 = Q.re[0][w] + Q.re[4][w] + Q.re[8][w];
+      const Float c1 = static_cast<Float>(0.5)*(S.re[0][w] + S.re[4][w] + S.re[8][w]);
+      Float c2 = 0.0;
+      for (int i=0; i<3; i++)
+	for (int j=0; j<3; j++) c2 += S.re[i*3+j][w]*Q.re[j*3+i][w] - S.im[i*3+j][w]*Q.im[j*3+i][w];
+      c2 *= one_third;
+
+      Float g0 = c0*one_third, g1 = g0, g2 = g0;
+      const Float s = c1*one_third - c0*c0*one_eighteenth;
+      if (std::fabs(s) >= eps) {
+	const Float sqrt_s = std::sqrt(s);
+	const Float r = c2*static_cast<Float>(0.5) - (c0*one_third)*(c1 - c0*c0*one_ninth);
+	const Float cosTheta = r/(s*sqrt_s);
+	const Float theta = std::fabs(cosTheta) >= 1 ? ((r > 0) ? static_cast<Float>(0.0) : pi) : std::acos(cosTheta);
+	g0 = c0*one_third + 2*sqrt_s*std::cos( theta*one_third );
+	g1 = c0*one_third + 2*sqrt_s*std::cos( theta*one_third + pi23 );
+	g2 = c0*one_third + 2*sqrt_s*std::cos( theta*one_third + 2*pi23 );
+      }
+
+      // Q is hermitian so its determinant is real
+      const Float det = Q.re[0][w]*Q.re[4][w]*Q.re[8][w]
+	+ 2*(Q.re[1][w]*(Q.re[5][w]*Q.re[6][w] - Q.im[5][w]*Q.im[6][w]) - Q.im[1][w]*(Q.re[5][w]*Q.im[6][w] + Q.im[5][w]*Q.re[6][w]))
+	- Q.re[0][w]*(Q.re[5][w]*Q.re[5][w] + Q.im[5][w]*Q.im[5][w])
+	- Q.re[4][w]*(Q.re[2][w]*Q.re[2][w] + Q.im[2][w]*Q.im[2][w])
+	- Q.re[8][w]*(Q.re[1][w]*Q.re[1][w] + Q.im[1][w]*Q.im[1][w]);
+      ok[w] = std::fabs(det) >= abs_error && std::fabs((g0*g1*g2 - det)/det) < rel_error;
+
+      const Float r0 = std::sqrt(g0), r1 = std::sqrt(g1), r2 = std::sqrt(g2);
+      const Float u = r0 + r1 + r2;
+      const Float v = r0*r1 + r0*r2 + r1*r2;
+      const Float t = r0*r1*r2;
+      const Float denominator = 1 / ( t*(u*v - t) );
+      f0[w] = (u*v*v - t*(u*u + v)) * denominator;
+      f1[w] = (-u*u*u - t + 2*u*v) * denominator;
+      f2[w] = u * denominator;
+    }
+
+    // S = (V^dagger V)^{-1/2} = f0 + f1 Q + f2 Q^2
+    for (int i=0; i<9; i++) {
+#pragma omp simd
+      for (int w=0; w<W; w++) {
+	S.re[i][w] = f1[w]*Q.re[i][w] + f2[w]*S.re[i][w] + (i % 4 == 0 ? f0[w] : 0.0);
+	S.im[i][w] = f1[w]*Q.im[i][w] + f2[w]*S.im[i][w];
+      }
+    }
+
+    mulNN(U, V, S);
+  }
+
+  /**
+     @brief Remove a third of the phase (and the modulus) of the
+     determinant from each lane, projecting a unitary matrix onto SU(3)
+   */
+  template <typename Float, int W>
+  inline void removeDeterminantPhase(MatrixSoA<Float,W> &U)
+  {
+    Float dr[W], di[W];
+    determinant(dr, di, U);
+#pragma omp simd
+    for (int w=0; w<W; w++) {
+      const Float mod = std::pow(dr[w]*dr[w] + di[w]*di[w], static_cast<Float>(-1.0/6.0));
+      const Float angle = -std::atan2(di[w], dr[w])/static_cast<Float>(3.0);
+      const Float pr = mod*std::cos(angle), pi = mod*std::sin(angle);
+      for (int i=0; i<9; i++) {
+	const Float re = U.re[i][w]*pr - U.im[i][w]*pi;
+	U.im[i][w] = U.re[i][w]*pi + U.im[i][w]*pr;
+	U.re[i][w] = re;
+      }
+    }
+  }
+
+  /**
+     @brief Largest deviation of U^dagger U from the identity, per lane
+   */
+  template <typename Float, int W>
+  inline void unitarityError(Float err[W], const MatrixSoA<Float,W> &U)
+  {
+#pragma omp simd
+    for (int w=0; w<W; w++) {
+      Float e = 0.0;
+      for (int i=0; i<3; i++) {
+	for (int j=0; j<3; j++) {
+	  Float re = (i == j) ? -1.0 : 0.0, im = 0.0;
+	  for (int k=0; k<3; k++) {
+	    re += U.re[k*3+i][w]*U.re[k*3+j][w] + U.im[k*3+i][w]*U.im[k*3+j][w];
+	    im += U.re[k*3+i][w]*U.im[k*3+j][w] - U.im[k*3+i][w]*U.re[k*3+j][w];
+	  }
+	  e = std::fmax(e, std::fmax(std::fabs(re), std::fabs(im)));
+	}
+      }
+      err[w] = e;
+    }
+  }
+
+} // namespace quda
+
+#endif // _QUDA_MATRIX_SOA_H_
@@ -20,23 +20,22 @@ namespace quda {
 
 
   template<typename InOrder, typename FloatIn>
-  __device__ __host__ void genGauss(InOrder& inOrder, cuRNGState& localState, int x, int s, int c){
+  __device__ __host__ void genGauss(InOrder& inOrder, PhiloxState& localState, int x, int s, int c){
       FloatIn phi = 2.0*M_PI*Random<FloatIn>(localState);
       FloatIn radius = Random<FloatIn>(localState);
       radius = sqrt(-1.0 * log(radius));
       inOrder(0, x, s, c) = complex<FloatIn>(radius*cos(phi),radius*sin(phi));
   }
 
-  /** CPU function to reorder spinor fields.  */
+  /** CPU function to generate the random spinor field.  Each site draws from its own stream, so the result matches the GPU. */
   template <typename FloatIn, int Ns, int Nc, typename InOrder>
-    void gaussSpinor(InOrder &inOrder, int volume, RNG rngstate) {
+    void gaussSpinor(InOrder &inOrder, int volume, const RNG &rngstate) {
+#pragma omp parallel for
     for (int x=0; x<volume; x++) {
+      PhiloxState localState = rngstate.State(x);
       for (int s=0; s<Ns; s++) {
 	for (int c=0; c<Nc; c++) {
-	    //inOrder(0, x, s, c) = complex<FloatIn>(0,0);
-	    cuRNGState localState = rngstate.State()[x];
 	    genGauss<InOrder, FloatIn>(inOrder, localState, x, s, c);
-	    rngstate.State()[x] = localState;
 	}
       }
     }
@@ -48,13 +47,12 @@ namespace quda {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
     if (x >= volume) return;
 
-    cuRNGState localState = rngstate.State()[x];
+    PhiloxState localState = rngstate.State(x);
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	  genGauss<InOrder, FloatIn>(inOrder, localState, x, s, c);
       }
     }
-    rngstate.State()[x] = localState;
   }
 
   template <typename FloatIn, int Ns, int Nc, typename InOrder>
@@ -90,19 +88,14 @@ namespace quda {
 
     long long flops() const { return 0; }
     long long bytes() const { return in.Bytes(); }
-
-    void preTune(){
-	rngstate.backup();
-    }
-    void postTune(){
-	rngstate.restore();
-    }
   };
 
   template <typename FloatIn, int Ns, int Nc, typename InOrder>
     void gaussSpinor(InOrder &inOrder, const ColorSpinorField &meta, RNG &rngstate) {
     GaussSpinor<FloatIn, Ns, Nc, InOrder> gauss(inOrder, meta, rngstate);
     gauss.apply(0);
+    // launches during tuning regenerate the same field, so the counter is only advanced here
+    rngstate.advance();
   }
 
   /** Decide on the input order*/
@@ -148,7 +141,11 @@ namespace quda {
 
   void spinorGauss(ColorSpinorField &src, int seed)
   {
-      RNG* randstates = new RNG(src.VolumeCB(), seed, src.X());
+      // the generator needs the dimensions of the full lattice
+      int X[4];
+      for (int d=0; d<4; d++) X[d] = src.X(d);
+      if (src.SiteSubset() == QUDA_PARITY_SITE_SUBSET) X[0] *= 2;
+      RNG* randstates = new RNG(src.VolumeCB(), seed, X);
       randstates->Init();
       spinorGauss(src, *randstates);
       randstates->Release();
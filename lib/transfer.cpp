@@ -152,6 +152,19 @@ namespace quda {
     if (geo_bs) delete []geo_bs;
   }
 
+  void Transfer::reset() {
+    printfQuda("Transfer: resetting null-space components\n");
+    fillV(*V_h);
+    BlockOrthogonalize(*V_h, Nvec, geo_bs, fine_to_coarse_h, spin_bs);
+
+    // the device copy may be single parity, so respect the current site subset
+    if (enable_gpu) {
+      if (site_subset == QUDA_PARITY_SITE_SUBSET) *V_d = parity == QUDA_EVEN_PARITY ? V_h->Even() : V_h->Odd();
+      else *V_d = *V_h;
+      printfQuda("Transferred prolongator to GPU\n");
+    }
+  }
+
   void Transfer::setSiteSubset(QudaSiteSubset site_subset_, QudaParity parity_) {
     if (parity_ != QUDA_EVEN_PARITY && parity_ != QUDA_ODD_PARITY) errorQuda("Undefined parity %d", parity_);
     parity = parity_;
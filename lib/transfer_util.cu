@@ -26,6 +26,7 @@ namespace quda {
   void FillVCPU(Arg &arg, int v) {
 
     for (int parity=0; parity<arg.V.Nparity(); parity++) {
+#pragma omp parallel for
       for (int x_cb=0; x_cb<arg.V.VolumeCB(); x_cb++) {
 	for (int s=0; s<nSpin; s++) {
 	  for (int c=0; c<nColor; c++) {
@@ -193,17 +194,17 @@ namespace quda {
     for (int d=0; d<in.Ndim(); d++) geoBlockSize *= geo_bs[d];
     int blockSize = geoBlockSize * in.Ncolor() * spin_bs; // blockSize includes internal dof
 
-    int x[QUDA_MAX_DIM]; // global coordinates
-    int y[QUDA_MAX_DIM]; // local coordinates within a block (full site ordering)
-
     int checkLength = in.Nparity() * in.VolumeCB() * in.Ncolor() * in.Nspin() * in.Nvec();
-    int *check = new int[checkLength];
     int count = 0;
 
-    // Run through the fine grid and do the block ordering
-    for (int parity = 0; parity<in.Nparity(); parity++) {
-      for (int x_cb=0; x_cb<in.VolumeCB(); x_cb++) {
-	int i = parity*in.VolumeCB() + x_cb;
+    // Run through the fine grid and do the block ordering (each fine site maps to a unique set of block indices)
+#pragma omp parallel for reduction(+:count)
+    for (int i=0; i<in.Nparity()*in.VolumeCB(); i++) {
+      int parity = i / in.VolumeCB();
+      int x_cb = i - parity*in.VolumeCB();
+      {
+	int x[QUDA_MAX_DIM]; // global coordinates
+	int y[QUDA_MAX_DIM]; // local coordinates within a block (full site ordering)
 
 	// Get fine grid coordinates
 	V.LatticeIndex(x, i);
@@ -237,29 +238,17 @@ namespace quda {
 	      if (toBlock) out[index] = in(parity, x_cb, s, c, v); // going to block order
 	      else in(parity, x_cb, s, c, v) = out[index]; // coming from block order
 	    
-	      check[count++] = index;
+	      count++;
 	    }
 	  }
 	}
       }
-
-      //printf("blockOrderV done %d / %d\n", i, in.Volume());
     }
     
     if (count != checkLength) {
       errorQuda("Number of elements packed %d does not match expected value %d nvec=%d nspin=%d ncolor=%d", 
 		count, checkLength, in.Nvec(), in.Nspin(), in.Ncolor());
     }
-
-    /*
-    // need non-quadratic check
-    for (int i=0; i<checkLength; i++) {
-      for (int j=0; j<i; j++) {
-      if (check[i] == check[j]) errorQuda("Collision detected in block ordering\n");
-      }
-    }
-    */
-    delete []check;
   }
 
 
@@ -274,17 +263,17 @@ namespace quda {
     for (int d=0; d<in.Ndim(); d++) geoBlockSize *= geo_bs[d];
     int blockSize = geoBlockSize * in.Ncolor(); // blockSize includes internal dof
 
-    int x[QUDA_MAX_DIM]; // global coordinates
-    int y[QUDA_MAX_DIM]; // local coordinates within a block (full site ordering)
-
     int checkLength = in.Nparity() * in.VolumeCB() * in.Ncolor() * in.Nvec();
-    int *check = new int[checkLength];
     int count = 0;
 
     // Run through the fine grid and do the block ordering
-    for (int parity = 0; parity<in.Nparity(); parity++) {
-      for (int x_cb=0; x_cb<in.VolumeCB(); x_cb++) {
-	int i = parity*in.VolumeCB() + x_cb;
+#pragma omp parallel for reduction(+:count)
+    for (int i=0; i<in.Nparity()*in.VolumeCB(); i++) {
+      int parity = i / in.VolumeCB();
+      int x_cb = i - parity*in.VolumeCB();
+      {
+	int x[QUDA_MAX_DIM]; // global coordinates
+	int y[QUDA_MAX_DIM]; // local coordinates within a block (full site ordering)
 
 	// Get fine grid coordinates
 	V.LatticeIndex(x, i);
@@ -318,20 +307,16 @@ namespace quda {
 	    if (toBlock) out[index] = in(parity, x_cb, s, c, v); // going to block order
 	    else in(parity, x_cb, s, c, v) = out[index]; // coming from block order
 
-	    check[count++] = index;
+	    count++;
 	  }
 	}
-
-	//printf("blockOrderV done %d / %d\n", i, in.Volume());
-      } // x_cb
-    } // parity
+      }
+    } // parity * x_cb
 
     if (count != checkLength) {
       errorQuda("Number of elements packed %d does not match expected value %d nvec=%d ncolor=%d", 
 		count, checkLength, in.Nvec(), in.Ncolor());
     }
-
-    delete []check;
   }
 
 
@@ -339,10 +324,12 @@ namespace quda {
 
   // Orthogonalise the nc vectors v[] of length n
   // this assumes the ordering v[(b * Nvec + v) * blocksize + i]
+  // so each aggregate's vectors are contiguous and the blocks are distributed across threads
 
   template <typename sumFloat, typename Float, int N>
   void blockGramSchmidt(complex<Float> *v, int nBlocks, int blockSize) {
     
+#pragma omp parallel for
     for (int b=0; b<nBlocks; b++) {
       for (int jc=0; jc<N; jc++) {
       
@@ -560,7 +547,8 @@ namespace quda {
       int numblocks = (V.Volume()/geo_blocksize) * chiralBlocks;
       if (V.Nspin() == 1) blocksize /= chiralBlocks; //for staggered chiral block size is a parity block size
     
-      printfQuda("Block Orthogonalizing %d blocks of %d length and width %d\n", numblocks, blocksize, nVec);
+      if (getVerbosity() >= QUDA_VERBOSE)
+	printfQuda("Block Orthogonalizing %d blocks of %d length and width %d\n", numblocks, blocksize, nVec);
 
 #if 0
       BlockOrthoArg<> arg(V);
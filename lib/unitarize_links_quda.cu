@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <cstdio>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <cuda.h>
@@ -8,6 +9,7 @@
 
 #include <tune_quda.h>
 #include <quda_matrix.h>
+#include <quda_matrix_soa.h>
 #include <unitarization_links.h>
 
 #include <su3_project.cuh>
@@ -15,12 +17,149 @@
 
 
 namespace quda{
-#ifdef GPU_UNITARIZE
 
 namespace{
   #include <svd_quda.h>
 }
 
+  // number of links unitarized together by the host code, which is
+  // built without GPU_UNITARIZE since it needs no device code
+  constexpr int unitarize_host_batch = host_simd_width;
+
+  /**
+     Parameters of the host unitarization engine.  Reunitarization
+     uses the constants set by setUnitarizeLinksConstants, while SU(3)
+     projection always allows the SVD fallback and additionally
+     removes the phase of the determinant (special = true).
+   */
+  struct UnitarizeHostParam {
+    double unitarize_eps;
+    double max_error;
+    double svd_rel_error;
+    double svd_abs_error;
+    bool allow_svd;
+    bool svd_only;
+    bool special;
+  };
+
+  /**
+     SVD unitarization of a single link, used for the links that the
+     batched Cayley-Hamilton step rejects.  This is kept out of line
+     since it is rarely taken and would otherwise bloat the batch loop.
+     @param out The unitarized link U = u v^dagger
+     @param in The link to unitarize
+     @param allow_svd Whether the SVD fallback is allowed
+     @return Whether the link was unitarized
+   */
+  static __noinline__ bool unitarizeLinkSVDHost(Matrix<complex<double>,3> &out, const Matrix<complex<double>,3> &in,
+						bool allow_svd)
+  {
+    if (!allow_svd) return false;
+    Matrix<complex<double>,3> u, v;
+    double singular_values[3];
+    computeSVD<double>(in, u, v, singular_values);
+    out = u*conj(v);
+    return true;
+  }
+
+  /**
+     Host unitarization of unitarize_host_batch consecutive links of
+     one direction and parity.  This is the same Cayley-Hamilton
+     reciprocal square root as reciprocalRoot, computed in double on
+     a structure-of-arrays pack (quda_matrix_soa.h) so that every step
+     vectorizes across the links.  Links failing the eigenvalue checks
+     are handed to the out-of-line SVD.  Lanes beyond the end of the
+     checkerboard are padded with the identity and discarded.
+     @return The number of links that failed the unitarity check
+   */
+  template <typename Float, typename G>
+  int unitarizeBatchHost(G &out, const G &in, int x0, int dir, int parity, int volumeCB,
+			 const UnitarizeHostParam &param)
+  {
+    constexpr int W = unitarize_host_batch;
+    const int n = std::min(W, volumeCB - x0);
+
+    MatrixSoA<double,W> V, U;
+    for (int w=0; w<W; w++) {
+      if (w < n) {
+	Float v[18];
+	in.load(v, x0+w, dir, parity);
+	V.insert(v, w);
+      } else {
+	V.identity(w);
+      }
+    }
+
+    bool ok[W];
+    unitarize(U, ok, V, param.unitarize_eps, param.svd_abs_error, param.svd_rel_error);
+
+    // rejected links go through the SVD; if that is not allowed the
+    // Cayley-Hamilton result is kept and fails the unitarity check
+    for (int w=0; w<n; w++) {
+      if (ok[w] && !param.svd_only) continue;
+      Matrix<complex<double>,3> Vw, Uw;
+      V.extract((double*)Vw.data, w);
+      if (unitarizeLinkSVDHost(Uw, Vw, param.allow_svd)) U.insert((double*)Uw.data, w);
+    }
+
+    if (param.special) removeDeterminantPhase(U);
+
+    double err[W];
+    unitarityError(err, U);
+
+    int fails = 0;
+    for (int w=0; w<n; w++) {
+      Float v[18];
+      U.extract(v, w);
+      out.save(v, x0+w, dir, parity);
+      if ( !(err[w] <= param.max_error) ) fails++; // also catches nan
+    }
+
+    return fails;
+  }
+
+  /**
+     Threaded host unitarization, in batches of unitarize_host_batch
+     links of the same direction and parity.  The whole batch is read
+     before any of it is written, so in and out may alias.
+   */
+  template <typename Float, typename G>
+  int unitarizeLinksHost(G out, const G in, int volumeCB, const UnitarizeHostParam &param)
+  {
+    const int nBlock = (volumeCB + unitarize_host_batch - 1) / unitarize_host_batch;
+    int fails = 0;
+
+#pragma omp parallel for reduction(+:fails)
+    for (int i=0; i<2*4*nBlock; i++) {
+      const int parity = i / (4*nBlock);
+      const int dir = (i / nBlock) % 4;
+      const int b = i % nBlock;
+      fails += unitarizeBatchHost<Float>(out, in, b*unitarize_host_batch, dir, parity, volumeCB, param);
+    }
+
+    return fails;
+  }
+
+  template <typename Float>
+  int unitarizeLinksHost(cpuGaugeField &out, const cpuGaugeField &in, const UnitarizeHostParam &param)
+  {
+    if (in.Order() != out.Order())
+      errorQuda("Orders must match (out=%d != in=%d)", out.Order(), in.Order());
+
+    if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
+      typedef gauge::MILCOrder<Float,18> G;
+      return unitarizeLinksHost<Float>(G(out), G(in), in.VolumeCB(), param);
+    } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
+      typedef gauge::QDPOrder<Float,18> G;
+      return unitarizeLinksHost<Float>(G(out), G(in), in.VolumeCB(), param);
+    } else {
+      errorQuda("Gauge field order %d not supported", in.Order());
+    }
+    return 0;
+  }
+
+#ifdef GPU_UNITARIZE
+
 #ifndef FL_UNITARIZE_PI
 #define FL_UNITARIZE_PI 3.14159265358979323846
 #endif
@@ -28,7 +167,6 @@ namespace{
 #define FL_UNITARIZE_PI23 FL_UNITARIZE_PI*0.66666666666666666666
 #endif 
  
-  static const int max_iter_newton = 20;
   static const int max_iter = 20;
 
   static double unitarize_eps = 1e-14;
@@ -267,50 +405,23 @@ namespace{
   }
 
 
-  template<class Float>
-  __host__ __device__
-  bool unitarizeLinkNewton(const Matrix<complex<Float>,3>& in, Matrix<complex<Float>,3>* const result, int max_iter)
-  {
-    Matrix<complex<Float>,3> u, uinv;
-    u = in;
-
-    for(int i=0; i<max_iter; ++i){
-      computeMatrixInverse(u, &uinv);
-      u = 0.5*(u + conj(uinv));
-    }
-
-    if(isUnitarizedLinkConsistent(in,u,0.0000001)==false)
-      {
-        printf("ERROR: Unitarized link is not consistent with incoming link\n");
-	return false;
-      }
-    *result = u;
-
-    return true;
-  }   
-
-  void unitarizeLinksCPU(cpuGaugeField &outfield, const cpuGaugeField& infield)
+  int unitarizeLinksCPU(cpuGaugeField &outfield, const cpuGaugeField& infield)
   {
     if (infield.Precision() != outfield.Precision())
       errorQuda("Precisions must match (out=%d != in=%d)", outfield.Precision(), infield.Precision());
-    
+
+    const UnitarizeHostParam param = { unitarize_eps, max_error, svd_rel_error, svd_abs_error,
+				       reunit_allow_svd != 0, reunit_svd_only != 0, false };
+
     int num_failures = 0;
-    Matrix<complex<double>,3> inlink, outlink;
-      
-    for (int i=0; i<infield.Volume(); ++i){
-      for (int dir=0; dir<4; ++dir){
-	if (infield.Precision() == QUDA_SINGLE_PRECISION){
-	  copyArrayToLink(&inlink, ((float*)(infield.Gauge_p()) + (i*4 + dir)*18)); // order of arguments?
-	  if( unitarizeLinkNewton<double>(inlink, &outlink, max_iter_newton) == false ) num_failures++;
-	  copyLinkToArray(((float*)(outfield.Gauge_p()) + (i*4 + dir)*18), outlink); 
-	} else if (infield.Precision() == QUDA_DOUBLE_PRECISION){
-	  copyArrayToLink(&inlink, ((double*)(infield.Gauge_p()) + (i*4 + dir)*18)); // order of arguments?
-	  if( unitarizeLinkNewton<double>(inlink, &outlink, max_iter_newton) == false ) num_failures++;
-	  copyLinkToArray(((double*)(outfield.Gauge_p()) + (i*4 + dir)*18), outlink); 
-	} // precision?
-      } // dir
-    }  // loop over volume
-    return;
+    if (infield.Precision() == QUDA_SINGLE_PRECISION) {
+      num_failures = unitarizeLinksHost<float>(outfield, infield, param);
+    } else if (infield.Precision() == QUDA_DOUBLE_PRECISION) {
+      num_failures = unitarizeLinksHost<double>(outfield, infield, param);
+    } else {
+      errorQuda("Precision %d not supported", infield.Precision());
+    }
+    return num_failures;
   }
     
   // CPU function which checks that the gauge field is unitary
@@ -612,5 +723,23 @@ void unitarizeLinks(cudaGaugeField& output, const cudaGaugeField &input, int* fa
 #endif
   }
 
+  void projectSU3(cpuGaugeField &u, double tol, int *fails) {
+    // check the the field doesn't have staggered phases applied
+    if (u.StaggeredPhaseApplied())
+      errorQuda("Cannot project gauge field with staggered phases applied");
+
+    // the projected links are close to unitary, so the eigenvalue
+    // checks are tight and the SVD is always available as a fallback
+    const UnitarizeHostParam param = { 1e-14, tol, 1e-6, 1e-6, true, false, true };
+
+    if (u.Precision() == QUDA_DOUBLE_PRECISION) {
+      *fails += unitarizeLinksHost<double>(u, u, param);
+    } else if (u.Precision() == QUDA_SINGLE_PRECISION) {
+      *fails += unitarizeLinksHost<float>(u, u, param);
+    } else {
+      errorQuda("Precision %d not supported", u.Precision());
+    }
+  }
+
 } // namespace quda
 
@@ -0,0 +1,373 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <util_quda.h>
+#include <test_util.h>
+#include "misc.h"
+
+#include <qio_field.h>
+
+// google test frame work
+#include <gtest.h>
+
+#define MAX(a,b) ((a)>(b)?(a):(b))
+
+// In a typical application, quda.h is the only QUDA header required.
+#include <quda.h>
+
+// internal headers used by the reference contractions
+#include <quda_internal.h>
+#include <comm_quda.h>
+
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern QudaPrecision prec;
+extern QudaReconstructType link_recon;
+extern double anisotropy;
+extern char latfile[];
+
+extern void usage(char** );
+
+QudaGaugeParam gauge_param;
+QudaInvertParam inv_param;
+void *gauge[4];
+
+// four-dimensional Wilson-type propagators in the DeGrand-Rossi basis,
+// as the host contractions expect
+void setContractParam(QudaGaugeParam &gauge_param, QudaInvertParam &inv_param)
+{
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+
+  gauge_param.anisotropy = anisotropy;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = prec;
+  gauge_param.reconstruct = link_recon;
+  gauge_param.cuda_prec_sloppy = prec;
+  gauge_param.reconstruct_sloppy = link_recon;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+  gauge_param.ga_pad = 0;
+
+  // For multi-GPU, ga_pad must be large enough to store a time-slice
+#ifdef MULTI_GPU
+  int x_face_size = gauge_param.X[1]*gauge_param.X[2]*gauge_param.X[3]/2;
+  int y_face_size = gauge_param.X[0]*gauge_param.X[2]*gauge_param.X[3]/2;
+  int z_face_size = gauge_param.X[0]*gauge_param.X[1]*gauge_param.X[3]/2;
+  int t_face_size = gauge_param.X[0]*gauge_param.X[1]*gauge_param.X[2]/2;
+  int pad_size =MAX(x_face_size, y_face_size);
+  pad_size = MAX(pad_size, z_face_size);
+  pad_size = MAX(pad_size, t_face_size);
+  gauge_param.ga_pad = pad_size;
+#endif
+
+  inv_param.dslash_type = QUDA_WILSON_DSLASH;
+  inv_param.Ls = 1;
+  inv_param.solution_type = QUDA_MAT_SOLUTION;
+  inv_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec = prec;
+  inv_param.cuda_prec_sloppy = prec;
+  inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  inv_param.dirac_order = QUDA_DIRAC_ORDER;
+  inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.sp_pad = 0;
+  inv_param.verbosity = QUDA_SUMMARIZE;
+}
+
+static void *randomSpinor(size_t length)
+{
+  double *v = (double*)malloc(length*sizeof(double));
+  for (size_t i=0; i<length; i++) v[i] = rand() / (double)RAND_MAX;
+  return v;
+}
+
+/**
+   Dense reference gamma matrix g in the DeGrand-Rossi basis of the
+   host fields, gamma_1^{g&1} gamma_2^{(g>>1)&1} gamma_3^{(g>>2)&1}
+   gamma_4^{(g>>3)&1}, with g = 16 denoting gamma_5
+*/
+static void referenceGamma(quda::Complex G[4][4], int g)
+{
+  using quda::Complex;
+  const Complex I(0.0, 1.0);
+  Complex gamma[5][4][4];
+  for (int mu=0; mu<5; mu++) for (int i=0; i<4; i++) for (int j=0; j<4; j++) gamma[mu][i][j] = 0.0;
+  gamma[0][0][3] = I;    gamma[0][1][2] = I;   gamma[0][2][1] = -I;  gamma[0][3][0] = -I;
+  gamma[1][0][3] = -1.0; gamma[1][1][2] = 1.0; gamma[1][2][1] = 1.0; gamma[1][3][0] = -1.0;
+  gamma[2][0][2] = I;    gamma[2][1][3] = -I;  gamma[2][2][0] = -I;  gamma[2][3][1] = I;
+  gamma[3][0][2] = 1.0;  gamma[3][1][3] = 1.0; gamma[3][2][0] = 1.0; gamma[3][3][1] = 1.0;
+  gamma[4][0][0] = -1.0; gamma[4][1][1] = -1.0; gamma[4][2][2] = 1.0; gamma[4][3][3] = 1.0;
+
+  for (int i=0; i<4; i++) for (int j=0; j<4; j++) G[i][j] = (g == 16) ? gamma[4][i][j] : Complex(i == j ? 1.0 : 0.0);
+  if (g == 16) return;
+  for (int mu=0; mu<4; mu++) {
+    if (!((g >> mu) & 1)) continue;
+    Complex T[4][4];
+    for (int i=0; i<4; i++)
+      for (int j=0; j<4; j++) {
+	T[i][j] = 0.0;
+	for (int k=0; k<4; k++) T[i][j] += G[i][k] * gamma[mu][k][j];
+      }
+    for (int i=0; i<4; i++) for (int j=0; j<4; j++) G[i][j] = T[i][j];
+  }
+}
+
+// spin matrix G times the unit color matrix
+static void referenceSpinMatrix(quda::Complex M[12][12], const quda::Complex G[4][4])
+{
+  for (int i=0; i<12; i++)
+    for (int j=0; j<12; j++) M[i][j] = (i%3 == j%3) ? G[i/3][j/3] : quda::Complex(0.0);
+}
+
+static void referenceMatMul(quda::Complex C[12][12], const quda::Complex A[12][12], const quda::Complex B[12][12])
+{
+  for (int i=0; i<12; i++)
+    for (int j=0; j<12; j++) {
+      C[i][j] = 0.0;
+      for (int k=0; k<12; k++) C[i][j] += A[i][k] * B[k][j];
+    }
+}
+
+// the 12x12 propagator matrix of a site, S[(s c)][j] is component (s c) of column j
+static void referencePropagator(quda::Complex S[12][12], void **prop, int parity, int x_cb)
+{
+  for (int j=0; j<12; j++) {
+    const double *v = static_cast<const double*>(prop[j]) + (parity*Vh + x_cb)*spinorSiteSize;
+    for (int i=0; i<12; i++) S[i][j] = quda::Complex(v[2*i], v[2*i+1]);
+  }
+}
+
+static int levicivita(int a, int b, int c) { return (a-b)*(b-c)*(c-a)/2; }
+
+/**
+   Fourier phase exp(-i p.x) of local site x, with x in global coordinates
+*/
+static quda::Complex referencePhase(const int *p, const int x[4])
+{
+  const int X[3] = { xdim, ydim, zdim };
+  double arg = 0.0;
+  for (int d=0; d<3; d++) arg -= 2.0 * M_PI * p[d] * (x[d] + comm_coord(d)*X[d]) / (X[d]*comm_dim(d));
+  return quda::Complex(cos(arg), sin(arg));
+}
+
+static void siteCoords(int x[4], int i)
+{
+  x[0] = i % xdim;
+  x[1] = (i / xdim) % ydim;
+  x[2] = (i / (xdim*ydim)) % zdim;
+  x[3] = i / (xdim*ydim*zdim);
+}
+
+// largest deviation of two correlator sets relative to the largest reference element
+static double correlatorDeviation(const std::vector<double> &corr, const std::vector<double> &ref)
+{
+  double dev = 0.0, max = 0.0;
+  for (size_t i=0; i<ref.size(); i++) {
+    dev = std::max(dev, fabs(corr[i] - ref[i]));
+    max = std::max(max, fabs(ref[i]));
+  }
+  return dev / max;
+}
+
+TEST(contract, mesons) {
+  using quda::Complex;
+
+  const int n_snk = 4, n_src = 3, n_mom = 4;
+  const int gamma_snk[n_snk] = { 0, 1, 15, 16 };
+  const int gamma_src[n_src] = { 0, 8, 16 };
+  const int mom[3*n_mom] = { 0,0,0, 1,0,0, 0,-1,2, 1,1,1 };
+  const int Lt = tdim * comm_dim(3);
+
+  // twelve distinct random columns, the second propagator permutes them
+  void *prop1[12], *prop2[12];
+  for (int j=0; j<12; j++) prop1[j] = randomSpinor(V*spinorSiteSize);
+  for (int j=0; j<12; j++) prop2[j] = prop1[(j+5)%12];
+
+  std::vector<double> corr(2*n_snk*n_src*n_mom*Lt);
+  contractMesonsQuda(corr.data(), prop1, prop2, n_snk, gamma_snk, n_src, gamma_src, n_mom, mom, &inv_param);
+
+  // naive Tr[G_snk S1 G_src gamma_5 S2^dagger gamma_5] at each site
+  Complex G[4][4], g5[12][12], snk[n_snk][12][12], src[n_src][12][12];
+  referenceGamma(G, 16);
+  referenceSpinMatrix(g5, G);
+  for (int i=0; i<n_snk; i++) { referenceGamma(G, gamma_snk[i]); referenceSpinMatrix(snk[i], G); }
+  for (int j=0; j<n_src; j++) { referenceGamma(G, gamma_src[j]); referenceSpinMatrix(src[j], G); }
+
+  std::vector<double> ref(corr.size(), 0.0);
+  for (int s=0; s<V; s++) {
+    int x[4];
+    siteCoords(x, s);
+    const int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+    Complex S1[12][12], S2[12][12], S2dag[12][12], T[12][12], B[12][12];
+    referencePropagator(S1, prop1, parity, s/2);
+    referencePropagator(S2, prop2, parity, s/2);
+    for (int a=0; a<12; a++) for (int b=0; b<12; b++) S2dag[a][b] = conj(S2[b][a]);
+    referenceMatMul(T, g5, S2dag);
+    referenceMatMul(B, T, g5);
+
+    Complex snkS1[n_snk][12][12], srcB[n_src][12][12];
+    for (int i=0; i<n_snk; i++) referenceMatMul(snkS1[i], snk[i], S1);
+    for (int j=0; j<n_src; j++) referenceMatMul(srcB[j], src[j], B);
+
+    for (int i=0; i<n_snk; i++) {
+      for (int j=0; j<n_src; j++) {
+	Complex tr = 0.0;
+	for (int a=0; a<12; a++) for (int b=0; b<12; b++) tr += snkS1[i][a][b] * srcB[j][b][a];
+	for (int p=0; p<n_mom; p++) {
+	  const Complex c = referencePhase(&mom[3*p], x) * tr;
+	  const size_t idx = ((size_t)((i*n_src + j)*n_mom + p))*Lt + x[3] + comm_coord(3)*tdim;
+	  ref[2*idx+0] += c.real();
+	  ref[2*idx+1] += c.imag();
+	}
+      }
+    }
+  }
+  comm_allreduce_array(ref.data(), ref.size());
+
+  double deviation = correlatorDeviation(corr, ref);
+  printfQuda("Meson contractions: relative deviation from the naive trace = %e\n", deviation);
+  EXPECT_LE(deviation, 1e-10) << "Batched meson contractions and reference do not agree";
+
+  for (int j=0; j<12; j++) free(prop1[j]);
+}
+
+TEST(contract, baryons) {
+  using quda::Complex;
+
+  const int n_mom = 3;
+  const int mom[3*n_mom] = { 0,0,0, 0,0,1, -1,2,0 };
+  const int Lt = tdim * comm_dim(3);
+
+  // twelve distinct random columns, the down propagator permutes them
+  void *prop_u[12], *prop_d[12];
+  for (int j=0; j<12; j++) prop_u[j] = randomSpinor(V*spinorSiteSize);
+  for (int j=0; j<12; j++) prop_d[j] = prop_u[(j+7)%12];
+
+  std::vector<double> corr(2*n_mom*Lt);
+  contractBaryonsQuda(corr.data(), prop_u, prop_d, n_mom, mom, &inv_param);
+
+  // Gamma = C gamma_5 with C = gamma_2 gamma_4, and P = (1 + gamma_4)/2
+  Complex g2[4][4], g4[4][4], g5[4][4], C[4][4], Gamma[4][4], P[4][4];
+  referenceGamma(g2, 2);
+  referenceGamma(g4, 8);
+  referenceGamma(g5, 16);
+  for (int i=0; i<4; i++)
+    for (int j=0; j<4; j++) {
+      C[i][j] = 0.0;
+      for (int k=0; k<4; k++) C[i][j] += g2[i][k] * g4[k][j];
+      P[i][j] = 0.5 * ((i == j ? 1.0 : 0.0) + g4[i][j]);
+    }
+  for (int i=0; i<4; i++)
+    for (int j=0; j<4; j++) {
+      Gamma[i][j] = 0.0;
+      for (int k=0; k<4; k++) Gamma[i][j] += C[i][k] * g5[k][j];
+    }
+
+  // naive epsilon contraction at each site
+  std::vector<double> ref(corr.size(), 0.0);
+  for (int s=0; s<V; s++) {
+    int x[4];
+    siteCoords(x, s);
+    const int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+    Complex U[12][12], D[12][12];
+    referencePropagator(U, prop_u, parity, s/2);
+    referencePropagator(D, prop_d, parity, s/2);
+
+    Complex c = 0.0;
+    for (int a=0; a<3; a++) for (int b=0; b<3; b++) for (int cc=0; cc<3; cc++) {
+      const int e = levicivita(a, b, cc);
+      if (e == 0) continue;
+      for (int a_=0; a_<3; a_++) for (int b_=0; b_<3; b_++) for (int c_=0; c_<3; c_++) {
+	const int e_ = levicivita(a_, b_, c_);
+	if (e_ == 0) continue;
+	for (int ga=0; ga<4; ga++) for (int de=0; de<4; de++) {
+	  if (Gamma[ga][de] == 0.0) continue;
+	  for (int de_=0; de_<4; de_++) for (int ga_=0; ga_<4; ga_++) {
+	    if (Gamma[de_][ga_] == 0.0) continue;
+	    const Complex w = (double)(e * e_) * Gamma[ga][de] * Gamma[de_][ga_] * D[de*3+b][de_*3+b_];
+	    for (int al=0; al<4; al++) for (int be=0; be<4; be++) {
+	      c += w * P[be][al] * (U[ga*3+a][ga_*3+a_] * U[al*3+cc][be*3+c_] - U[ga*3+a][be*3+c_] * U[al*3+cc][ga_*3+a_]);
+	    }
+	  }
+	}
+      }
+    }
+
+    for (int p=0; p<n_mom; p++) {
+      const Complex cp = referencePhase(&mom[3*p], x) * c;
+      const size_t idx = (size_t)p*Lt + x[3] + comm_coord(3)*tdim;
+      ref[2*idx+0] += cp.real();
+      ref[2*idx+1] += cp.imag();
+    }
+  }
+  comm_allreduce_array(ref.data(), ref.size());
+
+  double deviation = correlatorDeviation(corr, ref);
+  printfQuda("Baryon contractions: relative deviation from the naive epsilon contraction = %e\n", deviation);
+  EXPECT_LE(deviation, 1e-10) << "Batched baryon contractions and reference do not agree";
+
+  for (int j=0; j<12; j++) free(prop_u[j]);
+}
+
+int main(int argc, char **argv)
+{
+  // initalize google test, includes command line options
+  ::testing::InitGoogleTest(&argc, argv);
+  // return code for google test
+  int test_rc = 0;
+
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  // initialize QMP/MPI, QUDA comms grid and RNG (test_util.cpp)
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  gauge_param = newQudaGaugeParam();
+  inv_param = newQudaInvertParam();
+  setContractParam(gauge_param, inv_param);
+
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+
+  if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
+    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
+  } else { // else generate a random SU(3) field
+    construct_gauge_field(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  }
+
+  initQuda(device);
+  loadGaugeQuda((void*)gauge, &gauge_param);
+
+  test_rc = RUN_ALL_TESTS();
+
+  freeGaugeQuda();
+  endQuda();
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+
+  finalizeComms();
+
+  return test_rc;
+}
@@ -36,10 +36,12 @@ QudaPrecision cuda_prec;
 QudaGaugeParam gauge_param;
 QudaInvertParam inv_param;
 
-cpuColorSpinorField *spinor, *spinorOut, *spinorRef, *spinorTmp;
+cpuColorSpinorField *spinor, *spinorOut, *spinorRef, *spinorTmp, *spinorHost;
 cudaColorSpinorField *cudaSpinor, *cudaSpinorOut, *tmp1=0, *tmp2=0;
 
 void *hostGauge[4], *hostClover, *hostCloverInv;
+cpuGaugeField *cpuGauge = NULL; // host gauge field used by the host domain-wall operators
+bool hostTested = false; // whether the host operators were applied to this test
 
 Dirac *dirac = NULL;
 DiracMobiusPC *dirac_mdwf = NULL; // create the MDWF Dirac operator
@@ -299,6 +301,7 @@ void init(int argc, char **argv) {
   spinorOut = new cpuColorSpinorField(csParam);
   spinorRef = new cpuColorSpinorField(csParam);
   spinorTmp = new cpuColorSpinorField(csParam);
+  spinorHost = new cpuColorSpinorField(csParam);
 
   csParam.x[0] = gauge_param.X[0];
   
@@ -311,6 +314,12 @@ void init(int argc, char **argv) {
     construct_gauge_field(hostGauge, 1, gauge_param.cpu_prec, &gauge_param);
   }
 
+  if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH || dslash_type == QUDA_MOBIUS_DWF_DSLASH) {
+    GaugeFieldParam gParam(hostGauge, gauge_param);
+    gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+    cpuGauge = new cpuGaugeField(gParam);
+  }
+
   spinor->Source(QUDA_RANDOM_SOURCE, 0);
 
   if (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) {
@@ -436,6 +445,8 @@ void end() {
   delete spinorOut;
   delete spinorRef;
   delete spinorTmp;
+  delete spinorHost;
+  if (cpuGauge) delete cpuGauge;
 
   for (int dir = 0; dir < 4; dir++) free(hostGauge[dir]);
   if (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) {
@@ -912,6 +923,57 @@ void dslashRef() {
 }
 
 
+// Copy of a host field in the UKQCD basis required by the Dirac operators
+cpuColorSpinorField* createUKQCD(const cpuColorSpinorField &src)
+{
+  ColorSpinorParam param(src);
+  param.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField *field = new cpuColorSpinorField(param);
+  *field = src;
+  return field;
+}
+
+// Apply the host branches of the domain-wall operators to the tests
+// that have a reference: the fifth-dimension operators are applied by
+// the Dirac operator and the 4-d hopping term by the fused engine
+bool dslashHost() {
+
+  if (dslash_type != QUDA_DOMAIN_WALL_4D_DSLASH && dslash_type != QUDA_MOBIUS_DWF_DSLASH) return false;
+  if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH && test_type > 2) return false;
+  if (dslash_type == QUDA_MOBIUS_DWF_DSLASH && test_type > 3) return false;
+  if (transfer && test_type > 0) return false;
+
+  printfQuda("Calculating host implementation...");
+  fflush(stdout);
+
+  cpuColorSpinorField *in = createUKQCD(*spinor);
+  cpuColorSpinorField *out = createUKQCD(*spinorHost);
+
+  if (test_type == 0) {
+    DomainWall5DParam m5(Ls, inv_param.mass);
+    ApplyDomainWall4D(*out, *in, *cpuGauge, NULL, m5, parity, dagger == QUDA_DAG_YES);
+  } else if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH) {
+    switch (test_type) {
+    case 1: dirac_4dpc->Dslash5(*out, *in, parity); break;
+    case 2: dirac_4dpc->Dslash5inv(*out, *in, parity, kappa5); break;
+    }
+  } else {
+    switch (test_type) {
+    case 1: dirac_mdwf->Dslash5(*out, *in, parity); break;
+    case 2: dirac_mdwf->Dslash4pre(*out, *in, parity); break;
+    case 3: dirac_mdwf->Dslash5inv(*out, *in, parity); break;
+    }
+  }
+  *spinorHost = *out;
+
+  delete out;
+  delete in;
+
+  printfQuda("done.\n");
+  return true;
+}
+
 void display_test_info()
 {
   printfQuda("running the following test:\n");
@@ -941,6 +1003,327 @@ TEST(dslash, verify) {
   ASSERT_LE(deviation, tol) << "CPU and CUDA implementations do not agree";
 }
 
+TEST(dslash, host_verify) {
+  if (!hostTested) return;
+  double deviation = pow(10, -(double)(cpuColorSpinorField::Compare(*spinorRef, *spinorHost)));
+  ASSERT_LE(deviation, 1e-12) << "Host operator and reference implementation do not agree";
+}
+
+// y_s = a_s x_s + b_s y_s in each fifth-dimension slice of the host fields
+void axpbySlices(const std::vector<double> &a, const cpuColorSpinorField &x,
+		 const std::vector<double> &b, cpuColorSpinorField &y)
+{
+  if (x.Precision() != QUDA_DOUBLE_PRECISION || y.Precision() != QUDA_DOUBLE_PRECISION)
+    errorQuda("Unsupported precision %d", x.Precision());
+  const size_t slice = (size_t)x.Volume() / x.X(4) * spinorSiteSize;
+  const double *xv = static_cast<const double*>(x.V());
+  double *yv = static_cast<double*>(y.V());
+  for (int s=0; s<x.X(4); s++)
+    for (size_t i=0; i<slice; i++) yv[s*slice+i] = a[s]*xv[s*slice+i] + b[s]*yv[s*slice+i];
+}
+
+// Deviation of a host result in the UKQCD basis from the reference
+double hostDeviation(const cpuColorSpinorField &ref, const cpuColorSpinorField &out)
+{
+  ColorSpinorParam param(ref);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField host(param);
+  host = out;
+  return pow(10, -(double)(cpuColorSpinorField::Compare(ref, host)));
+}
+
+// The Xpay variants of the host branches against the reference: the
+// Moebius kernels scale by k kappa_b(s)^2, which goes on the accumulated
+// field for Dslash5Xpay and on the result for Dslash4preXpay and Dslash5invXpay
+TEST(dslash, host_xpay) {
+  if (dslash_type != QUDA_DOMAIN_WALL_4D_DSLASH && dslash_type != QUDA_MOBIUS_DWF_DSLASH) return;
+  if (transfer) return;
+
+  const double k = 0.37;
+  const std::vector<double> one(Ls, 1.0), kv(Ls, k);
+  std::vector<double> kappa_5(Ls), kappa_mdwf(Ls), scale(Ls);
+  for (int s=0; s<Ls; s++) {
+    double kappa_b = 1.0/(2*(inv_param.b_5[s]*(4.0 + inv_param.m5) + 1.0));
+    double kappa_c = 1.0/(2*(inv_param.c_5[s]*(4.0 + inv_param.m5) - 1.0));
+    kappa_5[s] = dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH ? kappa5 : 0.5*kappa_b/kappa_c;
+    kappa_mdwf[s] = -kappa_5[s];
+    scale[s] = k*kappa_b*kappa_b;
+  }
+
+  ColorSpinorParam param(*spinor);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField x(param), ref(param);
+  x.Source(QUDA_RANDOM_SOURCE);
+
+  cpuColorSpinorField *in = createUKQCD(*spinor);
+  cpuColorSpinorField *xU = createUKQCD(x);
+  cpuColorSpinorField *out = createUKQCD(ref);
+
+  if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH) {
+    dw_dslash_5_4d(ref.V(), hostGauge, spinor->V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, true);
+    axpbySlices(one, x, kv, ref);
+    dirac_4dpc->Dslash5Xpay(*out, *in, parity, *xU, k);
+    EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "Dslash5Xpay does not agree with the reference";
+
+    dslash_5_inv(ref.V(), hostGauge, spinor->V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, kappa_5.data());
+    axpbySlices(one, x, kv, ref);
+    dirac_4dpc->Dslash5invXpay(*out, *in, parity, kappa5, *xU, k);
+    EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "Dslash5invXpay does not agree with the reference";
+  } else {
+    mdw_dslash_5(ref.V(), hostGauge, spinor->V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, kappa_5.data(), true);
+    axpbySlices(scale, x, one, ref);
+    dirac_mdwf->Dslash5Xpay(*out, *in, parity, *xU, k);
+    EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "Dslash5Xpay does not agree with the reference";
+
+    mdw_dslash_4_pre(ref.V(), hostGauge, spinor->V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, inv_param.b_5, inv_param.c_5, true);
+    axpbySlices(one, x, scale, ref);
+    dirac_mdwf->Dslash4preXpay(*out, *in, parity, *xU, k);
+    EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "Dslash4preXpay does not agree with the reference";
+
+    dslash_5_inv(ref.V(), hostGauge, spinor->V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, kappa_mdwf.data());
+    axpbySlices(one, x, scale, ref);
+    dirac_mdwf->Dslash5invXpay(*out, *in, parity, *xU, k);
+    EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "Dslash5invXpay does not agree with the reference";
+  }
+
+  delete out;
+  delete xU;
+  delete in;
+}
+
+// The fused 4-d engine with the fifth-dimension operator of the test
+// and its inverse, scaled and accumulated per slice, against the
+// reference hopping term followed by the reference operator
+TEST(dslash, host_fused) {
+  if (dslash_type != QUDA_DOMAIN_WALL_4D_DSLASH && dslash_type != QUDA_MOBIUS_DWF_DSLASH) return;
+
+  const bool dag = (dagger == QUDA_DAG_YES);
+  std::vector<double> kappa_5(Ls), kappa_inv(Ls), alpha(Ls), beta(Ls);
+  DomainWall5DParam m5(Ls, inv_param.mass), m5inv(Ls, inv_param.mass, true);
+  for (int s=0; s<Ls; s++) {
+    if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH) {
+      m5.a[s] = 0.0; m5.b[s] = 1.0;
+      kappa_inv[s] = kappa5;
+      m5inv.b[s] = -kappa5;
+    } else {
+      double kappa_b = 1.0/(2*(inv_param.b_5[s]*(4.0 + inv_param.m5) + 1.0));
+      double kappa_c = 1.0/(2*(inv_param.c_5[s]*(4.0 + inv_param.m5) - 1.0));
+      kappa_5[s] = 0.5*kappa_b/kappa_c;
+      kappa_inv[s] = -kappa_5[s];
+      m5.b[s] = kappa_5[s];
+      m5inv.b[s] = kappa_5[s];
+    }
+    alpha[s] = 0.5 + 0.1*s;
+    beta[s] = 1.0 - 0.05*s;
+  }
+  m5inv.alpha = alpha;
+  m5inv.beta = beta;
+
+  ColorSpinorParam param(*spinor);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField hop(param), x(param), ref(param);
+  x.Source(QUDA_RANDOM_SOURCE);
+  dslash_4_4d(hop.V(), hostGauge, spinor->V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass);
+
+  cpuColorSpinorField *in = createUKQCD(*spinor);
+  cpuColorSpinorField *xU = createUKQCD(x);
+  cpuColorSpinorField *out = createUKQCD(ref);
+
+  if (dslash_type == QUDA_DOMAIN_WALL_4D_DSLASH)
+    dw_dslash_5_4d(ref.V(), hostGauge, hop.V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, true);
+  else
+    mdw_dslash_5(ref.V(), hostGauge, hop.V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, kappa_5.data(), true);
+  ApplyDomainWall4D(*out, *in, *cpuGauge, NULL, m5, parity, dag);
+  EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "M5 D4 does not agree with the reference";
+
+  dslash_5_inv(ref.V(), hostGauge, hop.V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, kappa_inv.data());
+  axpbySlices(beta, x, alpha, ref);
+  ApplyDomainWall4D(*out, *in, *cpuGauge, xU, m5inv, parity, dag);
+  EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "M5^{-1} D4 does not agree with the reference";
+
+  if (dslash_type == QUDA_MOBIUS_DWF_DSLASH) {
+    DomainWall5DParam pre(Ls, inv_param.mass);
+    for (int s=0; s<Ls; s++) { pre.a[s] = inv_param.b_5[s]; pre.b[s] = 0.5*inv_param.c_5[s]; }
+    mdw_dslash_4_pre(ref.V(), hostGauge, hop.V(), parity, dagger, gauge_param.cpu_prec, gauge_param, inv_param.mass, inv_param.b_5, inv_param.c_5, true);
+    ApplyDomainWall4D(*out, *in, *cpuGauge, NULL, pre, parity, dag);
+    EXPECT_LE(hostDeviation(ref, *out), 1e-12) << "M5pre D4 does not agree with the reference";
+  }
+
+  delete out;
+  delete xU;
+  delete in;
+}
+
+// Whether the shared-link multi-flavour operator applies to this test
+bool multiFlavorTested()
+{
+  if (transfer || (test_type != 2 && test_type != 4)) return false;
+  return dslash_type == QUDA_WILSON_DSLASH || dslash_type == QUDA_CLOVER_WILSON_DSLASH ||
+    (dslash_type == QUDA_TWISTED_MASS_DSLASH && twist_flavor == QUDA_TWIST_SINGLET);
+}
+
+const int nFlavor = 3;
+
+// Create the flavour sources, all copies of the benchmark source, and
+// their masses: the first flavour has the parameters of the benchmarked
+// operator, the remaining ones lighter kappa and heavier mu
+void createFlavors(std::vector<ColorSpinorField*> &out, std::vector<ColorSpinorField*> &in,
+		   std::vector<double> &kappa, std::vector<double> &mu)
+{
+  const double kappa_scale[nFlavor] = {1.0, 0.95, 0.9};
+  const double mu_scale[nFlavor] = {1.0, 2.0, 4.0};
+
+  kappa.resize(nFlavor);
+  mu.resize(nFlavor);
+  in.resize(nFlavor);
+  out.resize(nFlavor);
+  ColorSpinorParam param(*cudaSpinor);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  for (int f=0; f<nFlavor; f++) {
+    kappa[f] = inv_param.kappa * kappa_scale[f];
+    mu[f] = dslash_type == QUDA_TWISTED_MASS_DSLASH ? inv_param.mu * mu_scale[f] : 0.0;
+    in[f] = new cudaColorSpinorField(*cudaSpinor, param);
+    out[f] = new cudaColorSpinorField(param);
+  }
+}
+
+void destroyFlavors(std::vector<ColorSpinorField*> &out, std::vector<ColorSpinorField*> &in)
+{
+  for (unsigned int f=0; f<in.size(); f++) {
+    delete in[f];
+    delete out[f];
+  }
+}
+
+// Build the clover term of a flavour with hopping parameter kappa_f,
+// 1 + (kappa_f/kappa)(A - 1), from the packed host clover field
+cudaCloverField* createFlavorClover(const cudaCloverField &clover, double kappa_f)
+{
+  const double r = kappa_f / inv_param.kappa;
+  std::vector<double> A((size_t)V*cloverSiteSize);
+  for (size_t i=0; i<A.size(); i++) A[i] = r * ((double*)hostClover)[i];
+  for (int i=0; i<V; i++) {
+    for (int j=0; j<6; j++) {
+      A[(size_t)i*cloverSiteSize + j] += 1.0 - r;
+      A[(size_t)i*cloverSiteSize + j + 36] += 1.0 - r;
+    }
+  }
+
+  CloverFieldParam param(clover);
+  param.direct = true;
+  param.inverse = false;
+  cudaCloverField *A_f = new cudaCloverField(param);
+
+  CloverFieldParam hostParam(param);
+  hostParam.precision = QUDA_DOUBLE_PRECISION;
+  hostParam.order = QUDA_PACKED_CLOVER_ORDER;
+  hostParam.clover = A.data();
+  hostParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuCloverField hostA(hostParam);
+  A_f->copy(hostA, false);
+
+  return A_f;
+}
+
+TEST(dslash, multi_flavor) {
+  if (!multiFlavorTested()) return;
+  if (dslash_type == QUDA_CLOVER_WILSON_DSLASH && inv_param.clover_cpu_prec != QUDA_DOUBLE_PRECISION)
+    errorQuda("Multi-flavour clover test requires a double precision host clover field");
+
+  std::vector<double> kappa, mu;
+  std::vector<ColorSpinorField*> in, out;
+  createFlavors(out, in, kappa, mu);
+  // make the flavour sources distinct
+  for (int f=1; f<nFlavor; f++) blas::ax(1.0 + 0.5*f, *in[f]);
+
+  DiracWilson *wilson = dynamic_cast<DiracWilson*>(dirac);
+  ASSERT_TRUE(wilson != NULL) << "Multi-flavour operator requires a Wilson-type operator";
+  wilson->MultiFlavorM(out, in, kappa, mu);
+
+  double tol = (inv_param.cuda_prec == QUDA_DOUBLE_PRECISION ? 1e-12 :
+		(inv_param.cuda_prec == QUDA_SINGLE_PRECISION ? 1e-5 : 1e-2));
+
+  // compare each flavour against the unpreconditioned operator built
+  // with that flavour's kappa and mu
+  for (int f=0; f<nFlavor; f++) {
+    QudaInvertParam flavor_param = inv_param;
+    flavor_param.kappa = kappa[f];
+    flavor_param.mu = mu[f];
+
+    DiracParam diracParam;
+    setDiracParam(diracParam, &flavor_param, false);
+    diracParam.tmp1 = tmp1;
+    diracParam.tmp2 = tmp2;
+    cudaCloverField *A_f = NULL;
+    if (dslash_type == QUDA_CLOVER_WILSON_DSLASH) {
+      A_f = createFlavorClover(*diracParam.clover, kappa[f]);
+      diracParam.clover = A_f;
+    }
+    Dirac *ref = Dirac::create(diracParam);
+
+    ref->M(*cudaSpinorOut, *in[f]);
+    double deviation = sqrt(blas::xmyNorm(*cudaSpinorOut, *out[f]) / blas::norm2(*cudaSpinorOut));
+    EXPECT_LE(deviation, tol) << "Flavour " << f << " with kappa = " << kappa[f] << ", mu = " << mu[f]
+			      << " does not agree with the single-flavour operator";
+
+    delete ref;
+    if (A_f) delete A_f;
+  }
+
+  destroyFlavors(out, in);
+}
+
+// Benchmark the shared-link multi-flavour operator against one
+// operator application per flavour
+void multiFlavorBenchmark(int niter)
+{
+  if (!multiFlavorTested()) return;
+
+  std::vector<double> kappa, mu;
+  std::vector<ColorSpinorField*> in, out;
+  createFlavors(out, in, kappa, mu);
+
+  DiracWilson *wilson = dynamic_cast<DiracWilson*>(dirac);
+  if (!wilson) errorQuda("Multi-flavour benchmark requires a Wilson-type operator");
+
+  // warm-up runs
+  wilson->MultiFlavorM(out, in, kappa, mu);
+  for (int f=0; f<nFlavor; f++) {
+    std::vector<ColorSpinorField*> out1(1, out[f]), in1(1, in[f]);
+    wilson->MultiFlavorM(out1, in1, std::vector<double>(1, kappa[f]), std::vector<double>(1, mu[f]));
+  }
+
+  cudaEvent_t start, end;
+  cudaEventCreate(&start);
+  cudaEventCreate(&end);
+  float separateTime, fusedTime;
+
+  cudaEventRecord(start, 0);
+  for (int i=0; i<niter; i++) {
+    for (int f=0; f<nFlavor; f++) {
+      std::vector<ColorSpinorField*> out1(1, out[f]), in1(1, in[f]);
+      wilson->MultiFlavorM(out1, in1, std::vector<double>(1, kappa[f]), std::vector<double>(1, mu[f]));
+    }
+  }
+  cudaEventRecord(end, 0);
+  cudaEventSynchronize(end);
+  cudaEventElapsedTime(&separateTime, start, end);
+
+  cudaEventRecord(start, 0);
+  for (int i=0; i<niter; i++) wilson->MultiFlavorM(out, in, kappa, mu);
+  cudaEventRecord(end, 0);
+  cudaEventSynchronize(end);
+  cudaEventElapsedTime(&fusedTime, start, end);
+
+  cudaEventDestroy(start);
+  cudaEventDestroy(end);
+
+  printfQuda("Multi-flavour operator with %d flavours: separate = %fus, shared-link = %fus, speedup = %f\n",
+	     nFlavor, 1e3*separateTime/niter, 1e3*fusedTime/niter, separateTime/fusedTime);
+
+  destroyFlavors(out, in);
+}
+
 int main(int argc, char **argv)
 {
   // initalize google test, includes command line options
@@ -968,6 +1351,7 @@ int main(int argc, char **argv)
   
   int attempts = 1;
   dslashRef();
+  hostTested = dslashHost();
   for (int i=0; i<attempts; i++) {
 
     {
@@ -1003,7 +1387,8 @@ int main(int argc, char **argv)
       test_rc = RUN_ALL_TESTS();
       if (test_rc != 0) warningQuda("Tests failed");
     }
-  }    
+  }
+  multiFlavorBenchmark(niter);
   end();
 
   finalizeComms();
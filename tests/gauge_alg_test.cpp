@@ -5,6 +5,7 @@
 #include <quda.h>
 #include <quda_internal.h>
 #include <gauge_field.h>
+#include <quda_matrix.h>
 
 #include <comm_quda.h>
 #include <test_util.h>
@@ -13,10 +14,19 @@
 #include <pgauge_monte.h>
 #include <random_quda.h>
 #include <unitarization_links.h>
+#include <gauge_force_quda.h>
+#include <gauge_update_quda.h>
+#include <momentum.h>
+
+#include <random>
 
 
 #include <gtest.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using   namespace quda;
 
 extern int device;
@@ -269,6 +279,581 @@ TEST_F(GaugeAlgTest,Coulomb_FFT){
 
 
 
+/**
+   Fixture of the host algorithm tests: an 8^4 lattice with MILC
+   ordered host fields, the guard for tests that only run on a single
+   node, and running a step with a single thread to check that the
+   threaded host code gives the same result.
+*/
+class GaugeAlgHostTest : public ::testing::Test {
+ protected:
+  int X[4];
+  int nthreads; // number of threads the threaded runs use
+
+  void SetUp() {
+    for (int dir=0; dir<4; dir++) X[dir] = 8;
+    nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    // with one thread the threaded and serial runs are the same run,
+    // so the comparisons between them check nothing
+    static bool reported = false;
+    if (nthreads == 1 && !reported) {
+      printfQuda("Host tests run with a single thread: the threaded versus serial checks are not independent"
+#ifndef _OPENMP
+                 " (built without OpenMP)"
+#endif
+                 "\n");
+      reported = true;
+    }
+  }
+
+  int volumeCB() const { return X[0]*X[1]*X[2]*X[3] >> 1; }
+
+  bool partitioned() const {
+    return comm_dim_partitioned(0) || comm_dim_partitioned(1) || comm_dim_partitioned(2) || comm_dim_partitioned(3);
+  }
+
+  // regular host gauge field
+  GaugeFieldParam hostParam(QudaPrecision precision, QudaGaugeFieldOrder order=QUDA_MILC_GAUGE_ORDER) const {
+    GaugeFieldParam gParam(X, precision, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_NO);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    gParam.order = order;
+    gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+    gParam.t_boundary = QUDA_PERIODIC_T;
+    return gParam;
+  }
+
+  // host gauge field extended by R[dir] sites on each side
+  GaugeFieldParam extendedParam(QudaPrecision precision, const int *R) const {
+    int E[4];
+    for (int dir=0; dir<4; dir++) E[dir] = X[dir] + 2*R[dir];
+    GaugeFieldParam gParam(E, precision, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY, QUDA_GHOST_EXCHANGE_EXTENDED);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    gParam.order = QUDA_MILC_GAUGE_ORDER;
+    gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+    gParam.t_boundary = QUDA_PERIODIC_T;
+    for (int dir=0; dir<4; dir++) gParam.r[dir] = R[dir];
+    return gParam;
+  }
+
+  // host momentum field
+  GaugeFieldParam momParam() const {
+    GaugeFieldParam gParam(hostParam(QUDA_DOUBLE_PRECISION));
+    gParam.reconstruct = QUDA_RECONSTRUCT_10;
+    gParam.link_type = QUDA_ASQTAD_MOM_LINKS;
+    return gParam;
+  }
+
+  // run f with a single OpenMP thread
+  template <typename F> void serial(F f) {
+#ifdef _OPENMP
+    omp_set_num_threads(1);
+#endif
+    f();
+#ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+#endif
+  }
+};
+
+TEST_F(GaugeAlgHostTest,Heatbath){
+  // host fields are extended by two sites in each partitioned dimension, as on the device
+  int R[4];
+  for(int dir=0; dir<4; ++dir) R[dir] = comm_dim_partitioned(dir) ? 2 : 0;
+  GaugeFieldParam gParam = extendedParam(prec, R);
+  cpuGaugeField serial_field(gParam);
+  cpuGaugeField threaded(gParam);
+
+  const int nhb = 4, nover = 4;
+  const double beta = 6.2;
+  RNG rng_serial(volumeCB(), 1234, X);
+  RNG rng_threaded(volumeCB(), 1234, X);
+  InitGaugeField(serial_field);
+  InitGaugeField(threaded);
+
+  serial([&]() { Monte(serial_field, rng_serial, beta, nhb, nover); });
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+  Monte(threaded, rng_threaded, beta, nhb, nover);
+  timer.Stop(__func__, __FILE__, __LINE__);
+  printfQuda("Host heatbath: %.2f sweeps/s with %d threads\n", (nhb + nover) / timer.Last(), nthreads);
+
+  double3 plaq = plaquette(threaded, QUDA_CPU_FIELD_LOCATION);
+  printfQuda("Host plaq: %.16e , %.16e, %.16e\n", plaq.x, plaq.y, plaq.z);
+
+  // the ensemble must not depend on the number of threads
+  ASSERT_EQ(rng_serial.Counter(), rng_threaded.Counter());
+  ASSERT_EQ(memcmp(serial_field.Gauge_p(), threaded.Gauge_p(), serial_field.Bytes()), 0);
+}
+
+
+TEST_F(GaugeAlgHostTest,CounterRNG){
+  GaugeFieldParam gParam = hostParam(QUDA_DOUBLE_PRECISION, QUDA_QDP_GAUGE_ORDER);
+  cpuGaugeField host(gParam);
+  cpuGaugeField host_restart(gParam);
+  cpuGaugeField device_copy(gParam);
+  gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  cudaGaugeField device(gParam);
+
+  RNG rng_host(2*volumeCB(), 1234, X);
+  RNG rng_device(2*volumeCB(), 1234, X);
+
+  // the host and device fields must agree up to rounding
+  gaugeGauss(host, rng_host);
+  gaugeGauss(device, rng_device);
+  device.saveCPUField(device_copy);
+  double max_dev = 0.0;
+  for(int dir=0; dir<4; ++dir){
+    const double *a = ((double**)host.Gauge_p())[dir];
+    const double *b = ((double**)device_copy.Gauge_p())[dir];
+    for(int i=0; i<host.Volume()*18; i++) max_dev = MAX(max_dev, DABS(a[i] - b[i]));
+  }
+  printfQuda("Host - device deviation of Gaussian links: %e\n", max_dev);
+  ASSERT_LT(max_dev, 1e-10);
+
+  // restarting from a checkpoint only requires the seed and counter
+  unsigned long long checkpoint = rng_host.Counter();
+  gaugeGauss(host, rng_host);
+  RNG rng_restart(2*volumeCB(), 1234, X);
+  rng_restart.setCounter(checkpoint);
+  gaugeGauss(host_restart, rng_restart);
+  for(int dir=0; dir<4; ++dir)
+    ASSERT_EQ(memcmp(((void**)host.Gauge_p())[dir], ((void**)host_restart.Gauge_p())[dir], host.Volume()*18*sizeof(double)), 0);
+}
+
+
+TEST_F(GaugeAlgHostTest,ExtendedBorder){
+  // a two-deep border in every dimension, wrapped locally where not partitioned
+  const int R[4] = {2, 2, 2, 2};
+  const QudaGaugeFieldOrder order[2] = {QUDA_MILC_GAUGE_ORDER, QUDA_QDP_GAUGE_ORDER};
+  const size_t link_bytes = 18*sizeof(double);
+  const char zero[18*sizeof(double)] = { };
+
+  for(int o=0; o<2; o++){
+    GaugeFieldParam gParam = hostParam(QUDA_DOUBLE_PRECISION, order[o]);
+    cpuGaugeField U(gParam);
+    RNG rng(2*volumeCB(), 1234, X);
+    gaugeGauss(U, rng);
+
+    GaugeFieldParam gParamEx = extendedParam(QUDA_DOUBLE_PRECISION, R);
+    gParamEx.order = order[o];
+    gParamEx.create = QUDA_ZERO_FIELD_CREATE;
+    cpuGaugeField border(gParamEx);
+    cpuGaugeField by_dim(gParamEx);
+    copyExtendedGauge(border, U, QUDA_CPU_FIELD_LOCATION);
+    copyExtendedGauge(by_dim, U, QUDA_CPU_FIELD_LOCATION);
+    border.exchangeExtendedGhost(R, true);
+    by_dim.exchangeExtendedGhostByDim(R, true);
+
+    int E[4];
+    for(int dir=0; dir<4; ++dir) E[dir] = X[dir] + 2*R[dir];
+    const size_t volumeExCB = (size_t)E[0]*E[1]*E[2]*E[3] / 2;
+    auto link = [&](cpuGaugeField &u, size_t cb, int g) -> const char* {
+      return order[o] == QUDA_QDP_GAUGE_ORDER ? static_cast<char**>(u.Gauge_p())[g] + cb*link_bytes :
+	static_cast<char*>(u.Gauge_p()) + (cb*4 + g)*link_bytes;
+    };
+
+    // border links by the number of dimensions they lie outside the
+    // interior in: faces (1), edges (2) and corners (3, 4)
+    int checked[5] = { }, mismatch[5] = { }, empty[5] = { };
+    for(int t=0; t<E[3]; t++) for(int z=0; z<E[2]; z++) for(int y=0; y<E[1]; y++) for(int x=0; x<E[0]; x++){
+      const int c[4] = {x, y, z, t};
+      int n = 0;
+      for(int dir=0; dir<4; ++dir) if(c[dir] < R[dir] || c[dir] >= E[dir] - R[dir]) n++;
+      if(n == 0) continue;
+      size_t idx = (((size_t)t*E[2] + z)*E[1] + y)*E[0] + x;
+      size_t cb = ((x+y+z+t) & 1)*volumeExCB + idx/2;
+      for(int g=0; g<4; g++){
+	checked[n]++;
+	if(memcmp(link(border, cb, g), link(by_dim, cb, g), link_bytes)) mismatch[n]++;
+	if(!memcmp(link(border, cb, g), zero, link_bytes)) empty[n]++;
+      }
+    }
+
+    for(int n=1; n<=4; n++){
+      printfQuda("%s order, border links in %d dimensions: %d checked, %d differ from the per-dimension exchange\n",
+		 order[o] == QUDA_QDP_GAUGE_ORDER ? "QDP" : "MILC", n, checked[n], mismatch[n]);
+      EXPECT_GT(checked[n], 0);
+      EXPECT_EQ(mismatch[n], 0) << "border in " << n << " dimensions differs from the per-dimension exchange";
+      EXPECT_EQ(empty[n], 0) << "border in " << n << " dimensions was not filled";
+    }
+  }
+}
+
+
+TEST_F(GaugeAlgHostTest,ExtendedUpdate){
+  // the link update of an extended field touches only its interior, and
+  // a border exchange then makes it the extension of the updated field
+  if (partitioned()) return;
+  const int R[4] = {2, 2, 2, 2};
+  const double dt = 0.1;
+
+  GaugeFieldParam gParam = hostParam(QUDA_DOUBLE_PRECISION);
+  cpuGaugeField U(gParam);
+  cpuGaugeField U_interior(gParam);
+  RNG rng(volumeCB(), 1234, X);
+  InitGaugeField(U);
+  Monte(U, rng, 6.0, 2, 2);
+
+  cpuGaugeField mom(momParam());
+  std::mt19937 gen(1234);
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  double *m = (double*)mom.Gauge_p();
+  for (int i=0; i<4*mom.Volume(); i++) {
+    for (int j=0; j<9; j++) m[10*i+j] = gauss(gen);
+    m[10*i+9] = 0.0;
+  }
+
+  GaugeFieldParam gParamEx = extendedParam(QUDA_DOUBLE_PRECISION, R);
+  cpuGaugeField Uex(gParamEx);
+  cpuGaugeField Uex0(gParamEx);
+  copyExtendedGauge(Uex, U, QUDA_CPU_FIELD_LOCATION);
+  Uex.exchangeExtendedGhost(R, true);
+  memcpy(Uex0.Gauge_p(), Uex.Gauge_p(), Uex.Bytes());
+
+  updateGaugeField(U, dt, U, mom, false, true);
+  updateGaugeField(Uex, dt, Uex, mom, false, true);
+
+  int E[4];
+  for(int dir=0; dir<4; ++dir) E[dir] = X[dir] + 2*R[dir];
+  const size_t volumeExCB = (size_t)E[0]*E[1]*E[2]*E[3] / 2;
+  const size_t site_bytes = 4*18*sizeof(double);
+  auto site = [&](cpuGaugeField &u, int x, int y, int z, int t) -> const char* {
+    size_t idx = (((size_t)t*E[2] + z)*E[1] + y)*E[0] + x;
+    return static_cast<char*>(u.Gauge_p()) + (((x+y+z+t) & 1)*volumeExCB + idx/2)*site_bytes;
+  };
+
+  // the border still holds the links from before the update
+  int border_changed = 0;
+  for(int t=0; t<E[3]; t++) for(int z=0; z<E[2]; z++) for(int y=0; y<E[1]; y++) for(int x=0; x<E[0]; x++){
+    const int c[4] = {x, y, z, t};
+    bool interior = true;
+    for(int dir=0; dir<4; ++dir) if(c[dir] < R[dir] || c[dir] >= E[dir] - R[dir]) interior = false;
+    if(!interior && memcmp(site(Uex, x, y, z, t), site(Uex0, x, y, z, t), site_bytes)) border_changed++;
+  }
+  EXPECT_EQ(border_changed, 0) << "the update wrote to the border";
+
+  // the interior is the update of the regular field
+  copyExtendedGauge(U_interior, Uex, QUDA_CPU_FIELD_LOCATION);
+  ASSERT_EQ(memcmp(U_interior.Gauge_p(), U.Gauge_p(), U.Bytes()), 0);
+
+  // and after the exchange the whole field is its extension
+  Uex.exchangeExtendedGhost(R, true);
+  copyExtendedGauge(Uex0, U, QUDA_CPU_FIELD_LOCATION);
+  Uex0.exchangeExtendedGhost(R, true);
+  ASSERT_EQ(memcmp(Uex.Gauge_p(), Uex0.Gauge_p(), Uex.Bytes()), 0);
+}
+
+
+TEST_F(GaugeAlgHostTest,GaugeFixing){
+  // host gauge fixing is single node only
+  if (partitioned()) return;
+  GaugeFieldParam gParam = hostParam(prec);
+  cpuGaugeField U0(gParam);
+  cpuGaugeField ovr(gParam);
+  cpuGaugeField fft(gParam);
+  cpuGaugeField device_copy(gParam);
+  gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  cudaGaugeField device(gParam);
+
+  RNG rng(volumeCB(), 1234, X);
+  InitGaugeField(U0);
+  Monte(U0, rng, 6.2, 10, 10);
+  double3 plaq = plaquette(U0, QUDA_CPU_FIELD_LOCATION);
+
+  const int gauge_dir = 4, nsteps = 2000;
+  const double tol = prec == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-5;
+  const double theta_tol = prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-6;
+  const double fix_tol = prec == QUDA_DOUBLE_PRECISION ? 1e-8 : 1e-4;
+
+  // every overrelaxation sweep and steepest descent step increases the functional
+  memcpy(ovr.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  memcpy(fft.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  double2 q_ovr = gaugeFixQuality(ovr, gauge_dir);
+  double2 q_fft = q_ovr;
+  for(int step=0; step<20; step++){
+    gaugefixingOVR(ovr, gauge_dir, 1, 1, 1.5, 0, 1, 1);
+    gaugefixingFFT(fft, gauge_dir, 1, 1, 0.08, 0, 0, 1);
+    double2 q = gaugeFixQuality(ovr, gauge_dir);
+    ASSERT_GT(q.x, q_ovr.x) << "overrelaxation functional decreased at step " << step;
+    q_ovr = q;
+    q = gaugeFixQuality(fft, gauge_dir);
+    ASSERT_GT(q.x, q_fft.x) << "steepest descent functional decreased at step " << step;
+    q_fft = q;
+  }
+
+  // both methods converge below the requested theta, and the plaquette is gauge invariant
+  printfQuda("Host Landau gauge fixing with overrelaxation\n");
+  memcpy(ovr.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  gaugefixingOVR(ovr, gauge_dir, nsteps, 100, 1.5, theta_tol, 10, 1);
+  q_ovr = gaugeFixQuality(ovr, gauge_dir);
+  ASSERT_LT(q_ovr.y, theta_tol);
+  double3 plaq_ovr = plaquette(ovr, QUDA_CPU_FIELD_LOCATION);
+  ASSERT_LT(DABS(plaq.x - plaq_ovr.x), tol);
+
+  printfQuda("Host Landau gauge fixing with steepest descent method with FFTs\n");
+  memcpy(fft.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  gaugefixingFFT(fft, gauge_dir, nsteps, 100, 0.08, 0, theta_tol, 1);
+  q_fft = gaugeFixQuality(fft, gauge_dir);
+  ASSERT_LT(q_fft.y, theta_tol);
+  double3 plaq_fft = plaquette(fft, QUDA_CPU_FIELD_LOCATION);
+  ASSERT_LT(DABS(plaq.x - plaq_fft.x), tol);
+
+  // the device methods reach the same gauge from the same input
+  device.loadCPUField(U0);
+  gaugefixingOVR(device, gauge_dir, nsteps, 100, 1.5, theta_tol, 10, 1);
+  device.saveCPUField(device_copy);
+  double2 q_dev = gaugeFixQuality(device_copy, gauge_dir);
+  printfQuda("Overrelaxation functional host = %.16e device = %.16e\n", q_ovr.x, q_dev.x);
+  ASSERT_LT(q_dev.y, theta_tol);
+  ASSERT_LT(DABS(q_ovr.x - q_dev.x), fix_tol);
+
+  device.loadCPUField(U0);
+  gaugefixingFFT(device, gauge_dir, nsteps, 100, 0.08, 0, theta_tol, 1);
+  device.saveCPUField(device_copy);
+  q_dev = gaugeFixQuality(device_copy, gauge_dir);
+  printfQuda("Steepest descent functional host = %.16e device = %.16e\n", q_fft.x, q_dev.x);
+  ASSERT_LT(q_dev.y, theta_tol);
+  ASSERT_LT(DABS(q_fft.x - q_dev.x), fix_tol);
+}
+
+
+
+/**
+   Wilson gauge action HMC pieces on the host: the staples of each
+   link direction as gauge force paths, the Hamiltonian, and a
+   leapfrog trajectory.  With U -> exp(dt P) U and the momentum action
+   of computeMomAction, which is -1/2 Tr P^2 per link, the momentum
+   update is P -= dt beta/3 [U staple]_TA.
+*/
+struct WilsonHostHMC {
+  int path[4][6][3];
+  int *path_p[4][6];
+  int **input_path[4];
+  int length[6];
+  double coeff[6];
+  double beta;
+  int R[4];
+
+  WilsonHostHMC(double beta) : beta(beta) {
+    for (int mu=0; mu<4; mu++) {
+      int i = 0;
+      for (int nu=0; nu<4; nu++) {
+	if (nu == mu) continue;
+	const int fwd[3] = {nu, 7-mu, 7-nu};
+	const int bwd[3] = {7-nu, 7-mu, nu};
+	for (int j=0; j<3; j++) { path[mu][i][j] = fwd[j]; path[mu][i+1][j] = bwd[j]; }
+	i += 2;
+      }
+      for (int i=0; i<6; i++) path_p[mu][i] = path[mu][i];
+      input_path[mu] = path_p[mu];
+      R[mu] = 2;
+    }
+    for (int i=0; i<6; i++) { length[i] = 3; coeff[i] = 1.0; }
+  }
+
+  void force(cpuGaugeField &mom, cpuGaugeField &Uex, const cpuGaugeField &U, double dt) {
+    copyExtendedGauge(Uex, U, QUDA_CPU_FIELD_LOCATION);
+    Uex.exchangeExtendedGhost(R, true);
+    gaugeForce(mom, Uex, dt*beta/3.0, input_path, length, coeff, 6, 3);
+  }
+
+  double hamiltonian(const cpuGaugeField &mom, const cpuGaugeField &U) {
+    double3 plaq = plaquette(U, QUDA_CPU_FIELD_LOCATION);
+    return computeMomAction(mom) + 6.0*beta*U.Volume()*(1.0 - plaq.x);
+  }
+
+  void leapfrog(cpuGaugeField &mom, cpuGaugeField &Uex, cpuGaugeField &U, double tau, int nsteps) {
+    const double dt = tau / nsteps;
+    for (int step=0; step<nsteps; step++) {
+      force(mom, Uex, U, 0.5*dt);
+      updateGaugeField(U, dt, U, mom, false, true);
+      force(mom, Uex, U, 0.5*dt);
+    }
+  }
+};
+
+TEST_F(GaugeAlgHostTest,HMCLeapfrog){
+  // the momentum field and gauge field are regular, so single node only
+  if (partitioned()) return;
+  const double beta = 6.0, tau = 0.5;
+  const int nsteps = 10;
+
+  GaugeFieldParam gParam = hostParam(QUDA_DOUBLE_PRECISION);
+  cpuGaugeField U0(gParam);
+  cpuGaugeField U(gParam);
+  cpuGaugeField U_serial(gParam);
+
+  WilsonHostHMC hmc(beta);
+  cpuGaugeField Uex(extendedParam(QUDA_DOUBLE_PRECISION, hmc.R));
+
+  cpuGaugeField mom0(momParam());
+  cpuGaugeField mom(momParam());
+
+  RNG rng(volumeCB(), 1234, X);
+  InitGaugeField(U0);
+  Monte(U0, rng, beta, 10, 10);
+
+  // Gaussian momenta with weight exp(-S_mom): the off-diagonal
+  // components have variance 1/2 and the traceless diagonal is built
+  // from two unit-variance Gaussians
+  std::mt19937 gen(1234);
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  double *m = (double*)mom0.Gauge_p();
+  for (int i=0; i<4*mom0.Volume(); i++) {
+    for (int j=0; j<6; j++) m[10*i+j] = sqrt(0.5)*gauss(gen);
+    const double a = gauss(gen), b = gauss(gen);
+    m[10*i+6] =  a/sqrt(2.0) + b/sqrt(6.0);
+    m[10*i+7] = -a/sqrt(2.0) + b/sqrt(6.0);
+    m[10*i+8] = -2.0*b/sqrt(6.0);
+    m[10*i+9] = 0.0;
+  }
+
+  memcpy(U_serial.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  memcpy(mom.Gauge_p(), mom0.Gauge_p(), mom0.Bytes());
+  serial([&]() { hmc.leapfrog(mom, Uex, U_serial, tau, nsteps); });
+
+  memcpy(U.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  memcpy(mom.Gauge_p(), mom0.Gauge_p(), mom0.Bytes());
+  const double H0 = hmc.hamiltonian(mom, U);
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+  hmc.leapfrog(mom, Uex, U, tau, nsteps);
+  timer.Stop(__func__, __FILE__, __LINE__);
+  const double dH = hmc.hamiltonian(mom, U) - H0;
+  printfQuda("Host HMC: %d leapfrog steps in %.3f s with %d threads, dH = %e\n", nsteps, timer.Last(), nthreads, dH);
+
+  // the trajectory must not depend on the number of threads
+  ASSERT_EQ(memcmp(U_serial.Gauge_p(), U.Gauge_p(), U.Bytes()), 0);
+
+  // reversibility: flip the momentum and integrate back to the start
+  updateMomentum(mom, -2.0, mom);
+  hmc.leapfrog(mom, Uex, U, tau, nsteps);
+  double max_dev = 0.0;
+  const double *u = (const double*)U.Gauge_p();
+  const double *u0 = (const double*)U0.Gauge_p();
+  for (int i=0; i<4*U.Volume()*18; i++) max_dev = MAX(max_dev, DABS(u[i] - u0[i]));
+  printfQuda("Host HMC: reversibility deviation of the links %e\n", max_dev);
+  ASSERT_LT(max_dev, 1e-10);
+
+  // leapfrog energy violation falls as dt^2
+  memcpy(U.Gauge_p(), U0.Gauge_p(), U0.Bytes());
+  memcpy(mom.Gauge_p(), mom0.Gauge_p(), mom0.Bytes());
+  hmc.leapfrog(mom, Uex, U, tau, 2*nsteps);
+  const double dH_fine = hmc.hamiltonian(mom, U) - H0;
+  printfQuda("Host HMC: %d leapfrog steps, dH = %e\n", 2*nsteps, dH_fine);
+  ASSERT_LT(DABS(dH_fine), 0.5*DABS(dH));
+}
+
+TEST_F(GaugeAlgHostTest,STOUT){
+  if (partitioned()) return;
+  int R[4] = {1, 1, 1, 1};
+  const double rho = 0.1;
+
+  cpuGaugeField U(hostParam(QUDA_DOUBLE_PRECISION));
+  GaugeFieldParam gParamEx = extendedParam(QUDA_DOUBLE_PRECISION, R);
+  cpuGaugeField Uex(gParamEx);
+  cpuGaugeField Usmeared(gParamEx);
+
+  RNG rng(volumeCB(), 4321, X);
+  InitGaugeField(U);
+  Monte(U, rng, 6.0, 5, 5);
+  double3 plaq0 = plaquette(U, QUDA_CPU_FIELD_LOCATION);
+
+  // the same step on the device, from the same field
+  GaugeFieldParam gParamDev = hostParam(QUDA_DOUBLE_PRECISION);
+  gParamDev.order = QUDA_FLOAT2_GAUGE_ORDER;
+  cudaGaugeField Udev(gParamDev);
+  gParamEx.order = QUDA_FLOAT2_GAUGE_ORDER;
+  cudaGaugeField UexDev(gParamEx);
+  cudaGaugeField UsmearedDev(gParamEx);
+  Udev.loadCPUField(U);
+  copyExtendedGauge(UexDev, Udev, QUDA_CUDA_FIELD_LOCATION);
+  UexDev.exchangeExtendedGhost(R, true);
+  copyExtendedGauge(UsmearedDev, Udev, QUDA_CUDA_FIELD_LOCATION);
+  STOUTStep(UsmearedDev, UexDev, rho);
+  copyExtendedGauge(Udev, UsmearedDev, QUDA_CUDA_FIELD_LOCATION);
+  cpuGaugeField Uref(hostParam(QUDA_DOUBLE_PRECISION));
+  Udev.saveCPUField(Uref);
+
+  copyExtendedGauge(Uex, U, QUDA_CPU_FIELD_LOCATION);
+  Uex.exchangeExtendedGhost(R, true);
+  copyExtendedGauge(Usmeared, U, QUDA_CPU_FIELD_LOCATION);
+  STOUTStep(Usmeared, Uex, rho);
+  copyExtendedGauge(U, Usmeared, QUDA_CPU_FIELD_LOCATION);
+
+  // spatial smearing raises the spatial plaquette and stays in SU(3)
+  double3 plaq = plaquette(U, QUDA_CPU_FIELD_LOCATION);
+  printfQuda("Host STOUT: spatial plaquette %e -> %e\n", plaq0.y, plaq.y);
+  ASSERT_GT(plaq.y, plaq0.y);
+  ASSERT_TRUE(isUnitary(U, 1e-12));
+
+  // and agrees with the device
+  double max_dev = 0.0;
+  const double *u = (const double*)U.Gauge_p();
+  const double *u_ref = (const double*)Uref.Gauge_p();
+  for (int i=0; i<4*U.Volume()*18; i++) max_dev = MAX(max_dev, DABS(u[i] - u_ref[i]));
+  printfQuda("Host STOUT: deviation from the device %e\n", max_dev);
+  ASSERT_LT(max_dev, 1e-12);
+}
+
+
+
+
+/**
+   Taylor series of exp(iQ), summed far enough that the remainder is
+   below double precision for |Q| of order one.
+ */
+static Matrix<complex<double>,3> expTaylor(const Matrix<complex<double>,3> &Q)
+{
+  Matrix<complex<double>,3> sum, term;
+  setIdentity(&sum);
+  setIdentity(&term);
+  for (int n=1; n<40; n++) {
+    term = term * Q;
+    term = term * complex<double>(0.0, 1.0/n);
+    sum = sum + term;
+  }
+  return sum;
+}
+
+TEST(ExponentiateIQ,NegativeDeterminant){
+  // exponentiate_iQ maps det Q < 0 onto det Q > 0 by symmetry; compare
+  // both signs with the Taylor series over a range of norms
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  double max_dev[2] = {0.0, 0.0};
+
+  for (int trial=0; trial<200; trial++) {
+    // random hermitian traceless Q
+    Matrix<complex<double>,3> A, Q;
+    for (int i=0; i<3; i++)
+      for (int j=0; j<3; j++) A(i,j) = complex<double>(uniform(gen), uniform(gen));
+    Q = A + conj(A);
+    complex<double> tr = getTrace(Q) / 3.0;
+    for (int i=0; i<3; i++) Q(i,i) -= tr;
+    Q = Q * (0.05 + 0.2 * (trial % 10));
+
+    // det(-Q) = -det(Q), so each trial covers both signs
+    for (int sign=0; sign<2; sign++) {
+      Matrix<complex<double>,3> E, T;
+      exponentiate_iQ(Q, &E);
+      T = expTaylor(Q);
+      const int negative = getDeterminant(Q).x < 0 ? 1 : 0;
+      for (int i=0; i<3; i++)
+	for (int j=0; j<3; j++) max_dev[negative] = MAX(max_dev[negative], abs(E(i,j) - T(i,j)));
+      Q = -Q;
+    }
+  }
+
+  printfQuda("exp(iQ) deviation from the Taylor series: det Q > 0 %e, det Q < 0 %e\n", max_dev[0], max_dev[1]);
+  ASSERT_LT(max_dev[0], 1e-12);
+  ASSERT_LT(max_dev[1], 1e-12);
+}
+
 int main(int argc, char **argv){
   // initalize google test, includes command line options
   ::testing::InitGoogleTest(&argc, argv);
@@ -9,8 +9,10 @@
 #include "gauge_force_reference.h"
 #include "gauge_force_quda.h"
 #include <sys/time.h>
+#include <vector>
 #include "fat_force_quda.h"
 #include <dslash_quda.h>
+#include <comm_quda.h>
 
 #ifdef MULTI_GPU
 #include <face_quda.h>
@@ -347,6 +349,423 @@ int path_dir_t[][5] = {
 
 
 
+/**
+   Time the force of the standard improved actions, which use
+   subsets of the paths above: the plaquette staples (Wilson), plus
+   the rectangles (tree-level Symanzik, Iwasaki, DBW2), plus the
+   chairs (one-loop Luscher-Weisz).  The gauge field and momentum are
+   kept resident so that only the force computation and the extended
+   gauge field construction are timed.  The flops are those of the
+   path tree, with the count for independent paths for comparison.
+ */
+static void
+benchmark_actions(void *mom, void *sitelink, int **input_path_buf[4], const double *loop_coeff,
+		  int num_paths, int max_length, double eb3)
+{
+  const char *action[] = { "Wilson", "Symanzik", "Luscher-Weisz" };
+  const int action_paths[] = { 6, 24, 48 };
+
+  QudaGaugeParam param = qudaGaugeParam;
+  param.make_resident_gauge = 1;
+  param.make_resident_mom = 1;
+  param.return_result_mom = 0;
+  computeGaugeForceQuda(mom, sitelink, input_path_buf, length, const_cast<double*>(loop_coeff),
+			num_paths, max_length, eb3, &param);
+  param.use_resident_gauge = 1;
+  param.use_resident_mom = 1;
+
+  std::vector<double> coeff(num_paths);
+  for (int a = 0; a < 3; a++) {
+    if (action_paths[a] > num_paths) break;
+    for (int i = 0; i < num_paths; i++) coeff[i] = i < action_paths[a] ? loop_coeff[i] : 0.0;
+
+    computeGaugeForceQuda(mom, sitelink, input_path_buf, length, coeff.data(),
+			  num_paths, max_length, eb3, &param); // tuning
+
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    for (int i = 0; i < attempts; i++) {
+      computeGaugeForceQuda(mom, sitelink, input_path_buf, length, coeff.data(),
+			    num_paths, max_length, eb3, &param);
+    }
+    gettimeofday(&t1, NULL);
+    double secs = (t1.tv_sec - t0.tv_sec + 0.000001*(t1.tv_usec - t0.tv_usec)) / attempts;
+
+    long long tree_flops = quda::gaugeForceFlops(input_path_buf, length, coeff.data(), num_paths, true);
+    long long path_flops = quda::gaugeForceFlops(input_path_buf, length, coeff.data(), num_paths, false);
+    printfQuda("%-14s %2d paths: %8.3f ms, %7.2f GFLOPS, %lld flops/site (%lld without sharing sub-paths)\n",
+	       action[a], action_paths[a], secs*1e3, 1e-9*tree_flops*V/secs, tree_flops, path_flops);
+  }
+}
+
+/**
+   Check the path tree against the independent evaluation of every
+   path: both are run on the host, in double precision, on the test's
+   random gauge field, and must agree at every site up to rounding.
+ */
+static void
+test_path_tree(void *sitelink_milc, int **input_path_buf[4], double *loop_coeff, int num_paths, int max_length)
+{
+  // the host force reads a regular extended field, so single node only
+  if (comm_dim_partitioned(0) || comm_dim_partitioned(1) || comm_dim_partitioned(2) || comm_dim_partitioned(3)) return;
+
+  using namespace quda;
+  GaugeFieldParam gParam(qudaGaugeParam.X, QUDA_DOUBLE_PRECISION, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY,
+			 QUDA_GHOST_EXCHANGE_NO);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.order = QUDA_MILC_GAUGE_ORDER;
+  gParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParam.t_boundary = QUDA_PERIODIC_T;
+  cpuGaugeField U(gParam);
+
+  double *u = (double*)U.Gauge_p();
+  for (size_t i=0; i<4*(size_t)V*gaugeSiteSize; i++)
+    u[i] = qudaGaugeParam.cpu_prec == QUDA_DOUBLE_PRECISION ? ((double*)sitelink_milc)[i] : ((float*)sitelink_milc)[i];
+
+  int R[4], E[4];
+  for (int d=0; d<4; d++) { R[d] = 2; E[d] = qudaGaugeParam.X[d] + 2*R[d]; }
+  GaugeFieldParam gParamEx(E, QUDA_DOUBLE_PRECISION, QUDA_RECONSTRUCT_NO, 0, QUDA_VECTOR_GEOMETRY,
+			   QUDA_GHOST_EXCHANGE_EXTENDED);
+  gParamEx.create = QUDA_NULL_FIELD_CREATE;
+  gParamEx.order = QUDA_MILC_GAUGE_ORDER;
+  gParamEx.siteSubset = QUDA_FULL_SITE_SUBSET;
+  gParamEx.t_boundary = QUDA_PERIODIC_T;
+  for (int d=0; d<4; d++) gParamEx.r[d] = R[d];
+  cpuGaugeField Uex(gParamEx);
+  copyExtendedGauge(Uex, U, QUDA_CPU_FIELD_LOCATION);
+  Uex.exchangeExtendedGhost(R, true);
+
+  GaugeFieldParam gParamMom(gParam);
+  gParamMom.create = QUDA_ZERO_FIELD_CREATE;
+  gParamMom.reconstruct = QUDA_RECONSTRUCT_10;
+  gParamMom.link_type = QUDA_ASQTAD_MOM_LINKS;
+  cpuGaugeField momTree(gParamMom);
+  cpuGaugeField momPath(gParamMom);
+
+  gaugeForce(momTree, Uex, 1.0, input_path_buf, length, loop_coeff, num_paths, max_length, true);
+  gaugeForce(momPath, Uex, 1.0, input_path_buf, length, loop_coeff, num_paths, max_length, false);
+
+  const double *tree = (const double*)momTree.Gauge_p();
+  const double *path = (const double*)momPath.Gauge_p();
+  double max_diff = 0.0, max_force = 0.0;
+  for (size_t i=0; i<4*(size_t)V*momSiteSize; i++) {
+    max_diff = std::max(max_diff, fabs(tree[i] - path[i]));
+    max_force = std::max(max_force, fabs(path[i]));
+  }
+
+  int res = max_diff <= 1e-12 * max_force;
+  printfQuda("Path tree against per-path evaluation: maximum difference %e (maximum force element %e)\n",
+	     max_diff, max_force);
+  printfQuda("Path tree test %s\n", (1 == res) ? "PASSED" : "FAILED");
+}
+
+/**
+   Compare a leapfrog trajectory driven through the per-call
+   interface, where every force and link update moves the gauge field
+   and momentum between host and device, with the same trajectory run
+   by integrateTrajectoryQuda on resident fields.  The two agree up to
+   rounding, since the resident integrator merges the momentum updates
+   of consecutive steps.
+ */
+static void
+benchmark_trajectory(void *mom, void *sitelink_milc, int **input_path_buf[4], double *loop_coeff,
+		     int num_paths, int max_length)
+{
+  // the link update does not support 8-parameter reconstruction
+  if (qudaGaugeParam.reconstruct == QUDA_RECONSTRUCT_8) return;
+
+  const int n_step = 8;
+  const double dt = 0.02, coeff = 6.0/3.0; // beta/3 for MILC-normalized loops
+  size_t gauge_bytes = 4*V*gaugeSiteSize*qudaGaugeParam.cpu_prec;
+  size_t mom_bytes = 4*V*momSiteSize*qudaGaugeParam.cpu_prec;
+
+  QudaGaugeParam param = qudaGaugeParam;
+  param.gauge_order = QUDA_MILC_GAUGE_ORDER;
+  param.use_resident_gauge = 0;
+  param.use_resident_mom = 0;
+  param.make_resident_gauge = 0;
+  param.make_resident_mom = 0;
+  param.return_result_gauge = 1;
+  param.return_result_mom = 1;
+  param.overwrite_mom = 0;
+
+  void *gauge_call = safe_malloc(gauge_bytes);
+  void *mom_call = safe_malloc(mom_bytes);
+  memcpy(gauge_call, sitelink_milc, gauge_bytes);
+  memcpy(mom_call, mom, mom_bytes);
+
+  struct timeval t0, t1;
+  gettimeofday(&t0, NULL);
+  for (int i = 0; i < n_step; i++) {
+    computeGaugeForceQuda(mom_call, gauge_call, input_path_buf, length, loop_coeff,
+			  num_paths, max_length, 0.5*dt*coeff, &param);
+    updateGaugeFieldQuda(gauge_call, mom_call, dt, 0, 1, &param);
+    computeGaugeForceQuda(mom_call, gauge_call, input_path_buf, length, loop_coeff,
+			  num_paths, max_length, 0.5*dt*coeff, &param);
+  }
+  gettimeofday(&t1, NULL);
+  double call_secs = t1.tv_sec - t0.tv_sec + 0.000001*(t1.tv_usec - t0.tv_usec);
+
+  void *gauge_md = safe_malloc(gauge_bytes);
+  void *mom_md = safe_malloc(mom_bytes);
+  memcpy(gauge_md, sitelink_milc, gauge_bytes);
+  memcpy(mom_md, mom, mom_bytes);
+
+  QudaForceTerm term;
+  term.type = QUDA_GAUGE_FORCE_TERM;
+  term.input_path_buf = input_path_buf;
+  term.path_length = length;
+  term.loop_coeff = loop_coeff;
+  term.num_paths = num_paths;
+  term.max_length = max_length;
+  term.coeff = coeff;
+  term.callback = NULL;
+  term.context = NULL;
+
+  QudaIntegratorParam md_param = newQudaIntegratorParam();
+  md_param.n_level = 1;
+  md_param.integrator[0] = QUDA_LEAPFROG_INTEGRATOR;
+  md_param.n_step[0] = n_step;
+  md_param.n_term[0] = 1;
+  md_param.term[0] = &term;
+  md_param.tau = n_step*dt;
+
+  gettimeofday(&t0, NULL);
+  double dH = integrateTrajectoryQuda(gauge_md, mom_md, &md_param, &param);
+  gettimeofday(&t1, NULL);
+  double md_secs = t1.tv_sec - t0.tv_sec + 0.000001*(t1.tv_usec - t0.tv_usec);
+
+  printfQuda("Leapfrog trajectory of %d steps: %.3f ms per-call, %.3f ms resident (%d force evaluations), dH = %e\n",
+	     n_step, call_secs*1e3, md_secs*1e3, md_param.n_force[0], dH);
+
+  int res = compare_floats(gauge_call, gauge_md, 4*V*gaugeSiteSize, 1e-5, qudaGaugeParam.cpu_prec);
+  res &= compare_floats(mom_call, mom_md, 4*V*momSiteSize, 1e-5, qudaGaugeParam.cpu_prec);
+  printfQuda("Resident trajectory test %s\n", (1 == res) ? "PASSED" : "FAILED");
+
+  freeGaugeQuda();
+  host_free(gauge_call);
+  host_free(mom_call);
+  host_free(gauge_md);
+  host_free(mom_md);
+}
+
+/**
+   A gauge-force term handed to integrateTrajectoryQuda as a callback,
+   which adds its force to the resident momentum through
+   computeGaugeForceQuda
+ */
+struct GaugeForceCallback {
+  int ***input_path_buf;
+  double *loop_coeff;
+  int num_paths;
+  int max_length;
+  double coeff;
+  QudaGaugeParam param;
+};
+
+static void
+gauge_force_callback(double dt, void *context)
+{
+  GaugeForceCallback &c = *static_cast<GaugeForceCallback*>(context);
+  computeGaugeForceQuda(NULL, NULL, c.input_path_buf, length, c.loop_coeff, c.num_paths, c.max_length,
+			dt*c.coeff, &c.param);
+}
+
+static QudaForceTerm
+gauge_term(int ***input_path_buf, double *loop_coeff, int num_paths, int max_length, double coeff)
+{
+  QudaForceTerm term;
+  term.type = QUDA_GAUGE_FORCE_TERM;
+  term.input_path_buf = input_path_buf;
+  term.path_length = length;
+  term.loop_coeff = loop_coeff;
+  term.num_paths = num_paths;
+  term.max_length = max_length;
+  term.coeff = coeff;
+  term.callback = NULL;
+  term.context = NULL;
+  return term;
+}
+
+/**
+   Test the resident integrators on the tree-level Symanzik action,
+   the plaquette and rectangle paths with coefficients 1 and -1/20,
+   whose force derives from the action computed from the loops:
+   - the energy violation dH falls as dt^2 for leapfrog and Omelyan
+     and as dt^4 for the force-gradient integrator (double precision
+     only, where rounding does not mask the dt^4 term);
+   - the change of the Wilson action agrees with the plaquette;
+   - a two-level leapfrog with one inner step per outer step matches
+     the single-level leapfrog with both terms, since the inner
+     momentum updates merge;
+   - running the plaquette term as a callback gives the same
+     trajectory, and returns the momentum action change only.
+ */
+static void
+test_integrators(void *mom, void *sitelink_milc, int **input_path_buf[4], int num_paths, int max_length)
+{
+  if (qudaGaugeParam.reconstruct == QUDA_RECONSTRUCT_8) return;
+  if (num_paths < 24) return;
+
+  const double coeff = 6.0/3.0, tau = 0.16;
+  size_t gauge_bytes = 4*V*gaugeSiteSize*qudaGaugeParam.cpu_prec;
+  size_t mom_bytes = 4*V*momSiteSize*qudaGaugeParam.cpu_prec;
+  const double tol = qudaGaugeParam.cuda_prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+
+  QudaGaugeParam param = qudaGaugeParam;
+  param.gauge_order = QUDA_MILC_GAUGE_ORDER;
+  param.use_resident_gauge = 0;
+  param.use_resident_mom = 0;
+  param.make_resident_gauge = 0;
+  param.make_resident_mom = 0;
+  param.return_result_gauge = 1;
+  param.return_result_mom = 1;
+  param.overwrite_mom = 0;
+
+  std::vector<double> plaq_coeff(num_paths, 0.0), rect_coeff(num_paths, 0.0), symanzik(num_paths, 0.0);
+  for (int i = 0; i < 6; i++) plaq_coeff[i] = symanzik[i] = 1.0;
+  for (int i = 6; i < 24; i++) rect_coeff[i] = symanzik[i] = -1.0/20.0;
+
+  void *gauge_md = safe_malloc(gauge_bytes);
+  void *mom_md = safe_malloc(mom_bytes);
+  void *gauge_ref = safe_malloc(gauge_bytes);
+  void *mom_ref = safe_malloc(mom_bytes);
+
+  auto trajectory = [&](QudaIntegratorParam &md_param, void *gauge, void *momentum) {
+    memcpy(gauge, sitelink_milc, gauge_bytes);
+    memcpy(momentum, mom, mom_bytes);
+    return integrateTrajectoryQuda(gauge, momentum, &md_param, &param);
+  };
+
+  int res = 1;
+
+  // order of the energy violation
+  QudaForceTerm term = gauge_term(input_path_buf, symanzik.data(), num_paths, max_length, coeff);
+  const QudaIntegratorType integrator[] = { QUDA_LEAPFROG_INTEGRATOR, QUDA_OMELYAN_INTEGRATOR, QUDA_FORCE_GRADIENT_INTEGRATOR };
+  const char *name[] = { "leapfrog", "Omelyan", "force-gradient" };
+  const int order[] = { 2, 2, 4 };
+  const int n_step[] = { 8, 4, 2 };
+  for (int i = 0; i < 3; i++) {
+    QudaIntegratorParam md_param = newQudaIntegratorParam();
+    md_param.n_level = 1;
+    md_param.integrator[0] = integrator[i];
+    md_param.n_term[0] = 1;
+    md_param.term[0] = &term;
+    md_param.tau = tau;
+
+    md_param.n_step[0] = n_step[i];
+    double dH = trajectory(md_param, gauge_md, mom_md);
+    md_param.n_step[0] = 2*n_step[i];
+    double dH_fine = trajectory(md_param, gauge_md, mom_md);
+
+    double ratio = fabs(dH / dH_fine);
+    printfQuda("%-14s dH = %e (%d steps), %e (%d steps), ratio %.2f, expected %d\n",
+	       name[i], dH, n_step[i], dH_fine, 2*n_step[i], ratio, 1 << order[i]);
+    if (qudaGaugeParam.cuda_prec == QUDA_DOUBLE_PRECISION && ratio < 0.6 * (1 << order[i])) res = 0;
+  }
+
+  // the gauge action computed from the loops agrees with the plaquette
+  {
+    QudaForceTerm wilson = gauge_term(input_path_buf, plaq_coeff.data(), num_paths, max_length, coeff);
+    QudaIntegratorParam md_param = newQudaIntegratorParam();
+    md_param.n_level = 1;
+    md_param.integrator[0] = QUDA_LEAPFROG_INTEGRATOR;
+    md_param.n_step[0] = 8;
+    md_param.n_term[0] = 1;
+    md_param.term[0] = &wilson;
+    md_param.tau = tau;
+
+    double plaq0[3], plaq1[3];
+    QudaGaugeParam load_param = param;
+    load_param.type = QUDA_WILSON_LINKS;
+    loadGaugeQuda(sitelink_milc, &load_param);
+    plaqQuda(plaq0);
+    trajectory(md_param, gauge_md, mom_md);
+    plaqQuda(plaq1);
+
+    double dS = md_param.gauge_action[1] - md_param.gauge_action[0];
+    double dS_plaq = -coeff * 18.0 * V * comm_size() * (plaq1[0] - plaq0[0]);
+    printfQuda("Wilson action change from the loops %e, from the plaquette %e\n", dS, dS_plaq);
+    if (fabs(dS - dS_plaq) > tol * 18.0 * coeff * V * comm_size()) res = 0;
+  }
+
+  // two levels, the rectangles outside and the plaquettes inside
+  QudaForceTerm rect = gauge_term(input_path_buf, rect_coeff.data(), num_paths, max_length, coeff);
+  QudaForceTerm plaq = gauge_term(input_path_buf, plaq_coeff.data(), num_paths, max_length, coeff);
+  QudaForceTerm both[2] = { rect, plaq };
+  {
+    QudaIntegratorParam md_param = newQudaIntegratorParam();
+    md_param.n_level = 1;
+    md_param.integrator[0] = QUDA_LEAPFROG_INTEGRATOR;
+    md_param.n_step[0] = 8;
+    md_param.n_term[0] = 2;
+    md_param.term[0] = both;
+    md_param.tau = tau;
+    double dH = trajectory(md_param, gauge_ref, mom_ref);
+    double dS_mom = md_param.mom_action[1] - md_param.mom_action[0];
+
+    QudaIntegratorParam md2_param = newQudaIntegratorParam();
+    md2_param.n_level = 2;
+    md2_param.integrator[0] = QUDA_LEAPFROG_INTEGRATOR;
+    md2_param.integrator[1] = QUDA_LEAPFROG_INTEGRATOR;
+    md2_param.n_step[0] = 8;
+    md2_param.n_step[1] = 1;
+    md2_param.n_term[0] = 1;
+    md2_param.n_term[1] = 1;
+    md2_param.term[0] = &rect;
+    md2_param.term[1] = &plaq;
+    md2_param.tau = tau;
+    double dH2 = trajectory(md2_param, gauge_md, mom_md);
+    printfQuda("Two-level leapfrog dH = %e, single level dH = %e\n", dH2, dH);
+
+    int res2 = compare_floats(gauge_ref, gauge_md, 4*V*gaugeSiteSize, 1e-5, qudaGaugeParam.cpu_prec);
+    res2 &= compare_floats(mom_ref, mom_md, 4*V*momSiteSize, 1e-5, qudaGaugeParam.cpu_prec);
+    if (md2_param.n_force[0] != 9 + 2*8) res2 = 0; // merged outer updates, two inner updates per outer step
+    res &= res2;
+    printfQuda("Two-level trajectory test %s\n", (1 == res2) ? "PASSED" : "FAILED");
+
+    // the plaquette term as a callback on the resident fields
+    GaugeForceCallback context;
+    context.input_path_buf = input_path_buf;
+    context.loop_coeff = plaq_coeff.data();
+    context.num_paths = num_paths;
+    context.max_length = max_length;
+    context.coeff = coeff;
+    context.param = qudaGaugeParam;
+    context.param.use_resident_gauge = 1;
+    context.param.make_resident_gauge = 1;
+    context.param.use_resident_mom = 1;
+    context.param.make_resident_mom = 1;
+    context.param.return_result_gauge = 0;
+    context.param.return_result_mom = 0;
+    context.param.overwrite_mom = 0;
+
+    QudaForceTerm callback = plaq;
+    callback.type = QUDA_CALLBACK_FORCE_TERM;
+    callback.callback = gauge_force_callback;
+    callback.context = &context;
+    QudaForceTerm mixed[2] = { rect, callback };
+    md_param.term[0] = mixed;
+    double dS_cb = trajectory(md_param, gauge_md, mom_md);
+    printfQuda("Callback trajectory dS_mom = %e, gauge-only dS_mom = %e\n", dS_cb, dS_mom);
+
+    int res3 = compare_floats(gauge_ref, gauge_md, 4*V*gaugeSiteSize, 1e-5, qudaGaugeParam.cpu_prec);
+    res3 &= compare_floats(mom_ref, mom_md, 4*V*momSiteSize, 1e-5, qudaGaugeParam.cpu_prec);
+    if (md_param.n_force[1] != 9 || md_param.gauge_action[0] != 0.0 || md_param.gauge_action[1] != 0.0) res3 = 0;
+    if (fabs(dS_cb - dS_mom) > tol * fabs(md_param.mom_action[0])) res3 = 0;
+    res &= res3;
+    printfQuda("Callback trajectory test %s\n", (1 == res3) ? "PASSED" : "FAILED");
+  }
+
+  printfQuda("Integrator test %s\n", (1 == res) ? "PASSED" : "FAILED");
+
+  freeGaugeQuda();
+  host_free(gauge_md);
+  host_free(mom_md);
+  host_free(gauge_ref);
+  host_free(mom_ref);
+}
+
 static void
 gauge_force_test(void) 
 {
@@ -566,6 +985,11 @@ gauge_force_test(void)
   double perf = 1.0* flops*V/(total_time*1e+9);
   printf("total time =%.2f ms\n", total_time*1e+3);
   printf("overall performance : %.2f GFLOPS\n",perf);
+
+  if (verify_results) test_path_tree(sitelink_1d, input_path_buf, loop_coeff_d, num_paths, max_length);
+  benchmark_actions(mom, sitelink, input_path_buf, loop_coeff_d, num_paths, max_length, eb3);
+  benchmark_trajectory(refmom, sitelink_1d, input_path_buf, loop_coeff_d, num_paths, max_length);
+  if (verify_results) test_integrators(refmom, sitelink_1d, input_path_buf, num_paths, max_length);
   
   for(int dir = 0; dir < 4; dir++){
     for(int i=0;i < num_paths; i++) host_free(input_path_buf[dir][i]);
@@ -3,6 +3,7 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <sys/time.h>
 
 #include <util_quda.h>
 #include <test_util.h>
@@ -43,6 +44,7 @@ extern int gridsize_from_cmdline[];
 extern QudaPrecision prec;
 extern QudaPrecision  prec_sloppy;
 extern QudaPrecision  prec_precondition;
+extern QudaPrecision  prec_offset;
 extern QudaReconstructType link_recon;
 extern QudaReconstructType link_recon_sloppy;
 extern QudaReconstructType link_recon_precondition;
@@ -258,6 +260,9 @@ int main(int argc, char **argv)
   inv_param.cpu_prec = cpu_prec;
   inv_param.cuda_prec = cuda_prec;
   inv_param.cuda_prec_sloppy = cuda_prec_sloppy;
+  // optionally keep the heavier shifts in lower precision
+  for (int i=0; i<inv_param.num_offset; i++)
+    inv_param.cuda_prec_offset[i] = (i >= inv_param.num_offset/2 && prec_offset != QUDA_INVALID_PRECISION) ? prec_offset : cuda_prec_sloppy;
   inv_param.preserve_source = QUDA_PRESERVE_SOURCE_YES;
   inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
   inv_param.dirac_order = QUDA_DIRAC_ORDER;
@@ -402,6 +407,63 @@ int main(int argc, char **argv)
   printfQuda("\nDone: %i iter / %g secs = %g Gflops, total time = %g secs\n", 
 	 inv_param.iter, inv_param.secs, inv_param.gflops/inv_param.secs, time0);
 
+  // rebuild the clover term and its inverse on the host and compare with the device
+  if (compute_clover && (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH)) {
+    size_t cSize = inv_param.clover_cpu_prec;
+    void *clover_host = malloc(V*cloverSiteSize*cSize);
+    void *clover_inv_host = malloc(V*cloverSiteSize*cSize);
+    double trlog_device[2] = { inv_param.trlogA[0], inv_param.trlogA[1] };
+
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    computeCloverHostQuda(clover_host, clover_inv_host, (void*)gauge, &gauge_param, &inv_param);
+    gettimeofday(&t1, NULL);
+    double secs = (t1.tv_sec - t0.tv_sec) + 1e-6*(t1.tv_usec - t0.tv_usec);
+
+    // the device only inverts the clover term for preconditioned solves
+    bool pc_solve = inv_param.solve_type == QUDA_DIRECT_PC_SOLVE || inv_param.solve_type == QUDA_NORMOP_PC_SOLVE;
+    double dev[2] = { 0.0, 0.0 };
+    for (int i=0; i<V*cloverSiteSize; i++) {
+      double a = cSize == sizeof(double) ? ((double*)clover)[i] - ((double*)clover_host)[i] :
+	((float*)clover)[i] - ((float*)clover_host)[i];
+      double b = cSize == sizeof(double) ? ((double*)clover_inv)[i] - ((double*)clover_inv_host)[i] :
+	((float*)clover_inv)[i] - ((float*)clover_inv_host)[i];
+      dev[0] = fabs(a) > dev[0] ? fabs(a) : dev[0];
+      if (pc_solve) dev[1] = fabs(b) > dev[1] ? fabs(b) : dev[1];
+    }
+    printfQuda("Host clover in %g secs: max deviation from device clover = %e, inverse = %e\n", secs, dev[0], dev[1]);
+    if (pc_solve && inv_param.compute_clover_trlog)
+      printfQuda("Host clover trlog = (%e, %e), device = (%e, %e)\n",
+		 inv_param.trlogA[0], inv_param.trlogA[1], trlog_device[0], trlog_device[1]);
+
+    free(clover_inv_host);
+    free(clover_host);
+  }
+
+#ifdef GPU_CONTRACT
+  // benchmark the batched meson contractions, using the solution for
+  // every spin-color column of the propagator
+  if (!multishift && inv_param.solution_type == QUDA_MAT_SOLUTION && inv_param.Ls == 1) {
+    void *prop[12];
+    for (int j=0; j<12; j++) prop[j] = spinorOut;
+    const int n_gamma = 16, n_mom = 7;
+    int gamma[n_gamma];
+    for (int g=0; g<n_gamma; g++) gamma[g] = g;
+    const int mom[3*n_mom] = { 0,0,0, 1,0,0, -1,0,0, 0,1,0, 0,-1,0, 0,0,1, 0,0,-1 };
+    double *corr = (double*)malloc(2*n_gamma*n_gamma*n_mom*tdim*gridsize_from_cmdline[3]*sizeof(double));
+
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    contractMesonsQuda(corr, prop, prop, n_gamma, gamma, n_gamma, gamma, n_mom, mom, &inv_param);
+    gettimeofday(&t1, NULL);
+    double secs = (t1.tv_sec - t0.tv_sec) + 1e-6*(t1.tv_usec - t0.tv_usec);
+
+    printfQuda("Meson contractions: %d gamma pairs x %d momenta in %g secs = %g site contractions/s per process\n",
+	       n_gamma*n_gamma, n_mom, secs, (double)V*n_gamma*n_gamma*n_mom/secs);
+    free(corr);
+  }
+#endif
+
   if (multishift) {
     if (inv_param.mass_normalization == QUDA_MASS_NORMALIZATION) {
       errorQuda("Mass normalization not supported for multi-shift solver in invert_test");
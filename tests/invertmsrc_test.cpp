@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
+#include <sys/time.h>
 #include <math.h>
 #include <string.h>
 
@@ -56,6 +57,8 @@ extern QudaMatPCType matpc_type; // preconditioning type
 
 extern int niter; // max solver iterations
 extern char latfile[];
+extern char prop_outfile[];
+extern QudaPrecision prop_save_prec;
 
 extern void usage(char** );
 
@@ -442,8 +445,34 @@ int main(int argc, char **argv)
   printfQuda("\nDone: %i iter / %g secs = %g Gflops, total time = %g secs\n",
 	 inv_param.iter, inv_param.secs, inv_param.gflops/inv_param.secs, time0);
 
+   // with --prop-save each solution is queued for writing as soon as
+   // it is returned, overlapping the I/O with the next solve
+   bool save_props = strcmp(prop_outfile, "") != 0;
+   if (save_props && inv_param.Ls != 1) {
+     warningQuda("Saving solutions only supported for Ls = 1");
+     save_props = false;
+   }
+   double io_time = 0.0;
    for(int i = 0; i < inv_param.num_src ; i++){
      invertQuda(spinorOutMulti[i], spinorIn[i], &inv_param);
+     if (save_props) {
+       char filename[512];
+       sprintf(filename, "%s.%d", prop_outfile, i);
+       struct timeval t0, t1;
+       gettimeofday(&t0, NULL);
+       write_spinor_field_async(filename, &spinorOutMulti[i], inv_param.cpu_prec, prop_save_prec,
+				gauge_param.X, 3, 4, 1);
+       gettimeofday(&t1, NULL);
+       io_time += (t1.tv_sec - t0.tv_sec) + 1e-6*(t1.tv_usec - t0.tv_usec);
+     }
+   }
+   if (save_props) {
+     struct timeval t0, t1;
+     gettimeofday(&t0, NULL);
+     write_spinor_field_wait();
+     gettimeofday(&t1, NULL);
+     io_time += (t1.tv_sec - t0.tv_sec) + 1e-6*(t1.tv_usec - t0.tv_usec);
+     printfQuda("Saved %d solutions, time spent blocked on output = %g secs\n", inv_param.num_src, io_time);
    }
 
 //  if (true) {
@@ -1278,5 +1278,52 @@ get_df_mem_type_ritz(char* s)
   return ret;
 }
 
+QudaMultigridCycleType
+get_mg_cycle_type(char* s)
+{
+  QudaMultigridCycleType ret = QUDA_MG_CYCLE_INVALID;
+
+  if (strcmp(s, "vcycle") == 0) {
+    ret = QUDA_MG_CYCLE_VCYCLE;
+  } else if (strcmp(s, "wcycle") == 0) {
+    ret = QUDA_MG_CYCLE_WCYCLE;
+  } else if (strcmp(s, "kcycle") == 0) {
+    ret = QUDA_MG_CYCLE_KCYCLE;
+  } else if (strcmp(s, "recursive") == 0) {
+    ret = QUDA_MG_CYCLE_RECURSIVE;
+  } else {
+    fprintf(stderr, "Error: invalid multigrid cycle type %s\n", s);
+    exit(1);
+  }
+
+  return ret;
+}
+
+const char*
+get_mg_cycle_str(QudaMultigridCycleType type)
+{
+  const char* ret;
 
+  switch (type) {
+  case QUDA_MG_CYCLE_VCYCLE:
+    ret = "vcycle";
+    break;
+  case QUDA_MG_CYCLE_FCYCLE:
+    ret = "fcycle";
+    break;
+  case QUDA_MG_CYCLE_WCYCLE:
+    ret = "wcycle";
+    break;
+  case QUDA_MG_CYCLE_KCYCLE:
+    ret = "kcycle";
+    break;
+  case QUDA_MG_CYCLE_RECURSIVE:
+    ret = "recursive";
+    break;
+  default:
+    fprintf(stderr, "Error: invalid multigrid cycle type %d\n", type);
+    exit(1);
+  }
 
+  return ret;
+}
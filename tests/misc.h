@@ -50,6 +50,9 @@ extern "C" {
 
   QudaMemoryType get_df_mem_type_ritz(char* s);
 
+  QudaMultigridCycleType get_mg_cycle_type(char* s);
+  const char* get_mg_cycle_str(QudaMultigridCycleType type);
+
 
 #ifdef __cplusplus
 }
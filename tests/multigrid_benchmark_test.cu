@@ -12,11 +12,12 @@
 // include because of nasty globals used in the tests
 #include <dslash_util.h>
 #include <dirac_quda.h>
+#include <transfer.h>
 #include <algorithm>
 
 extern QudaDslashType dslash_type;
 extern QudaInverterType inv_type;
-extern int nvec;
+extern int nvec[];
 extern int device;
 extern int xdim;
 extern int ydim;
@@ -32,6 +33,7 @@ extern bool verify_results;
 extern int test_type;
 
 extern QudaPrecision prec;
+extern QudaPrecision coarse_link_prec;
 
 extern void usage(char** );
 
@@ -42,6 +44,7 @@ ColorSpinorField *xD, *yD;
 
 cpuGaugeField *Y_h, *X_h, *Xinv_h, *Yhat_h;
 cudaGaugeField *Y_d, *X_d, *Xinv_d, *Yhat_d;
+cudaGaugeField *Y_half_d, *Yhat_half_d;
 
 int Nspin;
 int Ncolor;
@@ -61,7 +64,32 @@ display_test_info()
   return;
 }
 
-void initFields(QudaPrecision prec)
+// fill a host coarse link field with uniform random numbers in [-1,1]
+template <typename Float>
+void fillRandom(cpuGaugeField &u) {
+  const int geometry = u.Geometry();
+  const int length = u.Volume() * 2 * u.Ncolor() * u.Ncolor();
+  Float **gauge = static_cast<Float**>(u.Gauge_p());
+  for (int d=0; d<geometry; d++)
+    for (int i=0; i<length; i++) gauge[d][i] = 2.0*rand()/(double)RAND_MAX - 1.0;
+}
+
+// create half-precision copies of the device Y and Yhat fields
+void initHalfLinks()
+{
+  GaugeFieldParam gParam(*Y_d);
+  gParam.precision = QUDA_HALF_PRECISION;
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+
+  // each link matrix is encoded with its own scale during the copy
+  Y_half_d = new cudaGaugeField(gParam);
+  Y_half_d->copy(*Y_d);
+
+  Yhat_half_d = new cudaGaugeField(gParam);
+  Yhat_half_d->copy(*Yhat_d);
+}
+
+void initFields(QudaPrecision prec, bool half_links)
 {
   ColorSpinorParam param;
   param.nColor = Ncolor;
@@ -133,6 +161,14 @@ void initFields(QudaPrecision prec)
   X_h = new cpuGaugeField(gParam);
   Xinv_h = new cpuGaugeField(gParam);
 
+  // the half-precision links are scaled by the maximum of each link matrix so need non-trivial data
+  if (half_links) {
+    fillRandom<double>(*Y_h);
+    fillRandom<double>(*Yhat_h);
+    fillRandom<double>(*X_h);
+    fillRandom<double>(*Xinv_h);
+  }
+
   gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
   gParam.geometry = QUDA_COARSE_GEOMETRY;
   gParam.nFace = 1;
@@ -153,6 +189,11 @@ void initFields(QudaPrecision prec)
   Xinv_d = new cudaGaugeField(gParam);
   X_d->copy(*X_h);
   Xinv_d->copy(*Xinv_h);
+
+  if (half_links) {
+    static_cast<cudaColorSpinorField*>(yD)->Source(QUDA_RANDOM_SOURCE);
+    initHalfLinks();
+  }
 }
 
 
@@ -173,11 +214,92 @@ void freeFields()
   delete X_d;
   delete Xinv_d;
   delete Yhat_d;
+
+  if (Y_half_d) delete Y_half_d;
+  if (Yhat_half_d) delete Yhat_half_d;
+  Y_half_d = nullptr;
+  Yhat_half_d = nullptr;
 }
 
 DiracCoarse *dirac;
+DiracCoarse *dirac_half; // coarse operator with half-precision links
+
+// host transfer-operator benchmark state
+std::vector<ColorSpinorField*> B;
+ColorSpinorField *fineH, *coarseH;
+Transfer *transfer;
+TimeProfile profile_transfer("multigrid_benchmark_test");
+
+void initTransfer(QudaPrecision prec, int Nvec)
+{
+  ColorSpinorParam param;
+  param.nColor = 3;
+  param.nSpin = 4;
+  param.nDim = 4;
+
+  param.pad = 0;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.x[0] = xdim;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.PCtype = QUDA_4D_PC;
 
-double benchmark(int test, const int niter) {
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+  param.precision = prec;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  B.resize(Nvec);
+  for (int i=0; i<Nvec; i++) {
+    B[i] = new cpuColorSpinorField(param);
+    static_cast<cpuColorSpinorField*>(B[i])->Source(QUDA_RANDOM_SOURCE);
+  }
+
+  fineH = new cpuColorSpinorField(param);
+  static_cast<cpuColorSpinorField*>(fineH)->Source(QUDA_RANDOM_SOURCE);
+
+  int geo_bs[] = {4, 4, 4, 4};
+  transfer = new Transfer(B, Nvec, geo_bs, 2, false, profile_transfer);
+
+  coarseH = fineH->CreateCoarse(geo_bs, 2, Nvec);
+}
+
+void freeTransfer()
+{
+  delete coarseH;
+  delete fineH;
+  delete transfer;
+  for (unsigned int i=0; i<B.size(); i++) delete B[i];
+  B.clear();
+}
+
+// the host transfer operators are synchronous so we use a host timer
+double benchmarkTransfer(int test, const int niter) {
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+
+  switch(test) {
+  case 3:
+    for (int i=0; i < niter; ++i) transfer->R(*coarseH, *fineH);
+    break;
+  case 4:
+    for (int i=0; i < niter; ++i) transfer->P(*fineH, *coarseH);
+    break;
+  case 5:
+    for (int i=0; i < niter; ++i) transfer->reset();
+    break;
+  default:
+    errorQuda("Undefined test %d", test);
+  }
+
+  timer.Stop(__func__, __FILE__, __LINE__);
+  return timer.last;
+}
+
+double benchmark(DiracCoarse *dirac, int test, const int niter) {
 
   cudaEvent_t start, end;
   cudaEventCreate(&start);
@@ -213,7 +335,10 @@ double benchmark(int test, const int niter) {
 const char *names[] = {
   "Dslash",
   "Mat",
-  "Clover"
+  "Clover",
+  "Restrict (host)",
+  "Prolongate (host)",
+  "BlockOrthogonalize (host)"
 };
 
 int main(int argc, char** argv)
@@ -236,24 +361,80 @@ int main(int argc, char** argv)
   Nspin = 2;
 
   printfQuda("\nBenchmarking %s precision with %d iterations...\n\n", get_prec_str(prec), niter);
+
+  if (test_type >= 3) {
+    // host transfer operators between a Wilson-like fine grid and its first coarse grid
+    const int Nvec = nvec[0] ? nvec[0] : 24;
+    initTransfer(prec, Nvec);
+
+    benchmarkTransfer(test_type, 1); // warm up
+    transfer->flops(); // reset flops counter
+
+    double secs = benchmarkTransfer(test_type, niter);
+    double gflops = (transfer->flops()*1e-9)/(secs);
+
+    if (test_type == 5) printfQuda("Nvec = %2d, %-31s: time per call = %8.3f ms\n", Nvec, names[test_type], 1e3*secs/niter);
+    else printfQuda("Nvec = %2d, %-31s: Gflop/s = %6.1f\n", Nvec, names[test_type], gflops);
+
+    freeTransfer();
+
+    endQuda();
+    finalizeComms();
+    return 0;
+  }
+
+  // compare half against single-precision links for the link-bound stencil applications
+  const bool half_links = (coarse_link_prec == QUDA_HALF_PRECISION && test_type < 2);
+  if (half_links && prec != QUDA_SINGLE_PRECISION)
+    errorQuda("Half-precision coarse links require single-precision fields (--prec single)");
+
   for (int c=24; c<=32; c+=8) {
     Ncolor = c;
 
-    initFields(prec);
+    initFields(prec, half_links);
 
     DiracParam param;
     dirac = new DiracCoarse(param, Y_h, X_h, Xinv_h, Yhat_h, Y_d, X_d, Xinv_d, Yhat_d);
 
     // do the initial tune
-    benchmark(test_type, 1);
+    benchmark(dirac, test_type, 1);
 
     // now rerun with more iterations to get accurate speed measurements
     dirac->Flops(); // reset flops counter
 
-    double secs = benchmark(test_type, niter);
+    double secs = benchmark(dirac, test_type, niter);
     double gflops = (dirac->Flops()*1e-9)/(secs);
 
-    printfQuda("Ncolor = %2d, %-31s: Gflop/s = %6.1f\n", Ncolor, names[test_type], gflops);
+    // link bytes streamed per call: the Dslash reads Y on one parity, M reads Y on both
+    const double link_sites = (double)Y_d->Volume() * Y_d->Geometry();
+    const double link_calls = (test_type == 0 ? 0.5 : 1.0) * niter;
+
+    printfQuda("Ncolor = %2d, %-31s: Gflop/s = %6.1f", Ncolor, names[test_type], gflops);
+    if (half_links) printfQuda(", link GB/s = %6.1f", link_calls*link_sites*Y_d->Ninternal()*Y_d->Precision()*1e-9/secs);
+    printfQuda("\n");
+
+    if (half_links) {
+      ColorSpinorParam csParam(*xD);
+      csParam.create = QUDA_NULL_FIELD_CREATE;
+      cudaColorSpinorField x_ref(csParam);
+      blas::copy(x_ref, *xD); // reference result from the last single-precision application
+
+      dirac_half = new DiracCoarse(param, Y_h, X_h, Xinv_h, Yhat_h, Y_half_d, X_d, Xinv_d, Yhat_half_d);
+
+      benchmark(dirac_half, test_type, 1);
+      dirac_half->Flops();
+
+      double secs_half = benchmark(dirac_half, test_type, niter);
+      double gflops_half = (dirac_half->Flops()*1e-9)/(secs_half);
+
+      double deviation = sqrt(blas::xmyNorm(x_ref, *xD) / blas::norm2(x_ref));
+
+      printfQuda("Ncolor = %2d, %-19s (half links): Gflop/s = %6.1f, link GB/s = %6.1f, speedup = %5.2f, relative deviation = %e\n",
+		 Ncolor, names[test_type], gflops_half, link_calls*link_sites*Y_half_d->Ninternal()*Y_half_d->Precision()*1e-9/secs_half,
+		 secs/secs_half, deviation);
+
+      delete dirac_half;
+    }
 
     delete dirac;
     freeFields();
@@ -65,6 +65,11 @@ extern QudaVerbosity mg_verbosity[QUDA_MAX_MG_LEVEL];
 
 extern QudaInverterType setup_inv[QUDA_MAX_MG_LEVEL];
 extern double setup_tol;
+extern int setup_maxiter;
+extern QudaMultigridCycleType mg_cycle_type;
+extern double coarse_solver_tol;
+extern int coarse_solver_maxiter;
+extern QudaPrecision coarse_link_prec;
 extern double omega;
 extern QudaInverterType smoother_type;
 
@@ -102,6 +107,8 @@ display_test_info()
   for (int i=0; i<mg_levels-1; i++) printfQuda(" - level %d number of null-space vectors %d\n", i+1, nvec[i]);
   printfQuda(" - number of pre-smoother applications %d\n", nu_pre);
   printfQuda(" - number of post-smoother applications %d\n", nu_post);
+  printfQuda(" - cycle type %s\n", get_mg_cycle_str(mg_cycle_type));
+  printfQuda(" - coarse link precision %s\n", get_prec_str(coarse_link_prec));
 
   printfQuda("Grid partition info:     X  Y  Z  T\n"); 
   printfQuda("                         %d  %d  %d  %d\n", 
@@ -220,13 +227,17 @@ void setMultigridParam(QudaMultigridParam &mg_param) {
     mg_param.verbosity[i] = mg_verbosity[i];
     mg_param.setup_inv_type[i] = setup_inv[i];
     mg_param.setup_tol[i] = setup_tol;
+    mg_param.setup_maxiter[i] = setup_maxiter;
     mg_param.spin_block_size[i] = 1;
     mg_param.n_vec[i] = nvec[i] == 0 ? 24 : nvec[i]; // default to 24 vectors if not set
     mg_param.nu_pre[i] = nu_pre;
     mg_param.nu_post[i] = nu_post;
     mg_param.mu_factor[i] = mu_factor[i];
 
-    mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_param.cycle_type[i] = mg_cycle_type;
+    mg_param.coarse_solver_tol[i] = coarse_solver_tol;
+    mg_param.coarse_solver_maxiter[i] = coarse_solver_maxiter;
+    mg_param.coarse_link_precision[i] = coarse_link_prec;
 
     mg_param.smoother[i] = smoother_type;
 
@@ -0,0 +1,414 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#include <util_quda.h>
+#include <test_util.h>
+#include "misc.h"
+
+#include <qio_field.h>
+
+// google test frame work
+#include <gtest.h>
+
+#define MAX(a,b) ((a)>(b)?(a):(b))
+
+// In a typical application, quda.h is the only QUDA header required.
+#include <quda.h>
+
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern QudaPrecision prec;
+extern QudaPrecision prec_sloppy;
+extern QudaReconstructType link_recon;
+extern QudaReconstructType link_recon_sloppy;
+extern QudaInverterType inv_type;
+extern double mass;
+extern double anisotropy;
+extern double tol;
+extern int niter;
+extern int gcrNkrylov;
+extern QudaMatPCType matpc_type;
+extern char latfile[];
+
+extern void usage(char** );
+
+QudaGaugeParam gauge_param;
+QudaInvertParam inv_param;
+void *gauge[4];
+
+/**
+   The resident gauge field is only inspected through the public
+   interface: its content hash, the memory reported by the load, and
+   the iteration counts of Wilson solves on it.
+*/
+void setResidentParam(QudaGaugeParam &gauge_param, QudaInvertParam &inv_param)
+{
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+
+  gauge_param.anisotropy = anisotropy;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_ANTI_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = prec;
+  gauge_param.reconstruct = link_recon;
+  gauge_param.cuda_prec_sloppy = prec_sloppy;
+  gauge_param.reconstruct_sloppy = link_recon_sloppy;
+  gauge_param.cuda_prec_precondition = prec_sloppy;
+  gauge_param.reconstruct_precondition = link_recon_sloppy;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+  gauge_param.ga_pad = 0;
+
+  // For multi-GPU, ga_pad must be large enough to store a time-slice
+#ifdef MULTI_GPU
+  int x_face_size = gauge_param.X[1]*gauge_param.X[2]*gauge_param.X[3]/2;
+  int y_face_size = gauge_param.X[0]*gauge_param.X[2]*gauge_param.X[3]/2;
+  int z_face_size = gauge_param.X[0]*gauge_param.X[1]*gauge_param.X[3]/2;
+  int t_face_size = gauge_param.X[0]*gauge_param.X[1]*gauge_param.X[2]/2;
+  int pad_size =MAX(x_face_size, y_face_size);
+  pad_size = MAX(pad_size, z_face_size);
+  pad_size = MAX(pad_size, t_face_size);
+  gauge_param.ga_pad = pad_size;
+#endif
+
+  inv_param.dslash_type = QUDA_WILSON_DSLASH;
+  inv_param.Ls = 1;
+  inv_param.mass = mass;
+  inv_param.kappa = 1.0 / (2.0 * (1 + 3/gauge_param.anisotropy + mass));
+
+  inv_param.inv_type = inv_type;
+  inv_param.solution_type = QUDA_MATPC_SOLUTION;
+  inv_param.solve_type = inv_type == QUDA_CG_INVERTER ? QUDA_NORMOP_PC_SOLVE : QUDA_DIRECT_PC_SOLVE;
+  inv_param.matpc_type = matpc_type;
+  inv_param.dagger = QUDA_DAG_NO;
+  inv_param.mass_normalization = QUDA_KAPPA_NORMALIZATION;
+  inv_param.solver_normalization = QUDA_DEFAULT_NORMALIZATION;
+
+  inv_param.gcrNkrylov = gcrNkrylov;
+  inv_param.tol = tol;
+  inv_param.residual_type = QUDA_L2_RELATIVE_RESIDUAL;
+  inv_param.maxiter = niter;
+  inv_param.reliable_delta = 1e-1;
+  inv_param.use_sloppy_partial_accumulator = 0;
+  inv_param.max_res_increase = 1;
+  inv_param.inv_type_precondition = QUDA_INVALID_INVERTER;
+
+  inv_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec = prec;
+  inv_param.cuda_prec_sloppy = prec_sloppy;
+  inv_param.cuda_prec_precondition = prec_sloppy;
+  inv_param.preserve_source = QUDA_PRESERVE_SOURCE_YES;
+  inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  inv_param.dirac_order = QUDA_DIRAC_ORDER;
+  inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.sp_pad = 0;
+  inv_param.verbosity = QUDA_SUMMARIZE;
+}
+
+/**
+   Every case starts from a real load of the original host field, so
+   that none depends on what an earlier case left resident, and frees
+   the resident field when it is done.
+*/
+class ResidentGaugeTest : public ::testing::Test {
+ protected:
+  void *in;
+  void *out;
+
+  void SetUp() {
+    freeGaugeQuda();
+    loadGaugeQuda((void*)gauge, &gauge_param);
+
+    const size_t length = Vh*spinorSiteSize;
+    in = malloc(length*sizeof(double));
+    out = malloc(length*sizeof(double));
+    for (size_t i=0; i<length; i++) ((double*)in)[i] = rand() / (double)RAND_MAX;
+  }
+
+  void TearDown() {
+    free(out);
+    free(in);
+    freeGaugeQuda();
+  }
+
+  // solve on the resident field from a zero initial guess
+  void solve(QudaInvertParam &param) {
+    memset(out, 0, Vh*spinorSiteSize*sizeof(double));
+    invertQuda(out, in, &param);
+  }
+};
+
+TEST_F(ResidentGaugeTest, reload_skipped) {
+  // the first solve builds the sloppy copy, which a real load would free
+  QudaGaugeParam load_param = gauge_param;
+  load_param.gaugeGiB = 0;
+  freeGaugeQuda();
+  loadGaugeQuda((void*)gauge, &load_param);
+  QudaInvertParam before = inv_param;
+  solve(before);
+
+  unsigned long long hash = gaugeHashQuda(gauge_param.type);
+  ASSERT_NE(hash, 0ull) << "Resident gauge field has no hash";
+
+  QudaGaugeParam reload_param = gauge_param;
+  reload_param.gaugeGiB = 0;
+  loadGaugeQuda((void*)gauge, &reload_param);
+
+  EXPECT_EQ(gaugeHashQuda(gauge_param.type), hash) << "Reload changed the gauge field hash";
+  EXPECT_DOUBLE_EQ(reload_param.gaugeGiB, load_param.gaugeGiB) << "Reload did not report the resident memory";
+
+  // the resident fields still solve the same system
+  QudaInvertParam after = inv_param;
+  solve(after);
+  EXPECT_EQ(after.iter, before.iter) << "Solve after the reload differs";
+  EXPECT_NEAR(after.true_res, before.true_res, 1e-3*before.true_res) << "Solve after the reload differs";
+
+  // a different host field, or different resident parameters, is a real load
+  const size_t bytes = V*gaugeSiteSize*gauge_param.cpu_prec;
+  void *changed[4];
+  for (int dir=0; dir<4; dir++) {
+    changed[dir] = malloc(bytes);
+    memcpy(changed[dir], gauge[dir], bytes);
+  }
+  ((double*)changed[0])[0] += 1e-3;
+  loadGaugeQuda((void*)changed, &gauge_param);
+  EXPECT_NE(gaugeHashQuda(gauge_param.type), hash) << "Load of a different field kept the hash";
+
+  loadGaugeQuda((void*)gauge, &gauge_param);
+  EXPECT_EQ(gaugeHashQuda(gauge_param.type), hash) << "Load of the original field gives a different hash";
+
+  QudaGaugeParam other_param = gauge_param;
+  other_param.anisotropy = 2.0*gauge_param.anisotropy;
+  loadGaugeQuda((void*)gauge, &other_param);
+  EXPECT_NE(gaugeHashQuda(gauge_param.type), hash) << "Load with different parameters kept the hash";
+
+  for (int dir=0; dir<4; dir++) free(changed[dir]);
+}
+
+// updateGaugeFieldQuda only takes a resident field in its own order
+static bool residentUpdateSupported()
+{
+  return gauge_param.reconstruct != QUDA_RECONSTRUCT_8 &&
+    (gauge_param.cuda_prec == QUDA_DOUBLE_PRECISION || gauge_param.reconstruct == QUDA_RECONSTRUCT_NO);
+}
+
+// random host momentum in MILC order
+static void *hostMomentum()
+{
+  void *mom = malloc(4*V*momSiteSize*gauge_param.cpu_prec);
+  createMomCPU(mom, gauge_param.cpu_prec);
+  return mom;
+}
+
+TEST_F(ResidentGaugeTest, hash_reset) {
+  if (!residentUpdateSupported()) QUDA_TEST_SKIP("updateGaugeFieldQuda does not take this resident gauge order");
+  void *mom = hostMomentum();
+
+  // the resident field is modified in place, so no host field can match it any more
+  auto expectReset = [](const char *op) {
+    EXPECT_EQ(gaugeHashQuda(gauge_param.type), 0ull) << op << " did not reset the gauge field hash";
+  };
+  auto reload = []() {
+    loadGaugeQuda((void*)gauge, &gauge_param);
+    EXPECT_NE(gaugeHashQuda(gauge_param.type), 0ull) << "Resident gauge field has no hash";
+  };
+
+  {
+    reload();
+    QudaGaugeParam param = gauge_param;
+    param.gauge_order = QUDA_MILC_GAUGE_ORDER; // order of the momentum
+    param.use_resident_gauge = 1;
+    param.make_resident_gauge = 1;
+    param.return_result_gauge = 0;
+    param.use_resident_mom = 0;
+    param.make_resident_mom = 0;
+    updateGaugeFieldQuda((void*)gauge, mom, 0.1, 0, 0, &param);
+    expectReset("updateGaugeFieldQuda");
+  }
+
+#ifdef GPU_GAUGE_ALG
+  {
+    reload();
+    // gauge fixing returns the fixed field to the host, so work on a copy
+    const size_t bytes = V*gaugeSiteSize*gauge_param.cpu_prec;
+    void *fixed[4];
+    for (int dir=0; dir<4; dir++) {
+      fixed[dir] = malloc(bytes);
+      memcpy(fixed[dir], gauge[dir], bytes);
+    }
+    QudaGaugeParam param = gauge_param;
+    param.make_resident_gauge = 1;
+    computeGaugeFixingOVRQuda((void*)fixed, 4, 1, 1, 1.5, 0.0, 1, 0, &param, nullptr);
+    expectReset("computeGaugeFixingOVRQuda");
+    for (int dir=0; dir<4; dir++) free(fixed[dir]);
+  }
+#endif
+
+#ifdef GPU_GAUGE_FORCE
+  {
+    reload();
+    // the Wilson action from the six plaquettes through each link
+    int paths[4][6][3];
+    int *path_ptr[4][6];
+    int **path_buf[4];
+    int length[6];
+    double coeff[6];
+    for (int dir=0; dir<4; dir++) {
+      for (int e=0, i=0; e<4; e++) {
+	if (e == dir) continue;
+	int fwd[] = { e, 7-dir, 7-e }, bwd[] = { 7-e, 7-dir, e };
+	memcpy(paths[dir][i++], fwd, sizeof(fwd));
+	memcpy(paths[dir][i++], bwd, sizeof(bwd));
+      }
+      for (int i=0; i<6; i++) path_ptr[dir][i] = paths[dir][i];
+      path_buf[dir] = path_ptr[dir];
+    }
+    for (int i=0; i<6; i++) { length[i] = 3; coeff[i] = 1.0; }
+
+    QudaForceTerm term;
+    term.type = QUDA_GAUGE_FORCE_TERM;
+    term.input_path_buf = path_buf;
+    term.path_length = length;
+    term.loop_coeff = coeff;
+    term.num_paths = 6;
+    term.max_length = 3;
+    term.coeff = 2.0;
+    term.callback = NULL;
+    term.context = NULL;
+
+    QudaIntegratorParam md_param = newQudaIntegratorParam();
+    md_param.n_level = 1;
+    md_param.integrator[0] = QUDA_LEAPFROG_INTEGRATOR;
+    md_param.n_step[0] = 1;
+    md_param.n_term[0] = 1;
+    md_param.term[0] = &term;
+    md_param.tau = 0.01;
+
+    QudaGaugeParam param = gauge_param;
+    param.use_resident_gauge = 1;
+    param.return_result_gauge = 0;
+    param.use_resident_mom = 0;
+    param.make_resident_mom = 0;
+    param.return_result_mom = 0;
+    integrateTrajectoryQuda((void*)gauge, mom, &md_param, &param);
+    expectReset("integrateTrajectoryQuda");
+  }
+#endif
+
+  free(mom);
+}
+
+TEST_F(ResidentGaugeTest, derived_refresh) {
+  if (!residentUpdateSupported()) QUDA_TEST_SKIP("updateGaugeFieldQuda does not take this resident gauge order");
+
+  // solve once so that the update finds sloppy copies of the original field
+  QudaInvertParam original = inv_param;
+  solve(original);
+
+  // update the resident field, keeping the result resident and on the host
+  void *mom = hostMomentum();
+  void *updated = malloc(4*V*gaugeSiteSize*gauge_param.cpu_prec);
+  QudaGaugeParam update_param = gauge_param;
+  update_param.gauge_order = QUDA_MILC_GAUGE_ORDER;
+  update_param.use_resident_gauge = 1;
+  update_param.make_resident_gauge = 1;
+  update_param.return_result_gauge = 1;
+  update_param.use_resident_mom = 0;
+  update_param.make_resident_mom = 0;
+  updateGaugeFieldQuda(updated, mom, 0.1, 0, 0, &update_param);
+
+  QudaInvertParam resident = inv_param;
+  solve(resident);
+
+  // a solve at another sloppy precision must rebuild the sloppy copies
+  QudaPrecision prec_other = inv_param.cuda_prec_sloppy == QUDA_SINGLE_PRECISION ? QUDA_HALF_PRECISION : QUDA_SINGLE_PRECISION;
+  QudaInvertParam other = inv_param;
+  other.cuda_prec_sloppy = prec_other;
+  solve(other);
+
+  // the same solves after a fresh load of the updated field
+  QudaGaugeParam load_param = gauge_param;
+  load_param.gauge_order = QUDA_MILC_GAUGE_ORDER;
+  freeGaugeQuda();
+  loadGaugeQuda(updated, &load_param);
+  QudaInvertParam fresh = inv_param;
+  solve(fresh);
+
+  freeGaugeQuda();
+  loadGaugeQuda(updated, &load_param);
+  QudaInvertParam fresh_other = other;
+  solve(fresh_other);
+
+  printfQuda("Solve on the updated resident field: %d iterations, residual %e; after a fresh load: %d iterations, residual %e\n",
+	     resident.iter, resident.true_res, fresh.iter, fresh.true_res);
+  EXPECT_EQ(resident.iter, fresh.iter) << "Derived gauge copies were not refreshed after the update";
+  EXPECT_NEAR(resident.true_res, fresh.true_res, 1e-3*fresh.true_res) << "Derived gauge copies were not refreshed after the update";
+
+  printfQuda("Solve with %s sloppy precision: %d iterations, residual %e; after a fresh load: %d iterations, residual %e\n",
+	     get_prec_str(prec_other), other.iter, other.true_res, fresh_other.iter, fresh_other.true_res);
+  EXPECT_EQ(other.iter, fresh_other.iter) << "Sloppy gauge field was not rebuilt at the new precision";
+  EXPECT_NEAR(other.true_res, fresh_other.true_res, 1e-3*fresh_other.true_res) << "Sloppy gauge field was not rebuilt at the new precision";
+
+  free(updated);
+  free(mom);
+}
+
+int main(int argc, char **argv)
+{
+  // initalize google test, includes command line options
+  ::testing::InitGoogleTest(&argc, argv);
+  // return code for google test
+  int test_rc = 0;
+
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  if (prec_sloppy == QUDA_INVALID_PRECISION) prec_sloppy = prec;
+  if (link_recon_sloppy == QUDA_RECONSTRUCT_INVALID) link_recon_sloppy = link_recon;
+
+  // initialize QMP/MPI, QUDA comms grid and RNG (test_util.cpp)
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  gauge_param = newQudaGaugeParam();
+  inv_param = newQudaInvertParam();
+  setResidentParam(gauge_param, inv_param);
+
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+
+  if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
+    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
+  } else { // else generate a random SU(3) field
+    construct_gauge_field(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  }
+
+  initQuda(device);
+
+  test_rc = RUN_ALL_TESTS();
+
+  endQuda();
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+
+  finalizeComms();
+
+  return test_rc;
+}
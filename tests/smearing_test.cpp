@@ -0,0 +1,236 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#include <util_quda.h>
+#include <test_util.h>
+#include "misc.h"
+
+#include <qio_field.h>
+
+// google test frame work
+#include <gtest.h>
+
+#define MAX(a,b) ((a)>(b)?(a):(b))
+
+// In a typical application, quda.h is the only QUDA header required.
+#include <quda.h>
+
+// internal headers used by the tests of the host routines
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int gridsize_from_cmdline[];
+extern QudaPrecision prec;
+extern QudaReconstructType link_recon;
+extern double anisotropy;
+extern char latfile[];
+
+extern void usage(char** );
+
+QudaGaugeParam gauge_param;
+QudaInvertParam inv_param;
+void *gauge[4];
+
+// a four-dimensional Wilson-type field in the DeGrand-Rossi basis, as
+// the host smearing routines expect
+void setSmearingParam(QudaGaugeParam &gauge_param, QudaInvertParam &inv_param)
+{
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+
+  gauge_param.anisotropy = anisotropy;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = prec;
+  gauge_param.reconstruct = link_recon;
+  gauge_param.cuda_prec_sloppy = prec;
+  gauge_param.reconstruct_sloppy = link_recon;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+  gauge_param.ga_pad = 0;
+
+  // For multi-GPU, ga_pad must be large enough to store a time-slice
+#ifdef MULTI_GPU
+  int x_face_size = gauge_param.X[1]*gauge_param.X[2]*gauge_param.X[3]/2;
+  int y_face_size = gauge_param.X[0]*gauge_param.X[2]*gauge_param.X[3]/2;
+  int z_face_size = gauge_param.X[0]*gauge_param.X[1]*gauge_param.X[3]/2;
+  int t_face_size = gauge_param.X[0]*gauge_param.X[1]*gauge_param.X[2]/2;
+  int pad_size =MAX(x_face_size, y_face_size);
+  pad_size = MAX(pad_size, z_face_size);
+  pad_size = MAX(pad_size, t_face_size);
+  gauge_param.ga_pad = pad_size;
+#endif
+
+  inv_param.dslash_type = QUDA_WILSON_DSLASH;
+  inv_param.Ls = 1;
+  inv_param.solution_type = QUDA_MAT_SOLUTION;
+  inv_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec = prec;
+  inv_param.cuda_prec_sloppy = prec;
+  inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  inv_param.dirac_order = QUDA_DIRAC_ORDER;
+  inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+  inv_param.sp_pad = 0;
+  inv_param.verbosity = QUDA_SUMMARIZE;
+}
+
+// relative deviation |a - b| / |b| of two double-precision host vectors
+static double relativeDeviation(const void *a, const void *b, size_t length)
+{
+  double diff = 0.0, norm = 0.0;
+  for (size_t i=0; i<length; i++) {
+    double d = static_cast<const double*>(a)[i] - static_cast<const double*>(b)[i];
+    diff += d*d;
+    norm += static_cast<const double*>(b)[i] * static_cast<const double*>(b)[i];
+  }
+  return sqrt(diff / norm);
+}
+
+static void *randomSpinor(size_t length)
+{
+  double *v = (double*)malloc(length*sizeof(double));
+  for (size_t i=0; i<length; i++) v[i] = rand() / (double)RAND_MAX;
+  return v;
+}
+
+TEST(smearing, host_device) {
+  // the device supports single and double precision only
+  if (inv_param.cuda_prec == QUDA_HALF_PRECISION) QUDA_TEST_SKIP("device smearing does not support half precision");
+
+  const int n_vec = 4;
+  const unsigned int n_steps = 5;
+  const double alpha = 0.5;
+  const size_t length = V*spinorSiteSize;
+
+  void *in[n_vec], *host[n_vec], *device[n_vec];
+  for (int v=0; v<n_vec; v++) {
+    in[v] = randomSpinor(length);
+    host[v] = malloc(length*sizeof(double));
+    device[v] = malloc(length*sizeof(double));
+  }
+
+  performWuppertalnStepHost(host, in, n_vec, gauge, &gauge_param, &inv_param, n_steps, alpha);
+  for (int v=0; v<n_vec; v++) performWuppertalnStep(device[v], in[v], &inv_param, n_steps, alpha);
+
+  double tol = inv_param.cuda_prec == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-5;
+  for (int v=0; v<n_vec; v++) {
+    EXPECT_LE(relativeDeviation(host[v], device[v], length), tol) << "Host and device smearing of vector " << v << " do not agree";
+    free(device[v]);
+    free(host[v]);
+    free(in[v]);
+  }
+}
+
+TEST(smearing, multi_vector) {
+  // more vectors than are smeared in a single pass, such that the batching is exercised
+  const int n_vec = 13;
+  const unsigned int n_steps = 3;
+  const double alpha = 0.5;
+  const size_t length = V*spinorSiteSize;
+
+  void *in[n_vec], *multi[n_vec], *single[n_vec];
+  for (int v=0; v<n_vec; v++) {
+    in[v] = randomSpinor(length);
+    multi[v] = malloc(length*sizeof(double));
+    single[v] = malloc(length*sizeof(double));
+  }
+
+  performWuppertalnStepHost(multi, in, n_vec, gauge, &gauge_param, &inv_param, n_steps, alpha);
+  for (int v=0; v<n_vec; v++) performWuppertalnStepHost(&single[v], &in[v], 1, gauge, &gauge_param, &inv_param, n_steps, alpha);
+
+  for (int v=0; v<n_vec; v++) {
+    EXPECT_LE(relativeDeviation(multi[v], single[v], length), 1e-14) << "Multi-vector smearing of vector " << v << " differs";
+    free(single[v]);
+    free(multi[v]);
+    free(in[v]);
+  }
+}
+
+TEST(smearing, single_parity) {
+  using namespace quda;
+  GaugeFieldParam gParam(gauge, gauge_param);
+  cpuGaugeField U(gParam);
+  U.exchangeGhost();
+
+  // a full field whose two parities hold the same checkerboarded vector
+  ColorSpinorParam param(NULL, inv_param, gauge_param.X, false, QUDA_CPU_FIELD_LOCATION);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField in(param), out(param);
+  double *x = static_cast<double*>(in.V());
+  for (int i=0; i<Vh*spinorSiteSize; i++) x[i] = x[Vh*spinorSiteSize + i] = rand() / (double)RAND_MAX;
+
+  const double A = 0.3, B = 0.2;
+  wuppertalStep(out, in, 0, U, A, B);
+
+  // a single-parity field stores the requested parity at its own
+  // parity index 0, and its neighbours come from the ghost zones that
+  // the host accessors pick up from the field
+  ColorSpinorParam parityParam(NULL, inv_param, gauge_param.X, true, QUDA_CPU_FIELD_LOCATION);
+  parityParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField outParity(parityParam);
+  for (int parity=0; parity<2; parity++) {
+    wuppertalStep(outParity, in.Odd(), parity, U, A, B);
+    const void *ref = parity == 0 ? out.Even().V() : out.Odd().V();
+    EXPECT_LE(relativeDeviation(outParity.V(), ref, Vh*spinorSiteSize), 1e-14) << "Single-parity smearing of parity " << parity << " differs";
+  }
+}
+
+int main(int argc, char **argv)
+{
+  // initalize google test, includes command line options
+  ::testing::InitGoogleTest(&argc, argv);
+  // return code for google test
+  int test_rc = 0;
+
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+    printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+    usage(argv);
+  }
+
+  // initialize QMP/MPI, QUDA comms grid and RNG (test_util.cpp)
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  gauge_param = newQudaGaugeParam();
+  inv_param = newQudaInvertParam();
+  setSmearingParam(gauge_param, inv_param);
+
+  setDims(gauge_param.X);
+  setSpinorSiteSize(24);
+
+  for (int dir = 0; dir < 4; dir++) gauge[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+
+  if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
+    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
+  } else { // else generate a random SU(3) field
+    construct_gauge_field(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+  }
+
+  initQuda(device);
+  loadGaugeQuda((void*)gauge, &gauge_param);
+
+  test_rc = RUN_ALL_TESTS();
+
+  freeGaugeQuda();
+  endQuda();
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+
+  finalizeComms();
+
+  return test_rc;
+}
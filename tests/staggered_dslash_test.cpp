@@ -40,7 +40,7 @@ QudaInvertParam inv_param;
 cpuGaugeField *cpuFat = NULL;
 cpuGaugeField *cpuLong = NULL;
 
-cpuColorSpinorField *spinor, *spinorOut, *spinorRef, *tmpCpu;
+cpuColorSpinorField *spinor, *spinorOut, *spinorRef, *tmpCpu, *spinorHost;
 cudaColorSpinorField *cudaSpinor, *cudaSpinorOut;
 
 cudaColorSpinorField* tmp;
@@ -75,6 +75,7 @@ int X[4];
 extern int Nsrc; // number of spinors to apply to simultaneously
 
 Dirac* dirac;
+Dirac* hostDirac = NULL; // improved staggered operator acting on the host fields
 
 void init()
 {    
@@ -170,6 +171,7 @@ void init()
   spinorOut = new cpuColorSpinorField(csParam);
   spinorRef = new cpuColorSpinorField(csParam);
   tmpCpu = new cpuColorSpinorField(csParam);
+  spinorHost = new cpuColorSpinorField(csParam);
 
   csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
   csParam.x[0] = gaugeParam.X[0];
@@ -191,18 +193,19 @@ void init()
 
   construct_fat_long_gauge_field(fatlink, longlink, 1, gaugeParam.cpu_prec, &gaugeParam, dslash_type);
 
-#ifdef MULTI_GPU
   gaugeParam.type = QUDA_ASQTAD_FAT_LINKS;
   gaugeParam.reconstruct = QUDA_RECONSTRUCT_NO;
   GaugeFieldParam cpuFatParam(fatlink, gaugeParam);
   cpuFatParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
   cpuFat = new cpuGaugeField(cpuFatParam);
-  ghost_fatlink = cpuFat->Ghost();
 
   gaugeParam.type = QUDA_ASQTAD_LONG_LINKS;
   GaugeFieldParam cpuLongParam(longlink, gaugeParam);
   cpuLongParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
   cpuLong = new cpuGaugeField(cpuLongParam);
+
+#ifdef MULTI_GPU
+  ghost_fatlink = cpuFat->Ghost();
   ghost_longlink = cpuLong->Ghost();
 
   int x_face_size = X[1]*X[2]*X[3]/2;
@@ -280,6 +283,13 @@ void init()
 
     dirac = Dirac::create(diracParam);
 
+    if (dslash_type == QUDA_ASQTAD_DSLASH) {
+      diracParam.fatGauge = cpuFat;
+      diracParam.longGauge = cpuLong;
+      diracParam.tmp1 = NULL;
+      hostDirac = Dirac::create(diracParam);
+    }
+
   } else {
     errorQuda("Error not suppported");
   }
@@ -296,6 +306,7 @@ void end(void)
 
   if (!transfer){
     delete dirac;
+    if (hostDirac) delete hostDirac;
     delete cudaSpinor;
     delete cudaSpinorOut;
     delete tmp;
@@ -305,6 +316,7 @@ void end(void)
   delete spinorOut;
   delete spinorRef;
   delete tmpCpu;
+  delete spinorHost;
 
   if (cpuFat) delete cpuFat;
   if (cpuLong) delete cpuLong;
@@ -363,6 +375,26 @@ double dslashCUDA(int niter) {
   return secs;
 }
 
+double dslashHost(int niter) {
+
+  stopwatchStart();
+
+  for (int i = 0; i < niter; i++) {
+    switch (test_type) {
+      case 0:
+        hostDirac->Dslash(*spinorHost, *spinor, parity);
+        break;
+      case 1:
+        hostDirac->MdagM(*spinorHost, *spinor);
+        break;
+      default:
+        errorQuda("Test type %d not supported on the host", test_type);
+    }
+  }
+
+  return stopwatchReadSeconds();
+}
+
 void staggeredDslashRef()
 {
 
@@ -405,6 +437,30 @@ TEST(dslash, verify) {
   ASSERT_LE(deviation, tol) << "CPU and CUDA implementations do not agree";
 }
 
+TEST(dslash, host_verify) {
+  if (!hostDirac) return;
+  double deviation = pow(10, -(double)(cpuColorSpinorField::Compare(*spinorRef, *spinorHost)));
+  ASSERT_LE(deviation, 1e-12) << "Host operator and reference implementation do not agree";
+}
+
+TEST(dslash, host_xpay) {
+  // DslashXpay gives k x - D in, where the reference has computed D in for test type 0
+  if (!hostDirac || test_type != 0) return;
+  const double k = 0.375;
+
+  ColorSpinorParam param(*spinor);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuColorSpinorField x(param), out(param), ref(param);
+  x.Source(QUDA_RANDOM_SOURCE);
+  ref = *spinorRef;
+  blas::axpby(k, x, -1.0, ref);
+
+  hostDirac->DslashXpay(out, *spinor, parity, x, k);
+
+  double deviation = pow(10, -(double)(cpuColorSpinorField::Compare(ref, out)));
+  ASSERT_LE(deviation, 1e-12) << "Host DslashXpay and reference implementation do not agree";
+}
+
 static int dslashTest()
 {
   // return code for google test
@@ -433,6 +489,13 @@ static int dslashTest()
 
     unsigned long long flops = dirac->Flops();
     printfQuda("GFLOPS = %f\n", 1.0e-9*flops/secs);
+
+    if (hostDirac) {
+      hostDirac->Flops();
+      double host_secs = dslashHost(niter);
+      unsigned long long host_flops = hostDirac->Flops();
+      printfQuda("Host operator: %fms per loop, GFLOPS = %f\n", 1000*host_secs/niter, 1.0e-9*host_flops/host_secs);
+    }
     printfQuda("Effective halo bi-directional bandwidth = %f for aggregate message size %lu bytes\n",
 	       1.0e-9*2*cudaSpinor->GhostBytes()*niter/secs, 2*cudaSpinor->GhostBytes());
 
@@ -81,7 +81,9 @@ void setGaugeParam(QudaGaugeParam &gauge_param) {
 
 extern void usage(char**);
 
-void SU3test(int argc, char **argv) {
+int SU3test(int argc, char **argv) {
+
+  int fail = 0;
 
   for (int i = 1; i < argc; i++){
     if(process_command_line_option(argc, argv, &i) == 0){
@@ -146,6 +148,17 @@ void SU3test(int argc, char **argv) {
   time0 /= CLOCKS_PER_SEC;
   printf("Computed topological charge is %.16e Done in %g secs\n", qCharge, time0);
 
+  // the host implementation should agree with the device one
+  double plaq_host[3];
+  time0 = -((double)clock());
+  double qCharge_host = gaugeObservablesHostQuda(plaq_host, gauge, &gauge_param);
+  time0 += clock();
+  time0 /= CLOCKS_PER_SEC;
+  printf("Host plaquette is %e (spatial = %e, temporal = %e), topological charge is %.16e Done in %g secs\n",
+	 plaq_host[0], plaq_host[1], plaq_host[2], qCharge_host, time0);
+  printf("Host - device deviation: plaquette = %e, topological charge = %e\n",
+	 fabs(plaq_host[0] - plaq[0]), fabs(qCharge_host - qCharge));
+
   // Stout smearing should be equivalent to APE smearing
   // on D dimensional lattices for rho = alpha/2*(D-1). 
   // Typical APE values are aplha=0.6, rho=0.1 for Stout.
@@ -191,6 +204,51 @@ void SU3test(int argc, char **argv) {
   qCharge = qChargeCuda();
   printf("Computed topological charge after is %.16e \n", qCharge);
 
+  // Gradient flow with adaptive step size, measuring on the way
+  const int n_flow = 4;
+  double t_flow[n_flow] = { 0.0, 0.25, 0.5, 1.0 };
+  double E[n_flow], t2E[n_flow], Q[n_flow];
+  double E_host[n_flow], t2E_host[n_flow], Q_host[n_flow];
+  QudaGaugeFlowType flow_type[2] = { QUDA_FLOW_WILSON, QUDA_FLOW_ZEUTHEN };
+  const char *flow_str[2] = { "Wilson", "Zeuthen" };
+
+  // the host and device flows may accept different step sequences, so
+  // they agree to within the integration error rather than to rounding
+  const double flow_tol = 10*1e-5;
+
+  void *flow_gauge[4];
+  for (int dir = 0; dir < 4; dir++) flow_gauge[dir] = malloc(V*gaugeSiteSize*gSize);
+
+  for (int f = 0; f < 2; f++) {
+    time0 = -((double)clock());
+    int steps = performGradientFlowQuda(flow_type[f], 0.01, 1e-5, n_flow, t_flow, E, t2E, Q);
+    time0 += clock();
+    time0 /= CLOCKS_PER_SEC;
+    printfQuda("Total time for %s flow = %g secs (%d steps)\n", flow_str[f], time0, steps);
+
+    // the host flow runs on a copy of the original field
+    for (int dir = 0; dir < 4; dir++) memcpy(flow_gauge[dir], gauge[dir], V*gaugeSiteSize*gSize);
+    time0 = -((double)clock());
+    steps = performGradientFlowHostQuda(flow_gauge, &gauge_param, flow_type[f], 0.01, 1e-5, n_flow, t_flow,
+					E_host, t2E_host, Q_host);
+    time0 += clock();
+    time0 /= CLOCKS_PER_SEC;
+    printfQuda("Total time for host %s flow = %g secs (%d steps)\n", flow_str[f], time0, steps);
+
+    for (int i = 0; i < n_flow; i++) {
+      printfQuda("t = %5.2f: E = %e, t^2 E = %e, Q = %e, host - device deviation: t^2 E = %e, Q = %e\n",
+		 t_flow[i], E[i], t2E[i], Q[i], fabs(t2E_host[i] - t2E[i]), fabs(Q_host[i] - Q[i]));
+      if (fabs(t2E_host[i] - t2E[i]) > flow_tol*MAX(1.0, fabs(t2E[i])) ||
+	  fabs(Q_host[i] - Q[i]) > flow_tol*MAX(1.0, fabs(Q[i]))) {
+	printfQuda("FAILED: host %s flow at t = %5.2f deviates from the device flow by more than %e\n",
+		   flow_str[f], t_flow[i], flow_tol);
+	fail++;
+      }
+    }
+  }
+
+  for (int dir = 0; dir < 4; dir++) free(flow_gauge[dir]);
+
 #else
   printf("Skipping plaquette tests since gauge tools have not been compiled\n");
 #endif
@@ -206,11 +264,13 @@ void SU3test(int argc, char **argv) {
   }
 
   finalizeComms();
+
+  return fail;
 }
 
 int main(int argc, char **argv) {
 
-  SU3test(argc, argv);
+  int fail = SU3test(argc, argv);
 
-  return 0;
+  return fail ? 1 : 0;
 }
@@ -1566,6 +1566,7 @@ QudaPrecision prec = QUDA_SINGLE_PRECISION;
 QudaPrecision  prec_sloppy = QUDA_INVALID_PRECISION;
 QudaPrecision  prec_precondition = QUDA_INVALID_PRECISION;
 QudaPrecision  prec_ritz = QUDA_INVALID_PRECISION;
+QudaPrecision  prec_offset = QUDA_INVALID_PRECISION;
 
 int xdim = 24;
 int ydim = 24;
@@ -1586,6 +1587,8 @@ int test_type = 0;
 int nvec[QUDA_MAX_MG_LEVEL] = { };
 char vec_infile[256] = "";
 char vec_outfile[256] = "";
+char prop_outfile[256] = "";
+QudaPrecision prop_save_prec = QUDA_INVALID_PRECISION;
 QudaInverterType inv_type;
 QudaInverterType precon_type = QUDA_INVALID_INVERTER;
 int multishift = 0;
@@ -1611,6 +1614,12 @@ double mu_factor[QUDA_MAX_MG_LEVEL] = { };
 QudaVerbosity mg_verbosity[QUDA_MAX_MG_LEVEL] = { };
 QudaInverterType setup_inv[QUDA_MAX_MG_LEVEL] = { };
 double setup_tol = 5e-6;
+int setup_maxiter = 0;
+int setup_maxiter_refresh = 0;
+QudaMultigridCycleType mg_cycle_type = QUDA_MG_CYCLE_RECURSIVE;
+double coarse_solver_tol = 0.25;
+int coarse_solver_maxiter = 2;
+QudaPrecision coarse_link_prec = QUDA_SINGLE_PRECISION;
 double omega = 0.85;
 QudaInverterType smoother_type = QUDA_MR_INVERTER;
 bool generate_nullspace = true;
@@ -1652,6 +1661,7 @@ void usage(char** argv )
   printf("    --prec-sloppy <double/single/half>        # Sloppy precision in GPU\n");
   printf("    --prec-precondition <double/single/half>  # Preconditioner precision in GPU\n");
   printf("    --prec-ritz <double/single/half>  # Eigenvector precision in GPU\n");
+  printf("    --prec-offset <double/single/half>        # Precision of the search directions of the heavier half of the multi-shift solver shifts (default prec-sloppy)\n");
   printf("    --recon <8/9/12/13/18>                    # Link reconstruction type\n");
   printf("    --recon-sloppy <8/9/12/13/18>             # Sloppy link reconstruction type\n");
   printf("    --recon-precondition <8/9/12/13/18>       # Preconditioner link reconstruction type\n");
@@ -1675,6 +1685,8 @@ void usage(char** argv )
          "                                                  /asqtad/domain-wall/domain-wall-4d/mobius/laplace\n");
   printf("    --flavor <type>                           # Set the twisted mass flavor type (singlet (default), deg-doublet, nondeg-doublet)\n");
   printf("    --load-gauge file                         # Load gauge field \"file\" for the test (requires QIO)\n");
+  printf("    --prop-save prefix                        # Save each solution to \"prefix.<n>\" on a background thread (requires QIO)\n");
+  printf("    --prop-save-prec <double/single>          # Precision of the saved solutions (default solution precision)\n");
   printf("    --niter <n>                               # The number of iterations to perform (default 10)\n");
   printf("    --ngcrkrylov <n>                          # The number of inner iterations to use for GCR, BiCGstab-l (default 10)\n");
   printf("    --pipeline <n>                            # The pipeline length for fused operations in GCR, BiCGstab-l (default 0, no pipelining)\n");
@@ -1702,6 +1714,12 @@ void usage(char** argv )
   printf("    --mg-nu-post <1-20>                       # The number of post-smoother applications to do at each multigrid level (default 2)\n");
   printf("    --mg-setup-inv <level inv>                # The inverter to use for the setup of multigrid (default bicgstab)\n");
   printf("    --mg-setup-tol                            # The tolerance to use for the setup of multigrid (default 5e-6)\n");
+  printf("    --mg-setup-maxiter <n>                    # The maximum number of solver iterations to use when generating the null space (default 0, 2000 for CG and 500 otherwise)\n");
+  printf("    --mg-setup-maxiter-refresh <n>            # The maximum number of solver iterations to use when refreshing the null space on update (default 0, no refresh)\n");
+  printf("    --mg-cycle-type <vcycle/wcycle/kcycle/recursive> # The multigrid cycle to use on the intermediate levels (default recursive)\n");
+  printf("    --mg-coarse-solver-tol <tol>              # The tolerance of the flexible GCR wrapping each coarse level of a K-cycle (default 0.25)\n");
+  printf("    --mg-coarse-solver-maxiter <n>            # The number of flexible GCR iterations wrapping each coarse level of a K-cycle (default 2)\n");
+  printf("    --mg-coarse-link-prec <single/half>       # The precision in which the coarse link field is stored when applying the coarse operator (default single)\n");
   printf("    --mg-omega                                # The over/under relaxation factor for the smoother of multigrid (default 0.85)\n");
   printf("    --mg-smoother                             # The smoother to use for multigrid (default mr)\n");
   printf("    --mg-block-size <level x y z t>           # Set the geometric block size for the each multigrid level's transfer operator (default 4 4 4 4)\n");
@@ -1811,6 +1829,16 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
   
+  if( strcmp(argv[i], "--prec-offset") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+    prec_offset =  get_prec(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--prec-precondition") == 0){
     if (i+1 >= argc){
       usage(argv);
@@ -2432,6 +2460,75 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--mg-setup-maxiter") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    setup_maxiter = atoi(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--mg-setup-maxiter-refresh") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    setup_maxiter_refresh = atoi(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--mg-cycle-type") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    mg_cycle_type = get_mg_cycle_type(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--mg-coarse-solver-tol") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    coarse_solver_tol = atof(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--mg-coarse-solver-maxiter") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+
+    coarse_solver_maxiter = atoi(argv[i+1]);
+    if (coarse_solver_maxiter < 1){
+      printf("ERROR: invalid coarse solver iteration count %d\n", coarse_solver_maxiter);
+      usage(argv);
+    }
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--mg-coarse-link-prec") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+    coarse_link_prec = get_prec(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--mg-omega") == 0){
     if (i+1 >= argc){
       usage(argv);
@@ -2593,6 +2690,26 @@ int process_command_line_option(int argc, char** argv, int* idx)
     goto out;
   }
 
+  if( strcmp(argv[i], "--prop-save") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+    strcpy(prop_outfile, argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
+  if( strcmp(argv[i], "--prop-save-prec") == 0){
+    if (i+1 >= argc){
+      usage(argv);
+    }
+    prop_save_prec = get_prec(argv[i+1]);
+    i++;
+    ret = 0;
+    goto out;
+  }
+
   if( strcmp(argv[i], "--mg-save-vec") == 0){
     if (i+1 >= argc){
       usage(argv);
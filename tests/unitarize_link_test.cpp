@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <complex>
 
 #include <cuda.h>
 #include <cuda_runtime.h>
@@ -52,7 +53,7 @@ extern QudaPrecision prec;
 static QudaPrecision cpu_prec = QUDA_DOUBLE_PRECISION;
 static QudaGaugeFieldOrder gauge_order = QUDA_MILC_GAUGE_ORDER;
 
-cpuGaugeField *cpuFatLink, *cpuULink, *cudaResult;
+cpuGaugeField *cpuFatLink, *cpuULink, *cudaResult, *cpuSiteLink;
 cudaGaugeField *cudaFatLink, *cudaULink;
 
 const double tol = (prec == QUDA_DOUBLE_PRECISION) ? 1e-10 : 1e-6;
@@ -72,6 +73,94 @@ TEST(unitarization, verify) {
   ASSERT_EQ(res,1) << "CPU and CUDA implementations do not agree";
 }
 
+/**
+   Deviation of a MILC-ordered double-precision field from SU(3): the
+   largest of |det U - 1| and the largest element of |U^dagger U - 1|
+   over all links.
+ */
+static double su3Deviation(const cpuGaugeField &u)
+{
+  typedef std::complex<double> Complex;
+  const Complex *link = static_cast<const Complex*>(u.Gauge_p());
+  double deviation = 0.0;
+  for (int i=0; i<4*u.Volume(); i++) {
+    const Complex *U = link + 9*i;
+    Complex det = U[0]*(U[4]*U[8] - U[5]*U[7]) - U[1]*(U[3]*U[8] - U[5]*U[6]) + U[2]*(U[3]*U[7] - U[4]*U[6]);
+    deviation = std::max(deviation, std::abs(det - 1.0));
+    for (int r=0; r<3; r++) {
+      for (int c=0; c<3; c++) {
+	Complex uu = 0.0;
+	for (int k=0; k<3; k++) uu += std::conj(U[3*k+r]) * U[3*k+c];
+	deviation = std::max(deviation, std::abs(uu - (r == c ? 1.0 : 0.0)));
+      }
+    }
+  }
+  return deviation;
+}
+
+TEST(unitarization, project_su3) {
+  // perturb the site links away from SU(3), after undoing the
+  // boundary signs so the determinant phase stays clear of the branch
+  // cut, where host and device could pick different cube roots
+  GaugeFieldParam param(*cpuSiteLink);
+  param.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField hostLink(param);
+  cpuGaugeField deviceResult(param);
+  const double *in = static_cast<const double*>(cpuSiteLink->Gauge_p());
+  double *out = static_cast<double*>(hostLink.Gauge_p());
+  for (int i=0; i<4*cpuSiteLink->Volume(); i++) {
+    const double *v = in + i*gaugeSiteSize;
+    // real part of the determinant, which is +1 or -1 for the signed SU(3) links
+    double det = 0.0;
+    for (int c=0; c<3; c++) {
+      int c1 = (c+1)%3, c2 = (c+2)%3;
+      std::complex<double> u0(v[2*c], v[2*c+1]);
+      std::complex<double> m = std::complex<double>(v[6+2*c1], v[6+2*c1+1]) * std::complex<double>(v[12+2*c2], v[12+2*c2+1])
+	- std::complex<double>(v[6+2*c2], v[6+2*c2+1]) * std::complex<double>(v[12+2*c1], v[12+2*c1+1]);
+      det += (u0*m).real();
+    }
+    const double sign = det < 0 ? -1.0 : 1.0;
+    for (int j=0; j<gaugeSiteSize; j++)
+      out[i*gaugeSiteSize+j] = sign*v[j] + 0.1*(rand()/(double)RAND_MAX - 0.5);
+  }
+
+  param.reconstruct = QUDA_RECONSTRUCT_NO;
+  param.order = QUDA_FLOAT2_GAUGE_ORDER;
+  param.setPrecision(prec);
+  cudaGaugeField deviceLink(param);
+  deviceLink.loadCPUField(hostLink);
+
+  const double project_tol = prec == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-6;
+  int host_fails = 0;
+  projectSU3(hostLink, 1e-12, &host_fails);
+
+  int *fails_dev;
+  cudaMalloc(&fails_dev, sizeof(int));
+  cudaMemset(fails_dev, 0, sizeof(int));
+  projectSU3(deviceLink, project_tol, fails_dev);
+  int device_fails = 0;
+  cudaMemcpy(&device_fails, fails_dev, sizeof(int), cudaMemcpyDeviceToHost);
+  cudaFree(fails_dev);
+  deviceLink.saveCPUField(deviceResult);
+
+  double host_deviation = su3Deviation(hostLink);
+  double device_deviation = su3Deviation(deviceResult);
+  printfQuda("Deviation from SU(3) after projection: host %e (%d failures), device %e (%d failures)\n",
+	     host_deviation, host_fails, device_deviation, device_fails);
+
+  EXPECT_EQ(host_fails, 0) << "Host SU(3) projection failed";
+  EXPECT_LE(host_deviation, 1e-12) << "Host projection is not special unitary";
+  EXPECT_EQ(device_fails, 0) << "Device SU(3) projection failed";
+
+  int res = compare_floats(deviceResult.Gauge_p(), hostLink.Gauge_p(), 4*hostLink.Volume()*gaugeSiteSize,
+			   prec == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-5, cpu_prec);
+#ifdef MULTI_GPU
+  comm_allreduce_int(&res);
+  res /= comm_size();
+#endif
+  EXPECT_EQ(res, 1) << "Host and device SU(3) projections do not agree";
+}
+
 static int unitarize_link_test(int &test_rc)
 {
   QudaGaugeParam qudaGaugeParam = newQudaGaugeParam();
@@ -164,6 +253,10 @@ static int unitarize_link_test(int &test_rc)
   gParam.create = QUDA_ZERO_FIELD_CREATE;
   cudaResult  = new cpuGaugeField(gParam);
 
+  gParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  gParam.gauge  = inlink;
+  cpuSiteLink = new cpuGaugeField(gParam);
+
   gParam.pad         = 0;
   gParam.create      = QUDA_NULL_FIELD_CREATE;
   gParam.reconstruct = QUDA_RECONSTRUCT_NO;
@@ -213,7 +306,19 @@ static int unitarize_link_test(int &test_rc)
     if (test_rc != 0) warningQuda("Tests failed");
   }
 
+  // host throughput of the batched unitarization
+  const int niter_host = 10;
+  struct timeval h0, h1;
+  int host_failures = 0;
+  gettimeofday(&h0,NULL);
+  for (int i=0; i<niter_host; i++) host_failures += unitarizeLinksCPU(*cpuULink, *cpuFatLink);
+  gettimeofday(&h1,NULL);
+  double host_secs = TDIFF(h0,h1) / niter_host;
+  printfQuda("Host unitarization time: %g ms (%g links/s, %d failures)\n", host_secs*1000,
+	     4.0*cpuFatLink->Volume()/host_secs, host_failures / niter_host);
+
   delete cudaResult;
+  delete cpuSiteLink;
   delete cpuULink;
   delete cpuFatLink;
   delete cudaFatLink;